@@ -98,11 +98,12 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	std::size_t nbSamples = end - begin;
+	m_nco.mixIQ(begin, end, m_mixBuffer);
+
+	for (std::size_t i = 0; i < nbSamples; i++)
 	{
-		//Complex c(it->real() / 32768.0, it->imag() / 32768.0);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = m_mixBuffer[i];
 
 		if (m_interpolatorDistance < 1.0f) // interpolate
 		{
@@ -127,7 +128,7 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill)
 		{
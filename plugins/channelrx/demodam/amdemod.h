@@ -50,6 +50,8 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+	AudioFifo *getAudioFifo() { return &m_audioFifo; }
+
 	double getMagSq() const { return m_magsq; }
 	bool getSquelchOpen() const { return m_squelchOpen; }
 
@@ -169,6 +171,7 @@ private:
 	Config m_running;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixBuffer; //!< input shifted by the NCO
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -263,7 +266,7 @@ private:
 
         if (m_audioBufferFill >= m_audioBuffer.size())
         {
-            uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+            uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
             if (res != m_audioBufferFill)
             {
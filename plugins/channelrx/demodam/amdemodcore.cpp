@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "amdemod.h"
+#include "amdemodcore.h"
+
+AMDemodCore* AMDemodCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new AMDemodCore(deviceAPI);
+}
+
+void AMDemodCore::destroy()
+{
+	delete this;
+}
+
+AMDemodCore::AMDemodCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("AMDemod")
+{
+	m_amDemod = new AMDemod();
+	m_channelizer = new DownChannelizer(m_amDemod);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("AM Demodulator");
+	m_channelMarker.setColor(Qt::yellow);
+
+	resetToDefaults();
+}
+
+AMDemodCore::~AMDemodCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_amDemod;
+}
+
+void AMDemodCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString AMDemodCore::getName() const
+{
+	return m_name;
+}
+
+qint64 AMDemodCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void AMDemodCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void AMDemodCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+
+	applySettings(true);
+}
+
+QByteArray AMDemodCore::serialize() const
+{
+	AMDemodSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
+}
+
+bool AMDemodCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.deserialize(m_settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	if (m_settings.m_hasRgbColor) {
+		m_channelMarker.setColor(m_settings.m_rgbColor);
+	}
+
+	applySettings(true);
+	return true;
+}
+
+void AMDemodCore::applySettings(bool force)
+{
+	m_channelMarker.setBandwidth(m_settings.m_rfBandwidth * 100);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		48000,
+		m_channelMarker.getCenterFrequency());
+
+	m_amDemod->configure(m_amDemod->getInputMessageQueue(),
+		m_settings.m_rfBandwidth * 100.0,
+		m_settings.m_volume / 10.0,
+		m_settings.m_squelch,
+		false, // the audio mute is not saved in the presets
+		m_settings.m_bandpassEnable,
+		false, // no copy to UDP: it is not saved in the presets
+		m_channelMarker.getUDPAddress(),
+		m_channelMarker.getUDPSendPort(),
+		force);
+
+	qDebug() << "AMDemodCore::applySettings:"
+			<< " rfBandwidth: " << m_settings.m_rfBandwidth * 100
+			<< " squelch: " << m_settings.m_squelch
+			<< " bandpassEnable: " << m_settings.m_bandpassEnable;
+}
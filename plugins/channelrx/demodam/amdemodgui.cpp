@@ -25,13 +25,13 @@
 #include "dsp/threadedbasebandsamplesink.h"
 #include "ui_amdemodgui.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 
 #include "amdemod.h"
+#include "amdemodsettings.h"
 
 const QString AMDemodGUI::m_channelID = "de.maintech.sdrangelove.channel.am";
 
@@ -81,70 +81,50 @@ void AMDemodGUI::resetToDefaults()
 
 QByteArray AMDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->rfBW->value());
-	s.writeS32(4, ui->volume->value());
-	s.writeS32(5, ui->squelch->value());
-    s.writeBlob(6, m_channelMarker.serialize());
-	s.writeU32(7, m_channelMarker.getColor().rgb());
-	s.writeBool(8, ui->bandpassEnable->isChecked());
-	return s.final();
+	AMDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rfBandwidth = ui->rfBW->value();
+	settings.m_volume = ui->volume->value();
+	settings.m_squelch = ui->squelch->value();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_bandpassEnable = ui->bandpassEnable->isChecked();
+	return settings.serialize();
 }
 
 bool AMDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	AMDemodSettings settings;
 
-	if(!d.isValid())
-    {
+	if (!settings.deserialize(data))
+	{
 		resetToDefaults();
 		return false;
 	}
 
-	if(d.getVersion() == 1)
-    {
-		QByteArray bytetmp;
-		quint32 u32tmp;
-		qint32 tmp;
-		bool boolTmp;
-		QString strtmp;
-
-		blockApplySettings(true);
-		m_channelMarker.blockSignals(true);
-
-        d.readBlob(6, &bytetmp);
-        m_channelMarker.deserialize(bytetmp);
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-		d.readS32(2, &tmp, 4);
-		ui->rfBW->setValue(tmp);
-		d.readS32(3, &tmp, 3);
-		//ui->afBW->setValue(tmp);
-		d.readS32(4, &tmp, 20);
-		ui->volume->setValue(tmp);
-		d.readS32(5, &tmp, -40);
-		ui->squelch->setValue(tmp);
-        if(d.readU32(7, &u32tmp)) {
-			m_channelMarker.setColor(u32tmp);
-        }
-        d.readBool(8, &boolTmp, false);
-        ui->bandpassEnable->setChecked(boolTmp);
-
-        this->setWindowTitle(m_channelMarker.getTitle());
-        displayUDPAddress();
-
-        blockApplySettings(false);
-		m_channelMarker.blockSignals(false);
-
-		applySettings(true);
-		return true;
-	}
-    else
-    {
-		resetToDefaults();
-		return false;
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
+
+	m_channelMarker.deserialize(settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
+
+	if (settings.m_hasRgbColor) {
+		m_channelMarker.setColor(settings.m_rgbColor);
 	}
+
+	ui->rfBW->setValue(settings.m_rfBandwidth);
+	ui->volume->setValue(settings.m_volume);
+	ui->squelch->setValue(settings.m_squelch);
+	ui->bandpassEnable->setChecked(settings.m_bandpassEnable);
+
+	this->setWindowTitle(m_channelMarker.getTitle());
+	displayUDPAddress();
+
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
+
+	applySettings(true);
+	return true;
 }
 
 bool AMDemodGUI::handleMessage(const Message& message __attribute__((unused)))
@@ -3,6 +3,7 @@
 #include "plugin/pluginapi.h"
 
 #include "amdemodgui.h"
+#include "amdemodcore.h"
 #include "amdemodplugin.h"
 
 const PluginDescriptor AMDemodPlugin::m_pluginDescriptor = {
@@ -44,6 +45,15 @@ PluginInstanceUI* AMDemodPlugin::createRxChannel(const QString& channelName, Dev
 	}
 }
 
+ChannelSinkAPI* AMDemodPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == AMDemodGUI::m_channelID) {
+		return AMDemodCore::create(deviceAPI);
+	} else {
+		return NULL;
+	}
+}
+
 void AMDemodPlugin::createInstanceDemodAM(DeviceSourceAPI *deviceAPI)
 {
 	AMDemodGUI::create(m_pluginAPI, deviceAPI);
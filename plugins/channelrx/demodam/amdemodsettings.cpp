@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QColor>
+
+#include "util/simpleserializer.h"
+#include "amdemodsettings.h"
+
+AMDemodSettings::AMDemodSettings()
+{
+	resetToDefaults();
+}
+
+void AMDemodSettings::resetToDefaults()
+{
+	m_inputFrequencyOffset = 0;
+	m_rfBandwidth = 50;
+	m_volume = 20;
+	m_squelch = -40;
+	m_channelMarker.clear();
+	m_rgbColor = QColor(Qt::yellow).rgb();
+	m_hasRgbColor = false;
+	m_bandpassEnable = false;
+}
+
+QByteArray AMDemodSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeS32(1, m_inputFrequencyOffset);
+	s.writeS32(2, m_rfBandwidth);
+	s.writeS32(4, m_volume);
+	s.writeS32(5, m_squelch);
+	s.writeBlob(6, m_channelMarker);
+	s.writeU32(7, m_rgbColor);
+	s.writeBool(8, m_bandpassEnable);
+	return s.final();
+}
+
+bool AMDemodSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	d.readS32(1, &m_inputFrequencyOffset, 0);
+	d.readS32(2, &m_rfBandwidth, 50);
+	d.readS32(4, &m_volume, 20);
+	d.readS32(5, &m_squelch, -40);
+	d.readBlob(6, &m_channelMarker);
+	m_hasRgbColor = d.readU32(7, &m_rgbColor, QColor(Qt::yellow).rgb());
+	d.readBool(8, &m_bandpassEnable, false);
+
+	return true;
+}
@@ -23,11 +23,15 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += amdemod.cpp\
+	amdemodcore.cpp\
 	amdemodgui.cpp\
+	amdemodsettings.cpp\
 	amdemodplugin.cpp
 
 HEADERS += amdemod.h\
+	amdemodcore.h\
 	amdemodgui.h\
+	amdemodsettings.h\
 	amdemodplugin.h
 
 FORMS += amdemodgui.ui
@@ -126,10 +126,12 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	std::size_t nbSamples = end - begin;
+	m_nco.mixIQ(begin, end, m_mixBuffer);
+
+	for (std::size_t i = 0; i < nbSamples; i++)
 	{
-		Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		c *= m_nco.nextIQ();
+		Complex c = m_mixBuffer[i] / 32768.0f;
 
 		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
 
@@ -265,7 +267,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				if(m_audioBufferFill >= m_audioBuffer.size())
 				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 					if(res != m_audioBufferFill)
 					{
@@ -282,7 +284,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	if(m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if(res != m_audioBufferFill)
 		{
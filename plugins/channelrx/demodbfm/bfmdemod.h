@@ -63,6 +63,8 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+	AudioFifo *getAudioFifo() { return &m_audioFifo; }
+
 	double getMagSq() const { return m_magsq; }
 
 	bool getPilotLock() const { return m_pilotPLL.locked(); }
@@ -215,6 +217,7 @@ private:
 	Config m_running;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixBuffer; //!< input shifted by the NCO
 	Interpolator m_interpolator; //!< Interpolator between fixed demod bandwidth and audio bandwidth (rational)
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "bfmdemod.h"
+#include "bfmdemodcore.h"
+
+BFMDemodCore* BFMDemodCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new BFMDemodCore(deviceAPI);
+}
+
+void BFMDemodCore::destroy()
+{
+	delete this;
+}
+
+BFMDemodCore::BFMDemodCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("BFMDemod")
+{
+	m_bfmDemod = new BFMDemod(0, &m_rdsParser); // no spectrum display
+	m_channelizer = new DownChannelizer(m_bfmDemod);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("Broadcast FM Demod");
+	m_channelMarker.setColor(QColor(80, 120, 228));
+
+	resetToDefaults();
+}
+
+BFMDemodCore::~BFMDemodCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_bfmDemod;
+}
+
+void BFMDemodCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString BFMDemodCore::getName() const
+{
+	return m_name;
+}
+
+qint64 BFMDemodCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void BFMDemodCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void BFMDemodCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+
+	applySettings(true);
+}
+
+QByteArray BFMDemodCore::serialize() const
+{
+	BFMDemodSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
+}
+
+bool BFMDemodCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.deserialize(m_settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	if (m_settings.m_hasRgbColor) {
+		m_channelMarker.setColor(m_settings.m_rgbColor);
+	}
+
+	applySettings(true);
+	return true;
+}
+
+void BFMDemodCore::applySettings(bool force)
+{
+	int rfBandwidth = BFMDemodSettings::m_rfBW[m_settings.m_rfBandwidthIndex];
+
+	m_channelMarker.setBandwidth(rfBandwidth);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		BFMDemodSettings::requiredBW(rfBandwidth),
+		m_channelMarker.getCenterFrequency());
+
+	m_bfmDemod->configure(m_bfmDemod->getInputMessageQueue(),
+		rfBandwidth,
+		m_settings.m_afBandwidth * 1000.0,
+		m_settings.m_volume / 10.0,
+		m_settings.m_squelch,
+		m_settings.m_audioStereo,
+		m_settings.m_lsbStereo,
+		false, // no pilot display
+		false, // nothing reads the RDS data without GUI
+		false, // no copy to UDP: it is not saved in the presets
+		m_channelMarker.getUDPAddress(),
+		m_channelMarker.getUDPSendPort(),
+		force);
+
+	qDebug() << "BFMDemodCore::applySettings:"
+			<< " rfBandwidth: " << rfBandwidth
+			<< " afBandwidth: " << m_settings.m_afBandwidth
+			<< " audioStereo: " << m_settings.m_audioStereo;
+}
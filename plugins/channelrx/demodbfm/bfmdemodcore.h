@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_BFMDEMODCORE_H
+#define INCLUDE_BFMDEMODCORE_H
+
+#include <QByteArray>
+
+#include "channel/channelsinkapi.h"
+#include "dsp/channelmarker.h"
+
+#include "bfmdemodsettings.h"
+#include "rdsparser.h"
+
+class DeviceSourceAPI;
+class ThreadedBasebandSampleSink;
+class DownChannelizer;
+class BFMDemod;
+
+/**
+ * Broadcast FM demodulator without GUI for the headless server. Settings are read and written with
+ * BFMDemodSettings like BFMDemodGUI so that the channel can be configured from the presets saved by the GUI.
+ */
+class BFMDemodCore : public ChannelSinkAPI {
+public:
+	static BFMDemodCore* create(DeviceSourceAPI *deviceAPI);
+	virtual void destroy();
+
+	virtual void setName(const QString& name);
+	virtual QString getName() const;
+
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+
+	void resetToDefaults();
+
+private:
+	DeviceSourceAPI* m_deviceAPI;
+	QString m_name;
+	ChannelMarker m_channelMarker;
+	BFMDemodSettings m_settings;
+
+	ThreadedBasebandSampleSink* m_threadedChannelizer;
+	DownChannelizer* m_channelizer;
+	BFMDemod* m_bfmDemod;
+	RDSParser m_rdsParser; //!< needed by the demodulator. Not read without GUI.
+
+	explicit BFMDemodCore(DeviceSourceAPI *deviceAPI);
+	virtual ~BFMDemodCore();
+
+	void applySettings(bool force = false);
+};
+
+#endif // INCLUDE_BFMDEMODCORE_H
@@ -32,21 +32,17 @@
 #include "dsp/spectrumvis.h"
 #include "gui/glspectrum.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
 #include "mainwindow.h"
 
 #include "bfmdemod.h"
+#include "bfmdemodsettings.h"
 #include "rdstmc.h"
 #include "ui_bfmdemodgui.h"
 
 const QString BFMDemodGUI::m_channelID = "sdrangel.channel.bfm";
 
-const int BFMDemodGUI::m_rfBW[] = {
-	80000, 100000, 120000, 140000, 160000, 180000, 200000, 220000, 250000
-};
-
 //int requiredBW(int rfBW)
 //{
 //	if (rfBW <= 48000)
@@ -116,89 +112,60 @@ void BFMDemodGUI::resetToDefaults()
 
 QByteArray BFMDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->rfBW->value());
-	s.writeS32(3, ui->afBW->value());
-	s.writeS32(4, ui->volume->value());
-	s.writeS32(5, ui->squelch->value());
-	s.writeU32(7, m_channelMarker.getColor().rgb());
-	s.writeBlob(8, ui->spectrumGUI->serialize());
-	s.writeBool(9, ui->audioStereo->isChecked());
-	s.writeBool(10, ui->lsbStereo->isChecked());
-	s.writeBlob(11, m_channelMarker.serialize());
-	return s.final();
+	BFMDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rfBandwidthIndex = ui->rfBW->value();
+	settings.m_afBandwidth = ui->afBW->value();
+	settings.m_volume = ui->volume->value();
+	settings.m_squelch = ui->squelch->value();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_spectrumGUI = ui->spectrumGUI->serialize();
+	settings.m_audioStereo = ui->audioStereo->isChecked();
+	settings.m_lsbStereo = ui->lsbStereo->isChecked();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
 }
 
 bool BFMDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	BFMDemodSettings settings;
 
-	if (!d.isValid())
+	if (!settings.deserialize(data))
 	{
 		resetToDefaults();
 		return false;
 	}
 
-	if (d.getVersion() == 1)
-	{
-		QByteArray bytetmp;
-		qint32 tmp;
-		quint32 u32tmp;
-		bool booltmp;
-		QString strtmp;
-
-		blockApplySettings(true);
-	    m_channelMarker.blockSignals(true);
-
-        d.readBlob(11, &bytetmp);
-        m_channelMarker.deserialize(bytetmp);
-
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-
-		d.readS32(2, &tmp, 4);
-		ui->rfBW->setValue(tmp);
-		ui->rfBWText->setText(QString("%1 kHz").arg(m_rfBW[tmp] / 1000.0));
-		m_channelMarker.setBandwidth(m_rfBW[tmp]);
-
-		d.readS32(3, &tmp, 3);
-		ui->afBW->setValue(tmp);
-
-		d.readS32(4, &tmp, 20);
-		ui->volume->setValue(tmp);
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
 
-		d.readS32(5, &tmp, -40);
-		ui->squelch->setValue(tmp);
+	m_channelMarker.deserialize(settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
 
-		if(d.readU32(7, &u32tmp))
-		{
-			m_channelMarker.setColor(u32tmp);
-		}
+	ui->rfBW->setValue(settings.m_rfBandwidthIndex);
+	ui->rfBWText->setText(QString("%1 kHz").arg(BFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex] / 1000.0));
+	m_channelMarker.setBandwidth(BFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex]);
 
-		d.readBlob(8, &bytetmp);
-		ui->spectrumGUI->deserialize(bytetmp);
+	ui->afBW->setValue(settings.m_afBandwidth);
+	ui->volume->setValue(settings.m_volume);
+	ui->squelch->setValue(settings.m_squelch);
 
-		d.readBool(9, &booltmp, false);
-		ui->audioStereo->setChecked(booltmp);
+	if (settings.m_hasRgbColor) {
+		m_channelMarker.setColor(settings.m_rgbColor);
+	}
 
-		d.readBool(10, &booltmp, false);
-		ui->lsbStereo->setChecked(booltmp);
+	ui->spectrumGUI->deserialize(settings.m_spectrumGUI);
+	ui->audioStereo->setChecked(settings.m_audioStereo);
+	ui->lsbStereo->setChecked(settings.m_lsbStereo);
 
-        this->setWindowTitle(m_channelMarker.getTitle());
-		displayUDPAddress();
+	this->setWindowTitle(m_channelMarker.getTitle());
+	displayUDPAddress();
 
-		blockApplySettings(false);
-	    m_channelMarker.blockSignals(false);
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
 
-		applySettings(true);
-		return true;
-	}
-	else
-	{
-		resetToDefaults();
-		return false;
-	}
+	applySettings(true);
+	return true;
 }
 
 bool BFMDemodGUI::handleMessage(const Message& message __attribute__((unused)))
@@ -220,8 +187,8 @@ void BFMDemodGUI::on_deltaFrequency_changed(qint64 value)
 
 void BFMDemodGUI::on_rfBW_valueChanged(int value)
 {
-	ui->rfBWText->setText(QString("%1 kHz").arg(m_rfBW[value] / 1000.0));
-	m_channelMarker.setBandwidth(m_rfBW[value]);
+	ui->rfBWText->setText(QString("%1 kHz").arg(BFMDemodSettings::m_rfBW[value] / 1000.0));
+	m_channelMarker.setBandwidth(BFMDemodSettings::m_rfBW[value]);
 	applySettings();
 }
 
@@ -457,13 +424,13 @@ void BFMDemodGUI::applySettings(bool force)
 	    setTitleColor(m_channelMarker.getColor());
 
 		m_channelizer->configure(m_channelizer->getInputMessageQueue(),
-			requiredBW(m_rfBW[ui->rfBW->value()]), // TODO: this is where requested sample rate is specified
+			BFMDemodSettings::requiredBW(BFMDemodSettings::m_rfBW[ui->rfBW->value()]), // TODO: this is where requested sample rate is specified
 			m_channelMarker.getCenterFrequency());
 
 		ui->deltaFrequency->setValue(m_channelMarker.getCenterFrequency());
 
 		m_bfmDemod->configure(m_bfmDemod->getInputMessageQueue(),
-			m_rfBW[ui->rfBW->value()],
+			BFMDemodSettings::m_rfBW[ui->rfBW->value()],
 			ui->afBW->value() * 1000.0,
 			ui->volume->value() / 10.0,
 			ui->squelch->value(),
@@ -97,8 +97,6 @@ private:
 	int m_rate;
 	std::vector<unsigned int> m_g14ComboIndex;
 
-	static const int m_rfBW[];
-
 	explicit BFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidget* parent = NULL);
 	virtual ~BFMDemodGUI();
 
@@ -112,15 +110,6 @@ private:
 	void enterEvent(QEvent*);
 
 	void changeFrequency(qint64 f);
-
-    static int requiredBW(int rfBW)
-    {
-        if (rfBW <= 48000) {
-            return 48000;
-        } else {
-            return (3*rfBW)/2;
-        }
-    }
 };
 
 #endif // INCLUDE_BFMDEMODGUI_H
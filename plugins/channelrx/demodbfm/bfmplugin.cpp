@@ -21,6 +21,7 @@
 #include "plugin/pluginapi.h"
 
 #include "bfmdemodgui.h"
+#include "bfmdemodcore.h"
 
 const PluginDescriptor BFMPlugin::m_pluginDescriptor = {
 	QString("Broadcast FM Demodulator"),
@@ -61,6 +62,15 @@ PluginInstanceUI* BFMPlugin::createRxChannel(const QString& channelName, DeviceS
 	}
 }
 
+ChannelSinkAPI* BFMPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == BFMDemodGUI::m_channelID) {
+		return BFMDemodCore::create(deviceAPI);
+	} else {
+		return 0;
+	}
+}
+
 void BFMPlugin::createInstanceBFM(DeviceSourceAPI *deviceAPI)
 {
 	BFMDemodGUI::create(m_pluginAPI, deviceAPI);
@@ -28,7 +28,9 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += bfmdemod.cpp\
+    bfmdemodcore.cpp\
     bfmdemodgui.cpp\
+    bfmdemodsettings.cpp\
     bfmplugin.cpp\
     rdsdemod.cpp\
     rdsdecoder.cpp\
@@ -36,7 +38,9 @@ SOURCES += bfmdemod.cpp\
     rdstmc.cpp
 
 HEADERS += bfmdemod.h\
+    bfmdemodcore.h\
     bfmdemodgui.h\
+    bfmdemodsettings.h\
     bfmplugin.h\
     rdsdemod.h\
     rdsdecoder.h\
@@ -291,7 +291,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	        if (nbAudioSamples > 0)
 	        {
 	            if (!m_running.m_audioMute) {
-	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 	            }
 
 	            m_dsdDecoder.resetAudio1();
@@ -306,7 +306,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
             if (nbAudioSamples > 0)
             {
                 if (!m_running.m_audioMute) {
-                    m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+                    m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples);
                 }
 
                 m_dsdDecoder.resetAudio2();
@@ -319,7 +319,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 //	    if (nbAudioSamples > 0)
 //	    {
 //	        if (!m_running.m_audioMute) {
-//	            uint res = m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+//	            uint res = m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 //	        }
 //
 //	        m_dsdDecoder.resetAudio1();
@@ -28,6 +28,7 @@ MESSAGE_CLASS_DEFINITION(LoRaDemod::MsgConfigureLoRaDemod, Message)
 
 LoRaDemod::LoRaDemod(BasebandSampleSink* sampleSink) :
 	m_sampleSink(sampleSink),
+	m_decodeOutput(stdout),
 	m_settingsMutex(QMutex::Recursive)
 {
 	setObjectName("LoRaDemod");
@@ -116,7 +117,7 @@ void LoRaDemod::dumpRaw()
 	text[1] = text[0];
 	text[j] = 0;
 
-	printf("%s\n", &text[1]);
+	fprintf(m_decodeOutput, "%s\n", &text[1]);
 }
 
 short LoRaDemod::synch(short bin)
@@ -21,6 +21,7 @@
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
 #include <vector>
+#include <stdio.h>
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
 #include "util/message.h"
@@ -44,6 +45,8 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+	void setDecodeOutput(FILE *decodeOutput) { m_decodeOutput = decodeOutput; } //!< decoded frames go to stdout by default
+
 private:
 	int  detect(Complex sample, Complex angle);
 	void dumpRaw(void);
@@ -98,6 +101,7 @@ private:
 
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
+	FILE *m_decodeOutput;
 	QMutex m_settingsMutex;
 };
 
@@ -12,10 +12,10 @@
 #include "dsp/spectrumvis.h"
 #include "gui/glspectrum.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "gui/basicchannelsettingswidget.h"
 #include "dsp/dspengine.h"
 #include "../../channelrx/demodlora/lorademod.h"
+#include "lorademodsettings.h"
 
 const QString LoRaDemodGUI::m_channelID = "de.maintech.sdrangelove.channel.lora";
 
@@ -63,52 +63,37 @@ void LoRaDemodGUI::resetToDefaults()
 
 QByteArray LoRaDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->BW->value());
-	s.writeS32(3, ui->Spread->value());
-	s.writeBlob(4, ui->spectrumGUI->serialize());
-	return s.final();
+	LoRaDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_bandwidthIndex = ui->BW->value();
+	settings.m_spread = ui->Spread->value();
+	settings.m_spectrumGUI = ui->spectrumGUI->serialize();
+	return settings.serialize();
 }
 
 bool LoRaDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	LoRaDemodSettings settings;
 
-	if(!d.isValid())
-    {
+	if (!settings.deserialize(data))
+	{
 		resetToDefaults();
 		return false;
 	}
 
-	if(d.getVersion() == 1)
-    {
-		QByteArray bytetmp;
-		qint32 tmp;
-
-		blockApplySettings(true);
-	    m_channelMarker.blockSignals(true);
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
 
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-		d.readS32(2, &tmp, 0);
-		ui->BW->setValue(tmp);
-		d.readS32(3, &tmp, 0);
-		ui->Spread->setValue(tmp);
-		d.readBlob(4, &bytetmp);
-		ui->spectrumGUI->deserialize(bytetmp);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
+	ui->BW->setValue(settings.m_bandwidthIndex);
+	ui->Spread->setValue(settings.m_spread);
+	ui->spectrumGUI->deserialize(settings.m_spectrumGUI);
 
-		blockApplySettings(false);
-	    m_channelMarker.blockSignals(false);
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
 
-		applySettings();
-		return true;
-	}
-    else
-    {
-		resetToDefaults();
-		return false;
-	}
+	applySettings();
+	return true;
 }
 
 bool LoRaDemodGUI::handleMessage(const Message& message __attribute__((unused)))
@@ -123,8 +108,7 @@ void LoRaDemodGUI::viewChanged()
 
 void LoRaDemodGUI::on_BW_valueChanged(int value)
 {
-	const int loraBW[] = BANDWIDTHSTRING;
-	int thisBW = loraBW[value];
+	int thisBW = LoRaDemodSettings::m_bandwidths[value];
 	ui->BWText->setText(QString("%1 Hz").arg(thisBW));
 	m_channelMarker.setBandwidth(thisBW);
 	applySettings();
@@ -216,8 +200,7 @@ void LoRaDemodGUI::applySettings()
 {
 	if (m_doApplySettings)
 	{
-		const int  loraBW[] = BANDWIDTHSTRING;
-		int thisBW = loraBW[ui->BW->value()];
+		int thisBW = LoRaDemodSettings::m_bandwidths[ui->BW->value()];
 
 		m_channelizer->configure(m_channelizer->getInputMessageQueue(),
 			thisBW,
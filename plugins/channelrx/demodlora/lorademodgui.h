@@ -5,8 +5,6 @@
 #include "gui/rollupwidget.h"
 #include "dsp/channelmarker.h"
 
-#define BANDWIDTHSTRING {7813,15625,20833,31250,62500}
-
 class PluginAPI;
 class DeviceSourceAPI;
 class ThreadedBasebandSampleSink;
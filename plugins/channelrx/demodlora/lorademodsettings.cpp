@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "util/simpleserializer.h"
+#include "lorademodsettings.h"
+
+const int LoRaDemodSettings::m_bandwidths[] = { 7813, 15625, 20833, 31250, 62500 };
+const int LoRaDemodSettings::m_nbBandwidths = 5;
+
+LoRaDemodSettings::LoRaDemodSettings()
+{
+	resetToDefaults();
+}
+
+void LoRaDemodSettings::resetToDefaults()
+{
+	m_inputFrequencyOffset = 0;
+	m_bandwidthIndex = 0;
+	m_spread = 0;
+	m_spectrumGUI.clear();
+}
+
+QByteArray LoRaDemodSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeS32(1, m_inputFrequencyOffset);
+	s.writeS32(2, m_bandwidthIndex);
+	s.writeS32(3, m_spread);
+	s.writeBlob(4, m_spectrumGUI);
+	return s.final();
+}
+
+bool LoRaDemodSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	d.readS32(1, &m_inputFrequencyOffset, 0);
+	d.readS32(2, &m_bandwidthIndex, 0);
+	m_bandwidthIndex = m_bandwidthIndex < 0 ? 0 : m_bandwidthIndex >= m_nbBandwidths ? m_nbBandwidths - 1 : m_bandwidthIndex;
+	d.readS32(3, &m_spread, 0);
+	d.readBlob(4, &m_spectrumGUI);
+
+	return true;
+}
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_LORADEMODSETTINGS_H
+#define INCLUDE_LORADEMODSETTINGS_H
+
+#include <QByteArray>
+
+/**
+ * LoRa demodulator settings as saved in the presets, in the units of the GUI controls. The GUI, the
+ * server and the batch processor read and write the presets through it.
+ */
+struct LoRaDemodSettings
+{
+	qint32 m_inputFrequencyOffset;
+	int m_bandwidthIndex;               //!< in m_bandwidths
+	int m_spread;
+	QByteArray m_spectrumGUI;
+
+	static const int m_bandwidths[];
+	static const int m_nbBandwidths;
+
+	LoRaDemodSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data); //!< false and defaults if the data is not a version 1 blob
+};
+
+#endif // INCLUDE_LORADEMODSETTINGS_H
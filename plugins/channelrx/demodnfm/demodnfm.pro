@@ -23,11 +23,15 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += nfmdemod.cpp\
+    nfmdemodcore.cpp\
     nfmdemodgui.cpp\
+    nfmdemodsettings.cpp\
     nfmplugin.cpp
 
 HEADERS += nfmdemod.h\
+    nfmdemodcore.h\
     nfmdemodgui.h\
+    nfmdemodsettings.h\
     nfmplugin.h
 
 FORMS += nfmdemodgui.ui
@@ -26,9 +26,9 @@
 #include "audio/audiooutput.h"
 #include "dsp/pidcontroller.h"
 #include "dsp/dspengine.h"
-#include "nfmdemodgui.h"
 
 MESSAGE_CLASS_DEFINITION(NFMDemod::MsgConfigureNFMDemod, Message)
+MESSAGE_CLASS_DEFINITION(NFMDemod::MsgReportCTCSSFreq, Message)
 
 static const double afSqTones[2] = {1000.0, 6000.0}; // {1200.0, 8000.0};
 const int NFMDemod::m_udpBlockSize = 512;
@@ -154,11 +154,12 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	std::size_t nbSamples = end - begin;
+	m_nco.mixIQ(begin, end, m_mixBuffer);
+
+	for (std::size_t i = 0; i < nbSamples; i++)
 	{
-		//Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = m_mixBuffer[i];
 
 		{
 			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
@@ -272,7 +273,7 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 								{
 									if (maxToneIndex+1 != m_ctcssIndex)
 									{
-										m_nfmDemodGUI->setCtcssFreq(m_ctcssDetector.getToneSet()[maxToneIndex]);
+										getOutputMessageQueue()->push(MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]));
 										m_ctcssIndex = maxToneIndex+1;
 									}
 								}
@@ -280,7 +281,7 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 								{
 									if (m_ctcssIndex != 0)
 									{
-										m_nfmDemodGUI->setCtcssFreq(0);
+										getOutputMessageQueue()->push(MsgReportCTCSSFreq::create(0));
 										m_ctcssIndex = 0;
 									}
 								}
@@ -305,7 +306,7 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 				{
 					if (m_ctcssIndex != 0)
 					{
-						m_nfmDemodGUI->setCtcssFreq(0);
+						getOutputMessageQueue()->push(MsgReportCTCSSFreq::create(0));
 						m_ctcssIndex = 0;
 					}
 
@@ -319,7 +320,7 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				if (m_audioBufferFill >= m_audioBuffer.size())
 				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 					if (res != m_audioBufferFill)
 					{
@@ -336,7 +337,7 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill)
 		{
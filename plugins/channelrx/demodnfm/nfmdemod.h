@@ -33,8 +33,6 @@
 #include "audio/audiofifo.h"
 #include "util/message.h"
 
-class NFMDemodGUI;
-
 class NFMDemod : public BasebandSampleSink {
 public:
 	NFMDemod();
@@ -60,9 +58,7 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
-	void registerGUI(NFMDemodGUI *nfmDemodGUI) {
-		m_nfmDemodGUI = nfmDemodGUI;
-	}
+	AudioFifo *getAudioFifo() { return &m_audioFifo; }
 
 	const Real *getCtcssToneSet(int& nbTones) const {
 		nbTones = m_ctcssDetector.getNTones();
@@ -87,6 +83,26 @@ public:
         m_magsqCount = 0;
     }
 
+	class MsgReportCTCSSFreq : public Message { //!< pushed on the output message queue when the detected tone changes
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		Real getFrequency() const { return m_freq; } //!< 0 when no tone is detected
+
+		static MsgReportCTCSSFreq* create(Real freq)
+		{
+			return new MsgReportCTCSSFreq(freq);
+		}
+
+	private:
+		Real m_freq;
+
+		MsgReportCTCSSFreq(Real freq) :
+			Message(),
+			m_freq(freq)
+		{ }
+	};
+
 private:
 	class MsgConfigureNFMDemod : public Message {
 		MESSAGE_CLASS_DECLARATION
@@ -228,6 +244,7 @@ private:
 	Config m_running;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixBuffer; //!< input shifted by the NCO
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -266,7 +283,6 @@ private:
 	AudioFifo m_audioFifo;
     UDPSink<qint16> *m_udpBufferAudio;
 
-	NFMDemodGUI *m_nfmDemodGUI;
 	QMutex m_settingsMutex;
 
     PhaseDiscriminators m_phaseDiscri;
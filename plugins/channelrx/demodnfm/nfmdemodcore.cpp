@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "nfmdemod.h"
+#include "nfmdemodcore.h"
+
+NFMDemodCore* NFMDemodCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new NFMDemodCore(deviceAPI);
+}
+
+void NFMDemodCore::destroy()
+{
+	delete this;
+}
+
+NFMDemodCore::NFMDemodCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("NFMDemod")
+{
+	m_nfmDemod = new NFMDemod();
+	m_channelizer = new DownChannelizer(m_nfmDemod);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("NFM Demodulator");
+	m_channelMarker.setColor(Qt::red);
+
+	resetToDefaults();
+}
+
+NFMDemodCore::~NFMDemodCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_nfmDemod;
+}
+
+void NFMDemodCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString NFMDemodCore::getName() const
+{
+	return m_name;
+}
+
+qint64 NFMDemodCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void NFMDemodCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void NFMDemodCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+
+	applySettings(true);
+}
+
+QByteArray NFMDemodCore::serialize() const
+{
+	NFMDemodSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
+}
+
+bool NFMDemodCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.deserialize(m_settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	if (m_settings.m_hasRgbColor) {
+		m_channelMarker.setColor(m_settings.m_rgbColor);
+	}
+
+	applySettings(true);
+	return true;
+}
+
+void NFMDemodCore::purgeReports()
+{
+	m_nfmDemod->getOutputMessageQueue()->clear(); // CTCSS tones detected
+}
+
+void NFMDemodCore::applySettings(bool force)
+{
+	int rfBandwidth = NFMDemodSettings::m_rfBW[m_settings.m_rfBandwidthIndex];
+
+	m_channelMarker.setBandwidth(rfBandwidth);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		48000,
+		m_channelMarker.getCenterFrequency());
+
+	// use the device shared filter bank when the channel fits in one of its channels
+	m_deviceAPI->configureThreadedSinkSubBand(m_threadedChannelizer,
+		m_channelMarker.getCenterFrequency(),
+		rfBandwidth,
+		48000);
+
+	m_nfmDemod->setSelectedCtcssIndex(m_settings.m_ctcssIndex);
+
+	m_nfmDemod->configure(m_nfmDemod->getInputMessageQueue(),
+		rfBandwidth,
+		m_settings.m_afBandwidth * 1000.0f,
+		NFMDemodSettings::m_fmDev[m_settings.m_rfBandwidthIndex],
+		m_settings.m_volume / 10.0f,
+		m_settings.m_squelchGate, // in 10ths of ms 1 -> 50
+		m_settings.m_deltaSquelch,
+		m_settings.m_squelch, // -1000 -> 0
+		m_settings.m_ctcssOn,
+		m_settings.m_audioMute,
+		false, // no copy to UDP: it is not saved in the presets
+		m_channelMarker.getUDPAddress(),
+		m_channelMarker.getUDPSendPort(),
+		force);
+
+	qDebug() << "NFMDemodCore::applySettings:"
+			<< " rfBandwidth: " << rfBandwidth
+			<< " afBandwidth: " << m_settings.m_afBandwidth
+			<< " squelch: " << m_settings.m_squelch
+			<< " ctcss: " << m_settings.m_ctcssIndex;
+}
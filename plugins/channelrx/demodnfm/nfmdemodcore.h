@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_NFMDEMODCORE_H
+#define INCLUDE_NFMDEMODCORE_H
+
+#include <QByteArray>
+
+#include "channel/channelsinkapi.h"
+#include "dsp/channelmarker.h"
+
+#include "nfmdemodsettings.h"
+
+class DeviceSourceAPI;
+class ThreadedBasebandSampleSink;
+class DownChannelizer;
+class NFMDemod;
+
+/**
+ * NFM demodulator without GUI for the headless server. Settings are read and written with
+ * NFMDemodSettings like NFMDemodGUI so that the channel can be configured from the presets saved by the GUI.
+ */
+class NFMDemodCore : public ChannelSinkAPI {
+public:
+	static NFMDemodCore* create(DeviceSourceAPI *deviceAPI);
+	virtual void destroy();
+
+	virtual void setName(const QString& name);
+	virtual QString getName() const;
+
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+
+	virtual void purgeReports();
+
+	void resetToDefaults();
+
+private:
+	DeviceSourceAPI* m_deviceAPI;
+	QString m_name;
+	ChannelMarker m_channelMarker;
+	NFMDemodSettings m_settings;
+
+	ThreadedBasebandSampleSink* m_threadedChannelizer;
+	DownChannelizer* m_channelizer;
+	NFMDemod* m_nfmDemod;
+
+	explicit NFMDemodCore(DeviceSourceAPI *deviceAPI);
+	virtual ~NFMDemodCore();
+
+	void applySettings(bool force = false);
+};
+
+#endif // INCLUDE_NFMDEMODCORE_H
@@ -10,23 +10,15 @@
 #include "ui_nfmdemodgui.h"
 #include "dsp/nullsink.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 #include "nfmdemod.h"
+#include "nfmdemodsettings.h"
 
 const QString NFMDemodGUI::m_channelID = "de.maintech.sdrangelove.channel.nfm";
 
-const int NFMDemodGUI::m_rfBW[] = {
-	5000, 6250, 8330, 10000, 12500, 15000, 20000, 25000, 40000
-};
-const int NFMDemodGUI::m_fmDev[] = { // corresponding FM deviations
-    1000, 1500, 2000, 2000,  2000,  2500,  3000,  3500,  5000
-};
-const int NFMDemodGUI::m_nbRfBW = 9;
-
 NFMDemodGUI* NFMDemodGUI::create(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI)
 {
 	NFMDemodGUI* gui = new NFMDemodGUI(pluginAPI, deviceAPI);
@@ -78,91 +70,86 @@ void NFMDemodGUI::resetToDefaults()
 
 QByteArray NFMDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->rfBW->currentIndex());
-	s.writeS32(3, ui->afBW->value());
-	s.writeS32(4, ui->volume->value());
-	s.writeS32(5, ui->squelch->value());
-	s.writeU32(7, m_channelMarker.getColor().rgb());
-	s.writeS32(8, ui->ctcss->currentIndex());
-	s.writeBool(9, ui->ctcssOn->isChecked());
-	s.writeBool(10, ui->audioMute->isChecked());
-	s.writeS32(11, ui->squelchGate->value());
-	s.writeBool(12, ui->deltaSquelch->isChecked());
-	s.writeBlob(13, m_channelMarker.serialize());
-	return s.final();
+	NFMDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rfBandwidthIndex = ui->rfBW->currentIndex();
+	settings.m_afBandwidth = ui->afBW->value();
+	settings.m_volume = ui->volume->value();
+	settings.m_squelch = ui->squelch->value();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_ctcssIndex = ui->ctcss->currentIndex();
+	settings.m_ctcssOn = ui->ctcssOn->isChecked();
+	settings.m_audioMute = ui->audioMute->isChecked();
+	settings.m_squelchGate = ui->squelchGate->value();
+	settings.m_deltaSquelch = ui->deltaSquelch->isChecked();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
 }
 
 bool NFMDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	NFMDemodSettings settings;
 
-	if (!d.isValid())
+	if (!settings.deserialize(data))
 	{
 		resetToDefaults();
 		return false;
 	}
 
-	if (d.getVersion() == 1)
-	{
-		QByteArray bytetmp;
-		quint32 u32tmp;
-		qint32 tmp;
-		bool boolTmp;
-
-		blockApplySettings(true);
-		m_channelMarker.blockSignals(true);
-
-        d.readBlob(13, &bytetmp);
-        m_channelMarker.deserialize(bytetmp);
-
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-		d.readS32(2, &tmp, 4);
-		ui->rfBW->setCurrentIndex(tmp);
-		d.readS32(3, &tmp, 3);
-		ui->afBW->setValue(tmp);
-		d.readS32(4, &tmp, 20);
-		ui->volume->setValue(tmp);
-		d.readS32(5, &tmp, -40);
-		ui->squelch->setValue(tmp);
-
-		if(d.readU32(7, &u32tmp))
-		{
-			m_channelMarker.setColor(u32tmp);
-		}
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
 
-		d.readS32(8, &tmp, 0);
-		ui->ctcss->setCurrentIndex(tmp);
-		d.readBool(9, &boolTmp, false);
-		ui->ctcssOn->setChecked(boolTmp);
-		d.readBool(10, &boolTmp, false);
-		ui->audioMute->setChecked(boolTmp);
-		d.readS32(11, &tmp, 5);
-		ui->squelchGate->setValue(tmp);
-        d.readBool(12, &boolTmp, false);
-        ui->deltaSquelch->setChecked(boolTmp);
+	m_channelMarker.deserialize(settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
 
-        this->setWindowTitle(m_channelMarker.getTitle());
-        displayUDPAddress();
+	if (settings.m_hasRgbColor) {
+		m_channelMarker.setColor(settings.m_rgbColor);
+	}
 
-		blockApplySettings(false);
-		m_channelMarker.blockSignals(false);
+	ui->rfBW->setCurrentIndex(settings.m_rfBandwidthIndex);
+	ui->afBW->setValue(settings.m_afBandwidth);
+	ui->volume->setValue(settings.m_volume);
+	ui->squelch->setValue(settings.m_squelch);
+	ui->ctcss->setCurrentIndex(settings.m_ctcssIndex);
+	ui->ctcssOn->setChecked(settings.m_ctcssOn);
+	ui->audioMute->setChecked(settings.m_audioMute);
+	ui->squelchGate->setValue(settings.m_squelchGate);
+	ui->deltaSquelch->setChecked(settings.m_deltaSquelch);
 
-		applySettings(true);
+	this->setWindowTitle(m_channelMarker.getTitle());
+	displayUDPAddress();
+
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
+
+	applySettings(true);
+	return true;
+}
+
+bool NFMDemodGUI::handleMessage(const Message& message)
+{
+	if (NFMDemod::MsgReportCTCSSFreq::match(message))
+	{
+		setCtcssFreq(((NFMDemod::MsgReportCTCSSFreq&) message).getFrequency());
 		return true;
 	}
 	else
 	{
-		resetToDefaults();
 		return false;
 	}
 }
 
-bool NFMDemodGUI::handleMessage(const Message& message __attribute__((unused)))
+void NFMDemodGUI::handleSourceMessages()
 {
-	return false;
+	Message* message;
+
+	while ((message = m_nfmDemod->getOutputMessageQueue()->pop()) != 0)
+	{
+		if (handleMessage(*message))
+		{
+			delete message;
+		}
+	}
 }
 
 void NFMDemodGUI::channelMarkerChanged()
@@ -181,7 +168,7 @@ void NFMDemodGUI::on_rfBW_currentIndexChanged(int index)
 {
 	qDebug() << "NFMDemodGUI::on_rfBW_currentIndexChanged" << index;
 	//ui->rfBWText->setText(QString("%1 k").arg(m_rfBW[value] / 1000.0));
-	m_channelMarker.setBandwidth(m_rfBW[index]);
+	m_channelMarker.setBandwidth(NFMDemodSettings::m_rfBW[index]);
 	applySettings();
 }
 
@@ -291,8 +278,8 @@ NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidg
 
 	blockApplySettings(true);
 	ui->rfBW->clear();
-	for (int i = 0; i < m_nbRfBW; i++) {
-		ui->rfBW->addItem(QString("%1").arg(m_rfBW[i] / 1000.0, 0, 'f', 2));
+	for (int i = 0; i < NFMDemodSettings::m_nbRfBW; i++) {
+		ui->rfBW->addItem(QString("%1").arg(NFMDemodSettings::m_rfBW[i] / 1000.0, 0, 'f', 2));
 	}
 	blockApplySettings(false);
 
@@ -300,7 +287,7 @@ NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidg
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
 
 	m_nfmDemod = new NFMDemod();
-	m_nfmDemod->registerGUI(this);
+	connect(m_nfmDemod->getOutputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleSourceMessages()));
 
 	connect(&m_pluginAPI->getMainWindow()->getMasterTimer(), SIGNAL(timeout()), this, SLOT(tick()));
 
@@ -371,12 +358,18 @@ void NFMDemodGUI::applySettings(bool force)
 			48000,
 			m_channelMarker.getCenterFrequency());
 
+		// use the device shared filter bank when the channel fits in one of its channels
+		m_deviceAPI->configureThreadedSinkSubBand(m_threadedChannelizer,
+			m_channelMarker.getCenterFrequency(),
+			NFMDemodSettings::m_rfBW[ui->rfBW->currentIndex()],
+			48000);
+
         ui->deltaFrequency->setValue(m_channelMarker.getCenterFrequency());
 
 		m_nfmDemod->configure(m_nfmDemod->getInputMessageQueue(),
-			m_rfBW[ui->rfBW->currentIndex()],
+			NFMDemodSettings::m_rfBW[ui->rfBW->currentIndex()],
 			ui->afBW->value() * 1000.0f,
-			m_fmDev[ui->rfBW->currentIndex()],
+			NFMDemodSettings::m_fmDev[ui->rfBW->currentIndex()],
 			ui->volume->value() / 10.0f,
 			ui->squelchGate->value(), // in 10ths of ms 1 -> 50
 			ui->deltaSquelch->isChecked(),
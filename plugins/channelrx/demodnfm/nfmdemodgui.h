@@ -35,7 +35,6 @@ public:
 	bool deserialize(const QByteArray& data);
 
 	virtual bool handleMessage(const Message& message);
-	void setCtcssFreq(Real ctcssFreq);
 
 	static const QString m_channelID;
 
@@ -54,6 +53,7 @@ private slots:
     void on_copyAudioToUDP_toggled(bool checked);
 	void onWidgetRolled(QWidget* widget, bool rollDown);
 	void onMenuDialogCalled(const QPoint& p);
+	void handleSourceMessages();
 	void tick();
 
 private:
@@ -72,16 +72,13 @@ private:
 	bool m_squelchOpen;
 	uint32_t m_tickCount;
 
-	static const int m_rfBW[];
-	static const int m_fmDev[];
-	static const int m_nbRfBW;
-
 	explicit NFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidget* parent = NULL);
 	virtual ~NFMDemodGUI();
 
 	void blockApplySettings(bool block);
 	void applySettings(bool force = false);
     void displayUDPAddress();
+	void setCtcssFreq(Real ctcssFreq);
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
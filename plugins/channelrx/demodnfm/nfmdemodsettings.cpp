@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QColor>
+
+#include "util/simpleserializer.h"
+#include "nfmdemodsettings.h"
+
+const int NFMDemodSettings::m_rfBW[] = {
+	5000, 6250, 8330, 10000, 12500, 15000, 20000, 25000, 40000
+};
+const int NFMDemodSettings::m_fmDev[] = { // corresponding FM deviations
+	1000, 1500, 2000, 2000,  2000,  2500,  3000,  3500,  5000
+};
+const int NFMDemodSettings::m_nbRfBW = 9;
+
+NFMDemodSettings::NFMDemodSettings()
+{
+	resetToDefaults();
+}
+
+void NFMDemodSettings::resetToDefaults()
+{
+	m_inputFrequencyOffset = 0;
+	m_rfBandwidthIndex = 4;
+	m_afBandwidth = 3;
+	m_volume = 20;
+	m_squelch = -40;
+	m_rgbColor = QColor(Qt::red).rgb();
+	m_hasRgbColor = false;
+	m_ctcssIndex = 0;
+	m_ctcssOn = false;
+	m_audioMute = false;
+	m_squelchGate = 5;
+	m_deltaSquelch = false;
+	m_channelMarker.clear();
+}
+
+QByteArray NFMDemodSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeS32(1, m_inputFrequencyOffset);
+	s.writeS32(2, m_rfBandwidthIndex);
+	s.writeS32(3, m_afBandwidth);
+	s.writeS32(4, m_volume);
+	s.writeS32(5, m_squelch);
+	s.writeU32(7, m_rgbColor);
+	s.writeS32(8, m_ctcssIndex);
+	s.writeBool(9, m_ctcssOn);
+	s.writeBool(10, m_audioMute);
+	s.writeS32(11, m_squelchGate);
+	s.writeBool(12, m_deltaSquelch);
+	s.writeBlob(13, m_channelMarker);
+	return s.final();
+}
+
+bool NFMDemodSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	d.readS32(1, &m_inputFrequencyOffset, 0);
+	d.readS32(2, &m_rfBandwidthIndex, 4);
+	m_rfBandwidthIndex = m_rfBandwidthIndex < 0 ? 0 : m_rfBandwidthIndex >= m_nbRfBW ? m_nbRfBW - 1 : m_rfBandwidthIndex;
+	d.readS32(3, &m_afBandwidth, 3);
+	d.readS32(4, &m_volume, 20);
+	d.readS32(5, &m_squelch, -40);
+	m_hasRgbColor = d.readU32(7, &m_rgbColor, QColor(Qt::red).rgb());
+	d.readS32(8, &m_ctcssIndex, 0);
+	d.readBool(9, &m_ctcssOn, false);
+	d.readBool(10, &m_audioMute, false);
+	d.readS32(11, &m_squelchGate, 5);
+	d.readBool(12, &m_deltaSquelch, false);
+	d.readBlob(13, &m_channelMarker);
+
+	return true;
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_NFMDEMODSETTINGS_H
+#define INCLUDE_NFMDEMODSETTINGS_H
+
+#include <QByteArray>
+
+/**
+ * NFM demodulator settings as saved in the presets, in the units of the GUI controls. The GUI, the
+ * server and the batch processor read and write the presets through it.
+ */
+struct NFMDemodSettings
+{
+	qint32 m_inputFrequencyOffset;
+	int m_rfBandwidthIndex;             //!< in m_rfBW and m_fmDev
+	int m_afBandwidth;                  //!< kHz
+	int m_volume;                       //!< tenths
+	int m_squelch;                      //!< dB
+	quint32 m_rgbColor;
+	bool m_hasRgbColor;                 //!< the data carried a color, else m_rgbColor is the default
+	int m_ctcssIndex;                   //!< 0 is none, else tone index + 1
+	bool m_ctcssOn;
+	bool m_audioMute;
+	int m_squelchGate;                  //!< 10s of ms
+	bool m_deltaSquelch;
+	QByteArray m_channelMarker;
+
+	static const int m_rfBW[];
+	static const int m_fmDev[];         //!< FM deviation for each RF bandwidth
+	static const int m_nbRfBW;
+
+	NFMDemodSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data); //!< false and defaults if the data is not a version 1 blob
+};
+
+#endif // INCLUDE_NFMDEMODSETTINGS_H
@@ -4,6 +4,7 @@
 #include "plugin/pluginapi.h"
 
 #include "../../channelrx/demodnfm/nfmdemodgui.h"
+#include "../../channelrx/demodnfm/nfmdemodcore.h"
 
 const PluginDescriptor NFMPlugin::m_pluginDescriptor = {
 	QString("NFM Demodulator"),
@@ -43,6 +44,15 @@ PluginInstanceUI* NFMPlugin::createRxChannel(const QString& channelName, DeviceS
 	}
 }
 
+ChannelSinkAPI* NFMPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == NFMDemodGUI::m_channelID) {
+		return NFMDemodCore::create(deviceAPI);
+	} else {
+		return NULL;
+	}
+}
+
 void NFMPlugin::createInstanceNFM(DeviceSourceAPI *deviceAPI)
 {
 	NFMDemodGUI::create(m_pluginAPI, deviceAPI);
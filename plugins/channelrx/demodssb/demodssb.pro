@@ -23,11 +23,15 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += ssbdemod.cpp\
+    ssbdemodcore.cpp\
     ssbdemodgui.cpp\
+    ssbdemodsettings.cpp\
     ssbplugin.cpp
 
 HEADERS += ssbdemod.h\
+    ssbdemodcore.h\
     ssbdemodgui.h\
+    ssbdemodsettings.h\
     ssbplugin.h
 
 FORMS += ssbdemodgui.ui
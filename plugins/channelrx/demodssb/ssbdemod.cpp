@@ -224,7 +224,7 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 			if (m_audioBufferFill >= m_audioBuffer.size())
 			{
-				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 				if (res != m_audioBufferFill)
 				{
@@ -236,7 +236,7 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 		}
 	}
 
-	if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 0) != m_audioBufferFill)
+	if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill) != m_audioBufferFill)
 	{
 		qDebug("SSBDemod::feed: lost samples");
 	}
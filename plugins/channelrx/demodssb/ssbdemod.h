@@ -56,6 +56,8 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+	AudioFifo *getAudioFifo() { return &m_audioFifo; }
+
 	double getMagSq() const { return m_magsq; }
 	bool getAudioActive() const { return m_audioActive; }
 
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "ssbdemod.h"
+#include "ssbdemodcore.h"
+
+SSBDemodCore* SSBDemodCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new SSBDemodCore(deviceAPI);
+}
+
+void SSBDemodCore::destroy()
+{
+	delete this;
+}
+
+SSBDemodCore::SSBDemodCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("SSBDemod")
+{
+	m_ssbDemod = new SSBDemod(0); // no spectrum display
+	m_channelizer = new DownChannelizer(m_ssbDemod);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("SSB Demodulator");
+	m_channelMarker.setColor(Qt::green);
+
+	resetToDefaults();
+}
+
+SSBDemodCore::~SSBDemodCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_ssbDemod;
+}
+
+void SSBDemodCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString SSBDemodCore::getName() const
+{
+	return m_name;
+}
+
+qint64 SSBDemodCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void SSBDemodCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void SSBDemodCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+
+	applySettings(true);
+}
+
+QByteArray SSBDemodCore::serialize() const
+{
+	SSBDemodSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	return settings.serialize();
+}
+
+bool SSBDemodCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	if (m_settings.m_hasRgbColor) {
+		m_channelMarker.setColor(m_settings.m_rgbColor);
+	}
+
+	applySettings(true);
+	return true;
+}
+
+void SSBDemodCore::applySettings(bool force __attribute__((unused)))
+{
+	// the GUI keeps the span in the range of its slider
+	int spanLog2 = m_settings.m_spanLog2 < 1 ? 1 : m_settings.m_spanLog2 > 5 ? 5 : m_settings.m_spanLog2;
+
+	m_channelMarker.setBandwidth(m_settings.m_rfBandwidth * 100 * 2);
+	m_channelMarker.setSidebands(m_settings.m_dsb ? ChannelMarker::dsb : m_settings.m_rfBandwidth < 0 ? ChannelMarker::lsb : ChannelMarker::usb);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		48000,
+		m_channelMarker.getCenterFrequency());
+
+	m_ssbDemod->configure(m_ssbDemod->getInputMessageQueue(),
+		m_settings.m_rfBandwidth * 100.0,
+		m_settings.m_lowCutoff * 100.0,
+		m_settings.m_volume / 10.0,
+		spanLog2,
+		m_settings.m_audioBinaural,
+		m_settings.m_audioFlipChannels,
+		m_settings.m_dsb,
+		false, // the audio mute is not saved in the presets
+		m_settings.m_agc,
+		m_settings.m_agcClamping,
+		m_settings.m_agcTimeLog2,
+		m_settings.m_agcPowerThreshold,
+		m_settings.m_agcThresholdGate);
+
+	qDebug() << "SSBDemodCore::applySettings:"
+			<< " rfBandwidth: " << m_settings.m_rfBandwidth * 100
+			<< " lowCutoff: " << m_settings.m_lowCutoff * 100
+			<< " spanLog2: " << spanLog2
+			<< " dsb: " << m_settings.m_dsb;
+}
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SSBDEMODCORE_H
+#define INCLUDE_SSBDEMODCORE_H
+
+#include <QByteArray>
+
+#include "channel/channelsinkapi.h"
+#include "dsp/channelmarker.h"
+
+#include "ssbdemodsettings.h"
+
+class DeviceSourceAPI;
+class ThreadedBasebandSampleSink;
+class DownChannelizer;
+class SSBDemod;
+
+/**
+ * SSB demodulator without GUI for the headless server. Settings are read and written with
+ * SSBDemodSettings like SSBDemodGUI so that the channel can be configured from the presets saved by the GUI.
+ */
+class SSBDemodCore : public ChannelSinkAPI {
+public:
+	static SSBDemodCore* create(DeviceSourceAPI *deviceAPI);
+	virtual void destroy();
+
+	virtual void setName(const QString& name);
+	virtual QString getName() const;
+
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+
+	void resetToDefaults();
+
+private:
+	DeviceSourceAPI* m_deviceAPI;
+	QString m_name;
+	ChannelMarker m_channelMarker;
+	SSBDemodSettings m_settings;
+
+	ThreadedBasebandSampleSink* m_threadedChannelizer;
+	DownChannelizer* m_channelizer;
+	SSBDemod* m_ssbDemod;
+
+	explicit SSBDemodCore(DeviceSourceAPI *deviceAPI);
+	virtual ~SSBDemodCore();
+
+	void applySettings(bool force = false);
+};
+
+#endif // INCLUDE_SSBDEMODCORE_H
@@ -12,12 +12,12 @@
 #include "dsp/spectrumvis.h"
 #include "gui/glspectrum.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingswidget.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 #include "ssbdemod.h"
+#include "ssbdemodsettings.h"
 
 const QString SSBDemodGUI::m_channelID = "de.maintech.sdrangelove.channel.ssb";
 
@@ -71,92 +71,70 @@ void SSBDemodGUI::resetToDefaults()
 
 QByteArray SSBDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->BW->value());
-	s.writeS32(3, ui->volume->value());
-	s.writeBlob(4, ui->spectrumGUI->serialize());
-	s.writeU32(5, m_channelMarker.getColor().rgb());
-	s.writeS32(6, ui->lowCut->value());
-	s.writeS32(7, ui->spanLog2->value());
-	s.writeBool(8, m_audioBinaural);
-	s.writeBool(9, m_audioFlipChannels);
-	s.writeBool(10, m_dsb);
-	s.writeBool(11, ui->agc->isChecked());
-	s.writeS32(12, ui->agcTimeLog2->value());
-	s.writeS32(13, ui->agcPowerThreshold->value());
-    s.writeS32(14, ui->agcThresholdGate->value());
-    s.writeBool(15, ui->agcClamping->isChecked());
-	return s.final();
+	SSBDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rfBandwidth = ui->BW->value();
+	settings.m_volume = ui->volume->value();
+	settings.m_spectrumGUI = ui->spectrumGUI->serialize();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	settings.m_lowCutoff = ui->lowCut->value();
+	settings.m_spanLog2 = ui->spanLog2->value();
+	settings.m_audioBinaural = m_audioBinaural;
+	settings.m_audioFlipChannels = m_audioFlipChannels;
+	settings.m_dsb = m_dsb;
+	settings.m_agc = ui->agc->isChecked();
+	settings.m_agcTimeLog2 = ui->agcTimeLog2->value();
+	settings.m_agcPowerThreshold = ui->agcPowerThreshold->value();
+	settings.m_agcThresholdGate = ui->agcThresholdGate->value();
+	settings.m_agcClamping = ui->agcClamping->isChecked();
+	return settings.serialize();
 }
 
 bool SSBDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	SSBDemodSettings settings;
 
-	if (!d.isValid())
+	if (!settings.deserialize(data))
 	{
 		resetToDefaults();
-	    applySettings();
+		applySettings();
 		return false;
 	}
 
-	if (d.getVersion() == 1)
-	{
-		QByteArray bytetmp;
-		quint32 u32tmp;
-		qint32 tmp;
-		bool booltmp;
-
-		blockApplySettings(true);
-	    m_channelMarker.blockSignals(true);
-
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-		d.readS32(2, &tmp, 30);
-		ui->BW->setValue(tmp);
-		d.readS32(3, &tmp, 30);
-		ui->volume->setValue(tmp);
-		d.readBlob(4, &bytetmp);
-		ui->spectrumGUI->deserialize(bytetmp);
-		if(d.readU32(5, &u32tmp))
-			m_channelMarker.setColor(u32tmp);
-		d.readS32(6, &tmp, 3);
-		ui->lowCut->setValue(tmp);
-		d.readS32(7, &tmp, 20);
-		ui->spanLog2->setValue(tmp);
-		setNewRate(tmp);
-		d.readBool(8, &m_audioBinaural);
-		ui->audioBinaural->setChecked(m_audioBinaural);
-		d.readBool(9, &m_audioFlipChannels);
-		ui->audioFlipChannels->setChecked(m_audioFlipChannels);
-		d.readBool(10, &m_dsb);
-		ui->dsb->setChecked(m_dsb);
-		d.readBool(11, &booltmp, false);
-		ui->agc->setChecked(booltmp);
-		d.readS32(12, &tmp, 7);
-		ui->agcTimeLog2->setValue(tmp);
-        d.readS32(13, &tmp, -40);
-        ui->agcPowerThreshold->setValue(tmp);
-        d.readS32(14, &tmp, 4);
-        ui->agcThresholdGate->setValue(tmp);
-        d.readBool(15, &booltmp, false);
-        ui->agcClamping->setChecked(booltmp);
-
-        displaySettings();
-
-		blockApplySettings(false);
-	    m_channelMarker.blockSignals(false);
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
 
-		applySettings();
-		return true;
-	}
-	else
-	{
-		resetToDefaults();
-	    applySettings();
-		return false;
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
+
+	if (settings.m_hasRgbColor) {
+		m_channelMarker.setColor(settings.m_rgbColor);
 	}
+
+	ui->BW->setValue(settings.m_rfBandwidth);
+	ui->volume->setValue(settings.m_volume);
+	ui->spectrumGUI->deserialize(settings.m_spectrumGUI);
+	ui->lowCut->setValue(settings.m_lowCutoff);
+	ui->spanLog2->setValue(settings.m_spanLog2);
+	setNewRate(settings.m_spanLog2);
+	m_audioBinaural = settings.m_audioBinaural;
+	ui->audioBinaural->setChecked(m_audioBinaural);
+	m_audioFlipChannels = settings.m_audioFlipChannels;
+	ui->audioFlipChannels->setChecked(m_audioFlipChannels);
+	m_dsb = settings.m_dsb;
+	ui->dsb->setChecked(m_dsb);
+	ui->agc->setChecked(settings.m_agc);
+	ui->agcTimeLog2->setValue(settings.m_agcTimeLog2);
+	ui->agcPowerThreshold->setValue(settings.m_agcPowerThreshold);
+	ui->agcThresholdGate->setValue(settings.m_agcThresholdGate);
+	ui->agcClamping->setChecked(settings.m_agcClamping);
+
+	displaySettings();
+
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
+
+	applySettings();
+	return true;
 }
 
 bool SSBDemodGUI::handleMessage(const Message& message __attribute__((unused)))
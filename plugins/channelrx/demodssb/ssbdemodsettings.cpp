@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QColor>
+
+#include "util/simpleserializer.h"
+#include "ssbdemodsettings.h"
+
+SSBDemodSettings::SSBDemodSettings()
+{
+	resetToDefaults();
+}
+
+void SSBDemodSettings::resetToDefaults()
+{
+	m_inputFrequencyOffset = 0;
+	m_rfBandwidth = 30;
+	m_volume = 30;
+	m_spectrumGUI.clear();
+	m_rgbColor = QColor(Qt::green).rgb();
+	m_hasRgbColor = false;
+	m_lowCutoff = 3;
+	m_spanLog2 = 3;
+	m_audioBinaural = false;
+	m_audioFlipChannels = false;
+	m_dsb = false;
+	m_agc = false;
+	m_agcTimeLog2 = 7;
+	m_agcPowerThreshold = -40;
+	m_agcThresholdGate = 4;
+	m_agcClamping = false;
+}
+
+QByteArray SSBDemodSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeS32(1, m_inputFrequencyOffset);
+	s.writeS32(2, m_rfBandwidth);
+	s.writeS32(3, m_volume);
+	s.writeBlob(4, m_spectrumGUI);
+	s.writeU32(5, m_rgbColor);
+	s.writeS32(6, m_lowCutoff);
+	s.writeS32(7, m_spanLog2);
+	s.writeBool(8, m_audioBinaural);
+	s.writeBool(9, m_audioFlipChannels);
+	s.writeBool(10, m_dsb);
+	s.writeBool(11, m_agc);
+	s.writeS32(12, m_agcTimeLog2);
+	s.writeS32(13, m_agcPowerThreshold);
+	s.writeS32(14, m_agcThresholdGate);
+	s.writeBool(15, m_agcClamping);
+	return s.final();
+}
+
+bool SSBDemodSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	d.readS32(1, &m_inputFrequencyOffset, 0);
+	d.readS32(2, &m_rfBandwidth, 30);
+	d.readS32(3, &m_volume, 30);
+	d.readBlob(4, &m_spectrumGUI);
+	m_hasRgbColor = d.readU32(5, &m_rgbColor, QColor(Qt::green).rgb());
+	d.readS32(6, &m_lowCutoff, 3);
+	d.readS32(7, &m_spanLog2, 3);
+	d.readBool(8, &m_audioBinaural, false);
+	d.readBool(9, &m_audioFlipChannels, false);
+	d.readBool(10, &m_dsb, false);
+	d.readBool(11, &m_agc, false);
+	d.readS32(12, &m_agcTimeLog2, 7);
+	d.readS32(13, &m_agcPowerThreshold, -40);
+	d.readS32(14, &m_agcThresholdGate, 4);
+	d.readBool(15, &m_agcClamping, false);
+
+	return true;
+}
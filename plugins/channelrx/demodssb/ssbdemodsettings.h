@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SSBDEMODSETTINGS_H
+#define INCLUDE_SSBDEMODSETTINGS_H
+
+#include <QByteArray>
+
+/**
+ * SSB demodulator settings as saved in the presets, in the units of the GUI controls. The GUI, the
+ * server and the batch processor read and write the presets through it.
+ */
+struct SSBDemodSettings
+{
+	qint32 m_inputFrequencyOffset;
+	int m_rfBandwidth;                  //!< 100s of Hz. Negative for LSB
+	int m_volume;                       //!< tenths
+	QByteArray m_spectrumGUI;
+	quint32 m_rgbColor;
+	bool m_hasRgbColor;                 //!< the data carried a color, else m_rgbColor is the default
+	int m_lowCutoff;                    //!< 100s of Hz
+	int m_spanLog2;                     //!< audio span is the channel rate divided by 2^m_spanLog2
+	bool m_audioBinaural;
+	bool m_audioFlipChannels;
+	bool m_dsb;
+	bool m_agc;
+	int m_agcTimeLog2;
+	int m_agcPowerThreshold;            //!< dB
+	int m_agcThresholdGate;
+	bool m_agcClamping;
+
+	SSBDemodSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data); //!< false and defaults if the data is not a version 1 blob
+};
+
+#endif // INCLUDE_SSBDEMODSETTINGS_H
@@ -4,6 +4,7 @@
 #include <QtPlugin>
 #include "plugin/pluginapi.h"
 #include "../../channelrx/demodssb/ssbdemodgui.h"
+#include "../../channelrx/demodssb/ssbdemodcore.h"
 
 const PluginDescriptor SSBPlugin::m_pluginDescriptor = {
 	QString("SSB Demodulator"),
@@ -44,6 +45,15 @@ PluginInstanceUI* SSBPlugin::createRxChannel(const QString& channelName, DeviceS
 	}
 }
 
+ChannelSinkAPI* SSBPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == SSBDemodGUI::m_channelID) {
+		return SSBDemodCore::create(deviceAPI);
+	} else {
+		return NULL;
+	}
+}
+
 void SSBPlugin::createInstanceSSB(DeviceSourceAPI *deviceAPI)
 {
 	SSBDemodGUI::create(m_pluginAPI, deviceAPI);
@@ -23,11 +23,15 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += wfmdemod.cpp\
+    wfmdemodcore.cpp\
     wfmdemodgui.cpp\
+    wfmdemodsettings.cpp\
     wfmplugin.cpp
 
 HEADERS += wfmdemod.h\
+    wfmdemodcore.h\
     wfmdemodgui.h\
+    wfmdemodsettings.h\
     wfmplugin.h
 
 FORMS += wfmdemodgui.ui
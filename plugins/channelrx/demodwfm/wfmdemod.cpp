@@ -149,7 +149,7 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				if(m_audioBufferFill >= m_audioBuffer.size())
 				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 					if(res != m_audioBufferFill)
 					{
@@ -166,7 +166,7 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	if(m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if(res != m_audioBufferFill)
 		{
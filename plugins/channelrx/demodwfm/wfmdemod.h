@@ -50,6 +50,8 @@ public:
 	virtual void stop();
 	virtual bool handleMessage(const Message& cmd);
 
+	AudioFifo *getAudioFifo() { return &m_audioFifo; }
+
 	double getMagSq() const { return m_movingAverage.average(); }
     bool getSquelchOpen() const { return m_squelchOpen; }
 
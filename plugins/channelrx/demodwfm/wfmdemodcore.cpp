@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "wfmdemod.h"
+#include "wfmdemodcore.h"
+
+WFMDemodCore* WFMDemodCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new WFMDemodCore(deviceAPI);
+}
+
+void WFMDemodCore::destroy()
+{
+	delete this;
+}
+
+WFMDemodCore::WFMDemodCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("WFMDemod")
+{
+	m_wfmDemod = new WFMDemod(0); // no spectrum display
+	m_channelizer = new DownChannelizer(m_wfmDemod);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("WFM Demodulator");
+	m_channelMarker.setColor(Qt::blue);
+
+	resetToDefaults();
+}
+
+WFMDemodCore::~WFMDemodCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_wfmDemod;
+}
+
+void WFMDemodCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString WFMDemodCore::getName() const
+{
+	return m_name;
+}
+
+qint64 WFMDemodCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void WFMDemodCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void WFMDemodCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+
+	applySettings(true);
+}
+
+QByteArray WFMDemodCore::serialize() const
+{
+	WFMDemodSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	return settings.serialize();
+}
+
+bool WFMDemodCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	if (m_settings.m_hasRgbColor) {
+		m_channelMarker.setColor(m_settings.m_rgbColor);
+	}
+
+	applySettings(true);
+	return true;
+}
+
+void WFMDemodCore::applySettings(bool force __attribute__((unused)))
+{
+	int rfBandwidth = WFMDemodSettings::m_rfBW[m_settings.m_rfBandwidthIndex];
+
+	m_channelMarker.setBandwidth(rfBandwidth);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		WFMDemodSettings::requiredBW(rfBandwidth),
+		m_channelMarker.getCenterFrequency());
+
+	m_wfmDemod->configure(m_wfmDemod->getInputMessageQueue(),
+		rfBandwidth,
+		m_settings.m_afBandwidth * 1000.0,
+		m_settings.m_volume / 10.0,
+		m_settings.m_squelch,
+		false); // the audio mute is not saved in the presets
+
+	qDebug() << "WFMDemodCore::applySettings:"
+			<< " rfBandwidth: " << rfBandwidth
+			<< " afBandwidth: " << m_settings.m_afBandwidth
+			<< " squelch: " << m_settings.m_squelch;
+}
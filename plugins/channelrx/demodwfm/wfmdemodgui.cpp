@@ -10,20 +10,15 @@
 #include "ui_wfmdemodgui.h"
 #include "dsp/dspengine.h"
 #include "plugin/pluginapi.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingswidget.h"
 #include "mainwindow.h"
 
 #include "wfmdemod.h"
+#include "wfmdemodsettings.h"
 
 const QString WFMDemodGUI::m_channelID = "de.maintech.sdrangelove.channel.wfm";
 
-const int WFMDemodGUI::m_rfBW[] = {
-        12500, 25000, 40000, 60000, 75000, 80000, 100000, 125000, 140000, 160000, 180000, 200000, 220000, 250000
-};
-const int WFMDemodGUI::m_nbRfBW = 14;
-
 WFMDemodGUI* WFMDemodGUI::create(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI)
 {
 	WFMDemodGUI* gui = new WFMDemodGUI(pluginAPI, deviceAPI);
@@ -72,67 +67,46 @@ void WFMDemodGUI::resetToDefaults()
 
 QByteArray WFMDemodGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeS32(1, m_channelMarker.getCenterFrequency());
-	s.writeS32(2, ui->rfBW->currentIndex());
-	s.writeS32(3, ui->afBW->value());
-	s.writeS32(4, ui->volume->value());
-	s.writeS32(5, ui->squelch->value());
-	s.writeU32(7, m_channelMarker.getColor().rgb());
-	return s.final();
+	WFMDemodSettings settings;
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_rfBandwidthIndex = ui->rfBW->currentIndex();
+	settings.m_afBandwidth = ui->afBW->value();
+	settings.m_volume = ui->volume->value();
+	settings.m_squelch = ui->squelch->value();
+	settings.m_rgbColor = m_channelMarker.getColor().rgb();
+	return settings.serialize();
 }
 
 bool WFMDemodGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	WFMDemodSettings settings;
 
-	if (!d.isValid())
+	if (!settings.deserialize(data))
 	{
 		resetToDefaults();
 		return false;
 	}
 
-	if (d.getVersion() == 1)
-	{
-		QByteArray bytetmp;
-		quint32 u32tmp;
-		qint32 tmp;
-
-		blockApplySettings(true);
-	    m_channelMarker.blockSignals(true);
-
-		d.readS32(1, &tmp, 0);
-		m_channelMarker.setCenterFrequency(tmp);
-
-		d.readS32(2, &tmp, 6);
-		ui->rfBW->setCurrentIndex(tmp);
-		m_channelMarker.setBandwidth(m_rfBW[tmp]);
-
-		d.readS32(3, &tmp, 3);
-		ui->afBW->setValue(tmp);
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
 
-		d.readS32(4, &tmp, 20);
-		ui->volume->setValue(tmp);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
+	ui->rfBW->setCurrentIndex(settings.m_rfBandwidthIndex);
+	m_channelMarker.setBandwidth(WFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex]);
+	ui->afBW->setValue(settings.m_afBandwidth);
+	ui->volume->setValue(settings.m_volume);
+	ui->squelch->setValue(settings.m_squelch);
 
-		d.readS32(5, &tmp, -40);
-		ui->squelch->setValue(tmp);
+	if (settings.m_hasRgbColor) {
+		m_channelMarker.setColor(settings.m_rgbColor);
+	}
 
-		if(d.readU32(7, &u32tmp))
-		{
-			m_channelMarker.setColor(u32tmp);
-		}
 
-		blockApplySettings(false);
-	    m_channelMarker.blockSignals(false);
+	blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
 
-		applySettings();
-		return true;
-	}
-	else
-	{
-		resetToDefaults();
-		return false;
-	}
+	applySettings();
+	return true;
 }
 
 bool WFMDemodGUI::handleMessage(const Message& message __attribute__((unused)))
@@ -152,7 +126,7 @@ void WFMDemodGUI::on_deltaFrequency_changed(qint64 value)
 
 void WFMDemodGUI::on_rfBW_currentIndexChanged(int index)
 {
-    m_channelMarker.setBandwidth(m_rfBW[index]);
+    m_channelMarker.setBandwidth(WFMDemodSettings::m_rfBW[index]);
 	applySettings();
 }
 
@@ -213,8 +187,8 @@ WFMDemodGUI::WFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidg
 
     blockApplySettings(true);
     ui->rfBW->clear();
-    for (int i = 0; i < m_nbRfBW; i++) {
-        ui->rfBW->addItem(QString("%1").arg(m_rfBW[i] / 1000.0, 0, 'f', 2));
+    for (int i = 0; i < WFMDemodSettings::m_nbRfBW; i++) {
+        ui->rfBW->addItem(QString("%1").arg(WFMDemodSettings::m_rfBW[i] / 1000.0, 0, 'f', 2));
     }
     ui->rfBW->setCurrentIndex(6);
     blockApplySettings(false);
@@ -231,7 +205,7 @@ WFMDemodGUI::WFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidg
 
 	//m_channelMarker = new ChannelMarker(this);
 	m_channelMarker.setColor(Qt::blue);
-	m_channelMarker.setBandwidth(m_rfBW[4]);
+	m_channelMarker.setBandwidth(WFMDemodSettings::m_rfBW[4]);
 	m_channelMarker.setCenterFrequency(0);
 	m_channelMarker.setVisible(true);
 
@@ -267,13 +241,13 @@ void WFMDemodGUI::applySettings()
 		setTitleColor(m_channelMarker.getColor());
 
 		m_channelizer->configure(m_channelizer->getInputMessageQueue(),
-			requiredBW(m_rfBW[ui->rfBW->currentIndex()]), // TODO: this is where requested sample rate is specified
+			WFMDemodSettings::requiredBW(WFMDemodSettings::m_rfBW[ui->rfBW->currentIndex()]), // TODO: this is where requested sample rate is specified
 			m_channelMarker.getCenterFrequency());
 
 		ui->deltaFrequency->setValue(m_channelMarker.getCenterFrequency());
 
 		m_wfmDemod->configure(m_wfmDemod->getInputMessageQueue(),
-		    m_rfBW[ui->rfBW->currentIndex()],
+		    WFMDemodSettings::m_rfBW[ui->rfBW->currentIndex()],
 			ui->afBW->value() * 1000.0,
 			ui->volume->value() / 10.0,
 			ui->squelch->value(),
@@ -64,9 +64,6 @@ private:
 	WFMDemod* m_wfmDemod;
 	MovingAverage<double> m_channelPowerDbAvg;
 
-	static const int m_rfBW[];
-    static const int m_nbRfBW;
-
 	explicit WFMDemodGUI(PluginAPI* pluginAPI, DeviceSourceAPI *deviceAPI, QWidget* parent = NULL);
 	virtual ~WFMDemodGUI();
 
@@ -75,15 +72,6 @@ private:
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
-
-	static int requiredBW(int rfBW)
-	{
-	    if (rfBW <= 48000) {
-	        return 48000;
-	    } else {
-	        return (3*rfBW)/2;
-	    }
-	}
 };
 
 #endif // INCLUDE_WFMDEMODGUI_H
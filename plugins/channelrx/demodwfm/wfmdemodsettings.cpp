@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QColor>
+
+#include "util/simpleserializer.h"
+#include "wfmdemodsettings.h"
+
+const int WFMDemodSettings::m_rfBW[] = {
+	12500, 25000, 40000, 60000, 75000, 80000, 100000, 125000, 140000, 160000, 180000, 200000, 220000, 250000
+};
+const int WFMDemodSettings::m_nbRfBW = 14;
+
+WFMDemodSettings::WFMDemodSettings()
+{
+	resetToDefaults();
+}
+
+void WFMDemodSettings::resetToDefaults()
+{
+	m_inputFrequencyOffset = 0;
+	m_rfBandwidthIndex = 6;
+	m_afBandwidth = 3;
+	m_volume = 20;
+	m_squelch = -40;
+	m_rgbColor = QColor(Qt::blue).rgb();
+	m_hasRgbColor = false;
+}
+
+QByteArray WFMDemodSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeS32(1, m_inputFrequencyOffset);
+	s.writeS32(2, m_rfBandwidthIndex);
+	s.writeS32(3, m_afBandwidth);
+	s.writeS32(4, m_volume);
+	s.writeS32(5, m_squelch);
+	s.writeU32(7, m_rgbColor);
+	return s.final();
+}
+
+bool WFMDemodSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	d.readS32(1, &m_inputFrequencyOffset, 0);
+	d.readS32(2, &m_rfBandwidthIndex, 6);
+	m_rfBandwidthIndex = m_rfBandwidthIndex < 0 ? 0 : m_rfBandwidthIndex >= m_nbRfBW ? m_nbRfBW - 1 : m_rfBandwidthIndex;
+	d.readS32(3, &m_afBandwidth, 3);
+	d.readS32(4, &m_volume, 20);
+	d.readS32(5, &m_squelch, -40);
+	m_hasRgbColor = d.readU32(7, &m_rgbColor, QColor(Qt::blue).rgb());
+
+	return true;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_WFMDEMODSETTINGS_H
+#define INCLUDE_WFMDEMODSETTINGS_H
+
+#include <QByteArray>
+
+/**
+ * WFM demodulator settings as saved in the presets, in the units of the GUI controls. The GUI, the
+ * server and the batch processor read and write the presets through it.
+ */
+struct WFMDemodSettings
+{
+	qint32 m_inputFrequencyOffset;
+	int m_rfBandwidthIndex;             //!< in m_rfBW
+	int m_afBandwidth;                  //!< kHz
+	int m_volume;                       //!< tenths
+	int m_squelch;                      //!< dB
+	quint32 m_rgbColor;
+	bool m_hasRgbColor;                 //!< the data carried a color, else m_rgbColor is the default
+
+	static const int m_rfBW[];
+	static const int m_nbRfBW;
+
+	static int requiredBW(int rfBW) //!< channel sample rate for an RF bandwidth
+	{
+		if (rfBW <= 48000) {
+			return 48000;
+		} else {
+			return (3*rfBW)/2;
+		}
+	}
+
+	WFMDemodSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data); //!< false and defaults if the data is not a version 1 blob
+};
+
+#endif // INCLUDE_WFMDEMODSETTINGS_H
@@ -4,6 +4,7 @@
 #include "plugin/pluginapi.h"
 
 #include "wfmdemodgui.h"
+#include "wfmdemodcore.h"
 
 const PluginDescriptor WFMPlugin::m_pluginDescriptor = {
 	QString("WFM Demodulator"),
@@ -44,6 +45,15 @@ PluginInstanceUI* WFMPlugin::createRxChannel(const QString& channelName, DeviceS
 	}
 }
 
+ChannelSinkAPI* WFMPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == WFMDemodGUI::m_channelID) {
+		return WFMDemodCore::create(deviceAPI);
+	} else {
+		return NULL;
+	}
+}
+
 void WFMPlugin::createInstanceWFM(DeviceSourceAPI *deviceAPI)
 {
 	WFMDemodGUI::create(m_pluginAPI, deviceAPI);
@@ -18,6 +18,7 @@ public:
 	void initPlugin(PluginAPI* pluginAPI);
 
 	PluginInstanceUI* createRxChannel(const QString& channelName, DeviceSourceAPI *deviceAPI);
+	ChannelSinkAPI* createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI);
 
 private:
 	static const PluginDescriptor m_pluginDescriptor;
@@ -87,17 +87,14 @@ void TCPSrc::feed(const SampleVector::const_iterator& begin, const SampleVector:
 	//int rescale = 32768 * (1 << m_boost);
 	int rescale = (1 << m_boost);
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it) {
-		//Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
-
-		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
-		{
-			m_magsq = ((ci.real()*ci.real() +  ci.imag()*ci.imag())*rescale*rescale) / (1<<30);
-			m_sampleBuffer.push_back(Sample(ci.real() * rescale, ci.imag() * rescale));
-			m_sampleDistanceRemain += m_inputSampleRate / m_outputSampleRate;
-		}
+	std::size_t nbSamples = end - begin;
+	m_nco.mixIQ(begin, end, m_mixBuffer);
+	int nbOut = nbSamples > 0 ? m_interpolator.decimate(&m_sampleDistanceRemain, m_inputSampleRate / m_outputSampleRate, &m_mixBuffer[0], nbSamples, m_decimBuffer) : 0;
+
+	for (int i = 0; i < nbOut; i++) {
+		ci = m_decimBuffer[i];
+		m_magsq = ((ci.real()*ci.real() +  ci.imag()*ci.imag())*rescale*rescale) / (1<<30);
+		m_sampleBuffer.push_back(Sample(ci.real() * rescale, ci.imag() * rescale));
 	}
 
 	if((m_spectrum != 0) && (m_spectrumEnabled))
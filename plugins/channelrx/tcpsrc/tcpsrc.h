@@ -154,7 +154,9 @@ protected:
 	Complex m_last, m_this;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixBuffer; //!< input shifted by the NCO
 	Interpolator m_interpolator;
+	std::vector<Complex> m_decimBuffer; //!< output of the interpolator
 	Real m_sampleDistanceRemain;
 	fftfilt* TCPFilter;
 
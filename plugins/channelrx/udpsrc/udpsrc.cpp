@@ -161,10 +161,12 @@ void UDPSrc::feed(const SampleVector::const_iterator& begin, const SampleVector:
 	m_sampleBuffer.clear();
 	m_settingsMutex.lock();
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
+	std::size_t nbSamples = end - begin;
+	m_nco.mixIQ(begin, end, m_mixBuffer);
+
+	for (std::size_t i = 0; i < nbSamples; i++)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = m_mixBuffer[i];
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
@@ -574,7 +576,7 @@ void UDPSrc::audioReadyRead()
 
 					if (m_audioBufferFill >= m_audioBuffer.size())
 					{
-						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 						if (res != m_audioBufferFill)
 						{
@@ -596,7 +598,7 @@ void UDPSrc::audioReadyRead()
 
 					if (m_audioBufferFill >= m_audioBuffer.size())
 					{
-						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 						if (res != m_audioBufferFill)
 						{
@@ -608,7 +610,7 @@ void UDPSrc::audioReadyRead()
 				}
 			}
 
-			if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 0) != m_audioBufferFill)
+			if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill) != m_audioBufferFill)
 			{
 				qDebug("UDPSrc::audioReadyRead: lost samples");
 			}
@@ -306,6 +306,7 @@ protected:
 	Complex m_last, m_this;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixBuffer; //!< input shifted by the NCO
 	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 	fftfilt* UDPFilter;
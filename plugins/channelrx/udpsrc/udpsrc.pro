@@ -23,11 +23,15 @@ CONFIG(Release):build_subdir = release
 CONFIG(Debug):build_subdir = debug
 
 SOURCES += udpsrc.cpp\
+    udpsrccore.cpp\
     udpsrcgui.cpp\
+    udpsrcsettings.cpp\
     udpsrcplugin.cpp
 
 HEADERS += udpsrc.h\
+    udpsrccore.h\
     udpsrcgui.h\
+    udpsrcsettings.h\
     udpsrcplugin.h
 
 FORMS += udpsrcgui.ui
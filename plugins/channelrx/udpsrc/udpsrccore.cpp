@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDebug>
+
+#include "device/devicesourceapi.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/threadedbasebandsamplesink.h"
+
+#include "udpsrccore.h"
+
+UDPSrcCore* UDPSrcCore::create(DeviceSourceAPI *deviceAPI)
+{
+	return new UDPSrcCore(deviceAPI);
+}
+
+void UDPSrcCore::destroy()
+{
+	delete this;
+}
+
+UDPSrcCore::UDPSrcCore(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_name("UDPSrc")
+{
+	m_udpSrc = new UDPSrc(0, 0, 0); // no GUI and no spectrum display
+	m_channelizer = new DownChannelizer(m_udpSrc);
+	m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
+	m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+
+	m_channelMarker.setTitle("UDP Sample Source");
+	m_channelMarker.setColor(Qt::green);
+
+	resetToDefaults();
+}
+
+UDPSrcCore::~UDPSrcCore()
+{
+	m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+	delete m_threadedChannelizer;
+	delete m_channelizer;
+	delete m_udpSrc;
+}
+
+void UDPSrcCore::setName(const QString& name)
+{
+	m_name = name;
+}
+
+QString UDPSrcCore::getName() const
+{
+	return m_name;
+}
+
+qint64 UDPSrcCore::getCenterFrequency() const
+{
+	return m_channelMarker.getCenterFrequency();
+}
+
+void UDPSrcCore::setCenterFrequency(qint64 centerFrequency)
+{
+	m_channelMarker.setCenterFrequency(centerFrequency);
+	applySettings();
+}
+
+void UDPSrcCore::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	m_channelMarker.setCenterFrequency(0);
+	m_channelMarker.setUDPAddress("127.0.0.1");
+	m_channelMarker.setUDPSendPort(9999);
+	m_channelMarker.setUDPReceivePort(9998);
+
+	applySettings(true);
+}
+
+QByteArray UDPSrcCore::serialize() const
+{
+	UDPSrcSettings settings(m_settings);
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_channelMarker = m_channelMarker.serialize();
+	return settings.serialize();
+}
+
+bool UDPSrcCore::deserialize(const QByteArray& data)
+{
+	if (!m_settings.deserialize(data))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	m_channelMarker.deserialize(m_settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(m_settings.m_inputFrequencyOffset);
+
+	applySettings(true);
+	return true;
+}
+
+void UDPSrcCore::applySettings(bool force)
+{
+	// same sanitization as the GUI
+	if (m_settings.m_outputSampleRate < 1000) {
+		m_settings.m_outputSampleRate = 48000;
+	}
+
+	if (m_settings.m_rfBandwidth > m_settings.m_outputSampleRate) {
+		m_settings.m_rfBandwidth = m_settings.m_outputSampleRate;
+	}
+
+	if (m_settings.m_fmDeviation < 1) {
+		m_settings.m_fmDeviation = 2500;
+	}
+
+	m_channelMarker.setBandwidth((int) m_settings.m_rfBandwidth);
+
+	m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+		m_settings.m_outputSampleRate,
+		m_channelMarker.getCenterFrequency());
+
+	m_udpSrc->configure(m_udpSrc->getInputMessageQueue(),
+		m_settings.m_sampleFormat,
+		m_settings.m_outputSampleRate,
+		m_settings.m_rfBandwidth,
+		m_settings.m_fmDeviation,
+		m_channelMarker.getUDPAddress(),
+		m_channelMarker.getUDPSendPort(),
+		m_channelMarker.getUDPReceivePort(),
+		force);
+
+	m_udpSrc->configureImmediate(m_udpSrc->getInputMessageQueue(),
+		m_settings.m_audioActive,
+		m_settings.m_audioStereo,
+		m_settings.m_gain / 10.0,
+		m_settings.m_volume,
+		m_settings.m_squelch * 1.0f,
+		m_settings.m_squelchGate * 0.01f,
+		m_settings.m_squelch != -100,
+		m_settings.m_agc,
+		force);
+
+	qDebug() << "UDPSrcCore::applySettings:"
+			<< " m_sampleFormat: " << m_settings.m_sampleFormat
+			<< " m_outputSampleRate: " << m_settings.m_outputSampleRate
+			<< " m_rfBandwidth: " << m_settings.m_rfBandwidth
+			<< " address: " << m_channelMarker.getUDPAddress()
+			<< " port: " << m_channelMarker.getUDPSendPort();
+}
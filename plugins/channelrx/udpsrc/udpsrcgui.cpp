@@ -23,13 +23,13 @@
 #include "plugin/pluginapi.h"
 #include "dsp/spectrumvis.h"
 #include "dsp/dspengine.h"
-#include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
 #include "ui_udpsrcgui.h"
 #include "mainwindow.h"
 
 #include "udpsrc.h"
+#include "udpsrcsettings.h"
 
 const QString UDPSrcGUI::m_channelID = "sdrangel.channel.udpsrc";
 
@@ -90,130 +90,101 @@ void UDPSrcGUI::resetToDefaults()
 
 QByteArray UDPSrcGUI::serialize() const
 {
-	SimpleSerializer s(1);
-	s.writeBlob(1, saveState());
-	s.writeS32(2, m_channelMarker.getCenterFrequency());
-	s.writeS32(3, m_sampleFormat);
-	s.writeReal(4, m_outputSampleRate);
-	s.writeReal(5, m_rfBandwidth);
-	s.writeBlob(6, m_channelMarker.serialize());
-	s.writeBlob(7, ui->spectrumGUI->serialize());
-	s.writeS32(8, ui->gain->value());
-	s.writeBool(11, m_audioActive);
-	s.writeS32(12, (qint32)m_volume);
-	s.writeBool(14, m_audioStereo);
-	s.writeS32(15, m_fmDeviation);
-	s.writeS32(16, ui->squelch->value());
-	s.writeS32(17, ui->squelchGate->value());
-    s.writeBool(18, ui->agc->isChecked());
-	return s.final();
+	UDPSrcSettings settings;
+	settings.m_rollupState = saveState();
+	settings.m_inputFrequencyOffset = m_channelMarker.getCenterFrequency();
+	settings.m_sampleFormat = m_sampleFormat;
+	settings.m_outputSampleRate = m_outputSampleRate;
+	settings.m_rfBandwidth = m_rfBandwidth;
+	settings.m_channelMarker = m_channelMarker.serialize();
+	settings.m_spectrumGUI = ui->spectrumGUI->serialize();
+	settings.m_gain = ui->gain->value();
+	settings.m_audioActive = m_audioActive;
+	settings.m_volume = m_volume;
+	settings.m_audioStereo = m_audioStereo;
+	settings.m_fmDeviation = m_fmDeviation;
+	settings.m_squelch = ui->squelch->value();
+	settings.m_squelchGate = ui->squelchGate->value();
+	settings.m_agc = ui->agc->isChecked();
+	return settings.serialize();
 }
 
 bool UDPSrcGUI::deserialize(const QByteArray& data)
 {
-	SimpleDeserializer d(data);
+	UDPSrcSettings settings;
 
-	if (!d.isValid())
+	if (!settings.deserialize(data))
 	{
 		resetToDefaults();
 		return false;
 	}
 
-	if (d.getVersion() == 1)
-	{
-		QByteArray bytetmp;
-		QString strtmp;
-		qint32 s32tmp;
-		Real realtmp;
-		bool booltmp;
-
-		blockApplySettings(true);
-		m_channelMarker.blockSignals(true);
-
-		d.readBlob(1, &bytetmp);
-		restoreState(bytetmp);
-        d.readBlob(6, &bytetmp);
-        m_channelMarker.deserialize(bytetmp);
-
-		d.readS32(2, &s32tmp, 0);
-		m_channelMarker.setCenterFrequency(s32tmp);
-		d.readS32(3, &s32tmp, UDPSrc::FormatS16LE);
-		switch(s32tmp) {
-			case UDPSrc::FormatS16LE:
-				ui->sampleFormat->setCurrentIndex(0);
-				break;
-			case UDPSrc::FormatNFM:
-				ui->sampleFormat->setCurrentIndex(1);
-				break;
-			case UDPSrc::FormatNFMMono:
-				ui->sampleFormat->setCurrentIndex(2);
-				break;
-			case UDPSrc::FormatLSB:
-				ui->sampleFormat->setCurrentIndex(3);
-				break;
-			case UDPSrc::FormatUSB:
-				ui->sampleFormat->setCurrentIndex(4);
-				break;
-			case UDPSrc::FormatLSBMono:
-				ui->sampleFormat->setCurrentIndex(5);
-				break;
-			case UDPSrc::FormatUSBMono:
-				ui->sampleFormat->setCurrentIndex(6);
-				break;
-			case UDPSrc::FormatAMMono:
-				ui->sampleFormat->setCurrentIndex(7);
-				break;
-            case UDPSrc::FormatAMNoDCMono:
-                ui->sampleFormat->setCurrentIndex(8);
-                break;
-            case UDPSrc::FormatAMBPFMono:
-                ui->sampleFormat->setCurrentIndex(9);
-                break;
-			default:
-				ui->sampleFormat->setCurrentIndex(0);
-				break;
-		}
-		d.readReal(4, &realtmp, 48000);
-		ui->sampleRate->setText(QString("%1").arg(realtmp, 0));
-		d.readReal(5, &realtmp, 32000);
-		ui->rfBandwidth->setText(QString("%1").arg(realtmp, 0));
-		d.readBlob(7, &bytetmp);
-		ui->spectrumGUI->deserialize(bytetmp);
-        d.readS32(8, &s32tmp, 10);
-        ui->gain->setValue(s32tmp);
-        ui->gainText->setText(tr("%1").arg(s32tmp/10.0, 0, 'f', 1));
-		d.readBool(11, &booltmp, false);
-		ui->audioActive->setChecked(booltmp);
-		d.readS32(12, &s32tmp, 20);
-		ui->volume->setValue(s32tmp);
-		ui->volumeText->setText(QString("%1").arg(s32tmp));
-		d.readBool(14, &booltmp, false);
-		ui->audioStereo->setChecked(booltmp);
-		d.readS32(15, &s32tmp, 2500);
-		ui->fmDeviation->setText(QString("%1").arg(s32tmp));
-        d.readS32(16, &s32tmp, -60);
-        ui->squelch->setValue(s32tmp);
-        ui->squelchText->setText(tr("%1").arg(s32tmp*1.0, 0, 'f', 0));
-        d.readS32(17, &s32tmp, 5);
-        ui->squelchGate->setValue(s32tmp);
-        ui->squelchGateText->setText(tr("%1").arg(s32tmp*10.0, 0, 'f', 0));
-        d.readBool(18, &booltmp, false);
-        ui->agc->setChecked(booltmp);
-
-        blockApplySettings(false);
-		m_channelMarker.blockSignals(false);
-
-		this->setWindowTitle(m_channelMarker.getTitle());
-		displaySettings();
-		applySettingsImmediate(true);
-		applySettings(true);
-		return true;
-	}
-	else
-	{
-		resetToDefaults();
-		return false;
+	blockApplySettings(true);
+	m_channelMarker.blockSignals(true);
+
+	restoreState(settings.m_rollupState);
+	m_channelMarker.deserialize(settings.m_channelMarker);
+	m_channelMarker.setCenterFrequency(settings.m_inputFrequencyOffset);
+
+	switch(settings.m_sampleFormat) {
+		case UDPSrc::FormatS16LE:
+			ui->sampleFormat->setCurrentIndex(0);
+			break;
+		case UDPSrc::FormatNFM:
+			ui->sampleFormat->setCurrentIndex(1);
+			break;
+		case UDPSrc::FormatNFMMono:
+			ui->sampleFormat->setCurrentIndex(2);
+			break;
+		case UDPSrc::FormatLSB:
+			ui->sampleFormat->setCurrentIndex(3);
+			break;
+		case UDPSrc::FormatUSB:
+			ui->sampleFormat->setCurrentIndex(4);
+			break;
+		case UDPSrc::FormatLSBMono:
+			ui->sampleFormat->setCurrentIndex(5);
+			break;
+		case UDPSrc::FormatUSBMono:
+			ui->sampleFormat->setCurrentIndex(6);
+			break;
+		case UDPSrc::FormatAMMono:
+			ui->sampleFormat->setCurrentIndex(7);
+			break;
+        case UDPSrc::FormatAMNoDCMono:
+            ui->sampleFormat->setCurrentIndex(8);
+            break;
+        case UDPSrc::FormatAMBPFMono:
+            ui->sampleFormat->setCurrentIndex(9);
+            break;
+		default:
+			ui->sampleFormat->setCurrentIndex(0);
+			break;
 	}
+	ui->sampleRate->setText(QString("%1").arg(settings.m_outputSampleRate, 0));
+	ui->rfBandwidth->setText(QString("%1").arg(settings.m_rfBandwidth, 0));
+	ui->spectrumGUI->deserialize(settings.m_spectrumGUI);
+    ui->gain->setValue(settings.m_gain);
+    ui->gainText->setText(tr("%1").arg(settings.m_gain/10.0, 0, 'f', 1));
+	ui->audioActive->setChecked(settings.m_audioActive);
+	ui->volume->setValue(settings.m_volume);
+	ui->volumeText->setText(QString("%1").arg(settings.m_volume));
+	ui->audioStereo->setChecked(settings.m_audioStereo);
+	ui->fmDeviation->setText(QString("%1").arg(settings.m_fmDeviation));
+    ui->squelch->setValue(settings.m_squelch);
+    ui->squelchText->setText(tr("%1").arg(settings.m_squelch*1.0, 0, 'f', 0));
+    ui->squelchGate->setValue(settings.m_squelchGate);
+    ui->squelchGateText->setText(tr("%1").arg(settings.m_squelchGate*10.0, 0, 'f', 0));
+    ui->agc->setChecked(settings.m_agc);
+
+    blockApplySettings(false);
+	m_channelMarker.blockSignals(false);
+
+	this->setWindowTitle(m_channelMarker.getTitle());
+	displaySettings();
+	applySettingsImmediate(true);
+	applySettings(true);
+	return true;
 }
 
 bool UDPSrcGUI::handleMessage(const Message& message __attribute__((unused)))
@@ -21,6 +21,7 @@
 #include "plugin/pluginapi.h"
 
 #include "udpsrcgui.h"
+#include "udpsrccore.h"
 
 const PluginDescriptor UDPSrcPlugin::m_pluginDescriptor = {
 	QString("UDP Channel Source"),
@@ -63,6 +64,15 @@ PluginInstanceUI* UDPSrcPlugin::createRxChannel(const QString& channelName, Devi
 	}
 }
 
+ChannelSinkAPI* UDPSrcPlugin::createRxChannelCore(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+	if(channelName == UDPSrcGUI::m_channelID) {
+		return UDPSrcCore::create(deviceAPI);
+	} else {
+		return 0;
+	}
+}
+
 void UDPSrcPlugin::createInstanceUDPSrc(DeviceSourceAPI *deviceAPI)
 {
 	UDPSrcGUI::create(m_pluginAPI, deviceAPI);
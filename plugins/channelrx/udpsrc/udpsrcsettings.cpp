@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "util/simpleserializer.h"
+#include "udpsrcsettings.h"
+
+UDPSrcSettings::UDPSrcSettings()
+{
+	resetToDefaults();
+}
+
+void UDPSrcSettings::resetToDefaults()
+{
+	m_rollupState.clear();
+	m_inputFrequencyOffset = 0;
+	m_sampleFormat = UDPSrc::FormatS16LE;
+	m_outputSampleRate = 48000;
+	m_rfBandwidth = 32000;
+	m_channelMarker.clear();
+	m_spectrumGUI.clear();
+	m_gain = 10;
+	m_audioActive = false;
+	m_volume = 20;
+	m_audioStereo = false;
+	m_fmDeviation = 2500;
+	m_squelch = -60;
+	m_squelchGate = 5;
+	m_agc = false;
+}
+
+QByteArray UDPSrcSettings::serialize() const
+{
+	SimpleSerializer s(1);
+	s.writeBlob(1, m_rollupState);
+	s.writeS32(2, m_inputFrequencyOffset);
+	s.writeS32(3, (qint32) m_sampleFormat);
+	s.writeReal(4, m_outputSampleRate);
+	s.writeReal(5, m_rfBandwidth);
+	s.writeBlob(6, m_channelMarker);
+	s.writeBlob(7, m_spectrumGUI);
+	s.writeS32(8, m_gain);
+	s.writeBool(11, m_audioActive);
+	s.writeS32(12, m_volume);
+	s.writeBool(14, m_audioStereo);
+	s.writeS32(15, m_fmDeviation);
+	s.writeS32(16, m_squelch);
+	s.writeS32(17, m_squelchGate);
+	s.writeBool(18, m_agc);
+	return s.final();
+}
+
+bool UDPSrcSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid() || (d.getVersion() != 1))
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	qint32 s32tmp;
+
+	d.readBlob(1, &m_rollupState);
+	d.readS32(2, &m_inputFrequencyOffset, 0);
+	d.readS32(3, &s32tmp, UDPSrc::FormatS16LE);
+	m_sampleFormat = (s32tmp >= 0) && (s32tmp < UDPSrc::FormatNone) ? (UDPSrc::SampleFormat) s32tmp : UDPSrc::FormatS16LE;
+	d.readReal(4, &m_outputSampleRate, 48000);
+	d.readReal(5, &m_rfBandwidth, 32000);
+	d.readBlob(6, &m_channelMarker);
+	d.readBlob(7, &m_spectrumGUI);
+	d.readS32(8, &m_gain, 10);
+	d.readBool(11, &m_audioActive, false);
+	d.readS32(12, &m_volume, 20);
+	d.readBool(14, &m_audioStereo, false);
+	d.readS32(15, &m_fmDeviation, 2500);
+	d.readS32(16, &m_squelch, -60);
+	d.readS32(17, &m_squelchGate, 5);
+	d.readBool(18, &m_agc, false);
+
+	return true;
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_UDPSRCSETTINGS_H
+#define INCLUDE_UDPSRCSETTINGS_H
+
+#include <QByteArray>
+
+#include "udpsrc.h"
+
+/**
+ * UDP source channel settings as saved in the presets, in the units of the GUI controls. The GUI and
+ * the server channel without GUI read and write the presets through it.
+ */
+struct UDPSrcSettings
+{
+	QByteArray m_rollupState;
+	qint32 m_inputFrequencyOffset;
+	UDPSrc::SampleFormat m_sampleFormat;
+	Real m_outputSampleRate;
+	Real m_rfBandwidth;
+	QByteArray m_channelMarker;
+	QByteArray m_spectrumGUI;
+	int m_gain;                         //!< tenths
+	bool m_audioActive;
+	int m_volume;
+	bool m_audioStereo;
+	int m_fmDeviation;                  //!< Hz
+	int m_squelch;                      //!< dB. -100 is no squelch
+	int m_squelchGate;                  //!< 10s of ms
+	bool m_agc;
+
+	UDPSrcSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data); //!< false and defaults if the data is not a version 1 blob
+};
+
+#endif // INCLUDE_UDPSRCSETTINGS_H
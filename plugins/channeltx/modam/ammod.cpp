@@ -29,9 +29,9 @@ MESSAGE_CLASS_DEFINITION(AMMod::MsgConfigureAMMod, Message)
 MESSAGE_CLASS_DEFINITION(AMMod::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(AMMod::MsgConfigureFileSourceSeek, Message)
 MESSAGE_CLASS_DEFINITION(AMMod::MsgConfigureAFInput, Message)
-MESSAGE_CLASS_DEFINITION(AMMod::MsgConfigureFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(AMMod::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(AMMod::MsgReportFileSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(AMMod::MsgReportFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(AMMod::MsgReportFileSourceStreamTiming, Message)
 
 const int AMMod::m_levelNbSamples = 480; // every 10ms
 
@@ -94,6 +94,24 @@ void AMMod::configure(MessageQueue* messageQueue,
 }
 
 void AMMod::pull(Sample& sample)
+{
+	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void AMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+	m_settingsMutex.lock(); // once for the whole block
+
+	for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+		pullOne(*begin);
+	}
+
+	m_settingsMutex.unlock();
+}
+
+void AMMod::pullOne(Sample& sample)
 {
 	if (m_running.m_channelMute)
 	{
@@ -104,8 +122,6 @@ void AMMod::pull(Sample& sample)
 
 	Complex ci;
 
-	m_settingsMutex.lock();
-
     if (m_interpolatorDistance > 1.0f) // decimate
     {
     	modulateSample();
@@ -127,8 +143,6 @@ void AMMod::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
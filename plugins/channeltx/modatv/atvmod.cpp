@@ -26,8 +26,8 @@ MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureATVMod, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureImageFileName, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureVideoFileName, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureVideoFileSourceSeek, Message)
-MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureVideoFileSourceStreamTiming, Message)
-MESSAGE_CLASS_DEFINITION(ATVMod::MsgReportVideoFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(ATVMod::MsgConfigureVideoFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(ATVMod::MsgReportVideoFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgReportVideoFileSourceStreamData, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureCameraIndex, Message)
 MESSAGE_CLASS_DEFINITION(ATVMod::MsgConfigureCameraData, Message)
@@ -142,6 +142,24 @@ void ATVMod::pullAudio(int nbSamples __attribute__((unused)))
 }
 
 void ATVMod::pull(Sample& sample)
+{
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void ATVMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    m_settingsMutex.lock(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void ATVMod::pullOne(Sample& sample)
 {
 	if (m_running.m_channelMute)
 	{
@@ -152,8 +170,6 @@ void ATVMod::pull(Sample& sample)
 
     Complex ci;
 
-    m_settingsMutex.lock();
-
     if ((m_tvSampleRate == m_running.m_outputSampleRate) && (!m_running.m_forceDecimator)) // no interpolation nor decimation
     {
         modulateSample();
@@ -187,8 +203,6 @@ void ATVMod::pullFinalize(Complex& ci, Sample& sample)
 {
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (1<<30);
     m_movingAverage.feed(magsq);
@@ -135,7 +135,7 @@ public:
     };
 
     class MsgConfigureVideoFileSourceStreamTiming : public Message {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
 
@@ -153,7 +153,7 @@ public:
 
     class MsgReportVideoFileSourceStreamTiming : public Message
     {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
         int getFrameCount() const { return m_frameCount; }
@@ -397,6 +397,7 @@ public:
             bool forceDecimator);
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples); // this is used for video signal actually
     virtual void start();
     virtual void stop();
@@ -705,6 +706,7 @@ private:
     void pullFinalize(Complex& ci, Sample& sample);
     void pullVideo(Real& sample);
     void calculateLevel(Real& sample);
+    void pullOne(Sample& sample); //!< next output sample. m_settingsMutex must be held.
     void modulateSample();
     Complex& modulateSSB(Real& sample);
     Complex& modulateVestigialSSB(Real& sample);
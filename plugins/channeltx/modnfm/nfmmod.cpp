@@ -29,9 +29,9 @@ MESSAGE_CLASS_DEFINITION(NFMMod::MsgConfigureNFMMod, Message)
 MESSAGE_CLASS_DEFINITION(NFMMod::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(NFMMod::MsgConfigureFileSourceSeek, Message)
 MESSAGE_CLASS_DEFINITION(NFMMod::MsgConfigureAFInput, Message)
-MESSAGE_CLASS_DEFINITION(NFMMod::MsgConfigureFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(NFMMod::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(NFMMod::MsgReportFileSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(NFMMod::MsgReportFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(NFMMod::MsgReportFileSourceStreamTiming, Message)
 
 const int NFMMod::m_levelNbSamples = 480; // every 10ms
 
@@ -108,6 +108,24 @@ void NFMMod::configure(MessageQueue* messageQueue,
 }
 
 void NFMMod::pull(Sample& sample)
+{
+	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void NFMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+	m_settingsMutex.lock(); // once for the whole block
+
+	for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+		pullOne(*begin);
+	}
+
+	m_settingsMutex.unlock();
+}
+
+void NFMMod::pullOne(Sample& sample)
 {
 	if (m_running.m_channelMute)
 	{
@@ -118,8 +136,6 @@ void NFMMod::pull(Sample& sample)
 
 	Complex ci;
 
-	m_settingsMutex.lock();
-
     if (m_interpolatorDistance > 1.0f) // decimate
     {
     	modulateSample();
@@ -141,8 +157,6 @@ void NFMMod::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
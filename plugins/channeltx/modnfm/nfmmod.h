@@ -90,7 +90,7 @@ public:
     };
 
     class MsgConfigureFileSourceStreamTiming : public Message {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
 
@@ -129,7 +129,7 @@ public:
 
     class MsgReportFileSourceStreamTiming : public Message
     {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
         std::size_t getSamplesCount() const { return m_samplesCount; }
@@ -190,6 +190,7 @@ public:
             float ctcssFrequency);
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -363,6 +364,7 @@ private:
     void apply();
     void pullAF(Real& sample);
     void calculateLevel(Real& sample);
+    void pullOne(Sample& sample); //!< next output sample. m_settingsMutex must be held.
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
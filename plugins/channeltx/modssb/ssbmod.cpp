@@ -30,9 +30,9 @@ MESSAGE_CLASS_DEFINITION(SSBMod::MsgConfigureSSBMod, Message)
 MESSAGE_CLASS_DEFINITION(SSBMod::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(SSBMod::MsgConfigureFileSourceSeek, Message)
 MESSAGE_CLASS_DEFINITION(SSBMod::MsgConfigureAFInput, Message)
-MESSAGE_CLASS_DEFINITION(SSBMod::MsgConfigureFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SSBMod::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(SSBMod::MsgReportFileSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(SSBMod::MsgReportFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SSBMod::MsgReportFileSourceStreamTiming, Message)
 
 const int SSBMod::m_levelNbSamples = 480; // every 10ms
 const int SSBMod::m_ssbFftLen = 1024;
@@ -162,9 +162,25 @@ void SSBMod::configure(MessageQueue* messageQueue,
 
 void SSBMod::pull(Sample& sample)
 {
-	Complex ci;
-
 	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void SSBMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+	m_settingsMutex.lock(); // once for the whole block
+
+	for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+		pullOne(*begin);
+	}
+
+	m_settingsMutex.unlock();
+}
+
+void SSBMod::pullOne(Sample& sample)
+{
+	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -188,8 +204,6 @@ void SSBMod::pull(Sample& sample)
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
     ci *= 29204.0f; //scaling at -1 dB to account for possible filter overshoot
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
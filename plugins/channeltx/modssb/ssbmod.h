@@ -89,7 +89,7 @@ public:
     };
 
     class MsgConfigureFileSourceStreamTiming : public Message {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
 
@@ -128,7 +128,7 @@ public:
 
     class MsgReportFileSourceStreamTiming : public Message
     {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
         std::size_t getSamplesCount() const { return m_samplesCount; }
@@ -196,6 +196,7 @@ public:
             int agcThresholdDelay);
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -444,6 +445,7 @@ private:
     void apply();
     void pullAF(Complex& sample);
     void calculateLevel(Complex& sample);
+    void pullOne(Sample& sample); //!< next output sample. m_settingsMutex must be held.
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
@@ -29,9 +29,9 @@ MESSAGE_CLASS_DEFINITION(WFMMod::MsgConfigureWFMMod, Message)
 MESSAGE_CLASS_DEFINITION(WFMMod::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(WFMMod::MsgConfigureFileSourceSeek, Message)
 MESSAGE_CLASS_DEFINITION(WFMMod::MsgConfigureAFInput, Message)
-MESSAGE_CLASS_DEFINITION(WFMMod::MsgConfigureFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(WFMMod::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(WFMMod::MsgReportFileSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(WFMMod::MsgReportFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(WFMMod::MsgReportFileSourceStreamTiming, Message)
 
 const int WFMMod::m_levelNbSamples = 480; // every 10ms
 const int WFMMod::m_rfFilterFFTLength = 1024;
@@ -108,6 +108,24 @@ void WFMMod::configure(MessageQueue* messageQueue,
 }
 
 void WFMMod::pull(Sample& sample)
+{
+	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void WFMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+	m_settingsMutex.lock(); // once for the whole block
+
+	for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+		pullOne(*begin);
+	}
+
+	m_settingsMutex.unlock();
+}
+
+void WFMMod::pullOne(Sample& sample)
 {
 	if (m_running.m_channelMute)
 	{
@@ -120,8 +138,6 @@ void WFMMod::pull(Sample& sample)
     fftfilt::cmplx *rf;
     int rf_out;
 
-	m_settingsMutex.lock();
-
 	if ((m_afInput == WFMModInputFile) || (m_afInput == WFMModInputAudio))
 	{
 	    if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ri))
@@ -155,8 +171,6 @@ void WFMMod::pull(Sample& sample)
     ci = m_rfFilterBuffer[m_rfFilterBufferIndex] * m_carrierNco.nextIQ(); // shift to carrier frequency
     m_rfFilterBufferIndex++;
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
@@ -89,7 +89,7 @@ public:
     };
 
     class MsgConfigureFileSourceStreamTiming : public Message {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
 
@@ -128,7 +128,7 @@ public:
 
     class MsgReportFileSourceStreamTiming : public Message
     {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
 
     public:
         std::size_t getSamplesCount() const { return m_samplesCount; }
@@ -187,6 +187,7 @@ public:
             bool playLoop);
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -346,6 +347,7 @@ private:
 
     void apply();
     void pullAF(Complex& sample);
+    void pullOne(Sample& sample); //!< next output sample. m_settingsMutex must be held.
     void calculateLevel(const Real& sample);
     void openFileStream();
     void seekFileStream(int seekPercentage);
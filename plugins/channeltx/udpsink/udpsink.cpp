@@ -73,6 +73,24 @@ void UDPSink::stop()
 }
 
 void UDPSink::pull(Sample& sample)
+{
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void UDPSink::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    m_settingsMutex.lock(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void UDPSink::pullOne(Sample& sample)
 {
     if (m_running.m_channelMute)
     {
@@ -84,8 +102,6 @@ void UDPSink::pull(Sample& sample)
 
     Complex ci;
 
-    m_settingsMutex.lock();
-
     if (m_interpolatorDistance > 1.0f) // decimate
     {
         modulateSample();
@@ -107,8 +123,6 @@ void UDPSink::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (1<<30);
     m_movingAverage.feed(magsq);
@@ -50,6 +50,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual bool handleMessage(const Message& cmd);
 
     double getMagSq() const { return m_magsq; }
@@ -330,6 +331,7 @@ private:
     static const int m_ssbFftLen = 1024;
 
     void apply(bool force);
+    void pullOne(Sample& sample); //!< next output sample. m_settingsMutex must be held.
     void modulateSample();
     void calculateLevel(Real sample);
     void calculateLevel(Complex sample);
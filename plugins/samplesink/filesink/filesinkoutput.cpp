@@ -32,9 +32,9 @@
 MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgConfigureFileSink, Message)
 MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgConfigureFileSinkName, Message)
 MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgConfigureFileSinkWork, Message)
-MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgConfigureFileSinkStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(FileSinkOutput::MsgConfigureFileSinkStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgReportFileSinkGeneration, Message)
-MESSAGE_CLASS_DEFINITION(FileSinkOutput::MsgReportFileSinkStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(FileSinkOutput::MsgReportFileSinkStreamTiming, Message)
 
 FileSinkOutput::FileSinkOutput(DeviceSinkAPI *deviceAPI, const QTimer& masterTimer) :
     m_deviceAPI(deviceAPI),
@@ -92,7 +92,7 @@ public:
 	};
 
 	class MsgConfigureFileSinkStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 
@@ -129,7 +129,7 @@ public:
 	};
 
 	class MsgReportFileSinkStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 		std::size_t getSamplesCount() const { return m_samplesCount; }
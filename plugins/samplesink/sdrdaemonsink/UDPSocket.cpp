@@ -359,6 +359,61 @@ void UDPSocket::SendDataGram( const void *buffer, int bufferLen, const string &f
 
 }
 
+void UDPSocket::SendDataGram(const void *buffer, int bufferLen, const sockaddr_in& destAddr) throw(CSocketException)
+{
+    if (sendto(m_sockDesc, (void *) buffer, bufferLen, 0, (const sockaddr *) &destAddr, sizeof(destAddr)) != bufferLen)
+    {
+        throw CSocketException("Send failed (sendto())", true);
+    }
+}
+
+void UDPSocket::SendDataGrams(const void * const *buffers, int bufferLen, int nbBuffers, const sockaddr_in& destAddr) throw(CSocketException)
+{
+#ifdef __linux__
+    mmsghdr msgs[UDPSOCKET_MAX_BATCH];
+    iovec iovecs[UDPSOCKET_MAX_BATCH];
+    int sent = 0;
+
+    while (sent < nbBuffers)
+    {
+        int batch = nbBuffers - sent < UDPSOCKET_MAX_BATCH ? nbBuffers - sent : UDPSOCKET_MAX_BATCH;
+        memset(msgs, 0, batch * sizeof(mmsghdr));
+
+        for (int i = 0; i < batch; i++)
+        {
+            iovecs[i].iov_base = (void *) buffers[sent + i];
+            iovecs[i].iov_len = bufferLen;
+            msgs[i].msg_hdr.msg_name = (void *) &destAddr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(destAddr);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int nbSent = sendmmsg(m_sockDesc, msgs, batch, 0);
+
+        if (nbSent < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw CSocketException("Send failed (sendmmsg())", true);
+        }
+
+        sent += nbSent;
+    }
+#else
+    for (int i = 0; i < nbBuffers; i++) {
+        SendDataGram(buffers[i], bufferLen, destAddr);
+    }
+#endif
+}
+
+void UDPSocket::ResolveAddress(const string &foreignAddress, unsigned short foreignPort, sockaddr_in& destAddr) throw(CSocketException)
+{
+    FillAddr(foreignAddress, foreignPort, destAddr);
+}
+
 int UDPSocket::RecvDataGram( void *buffer, int bufferLen, string &sourceAddress, unsigned short &sourcePort )
     throw(CSocketException)
 {
@@ -33,6 +33,8 @@
 #include <errno.h>
 #include <climits>
 
+#define UDPSOCKET_MAX_BATCH 256 // maximum number of datagrams sent in one sendmmsg() call
+
 using namespace std;
 
 /**
@@ -296,6 +298,36 @@ public:
     void SendDataGram(const void *buffer, int bufferLen, const string &foreignAddress,
         unsigned short foreignPort) throw(CSocketException);
 
+  /**
+   *   Send the given buffer as a UDP datagram to the destination
+   *   previously resolved with ResolveAddress()
+   *   @param buffer buffer to be written
+   *   @param bufferLen number of bytes to write
+   *   @param destAddr resolved destination address
+   *   @exception SocketException thrown if unable to send datagram
+   */
+    void SendDataGram(const void *buffer, int bufferLen, const sockaddr_in& destAddr) throw(CSocketException);
+
+  /**
+   *   Send nbBuffers datagrams of bufferLen bytes each to the resolved destination.
+   *   On Linux they are sent in batches of up to UDPSOCKET_MAX_BATCH with sendmmsg()
+   *   @param buffers array of nbBuffers pointers to the datagram payloads
+   *   @param bufferLen number of bytes of each datagram
+   *   @param nbBuffers number of datagrams to send
+   *   @param destAddr resolved destination address
+   *   @exception SocketException thrown if unable to send datagrams
+   */
+    void SendDataGrams(const void * const *buffers, int bufferLen, int nbBuffers, const sockaddr_in& destAddr) throw(CSocketException);
+
+  /**
+   *   Resolve address and port once for the sends to a fixed destination
+   *   @param foreignAddress address (IP address or name) to resolve
+   *   @param foreignPort port number
+   *   @param destAddr resolved destination address
+   *   @exception SocketException thrown if unable to resolve the address
+   */
+    static void ResolveAddress(const string &foreignAddress, unsigned short foreignPort, sockaddr_in& destAddr) throw(CSocketException);
+
     /**
      *   Read read up to bufferLen bytes data from this socket.  The given buffer
      *   is where the data will be placed
@@ -39,6 +39,7 @@
 
 #include "device/devicesinkapi.h"
 #include "sdrdaemonsinkgui.h"
+#include "udpsinkfec.h"
 
 SDRdaemonSinkGui::SDRdaemonSinkGui(DeviceSinkAPI *deviceAPI, QWidget* parent) :
 	QWidget(parent),
@@ -229,8 +230,8 @@ void SDRdaemonSinkGui::updateSampleRateAndFrequency()
 
 void SDRdaemonSinkGui::updateTxDelayTooltip()
 {
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
-    ui->txDelayText->setToolTip(tr("%1 us").arg(QString::number(delay*1e6, 'f', 0)));
+    uint32_t txPeriod = UDPSinkFEC::getTxPeriod(m_settings.m_txDelay, m_settings.m_sampleRate, m_settings.m_nbFECBlocks);
+    ui->txDelayText->setToolTip(tr("%1 us").arg(QString::number(txPeriod / 1e3, 'f', 1)));
 }
 
 void SDRdaemonSinkGui::displaySettings()
@@ -246,6 +247,8 @@ void SDRdaemonSinkGui::displaySettings()
     QString s0 = QString::number(128 + m_settings.m_nbFECBlocks, 'f', 0);
     QString s1 = QString::number(m_settings.m_nbFECBlocks, 'f', 0);
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s0).arg(s1));
+    ui->sampleBits->setCurrentIndex(m_settings.m_sampleBits == 8 ? 2 : m_settings.m_sampleBits == 12 ? 1 : 0);
+    ui->compression->setChecked(m_settings.m_compression);
 
     ui->address->setText(m_settings.m_address);
     ui->dataPort->setText(tr("%1").arg(m_settings.m_dataPort));
@@ -434,6 +437,22 @@ void SDRdaemonSinkGui::on_nbFECBlocks_valueChanged(int value)
     sendSettings();
 }
 
+void SDRdaemonSinkGui::on_sampleBits_currentIndexChanged(int index)
+{
+    if (index < 0) {
+        return;
+    }
+
+    m_settings.m_sampleBits = index == 2 ? 8 : index == 1 ? 12 : 16;
+    sendSettings();
+}
+
+void SDRdaemonSinkGui::on_compression_toggled(bool checked)
+{
+    m_settings.m_compression = checked;
+    sendSettings();
+}
+
 void SDRdaemonSinkGui::on_address_returnPressed()
 {
     m_settings.m_address = ui->address->text();
@@ -98,6 +98,8 @@ private slots:
     void on_interp_currentIndexChanged(int index);
     void on_txDelay_valueChanged(int value);
     void on_nbFECBlocks_valueChanged(int value);
+    void on_sampleBits_currentIndexChanged(int index);
+    void on_compression_toggled(bool checked);
     void on_address_returnPressed();
     void on_dataPort_returnPressed();
     void on_controlPort_returnPressed();
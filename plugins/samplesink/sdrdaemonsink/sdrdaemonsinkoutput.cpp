@@ -31,9 +31,9 @@
 
 MESSAGE_CLASS_DEFINITION(SDRdaemonSinkOutput::MsgConfigureSDRdaemonSink, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSinkOutput::MsgConfigureSDRdaemonSinkWork, Message)
-MESSAGE_CLASS_DEFINITION(SDRdaemonSinkOutput::MsgConfigureSDRdaemonSinkStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SDRdaemonSinkOutput::MsgConfigureSDRdaemonSinkStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSinkOutput::MsgConfigureSDRdaemonSinkChunkCorrection, Message)
-MESSAGE_CLASS_DEFINITION(SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming, Message)
 
 SDRdaemonSinkOutput::SDRdaemonSinkOutput(DeviceSinkAPI *deviceAPI, const QTimer& masterTimer) :
     m_deviceAPI(deviceAPI),
@@ -65,11 +65,12 @@ bool SDRdaemonSinkOutput::start()
 	m_sdrDaemonSinkThread->setCenterFrequency(m_settings.m_centerFrequency);
 	m_sdrDaemonSinkThread->setSamplerate(m_settings.m_sampleRate);
 	m_sdrDaemonSinkThread->setNbBlocksFEC(m_settings.m_nbFECBlocks);
+	m_sdrDaemonSinkThread->setSampleBits(m_settings.m_sampleBits);
+	m_sdrDaemonSinkThread->setCompression(m_settings.m_compression);
 	m_sdrDaemonSinkThread->connectTimer(m_masterTimer);
 	m_sdrDaemonSinkThread->startWork();
 
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
-    m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
+    m_sdrDaemonSinkThread->setTxDelay(UDPSinkFEC::getTxPeriod(m_settings.m_txDelay, m_settings.m_sampleRate, m_settings.m_nbFECBlocks));
 
 	mutexLocker.unlock();
 	//applySettings(m_generalSettings, m_settings, true);
@@ -229,6 +230,26 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
         changeTxDelay = true;
     }
 
+    if (force || (m_settings.m_sampleBits != settings.m_sampleBits))
+    {
+        m_settings.m_sampleBits = settings.m_sampleBits;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setSampleBits(m_settings.m_sampleBits);
+        }
+    }
+
+    if (force || (m_settings.m_compression != settings.m_compression))
+    {
+        m_settings.m_compression = settings.m_compression;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setCompression(m_settings.m_compression);
+        }
+    }
+
     if (force || (m_settings.m_txDelay != settings.m_txDelay))
     {
         m_settings.m_txDelay = settings.m_txDelay;
@@ -237,28 +258,30 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
 
     if (changeTxDelay)
     {
-        double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
-        qDebug("SDRdaemonSinkOutput::applySettings: Tx delay: %f us", delay*1e6);
+        // delay is calculated as a fraction of the nominal UDP block process time
+        // frame size: UDPSinkFEC::samplesPerFrame samples
+        // divided by sample rate gives the frame process time
+        // divided by the number of actual blocks including FEC blocks gives the block (i.e. UDP block) process time
+        uint32_t txPeriod = UDPSinkFEC::getTxPeriod(m_settings.m_txDelay, m_settings.m_sampleRate, m_settings.m_nbFECBlocks);
+        qDebug("SDRdaemonSinkOutput::applySettings: Tx delay: %f us", txPeriod / 1e3);
 
         if (m_sdrDaemonSinkThread != 0)
         {
-            // delay is calculated as a fraction of the nominal UDP block process time
-            // frame size: 127 * 127 samples
-            // divided by sample rate gives the frame process time
-            // divided by the number of actual blocks including FEC blocks gives the block (i.e. UDP block) process time
-            m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
+            m_sdrDaemonSinkThread->setTxDelay(txPeriod);
         }
     }
 
     mutexLocker.unlock();
 
-    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d",
+    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d m_sampleBits: %u m_compression: %d",
             forwardChange ? "forward change" : "",
             m_settings.m_centerFrequency,
             m_settings.m_sampleRate,
             m_settings.m_log2Interp,
             m_settings.m_txDelay,
-            m_settings.m_nbFECBlocks);
+            m_settings.m_nbFECBlocks,
+            m_settings.m_sampleBits,
+            m_settings.m_compression ? 1 : 0);
 
     if (forwardChange)
     {
@@ -96,7 +96,7 @@ public:
     };
 
 	class MsgConfigureSDRdaemonSinkStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 
@@ -113,7 +113,7 @@ public:
 	};
 
 	class MsgReportSDRdaemonSinkStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 		std::size_t getSamplesCount() const { return m_samplesCount; }
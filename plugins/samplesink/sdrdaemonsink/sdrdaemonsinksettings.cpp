@@ -29,6 +29,8 @@ void SDRdaemonSinkSettings::resetToDefaults()
     m_log2Interp = 4;
     m_txDelay = 0.5;
     m_nbFECBlocks = 0;
+    m_sampleBits = 16;
+    m_compression = false;
     m_address = "127.0.0.1";
     m_dataPort = 9092;
     m_controlPort = 9093;
@@ -47,6 +49,8 @@ QByteArray SDRdaemonSinkSettings::serialize() const
     s.writeU32(6, m_dataPort);
     s.writeU32(7, m_controlPort);
     s.writeString(8, m_specificParameters);
+    s.writeU32(9, m_sampleBits);
+    s.writeBool(10, m_compression);
 
     return s.final();
 }
@@ -74,6 +78,13 @@ bool SDRdaemonSinkSettings::deserialize(const QByteArray& data)
         d.readU32(7, &uintval, 9090);
         m_controlPort = uintval % (1<<16);
         d.readString(8, &m_specificParameters, "");
+        d.readU32(9, &m_sampleBits, 16);
+
+        if ((m_sampleBits != 8) && (m_sampleBits != 12)) {
+            m_sampleBits = 16;
+        }
+
+        d.readBool(10, &m_compression, false);
         return true;
     }
     else
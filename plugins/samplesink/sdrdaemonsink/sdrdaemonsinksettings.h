@@ -25,6 +25,8 @@ struct SDRdaemonSinkSettings {
     quint32 m_log2Interp;
     float   m_txDelay;
     quint32 m_nbFECBlocks;
+    quint32 m_sampleBits;    //!< bits per I or Q value sent: 16, 12 or 8
+    bool    m_compression;   //!< lossless compression of the samples sent
     QString m_address;
     quint16 m_dataPort;
     quint16 m_controlPort;
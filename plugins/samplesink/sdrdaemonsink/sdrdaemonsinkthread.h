@@ -50,6 +50,8 @@ public:
 	void setSamplerate(int samplerate);
     void setNbBlocksFEC(uint32_t nbBlocksFEC) { m_udpSinkFEC.setNbBlocksFEC(nbBlocksFEC); };
     void setTxDelay(uint32_t txDelay) { m_udpSinkFEC.setTxDelay(txDelay); };
+    void setSampleBits(uint8_t sampleBits) { m_udpSinkFEC.setSampleBits(sampleBits); }
+    void setCompression(bool compression) { m_udpSinkFEC.setCompression(compression); }
     void setRemoteAddress(const QString& address, uint16_t port) { m_udpSinkFEC.setRemoteAddress(address, port); }
 
     bool isRunning() const { return m_running; }
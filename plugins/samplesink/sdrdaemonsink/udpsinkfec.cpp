@@ -21,17 +21,18 @@
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
 
+#include "dsp/samplecodec.h"
+#include "dsp/samplepacker.h"
 #include "udpsinkfec.h"
 
-MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgUDPFECEncodeAndSend, Message)
 MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgConfigureRemoteAddress, Message)
 
 
 UDPSinkFEC::UDPSinkFEC() :
     m_centerFrequency(100000),
     m_sampleRate(48000),
-    m_sampleBytes(1),
-    m_sampleBits(8),
+    m_sampleBytes(sizeof(FixReal)),
+    m_sampleBits(16),
     m_nbSamples(0),
     m_nbBlocksFEC(0),
     m_txDelay(0),
@@ -168,11 +169,12 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
 
                 // TODO: send blocks
                 //qDebug("UDPSinkFEC::write: push frame to worker: %u", m_frameCount);
-                m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount);
+                m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount,
+                        m_sampleBits, (m_sampleBytes & m_codecIndicator) != 0);
                 //m_txThread = new std::thread(transmitUDP, this, m_txBlocks[m_txBlocksIndex], m_frameCount, nbBlocksFEC, txDelay, m_cm256Valid);
                 //transmitUDP(this, m_txBlocks[m_txBlocksIndex], m_frameCount, m_nbBlocksFEC, m_txDelay, m_cm256Valid);
 
-                m_txBlocksIndex = (m_txBlocksIndex + 1) % 4;
+                m_txBlocksIndex = (m_txBlocksIndex + 1) % UDPSINKFEC_NBTXFRAMES;
                 m_txBlockIndex = 0;
                 m_frameCount++;
             }
@@ -186,25 +188,87 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
 
 UDPSinkFECWorker::UDPSinkFECWorker() :
         m_running(false),
-        m_remotePort(9090)
+        m_encoderPool(0),
+        m_txFrameHead(0),
+        m_txFrameTail(0),
+        m_nbTxFrames(0),
+        m_remotePort(9090),
+        m_remoteResolved(false),
+        m_txLastRefill(0),
+        m_txTokens(m_txBurst)
 {
-    m_cm256Valid = m_cm256.isInitialized();
-    connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::DirectConnection);
+    m_encoderPool = new JobPool();
+    int nbEncoders = m_encoderPool->getNbWorkers();
+    m_cm256 = new CM256[nbEncoders];
+    m_cm256Valid = true;
+
+    for (int i = 0; i < nbEncoders; i++) {
+        m_cm256Valid = m_cm256Valid && m_cm256[i].isInitialized();
+    }
+
+    m_fecBlocks.resize(nbEncoders * 256);
+    m_compressBuffers.resize(nbEncoders * (UDPSinkFEC::m_nbOriginalBlocks - 1) * sizeof(UDPSinkFEC::ProtectedBlock));
+
+    for (int i = 0; i < UDPSINKFEC_NBTXFRAMES; i++) {
+        m_txFrames[i].m_worker = this;
+    }
+
+    memset((void *) &m_remoteSockAddr, 0, sizeof(m_remoteSockAddr));
+    m_txTimer.start();
+    qDebug("UDPSinkFECWorker::UDPSinkFECWorker: %d FEC encoders", nbEncoders);
 }
 
 UDPSinkFECWorker::~UDPSinkFECWorker()
 {
-    disconnect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+    delete m_encoderPool; // joins the encoders before their resources go
     m_inputMessageQueue.clear();
+    delete[] m_cm256;
 }
 
 void UDPSinkFECWorker::pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
     uint32_t nbBlocksFEC,
     uint32_t txDelay,
-    uint16_t frameIndex)
+    uint16_t frameIndex,
+    uint8_t sampleBits,
+    bool compression)
 {
-    //qDebug("UDPSinkFECWorker::pushTxFrame. %d", m_inputMessageQueue.size());
-    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex));
+    m_txMutex.lock();
+
+    while (m_nbTxFrames >= UDPSINKFEC_NBTXFRAMES - 1) // wait for the oldest frame to be sent
+    {
+        if (!m_running)
+        {
+            m_txMutex.unlock();
+            return;
+        }
+
+        m_txFrameFree.wait(&m_txMutex, 100);
+    }
+
+    TxFrame& txFrame = m_txFrames[m_txFrameHead];
+    txFrame.m_txBlocks = txBlocks;
+    txFrame.m_nbBlocksFEC = nbBlocksFEC;
+    txFrame.m_txDelay = txDelay;
+    txFrame.m_frameIndex = frameIndex;
+    txFrame.m_sampleBits = sampleBits;
+    txFrame.m_compression = compression;
+    txFrame.m_nbOriginalBlocks = UDPSinkFEC::m_nbOriginalBlocks;
+    txFrame.m_encoded = false;
+    m_txFrameHead = (m_txFrameHead + 1) % UDPSINKFEC_NBTXFRAMES;
+    m_nbTxFrames++;
+
+    if (((nbBlocksFEC == 0) || !m_cm256Valid) && (sampleBits == 16) && !compression) // nothing to encode
+    {
+        txFrame.m_encodeOK = true;
+        txFrame.m_encoded = true;
+        m_txFrameEncoded.wakeAll();
+        m_txMutex.unlock();
+    }
+    else
+    {
+        m_txMutex.unlock();
+        m_encoderPool->push(&txFrame);
+    }
 }
 
 void UDPSinkFECWorker::setRemoteAddress(const QString& address, uint16_t port)
@@ -220,7 +284,33 @@ void UDPSinkFECWorker::process()
 
     while (m_running)
     {
-        usleep(250000);
+        handleInputMessages();
+
+        // transmit frames in order as soon as they are encoded
+        m_txMutex.lock();
+
+        if ((m_nbTxFrames == 0) || !m_txFrames[m_txFrameTail].m_encoded)
+        {
+            m_txFrameEncoded.wait(&m_txMutex, 100);
+            m_txMutex.unlock();
+            continue;
+        }
+
+        TxFrame& txFrame = m_txFrames[m_txFrameTail];
+        m_txMutex.unlock();
+
+        if (txFrame.m_encodeOK)
+        {
+            int nbBlocks = txFrame.m_nbOriginalBlocks + (m_cm256Valid ? txFrame.m_nbBlocksFEC : 0);
+            transmitBlocks(txFrame.m_txBlocks, nbBlocks, txFrame.m_txDelay);
+        }
+
+        m_txMutex.lock();
+        txFrame.m_encoded = false;
+        m_txFrameTail = (m_txFrameTail + 1) % UDPSINKFEC_NBTXFRAMES;
+        m_nbTxFrames--;
+        m_txFrameFree.wakeAll();
+        m_txMutex.unlock();
     }
 
     qDebug("UDPSinkFECWorker::process: stopped");
@@ -229,7 +319,11 @@ void UDPSinkFECWorker::process()
 
 void UDPSinkFECWorker::stop()
 {
+    m_txMutex.lock();
     m_running = false;
+    m_txFrameEncoded.wakeAll();
+    m_txFrameFree.wakeAll();
+    m_txMutex.unlock();
 }
 
 void UDPSinkFECWorker::handleInputMessages()
@@ -238,101 +332,189 @@ void UDPSinkFECWorker::handleInputMessages()
 
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
-        if (MsgUDPFECEncodeAndSend::match(*message))
-        {
-            MsgUDPFECEncodeAndSend *sendMsg = (MsgUDPFECEncodeAndSend *) message;
-            encodeAndTransmit(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay());
-        }
-        else if (MsgConfigureRemoteAddress::match(*message))
+        if (MsgConfigureRemoteAddress::match(*message))
         {
             qDebug("UDPSinkFECWorker::handleInputMessages: %s", message->getIdentifier());
             MsgConfigureRemoteAddress *addressMsg = (MsgConfigureRemoteAddress *) message;
             m_remoteAddress = addressMsg->getAddress();
             m_remotePort = addressMsg->getPort();
+
+            try
+            {
+                UDPSocket::ResolveAddress(m_remoteAddress.toStdString(), m_remotePort, m_remoteSockAddr);
+                m_remoteResolved = true;
+            }
+            catch (CSocketException& e)
+            {
+                qWarning("UDPSinkFECWorker::handleInputMessages: cannot resolve %s: %s", qPrintable(m_remoteAddress), e.what());
+                m_remoteResolved = false;
+            }
         }
 
         delete message;
     }
 }
 
-void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay)
+void UDPSinkFECWorker::encodeFrame(TxFrame& txFrame, int workerIndex)
 {
     CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
     CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
-    UDPSinkFEC::ProtectedBlock fecBlocks[256];   //!< FEC data
+    UDPSinkFEC::SuperBlock *txBlockx = txFrame.m_txBlocks;
+    UDPSinkFEC::ProtectedBlock *fecBlocks = &m_fecBlocks[workerIndex * 256];
+    int nbOriginalBlocks = compressFrame(txFrame, workerIndex);
 
-    if ((nbBlocksFEC == 0) || !m_cm256Valid)
+    cm256Params.BlockBytes = sizeof(UDPSinkFEC::ProtectedBlock);
+    cm256Params.OriginalCount = nbOriginalBlocks;
+    cm256Params.RecoveryCount = m_cm256Valid ? txFrame.m_nbBlocksFEC : 0;
+
+    // Fill pointers to data
+    for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
     {
-//        qDebug("UDPSinkFECWorker::encodeAndTransmit: transmit frame without FEC to %s:%d", m_remoteAddress.toStdString().c_str(), m_remotePort);
+        if (i >= cm256Params.OriginalCount) {
+            memset((void *) &txBlockx[i].protectedBlock, 0, sizeof(UDPSinkFEC::ProtectedBlock));
+        }
 
-        for (unsigned int i = 0; i < UDPSinkFEC::m_nbOriginalBlocks; i++)
-        {
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
+        txBlockx[i].header.frameIndex = txFrame.m_frameIndex;
+        txBlockx[i].header.blockIndex = i;
+        txBlockx[i].header.nbOriginalBlocks = nbOriginalBlocks == (int) UDPSinkFEC::m_nbOriginalBlocks ? 0 : nbOriginalBlocks;
+        descriptorBlocks[i].Block = (void *) &(txBlockx[i].protectedBlock);
+        descriptorBlocks[i].Index = txBlockx[i].header.blockIndex;
+    }
+
+    // Encode FEC blocks
+    bool encodeOK = (cm256Params.RecoveryCount == 0) || (m_cm256[workerIndex].cm256_encode(cm256Params, descriptorBlocks, fecBlocks) == 0);
+
+    if (encodeOK)
+    {
+        // Merge FEC with data to transmit
+        for (int i = 0; i < cm256Params.RecoveryCount; i++) {
+            txBlockx[i + cm256Params.OriginalCount].protectedBlock = fecBlocks[i];
         }
     }
     else
     {
-        cm256Params.BlockBytes = sizeof(UDPSinkFEC::ProtectedBlock);
-        cm256Params.OriginalCount = UDPSinkFEC::m_nbOriginalBlocks;
-        cm256Params.RecoveryCount = nbBlocksFEC;
+        qDebug("UDPSinkFECWorker::encodeFrame: CM256 encode failed. No transmission.");
+    }
 
+    QMutexLocker mutexLocker(&m_txMutex);
+    txFrame.m_nbOriginalBlocks = nbOriginalBlocks;
+    txFrame.m_encodeOK = encodeOK;
+    txFrame.m_encoded = true;
+    m_txFrameEncoded.wakeAll();
+}
 
-        // Fill pointers to data
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
+int UDPSinkFECWorker::compressFrame(TxFrame& txFrame, int workerIndex)
+{
+    if ((txFrame.m_sampleBits == 16) && !txFrame.m_compression) {
+        return UDPSinkFEC::m_nbOriginalBlocks;
+    }
+
+    // the compressed payload must fit in less blocks than the nominal frame so that both can be told apart
+    const int blockSize = sizeof(UDPSinkFEC::ProtectedBlock);
+    const int bufferSize = (UDPSinkFEC::m_nbOriginalBlocks - 2) * blockSize;
+    uint8_t *buffer = &m_compressBuffers[workerIndex * (UDPSinkFEC::m_nbOriginalBlocks - 1) * blockSize];
+    UDPSinkFEC::SuperBlock *txBlockx = txFrame.m_txBlocks;
+    UDPSinkFEC::CompressedFrameHeader *header = (UDPSinkFEC::CompressedFrameHeader *) buffer;
+    int sampleBits = txFrame.m_sampleBits;
+    int sampleShift = 16 - sampleBits;
+    int nbBytes = sizeof(UDPSinkFEC::CompressedFrameHeader);
+
+    if (txFrame.m_compression)
+    {
+        for (uint32_t i = 1; i < UDPSinkFEC::m_nbOriginalBlocks; i++) // blocks are coded independently
         {
-            if (i >= cm256Params.OriginalCount) {
-                memset((void *) &txBlockx[i].protectedBlock, 0, sizeof(UDPSinkFEC::ProtectedBlock));
+            uint blockBytes = SampleCodec::encode(txBlockx[i].protectedBlock.m_samples, UDPSinkFEC::samplesPerBlock,
+                    &buffer[nbBytes], bufferSize - nbBytes, sampleBits, sampleShift);
+
+            if (blockBytes == 0) // does not compress enough: fall back to packing only
+            {
+                nbBytes = 0;
+                break;
             }
 
-            txBlockx[i].header.frameIndex = frameIndex;
-            txBlockx[i].header.blockIndex = i;
-            descriptorBlocks[i].Block = (void *) &(txBlockx[i].protectedBlock);
-            descriptorBlocks[i].Index = txBlockx[i].header.blockIndex;
+            nbBytes += blockBytes;
         }
 
-        // Encode FEC blocks
-        if (m_cm256.cm256_encode(cm256Params, descriptorBlocks, fecBlocks))
-        {
-            qDebug("UDPSinkFECWorker::encodeAndTransmit: CM256 encode failed. No transmission.");
-            return;
+        header->m_codec = nbBytes > 0 ? 1 : 0;
+    }
+
+    if ((nbBytes == 0) || !txFrame.m_compression)
+    {
+        if (sampleBits == 16) { // no gain
+            return UDPSinkFEC::m_nbOriginalBlocks;
         }
 
-        // Merge FEC with data to transmit
-        for (int i = 0; i < cm256Params.RecoveryCount; i++)
+        nbBytes = sizeof(UDPSinkFEC::CompressedFrameHeader);
+
+        for (uint32_t i = 1; i < UDPSinkFEC::m_nbOriginalBlocks; i++)
         {
-            txBlockx[i + cm256Params.OriginalCount].protectedBlock = fecBlocks[i];
+            SamplePacker::pack(txBlockx[i].protectedBlock.m_samples, UDPSinkFEC::samplesPerBlock, &buffer[nbBytes], sampleBits, sampleShift);
+            nbBytes += UDPSinkFEC::samplesPerBlock * SamplePacker::getBytesPerSample(sampleBits);
         }
 
-        // Transmit all blocks
+        header->m_codec = 0;
+    }
 
-//        qDebug("UDPSinkFECWorker::encodeAndTransmit: transmit frame with FEC to %s:%d", m_remoteAddress.toStdString().c_str(), m_remotePort);
+    header->m_sampleBits = sampleBits;
+    int nbBlocks = (nbBytes + blockSize - 1) / blockSize;
+    memset((void *) &buffer[nbBytes], 0, nbBlocks * blockSize - nbBytes); // padding of the last block
 
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-        {
+    for (int i = 0; i < nbBlocks; i++) {
+        memcpy((void *) &txBlockx[i + 1].protectedBlock, (const void *) &buffer[i * blockSize], blockSize);
+    }
+
+    return nbBlocks + 1; // with block zero
+}
+
+void UDPSinkFECWorker::transmitBlocks(UDPSinkFEC::SuperBlock *txBlockx, int nbBlocks, uint32_t txDelay)
+{
+    if (!m_remoteResolved) {
+        return;
+    }
+
+    int nbBuffers = 0;
+
+    for (int i = 0; i < nbBlocks; i++)
+    {
 #ifdef SDRDAEMON_PUNCTURE
-            if (i == SDRDAEMON_PUNCTURE) {
-                continue;
-            }
+        if (i == SDRDAEMON_PUNCTURE) {
+            continue;
+        }
 #endif
-//            std::cerr << "UDPSinkFEC::transmitUDP:"
-//                  << " i: " << i
-//                  << " frameIndex: " << (int) m_txBlocks[i].header.frameIndex
-//                  << " blockIndex: " << (int) m_txBlocks[i].header.blockIndex
-//                  << " i.q:";
-//
-//            for (int j = 0; j < 10; j++)
-//            {
-//                std::cerr << " " << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_real
-//                        << "." << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_imag;
-//            }
-//
-//            std::cerr << std::endl;
-
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
+        m_txBuffers[nbBuffers++] = (const void *) &txBlockx[i];
+    }
+
+    int sent = 0;
+
+    try
+    {
+        while (sent < nbBuffers)
+        {
+            int batch = nbBuffers - sent;
+
+            if (txDelay > 0) // token bucket refilled with one datagram every txDelay nanoseconds up to m_txBurst datagrams
+            {
+                qint64 now = m_txTimer.nsecsElapsed();
+                m_txTokens += (double) (now - m_txLastRefill) / txDelay;
+                m_txTokens = m_txTokens > m_txBurst ? m_txBurst : m_txTokens;
+                m_txLastRefill = now;
+
+                if (m_txTokens < 1.0)
+                {
+                    usleep((useconds_t) (((1.0 - m_txTokens) * txDelay) / 1000.0) + 1);
+                    continue;
+                }
+
+                batch = batch < (int) m_txTokens ? batch : (int) m_txTokens;
+                m_txTokens -= batch;
+            }
+
+            m_socket.SendDataGrams(&m_txBuffers[sent], (int) UDPSinkFEC::m_udpSize, batch, m_remoteSockAddr);
+            sent += batch;
         }
     }
+    catch (CSocketException& e)
+    {
+        qWarning("UDPSinkFECWorker::transmitBlocks: %s", e.what());
+    }
 }
@@ -19,11 +19,15 @@
 
 #include <string.h>
 #include <cstddef>
+#include <vector>
 
 #include <QObject>
 #include <QHostAddress>
 #include <QString>
 #include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 
 #include "cm256.h"
 
@@ -31,17 +35,25 @@
 #include "util/CRC64.h"
 #include "util/messagequeue.h"
 #include "util/message.h"
+#include "util/jobpool.h"
 
 #include "UDPSocket.h"
 
+#define UDPSINKFEC_NBTXFRAMES 8 // frames ring size. At most this minus one frames are being encoded or sent.
+
 class UDPSinkFECWorker;
 
 class UDPSinkFEC : public QObject
 {
     Q_OBJECT
 public:
+#ifdef SDRDAEMON_JUMBO
+    static const uint32_t m_udpSize = 8192;         //!< Size of UDP block in number of bytes (jumbo frames)
+#else
     static const uint32_t m_udpSize = 512;          //!< Size of UDP block in number of bytes
+#endif
     static const uint32_t m_nbOriginalBlocks = 128; //!< Number of original blocks in a protected block sequence
+    static const uint8_t m_codecIndicator = 0x10;   //!< Meta data m_sampleBytes indicator: samples are coded with SampleCodec
 #pragma pack(push, 1)
     struct MetaDataFEC
     {
@@ -71,10 +83,18 @@ public:
     {
         uint16_t frameIndex;
         uint8_t  blockIndex;
-        uint8_t  filler;
+        uint8_t  nbOriginalBlocks;    //!< number of original blocks of a compressed frame. 0 for the nominal uncompressed frame.
+    };
+
+    /** Start of the payload of a compressed frame (original blocks 1 and up) */
+    struct CompressedFrameHeader
+    {
+        uint8_t  m_sampleBits;        //!< bits per I or Q value
+        uint8_t  m_codec;             //!< 0: values packed with SamplePacker, 1: SampleCodec
     };
 
     static const int samplesPerBlock = (m_udpSize - sizeof(Header)) / sizeof(Sample);
+    static const int samplesPerFrame = (m_nbOriginalBlocks - 1) * samplesPerBlock; //!< block zero carries meta data only
 
     struct ProtectedBlock
     {
@@ -116,12 +136,26 @@ public:
     void setSampleRate(uint32_t sampleRate) { m_sampleRate = sampleRate; }
 
     void setSampleBytes(uint8_t sampleBytes) { m_sampleBytes = (sampleBytes & 0x0F) + (m_sampleBytes & 0xF0); }
+    /** Bits per I or Q value sent: 16, 12 or 8. Frames are compressed below 16 bits. */
     void setSampleBits(uint8_t sampleBits) { m_sampleBits = sampleBits; }
+    /** Lossless coding of the samples on top of the bit depth reduction */
+    void setCompression(bool compression) { m_sampleBytes = compression ? m_sampleBytes | m_codecIndicator : m_sampleBytes & ~m_codecIndicator; }
 
     void setNbBlocksFEC(uint32_t nbBlocksFEC);
+    /** Set interval in nanoseconds between two UDP datagrams that sets the rate of the transmit token bucket */
     void setTxDelay(uint32_t txDelay);
     void setRemoteAddress(const QString& address, uint16_t port);
 
+    /**
+     * Interval in nanoseconds between two UDP datagrams so that a frame is sent in the txDelay
+     * fraction of its duration at the given sample rate
+     */
+    static uint32_t getTxPeriod(float txDelay, uint32_t sampleRate, uint32_t nbBlocksFEC)
+    {
+        double framePeriod = (samplesPerFrame * 1e9) / (sampleRate == 0 ? 1 : sampleRate);
+        return (uint32_t) ((txDelay * framePeriod) / (m_nbOriginalBlocks + nbBlocksFEC));
+    }
+
     /** Return true if the stream is OK, return false if there is an error. */
     operator bool() const
     {
@@ -145,8 +179,8 @@ private:
 
     MetaDataFEC m_currentMetaFEC;        //!< Meta data for current frame
     uint32_t m_nbBlocksFEC;              //!< Variable number of FEC blocks
-    uint32_t m_txDelay;                  //!< Delay in microseconds (usleep) between each sending of an UDP datagram
-    SuperBlock m_txBlocks[4][256];       //!< UDP blocks to send with original data + FEC
+    uint32_t m_txDelay;                  //!< Interval in nanoseconds between each sending of an UDP datagram
+    SuperBlock m_txBlocks[UDPSINKFEC_NBTXFRAMES][256]; //!< UDP blocks to send with original data + FEC
     SuperBlock m_superBlock;             //!< current super block being built
     int m_txBlockIndex;                  //!< Current index in blocks to transmit in the Tx row
     int m_txBlocksIndex;                 //!< Current index of Tx blocks row
@@ -162,42 +196,6 @@ class UDPSinkFECWorker : public QObject
 {
     Q_OBJECT
 public:
-    class MsgUDPFECEncodeAndSend : public Message
-    {
-        MESSAGE_CLASS_DECLARATION
-    public:
-        UDPSinkFEC::SuperBlock *getTxBlocks() const { return m_txBlockx; }
-        uint32_t getNbBlocsFEC() const { return m_nbBlocksFEC; }
-        uint32_t getTxDelay() const { return m_txDelay; }
-        uint16_t getFrameIndex() const { return m_frameIndex; }
-
-        static MsgUDPFECEncodeAndSend* create(
-                UDPSinkFEC::SuperBlock *txBlocks,
-                uint32_t nbBlocksFEC,
-                uint32_t txDelay,
-                uint16_t frameIndex)
-        {
-            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex);
-        }
-
-    private:
-        UDPSinkFEC::SuperBlock *m_txBlockx;
-        uint32_t m_nbBlocksFEC;
-        uint32_t m_txDelay;
-        uint16_t m_frameIndex;
-
-        MsgUDPFECEncodeAndSend(
-                UDPSinkFEC::SuperBlock *txBlocks,
-                uint32_t nbBlocksFEC,
-                uint32_t txDelay,
-                uint16_t frameIndex) :
-            m_txBlockx(txBlocks),
-            m_nbBlocksFEC(nbBlocksFEC),
-            m_txDelay(txDelay),
-            m_frameIndex(frameIndex)
-        {}
-    };
-
     class MsgConfigureRemoteAddress : public Message
     {
         MESSAGE_CLASS_DECLARATION
@@ -223,10 +221,17 @@ public:
     UDPSinkFECWorker();
     ~UDPSinkFECWorker();
 
+    /**
+     * Queue a complete frame for FEC encoding and transmission. Frames are encoded in parallel
+     * and sent in the order they are pushed. Blocks while UDPSINKFEC_NBTXFRAMES - 1 frames are
+     * in flight so that the next frame of the caller ring can be filled safely.
+     */
     void pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
         uint32_t nbBlocksFEC,
         uint32_t txDelay,
-        uint16_t frameIndex);
+        uint16_t frameIndex,
+        uint8_t sampleBits,
+        bool compression);
     void setRemoteAddress(const QString& address, uint16_t port);
     void stop();
 
@@ -238,18 +243,64 @@ signals:
 public slots:
     void process();
 
-private slots:
-    void handleInputMessages();
-
 private:
-    void encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay);
+    struct TxFrame : public JobPool::Job
+    {
+        UDPSinkFECWorker *m_worker;
+        UDPSinkFEC::SuperBlock *m_txBlocks;
+        uint32_t m_nbBlocksFEC;
+        uint32_t m_txDelay;
+        uint16_t m_frameIndex;
+        uint8_t m_sampleBits;            //!< frame is compressed to this bit depth if less than 16
+        bool m_compression;              //!< frame is compressed with SampleCodec
+        int m_nbOriginalBlocks;          //!< number of original blocks to send after compression
+        bool m_encoded;                  //!< ready to transmit (guarded by m_txMutex)
+        bool m_encodeOK;                 //!< false if FEC encoding failed: frame is not sent
+
+        TxFrame() :
+            m_worker(0),
+            m_txBlocks(0),
+            m_nbBlocksFEC(0),
+            m_txDelay(0),
+            m_frameIndex(0),
+            m_sampleBits(16),
+            m_compression(false),
+            m_nbOriginalBlocks(UDPSinkFEC::m_nbOriginalBlocks),
+            m_encoded(false),
+            m_encodeOK(false)
+        {}
+        virtual void run(int workerIndex) { m_worker->encodeFrame(*this, workerIndex); }
+    };
 
-    bool m_running;
-    CM256 m_cm256;                       //!< CM256 library object
-    bool m_cm256Valid;                   //!< true if CM256 library is initialized correctly
+    void handleInputMessages();
+    void encodeFrame(TxFrame& txFrame, int workerIndex);
+    int compressFrame(TxFrame& txFrame, int workerIndex); //!< Returns the number of original blocks of the frame
+    void transmitBlocks(UDPSinkFEC::SuperBlock *txBlockx, int nbBlocks, uint32_t txDelay);
+
+    static const int m_txBurst = (16384 / UDPSinkFEC::m_udpSize) > 0 ? (16384 / UDPSinkFEC::m_udpSize) : 1; //!< token bucket depth (16 kB)
+
+    volatile bool m_running;
+    JobPool*     m_encoderPool;          //!< FEC encoding workers
+    CM256*       m_cm256;                //!< CM256 library objects one per encoding worker
+    bool         m_cm256Valid;           //!< true if CM256 library is initialized correctly
+    std::vector<UDPSinkFEC::ProtectedBlock> m_fecBlocks; //!< FEC data 256 blocks per encoding worker
+    std::vector<uint8_t> m_compressBuffers; //!< compressed frame payload one per encoding worker
+    TxFrame      m_txFrames[UDPSINKFEC_NBTXFRAMES]; //!< frames in flight
+    int          m_txFrameHead;          //!< next frame to push
+    int          m_txFrameTail;          //!< next frame to transmit
+    int          m_nbTxFrames;           //!< number of frames in flight
+    QMutex       m_txMutex;
+    QWaitCondition m_txFrameEncoded;
+    QWaitCondition m_txFrameFree;
     UDPSocket    m_socket;
     QString      m_remoteAddress;
     uint16_t     m_remotePort;
+    sockaddr_in  m_remoteSockAddr;       //!< remote address resolved once at configuration
+    bool         m_remoteResolved;       //!< true if the remote address could be resolved
+    const void*  m_txBuffers[256];       //!< datagrams of the frame being transmitted
+    QElapsedTimer m_txTimer;             //!< token bucket time base
+    qint64       m_txLastRefill;         //!< time of last token bucket refill in nanoseconds
+    double       m_txTokens;             //!< number of datagrams that can be sent right away
 };
 
 
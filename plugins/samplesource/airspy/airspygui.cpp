@@ -175,6 +175,7 @@ void AirspyGui::updateSampleRateAndFrequency()
 
 void AirspyGui::displaySettings()
 {
+	ui->recordNative->setChecked(m_settings.m_fileRecordNative);
 	ui->centerFrequency->setValue(m_settings.m_centerFrequency / 1000);
 
 	ui->LOppm->setValue(m_settings.m_LOppmTenths);
@@ -366,6 +367,12 @@ void AirspyGui::on_record_toggled(bool checked)
     m_sampleSource->getInputMessageQueue()->push(message);
 }
 
+void AirspyGui::on_recordNative_toggled(bool checked)
+{
+    m_settings.m_fileRecordNative = checked;
+    sendSettings();
+}
+
 void AirspyGui::updateHardware()
 {
 	qDebug() << "AirspyGui::updateHardware";
@@ -87,6 +87,7 @@ private slots:
 	void on_mixAGC_stateChanged(int state);
 	void on_startStop_toggled(bool checked);
     void on_record_toggled(bool checked);
+    void on_recordNative_toggled(bool checked);
 	void updateHardware();
     void updateStatus();
 	void handleSourceMessages();
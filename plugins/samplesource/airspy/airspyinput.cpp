@@ -23,6 +23,7 @@
 
 #include <device/devicesourceapi.h>
 #include <dsp/filerecord.h>
+#include "dsp/samplepacker.h"
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
 #include "airspysettings.h"
@@ -234,9 +235,18 @@ bool AirspyInput::handleMessage(const Message& message)
         MsgFileRecord& conf = (MsgFileRecord&) message;
         qDebug() << "AirspyInput::handleMessage: MsgFileRecord: " << conf.getStartStop();
 
-        if (conf.getStartStop()) {
+        if (conf.getStartStop())
+        {
+            if (m_settings.m_fileRecordNative) {
+                m_fileSink->setRecordFormat(FileRecord::RecordSigMF, 12, SamplePacker::getNativeShift(12));
+            } else {
+                m_fileSink->setRecordFormat(FileRecord::RecordSDRIQ);
+            }
+
             m_fileSink->startRecording();
-        } else {
+        }
+        else
+        {
             m_fileSink->stopRecording();
         }
 
@@ -274,6 +284,8 @@ bool AirspyInput::applySettings(const AirspySettings& settings, bool force)
 
 	qDebug() << "AirspyInput::applySettings";
 
+	m_settings.m_fileRecordNative = settings.m_fileRecordNative; // used when the next recording starts
+
 	if (m_settings.m_dcBlock != settings.m_dcBlock)
 	{
 		m_settings.m_dcBlock = settings.m_dcBlock;
@@ -38,6 +38,7 @@ void AirspySettings::resetToDefaults()
 	m_biasT = false;
 	m_dcBlock = false;
 	m_iqCorrection = false;
+	m_fileRecordNative = false;
 }
 
 QByteArray AirspySettings::serialize() const
@@ -56,6 +57,7 @@ QByteArray AirspySettings::serialize() const
 	s.writeBool(10, m_iqCorrection);
 	s.writeBool(11, m_lnaAGC);
 	s.writeBool(12, m_mixerAGC);
+	s.writeBool(13, m_fileRecordNative);
 
 	return s.final();
 }
@@ -87,6 +89,7 @@ bool AirspySettings::deserialize(const QByteArray& data)
 		d.readBool(10, &m_iqCorrection, false);
 		d.readBool(11, &m_lnaAGC, false);
 		d.readBool(12, &m_mixerAGC, false);
+		d.readBool(13, &m_fileRecordNative, false);
 
 		return true;
 	}
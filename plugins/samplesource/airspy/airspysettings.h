@@ -37,6 +37,7 @@ struct AirspySettings {
 	bool m_biasT;
 	bool m_dcBlock;
 	bool m_iqCorrection;
+	bool m_fileRecordNative; //!< record at the native 12 bit depth in SigMF format instead of .sdriq
 
 	AirspySettings();
 	void resetToDefaults();
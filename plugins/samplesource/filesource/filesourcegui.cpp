@@ -268,6 +268,17 @@ void FileSourceGui::on_play_toggled(bool checked)
 	m_enableNavTime = !checked;
 }
 
+void FileSourceGui::on_acceleration_currentIndexChanged(int index)
+{
+	const int accelerations[] = {1, 2, 5, 10, 20, 50, 0}; // 0 is as fast as possible
+
+	if ((index >= 0) && (index < (int) (sizeof(accelerations)/sizeof(accelerations[0]))))
+	{
+		FileSourceInput::MsgConfigureFileSourceAcceleration* message = FileSourceInput::MsgConfigureFileSourceAcceleration::create(accelerations[index]);
+		m_sampleSource->getInputMessageQueue()->push(message);
+	}
+}
+
 void FileSourceGui::on_navTimeSlider_valueChanged(int value)
 {
 	if (m_enableNavTime && ((value >= 0) && (value <= 100)))
@@ -284,7 +295,7 @@ void FileSourceGui::on_navTimeSlider_valueChanged(int value)
 void FileSourceGui::on_showFileDialog_clicked(bool checked __attribute__((unused)))
 {
 	QString fileName = QFileDialog::getOpenFileName(this,
-	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq)"));
+	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq *.sigmf-meta)"));
 
 	if (fileName != "")
 	{
@@ -83,6 +83,7 @@ private slots:
 	void on_startStop_toggled(bool checked);
 	void on_playLoop_toggled(bool checked);
 	void on_play_toggled(bool checked);
+	void on_acceleration_currentIndexChanged(int index);
 	void on_navTimeSlider_valueChanged(int value);
 	void on_showFileDialog_clicked(bool checked);
     void updateStatus();
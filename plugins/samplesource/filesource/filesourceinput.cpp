@@ -25,6 +25,7 @@
 #include "filesourceinput.h"
 
 #include <dsp/filerecord.h>
+#include "dsp/samplepacker.h"
 
 #include "filesourcethread.h"
 
@@ -32,10 +33,12 @@ MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSource, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceWork, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceSeek, Message)
-MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceStreamTiming, Message)
+MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceSeekTimestamp, Message)
+MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceAcceleration, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(FileSourceInput::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceAcquisition, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(FileSourceInput::MsgReportFileSourceStreamTiming, Message)
 
 FileSourceInput::Settings::Settings() :
 	m_fileName("./test.sdriq")
@@ -74,6 +77,8 @@ bool FileSourceInput::Settings::deserialize(const QByteArray& data)
 
 FileSourceInput::FileSourceInput(const QTimer& masterTimer) :
 	m_settings(),
+	m_sigMF(false),
+	m_dataOffset(0),
 	m_fileSourceThread(NULL),
 	m_deviceDescription(),
 	m_fileName("..."),
@@ -81,6 +86,7 @@ FileSourceInput::FileSourceInput(const QTimer& masterTimer) :
 	m_centerFrequency(0),
 	m_recordLength(0),
 	m_startingTimeStamp(0),
+	m_acceleration(1),
 	m_masterTimer(masterTimer)
 {
 }
@@ -94,22 +100,60 @@ void FileSourceInput::openFileStream()
 {
 	//stopInput();
 
-	if (m_ifstream.is_open()) {
-		m_ifstream.close();
+	if (m_file.isOpen()) {
+		m_file.close();
 	}
 
-	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
-	quint64 fileSize = m_ifstream.tellg();
-	m_ifstream.seekg(0,std::ios_base::beg);
-	FileRecord::Header header;
-	FileRecord::readHeader(m_ifstream, header);
+	m_sigMF = SigMFMeta::isSigMF(m_fileName);
+	quint64 fileSize = 0;
+	uint bytesPerSample = 4;
 
-	m_sampleRate = header.sampleRate;
-	m_centerFrequency = header.centerFrequency;
-	m_startingTimeStamp = header.startTimeStamp;
+	if (m_sigMF)
+	{
+		m_file.setFileName(SigMFMeta::getDataFileName(m_fileName));
+		m_dataOffset = 0;
+
+		if (!m_meta.read(SigMFMeta::getMetaFileName(m_fileName)))
+		{
+			qCritical("FileSourceInput::openFileStream: %s: no valid SigMF metadata", qPrintable(m_fileName));
+			m_meta.clear();
+		}
+		else if (!m_file.open(QIODevice::ReadOnly))
+		{
+			qCritical("FileSourceInput::openFileStream: cannot open %s: %s", qPrintable(m_file.fileName()), qPrintable(m_file.errorString()));
+		}
+
+		bytesPerSample = SamplePacker::getBytesPerSample(m_meta.m_sampleBits);
+		fileSize = m_file.isOpen() ? m_file.size() : 0;
+		m_sampleRate = m_meta.m_sampleRate;
+		m_centerFrequency = m_meta.m_captures.size() > 0 ? m_meta.m_captures.front().m_frequency : 0;
+		m_startingTimeStamp = m_meta.m_captures.size() > 0 ? m_meta.m_captures.front().m_timestampMs / 1000 : 0;
+	}
+	else
+	{
+		m_file.setFileName(m_fileName);
+		m_dataOffset = FileRecord::getHeaderSize();
+		FileRecord::Header header;
+		memset(&header, 0, sizeof(FileRecord::Header));
+
+		if (!m_file.open(QIODevice::ReadOnly))
+		{
+			qCritical("FileSourceInput::openFileStream: cannot open %s: %s", qPrintable(m_fileName), qPrintable(m_file.errorString()));
+		}
+		else if (!FileRecord::readHeader(m_file, header))
+		{
+			qCritical("FileSourceInput::openFileStream: %s: no header", qPrintable(m_fileName));
+			m_file.close();
+		}
+
+		fileSize = m_file.isOpen() ? m_file.size() : 0;
+		m_sampleRate = header.sampleRate;
+		m_centerFrequency = header.centerFrequency;
+		m_startingTimeStamp = header.startTimeStamp;
+	}
 
-	if (fileSize > sizeof(FileRecord::Header)) {
-		m_recordLength = (fileSize - sizeof(FileRecord::Header)) / (4 * m_sampleRate);
+	if ((fileSize > m_dataOffset) && (m_sampleRate > 0)) {
+		m_recordLength = (fileSize - m_dataOffset) / (bytesPerSample * m_sampleRate);
 	} else {
 		m_recordLength = 0;
 	}
@@ -129,25 +173,45 @@ void FileSourceInput::seekFileStream(int seekPercentage)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && !m_fileSourceThread->isRunning())
+	if (m_fileSourceThread != 0)
 	{
-		int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-		m_fileSourceThread->setSamplesCount(seekPoint);
-		seekPoint *= 4; // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		quint64 seekPoint = (m_fileSourceThread->getRecordSamples() * seekPercentage) / 100;
+		m_fileSourceThread->seek(seekPoint);
 	}
 }
 
-bool FileSourceInput::start()
+void FileSourceInput::seekFileStreamTimestamp(quint64 timestampMs)
 {
 	QMutexLocker mutexLocker(&m_mutex);
-	qDebug() << "FileSourceInput::start";
+	quint64 startMs = (quint64) m_startingTimeStamp * 1000LL;
+
+	quint64 sampleIndex;
 
-	if (m_ifstream.tellg() != 0) {
-		m_ifstream.clear();
-		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
+	if ((m_fileSourceThread != 0) && m_sigMF && m_meta.getSampleIndex(timestampMs, sampleIndex))
+	{
+		// the capture segments keep timestamps right across dropped blocks and frequency changes
+		if (sampleIndex < m_fileSourceThread->getRecordSamples()) {
+			m_fileSourceThread->seek(sampleIndex);
+		} else {
+			qWarning("FileSourceInput::seekFileStreamTimestamp: %llu ms is past the end of the record", timestampMs);
+		}
+	}
+	else if ((m_fileSourceThread != 0) && (timestampMs >= startMs))
+	{
+		quint64 seekPoint = ((timestampMs - startMs) * m_sampleRate) / 1000;
+
+		if (seekPoint < m_fileSourceThread->getRecordSamples()) {
+			m_fileSourceThread->seek(seekPoint);
+		} else {
+			qWarning("FileSourceInput::seekFileStreamTimestamp: %llu ms is past the end of the record", timestampMs);
+		}
 	}
+}
+
+bool FileSourceInput::start()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	qDebug() << "FileSourceInput::start";
 
 	if(!m_sampleFifo.setSize(m_sampleRate * 4)) {
 		qCritical("Could not allocate SampleFifo");
@@ -156,13 +220,18 @@ bool FileSourceInput::start()
 
 	//openFileStream();
 
-	if((m_fileSourceThread = new FileSourceThread(&m_ifstream, &m_sampleFifo)) == NULL) {
+	if((m_fileSourceThread = new FileSourceThread(&m_file, m_dataOffset, &m_sampleFifo)) == NULL) {
 		qFatal("out of memory");
 		stop();
 		return false;
 	}
 
+	if (m_sigMF) {
+		m_fileSourceThread->setSampleFormat(m_meta.m_sampleBits, m_meta.m_sampleShift);
+	}
+
 	m_fileSourceThread->setSamplerate(m_sampleRate);
+	m_fileSourceThread->setAcceleration(m_acceleration);
 	m_fileSourceThread->connectTimer(m_masterTimer);
 	m_fileSourceThread->startWork();
 	m_deviceDescription = "FileSource";
@@ -215,12 +284,29 @@ std::time_t FileSourceInput::getStartingTimeStamp() const
 	return m_startingTimeStamp;
 }
 
+QByteArray FileSourceInput::serialize() const
+{
+	return m_settings.serialize();
+}
+
+bool FileSourceInput::deserialize(const QByteArray& data)
+{
+	bool ok = m_settings.deserialize(data);
+
+	// without GUI the file of the preset is opened right away
+	MsgConfigureFileSourceName* message = MsgConfigureFileSourceName::create(m_settings.m_fileName);
+	getInputMessageQueue()->push(message);
+
+	return ok;
+}
+
 bool FileSourceInput::handleMessage(const Message& message)
 {
 	if (MsgConfigureFileSourceName::match(message))
 	{
 		MsgConfigureFileSourceName& conf = (MsgConfigureFileSourceName&) message;
 		m_fileName = conf.getFileName();
+		m_settings.m_fileName = m_fileName;
 		openFileStream();
 		return true;
 	}
@@ -255,6 +341,24 @@ bool FileSourceInput::handleMessage(const Message& message)
 
 		return true;
 	}
+	else if (MsgConfigureFileSourceSeekTimestamp::match(message))
+	{
+		MsgConfigureFileSourceSeekTimestamp& conf = (MsgConfigureFileSourceSeekTimestamp&) message;
+		seekFileStreamTimestamp(conf.getTimestampMs());
+
+		return true;
+	}
+	else if (MsgConfigureFileSourceAcceleration::match(message))
+	{
+		MsgConfigureFileSourceAcceleration& conf = (MsgConfigureFileSourceAcceleration&) message;
+		m_acceleration = conf.getAcceleration();
+
+		if (m_fileSourceThread != 0) {
+			m_fileSourceThread->setAcceleration(m_acceleration);
+		}
+
+		return true;
+	}
 	else if (MsgConfigureFileSourceStreamTiming::match(message))
 	{
 		MsgReportFileSourceStreamTiming *report;
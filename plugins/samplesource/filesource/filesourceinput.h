@@ -20,9 +20,10 @@
 #include <dsp/devicesamplesource.h>
 #include <QString>
 #include <QTimer>
+#include <QFile>
 #include <ctime>
-#include <iostream>
-#include <fstream>
+
+#include "dsp/sigmfmeta.h"
 
 class FileSourceThread;
 
@@ -98,7 +99,7 @@ public:
 	};
 
 	class MsgConfigureFileSourceStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 
@@ -134,6 +135,46 @@ public:
 		{ }
 	};
 
+	class MsgConfigureFileSourceSeekTimestamp : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		quint64 getTimestampMs() const { return m_timestampMs; }
+
+		static MsgConfigureFileSourceSeekTimestamp* create(quint64 timestampMs)
+		{
+			return new MsgConfigureFileSourceSeekTimestamp(timestampMs);
+		}
+
+	protected:
+		quint64 m_timestampMs; //!< absolute time to seek to in milliseconds since epoch
+
+		MsgConfigureFileSourceSeekTimestamp(quint64 timestampMs) :
+			Message(),
+			m_timestampMs(timestampMs)
+		{ }
+	};
+
+	class MsgConfigureFileSourceAcceleration : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		int getAcceleration() const { return m_acceleration; }
+
+		static MsgConfigureFileSourceAcceleration* create(int acceleration)
+		{
+			return new MsgConfigureFileSourceAcceleration(acceleration);
+		}
+
+	protected:
+		int m_acceleration; //!< N times real time or 0 for as fast as possible
+
+		MsgConfigureFileSourceAcceleration(int acceleration) :
+			Message(),
+			m_acceleration(acceleration)
+		{ }
+	};
+
 	class MsgReportFileSourceAcquisition : public Message {
 		MESSAGE_CLASS_DECLARATION
 
@@ -190,7 +231,7 @@ public:
 	};
 
 	class MsgReportFileSourceStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 		std::size_t getSamplesCount() const { return m_samplesCount; }
@@ -222,10 +263,16 @@ public:
 
 	virtual bool handleMessage(const Message& message);
 
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+
 private:
 	QMutex m_mutex;
 	Settings m_settings;
-	std::ifstream m_ifstream;
+	QFile m_file;
+	bool m_sigMF;           //!< SigMF style record with packed samples instead of .sdriq
+	SigMFMeta m_meta;
+	quint64 m_dataOffset;   //!< file offset of the first sample
 	FileSourceThread* m_fileSourceThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -233,10 +280,12 @@ private:
 	quint64 m_centerFrequency;
 	quint32 m_recordLength; //!< record length in seconds computed from file size
 	std::time_t m_startingTimeStamp;
+	int m_acceleration;
 	const QTimer& m_masterTimer;
 
 	void openFileStream();
 	void seekFileStream(int seekPercentage);
+	void seekFileStreamTimestamp(quint64 timestampMs);
 };
 
 #endif // INCLUDE_FILESOURCEINPUT_H
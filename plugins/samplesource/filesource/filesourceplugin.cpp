@@ -20,6 +20,7 @@
 #include "util/simpleserializer.h"
 
 #include "filesourcegui.h"
+#include "filesourceinput.h"
 #include "filesourceplugin.h"
 #include <device/devicesourceapi.h>
 
@@ -82,3 +83,15 @@ PluginInstanceUI* FileSourcePlugin::createSampleSourcePluginInstanceUI(const QSt
 		return NULL;
 	}
 }
+
+DeviceSampleSource* FileSourcePlugin::createSampleSourcePluginInstanceInput(const QString& sourceId, DeviceSourceAPI *deviceAPI __attribute__((unused)), const QTimer& masterTimer)
+{
+	if(sourceId == m_deviceTypeID)
+	{
+		return new FileSourceInput(masterTimer);
+	}
+	else
+	{
+		return NULL;
+	}
+}
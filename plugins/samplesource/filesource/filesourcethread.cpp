@@ -19,24 +19,33 @@
 #include <assert.h>
 #include <QDebug>
 
-#include "dsp/filerecord.h"
 #include "filesourcethread.h"
 #include "dsp/samplesinkfifo.h"
+#include "dsp/samplepacker.h"
 
-FileSourceThread::FileSourceThread(std::ifstream *samplesStream, SampleSinkFifo* sampleFifo, QObject* parent) :
+FileSourceThread::FileSourceThread(QFile *file, quint64 dataOffset, SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
 	m_running(false),
-	m_ifstream(samplesStream),
-	m_buf(0),
-	m_bufsize(0),
-	m_chunksize(0),
+	m_file(file),
+	m_dataOffset(dataOffset),
+	m_dataSize(0),
+	m_sampleBits(16),
+	m_sampleShift(0),
+	m_bytesPerSample(4),
+	m_map(0),
+	m_mapOffset(0),
+	m_mapSize(0),
+	m_position(0),
 	m_sampleFifo(sampleFifo),
-	m_samplesCount(0),
-    m_samplerate(0),
-    m_throttlems(FILESOURCE_THROTTLE_MS),
-    m_throttleToggle(false)
+	m_samplerate(0),
+	m_acceleration(1),
+	m_chunksize(0),
+	m_throttlems(FILESOURCE_THROTTLE_MS),
+	m_throttleToggle(false)
 {
-    assert(m_ifstream != 0);
+	assert(m_file != 0);
+
+	setSampleFormat(16, 0);
 }
 
 FileSourceThread::~FileSourceThread()
@@ -45,8 +54,32 @@ FileSourceThread::~FileSourceThread()
 		stopWork();
 	}
 
-	if (m_buf != 0) {
-		free(m_buf);
+	unmapData();
+}
+
+void FileSourceThread::setSampleFormat(int sampleBits, int sampleShift)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	uint bytesPerSample = SamplePacker::getBytesPerSample(sampleBits);
+
+	if (bytesPerSample == 0)
+	{
+		qWarning("FileSourceThread::setSampleFormat: %d bits not supported", sampleBits);
+		return;
+	}
+
+	m_sampleBits = sampleBits;
+	m_sampleShift = sampleShift;
+	m_bytesPerSample = bytesPerSample;
+	m_dataSize = 0;
+	m_position = 0;
+
+	if (m_file->isOpen() && ((quint64) m_file->size() > m_dataOffset)) {
+		m_dataSize = ((m_file->size() - m_dataOffset) / m_bytesPerSample) * m_bytesPerSample;
+	}
+
+	if (m_sampleBits != 16) {
+		m_unpackBuffer.resize(FILESOURCE_UNPACK_SIZE);
 	}
 }
 
@@ -54,20 +87,20 @@ void FileSourceThread::startWork()
 {
 	qDebug() << "FileSourceThread::startWork: ";
 
-    if (m_ifstream->is_open())
-    {
-        qDebug() << "FileSourceThread::startWork: file stream open, starting...";
-        m_startWaitMutex.lock();
-        m_elapsedTimer.start();
-        start();
-        while(!m_running)
-            m_startWaiter.wait(&m_startWaitMutex, 100);
-        m_startWaitMutex.unlock();
-    }
-    else
-    {
-        qDebug() << "FileSourceThread::startWork: file stream closed, not starting.";
-    }
+	if (m_file->isOpen() && (m_dataSize > 0))
+	{
+		qDebug() << "FileSourceThread::startWork: file open, starting...";
+		m_startWaitMutex.lock();
+		m_elapsedTimer.start();
+		start();
+		while(!m_running)
+			m_startWaiter.wait(&m_startWaitMutex, 100);
+		m_startWaitMutex.unlock();
+	}
+	else
+	{
+		qDebug() << "FileSourceThread::startWork: file closed or empty, not starting.";
+	}
 }
 
 void FileSourceThread::stopWork()
@@ -90,37 +123,29 @@ void FileSourceThread::setSamplerate(int samplerate)
 		}
 
 		m_samplerate = samplerate;
-        // TODO: implement FF and slow motion here. 4 corresponds to live. 2 is half speed, 8 is doulbe speed
-        m_chunksize = (m_samplerate * 4 * m_throttlems) / 1000;
-
-        setBuffer(m_chunksize);
+		m_chunksize = (m_samplerate * m_bytesPerSample * m_throttlems) / 1000;
 	}
+}
 
-	//m_samplerate = samplerate;
+void FileSourceThread::setAcceleration(int acceleration)
+{
+	qDebug() << "FileSourceThread::setAcceleration: " << acceleration;
+	m_acceleration = acceleration < 0 ? 1 : acceleration;
 }
 
-void FileSourceThread::setBuffer(std::size_t chunksize)
+quint64 FileSourceThread::getSamplesCount() const
 {
-    if (chunksize > m_bufsize)
-    {
-        m_bufsize = chunksize;
-
-        if (m_buf == 0)
-        {
-            qDebug() << "FileSourceThread::setBuffer: Allocate buffer";
-            m_buf = (quint8*) malloc(m_bufsize);
-        }
-        else
-        {
-            qDebug() << "FileSourceThread::setBuffer: Re-allocate buffer";
-            quint8 *buf = m_buf;
-            m_buf = (quint8*) realloc((void*) m_buf, m_bufsize);
-            if (!m_buf) free(buf);
-        }
-
-        qDebug() << "FileSourceThread::setBuffer: size: " << m_bufsize
-                << " #samples: " << (m_bufsize/4);
-    }
+	QMutexLocker mutexLocker(&m_mutex);
+	return m_position / m_bytesPerSample;
+}
+
+void FileSourceThread::seek(quint64 sampleIndex)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (m_dataSize > 0) {
+		m_position = (sampleIndex * m_bytesPerSample) % m_dataSize;
+	}
 }
 
 void FileSourceThread::run()
@@ -128,9 +153,22 @@ void FileSourceThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running) // actual work is in the tick() function unless playing as fast as possible
 	{
-		sleep(1);
+		if (m_acceleration == 0)
+		{
+			uint room = m_sampleFifo->size() - m_sampleFifo->fill();
+
+			if (room >= FILESOURCE_ASAP_CHUNK) {
+				writeToFifo((quint64) room * m_bytesPerSample);
+			} else {
+				usleep(1000);
+			}
+		}
+		else
+		{
+			msleep(FILESOURCE_THROTTLE_MS);
+		}
 	}
 
 	m_running = false;
@@ -144,35 +182,95 @@ void FileSourceThread::connectTimer(const QTimer& timer)
 
 void FileSourceThread::tick()
 {
-	if (m_running)
+	if (m_running && (m_acceleration > 0))
+	{
+		qint64 throttlems = m_elapsedTimer.restart();
+
+		if (throttlems != m_throttlems)
+		{
+			m_throttlems = throttlems;
+			m_chunksize = m_bytesPerSample * ((m_samplerate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000);
+			m_throttleToggle = !m_throttleToggle;
+		}
+
+		quint64 size = (quint64) m_chunksize * m_acceleration;
+
+		if (m_acceleration > 1) // faster than real time: do not drop samples
+		{
+			quint64 room = (quint64) (m_sampleFifo->size() - m_sampleFifo->fill()) * m_bytesPerSample;
+			size = size < room ? size : room;
+		}
+
+		writeToFifo(size);
+	}
+}
+
+void FileSourceThread::writeToFifo(quint64 size)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	while (size > 0)
+	{
+		if (m_position >= m_dataSize) {
+			m_position = 0; // loop playback
+		}
+
+		quint64 len = size < m_dataSize - m_position ? size : m_dataSize - m_position;
+		const uchar *data = mapData(m_position, len);
+
+		if (data == 0) {
+			break;
+		}
+
+		if (m_sampleBits == 16) // samples go straight from the mapped file to the FIFO
+		{
+			m_sampleFifo->write(data, (uint) len);
+		}
+		else // unpacked on the fly
+		{
+			for (quint64 i = 0; i < len; i += FILESOURCE_UNPACK_SIZE * m_bytesPerSample)
+			{
+				uint nbSamples = (len - i) / m_bytesPerSample;
+				nbSamples = nbSamples < FILESOURCE_UNPACK_SIZE ? nbSamples : FILESOURCE_UNPACK_SIZE;
+				SamplePacker::unpack(data + i, nbSamples, &m_unpackBuffer[0], m_sampleBits, m_sampleShift);
+				m_sampleFifo->write(m_unpackBuffer.begin(), m_unpackBuffer.begin() + nbSamples);
+			}
+		}
+
+		m_position += len;
+		size -= len;
+	}
+}
+
+const uchar *FileSourceThread::mapData(quint64 position, quint64& size)
+{
+	quint64 offset = m_dataOffset + position;
+
+	if ((m_map == 0) || (offset < m_mapOffset) || (offset + m_bytesPerSample > m_mapOffset + m_mapSize))
+	{
+		unmapData();
+		m_mapOffset = offset;
+		m_mapSize = m_dataOffset + m_dataSize - offset;
+		m_mapSize = m_mapSize < FILESOURCE_MAP_SIZE ? m_mapSize : FILESOURCE_MAP_SIZE;
+		m_map = m_file->map(m_mapOffset, m_mapSize);
+
+		if (m_map == 0)
+		{
+			qCritical("FileSourceThread::mapData: cannot map file: %s", qPrintable(m_file->errorString()));
+			return 0;
+		}
+	}
+
+	quint64 available = ((m_mapOffset + m_mapSize - offset) / m_bytesPerSample) * m_bytesPerSample;
+	size = size < available ? size : available;
+	return m_map + (offset - m_mapOffset);
+}
+
+void FileSourceThread::unmapData()
+{
+	if (m_map != 0)
 	{
-        qint64 throttlems = m_elapsedTimer.restart();
-
-        if (throttlems != m_throttlems)
-        {
-            m_throttlems = throttlems;
-            m_chunksize = 4 * ((m_samplerate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000);
-            m_throttleToggle = !m_throttleToggle;
-            setBuffer(m_chunksize);
-        }
-
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_buf), m_chunksize);
-
-        if (m_ifstream->eof())
-        {
-            m_sampleFifo->write(m_buf, m_ifstream->gcount());
-            // TODO: handle loop playback situation
-    		m_ifstream->clear();
-            m_ifstream->seekg(sizeof(FileRecord::Header), std::ios::beg);
-    		m_samplesCount = 0;
-            //stopWork();
-            //m_ifstream->close();
-        }
-        else
-        {
-            m_sampleFifo->write(m_buf, m_chunksize);
-    		m_samplesCount += m_chunksize / 4;
-        }
+		m_file->unmap(m_map);
+		m_map = 0;
 	}
 }
@@ -22,30 +22,41 @@
 #include <QWaitCondition>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <iostream>
-#include <fstream>
+#include <QFile>
 #include <cstdlib>
 
+#include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfilter.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_MAP_SIZE (64*1024*1024) //!< size of the file window mapped in memory
+#define FILESOURCE_ASAP_CHUNK (1<<16)      //!< minimum room in samples to write to the FIFO when playing as fast as possible
+#define FILESOURCE_UNPACK_SIZE (1<<14)     //!< samples unpacked at once from packed records
 
 class SampleSinkFifo;
 
+/**
+ * Plays a FileRecord file from a memory mapped window of the file directly into the sample FIFO.
+ * Paced by the master timer at N times real time or by the thread itself as fast as the FIFO is
+ * emptied when the acceleration is 0.
+ */
 class FileSourceThread : public QThread {
 	Q_OBJECT
 
 public:
-	FileSourceThread(std::ifstream *samplesStream, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
+	FileSourceThread(QFile *file, quint64 dataOffset, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
 	~FileSourceThread();
 
 	void startWork();
 	void stopWork();
 	void setSamplerate(int samplerate);
-    void setBuffer(std::size_t chunksize);
+	void setAcceleration(int acceleration); //!< N times real time or 0 for as fast as possible
 	bool isRunning() const { return m_running; }
-	std::size_t getSamplesCount() const { return m_samplesCount; }
-	void setSamplesCount(int samplesCount) { m_samplesCount = samplesCount; }
+	quint64 getSamplesCount() const;         //!< position in samples from the start of the record
+	quint64 getRecordSamples() const { return m_dataSize / m_bytesPerSample; }
+	/** Packed records (see SamplePacker). Resets the position so this is done before starting */
+	void setSampleFormat(int sampleBits, int sampleShift);
+	void seek(quint64 sampleIndex);
 
 	void connectTimer(const QTimer& timer);
 
@@ -54,21 +65,32 @@ private:
 	QWaitCondition m_startWaiter;
 	bool m_running;
 
-	std::ifstream* m_ifstream;
-	quint8  *m_buf;
-	std::size_t m_bufsize;
-	std::size_t m_chunksize;
+	QFile* m_file;
+	quint64 m_dataOffset;   //!< file offset of the first sample (header size)
+	quint64 m_dataSize;     //!< bytes of whole samples after the header
+	int m_sampleBits;
+	int m_sampleShift;
+	uint m_bytesPerSample;
+	SampleVector m_unpackBuffer;
+	uchar *m_map;           //!< current mapped window of the file
+	quint64 m_mapOffset;    //!< file offset of the mapped window
+	quint64 m_mapSize;
+	mutable QMutex m_mutex; //!< protects the position and the mapping
+	quint64 m_position;     //!< byte position of the next sample from the start of the data
 	SampleSinkFifo* m_sampleFifo;
-	std::size_t m_samplesCount;
 
 	int m_samplerate;
-    int m_throttlems;
-    QElapsedTimer m_elapsedTimer;
-    bool m_throttleToggle;
+	int m_acceleration;
+	std::size_t m_chunksize;
+	int m_throttlems;
+	QElapsedTimer m_elapsedTimer;
+	bool m_throttleToggle;
 
 	void run();
-	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
-	//void callback(const qint16* buf, qint32 len);
+	void writeToFifo(quint64 size);
+	const uchar *mapData(quint64 position, quint64& size);
+	void unmapData();
+
 private slots:
 	void tick();
 };
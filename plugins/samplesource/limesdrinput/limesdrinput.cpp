@@ -24,6 +24,7 @@
 #include "device/devicesinkapi.h"
 #include "dsp/dspcommands.h"
 #include "dsp/filerecord.h"
+#include "dsp/samplepacker.h"
 #include "limesdrinput.h"
 #include "limesdrinputthread.h"
 #include "limesdr/devicelimesdrparam.h"
@@ -496,9 +497,18 @@ bool LimeSDRInput::handleMessage(const Message& message)
         MsgFileRecord& conf = (MsgFileRecord&) message;
         qDebug() << "LimeSDRInput::handleMessage: MsgFileRecord: " << conf.getStartStop();
 
-        if (conf.getStartStop()) {
+        if (conf.getStartStop())
+        {
+            if (m_settings.m_fileRecordNative) {
+                m_fileSink->setRecordFormat(FileRecord::RecordSigMF, 12, SamplePacker::getNativeShift(12));
+            } else {
+                m_fileSink->setRecordFormat(FileRecord::RecordSDRIQ);
+            }
+
             m_fileSink->startRecording();
-        } else {
+        }
+        else
+        {
             m_fileSink->stopRecording();
         }
 
@@ -630,6 +640,8 @@ bool LimeSDRInput::applySettings(const LimeSDRInputSettings& settings, bool forc
 
     // apply settings
 
+    m_settings.m_fileRecordNative = settings.m_fileRecordNative; // used when the next recording starts
+
     if ((m_settings.m_dcBlock != settings.m_dcBlock) || force)
     {
         m_settings.m_dcBlock = settings.m_dcBlock;
@@ -257,6 +257,7 @@ void LimeSDRInputGUI::updateSampleRateAndFrequency()
 
 void LimeSDRInputGUI::displaySettings()
 {
+    ui->recordNative->setChecked(m_settings.m_fileRecordNative);
     ui->centerFrequency->setValue(m_settings.m_centerFrequency / 1000);
     ui->sampleRate->setValue(m_settings.m_devSampleRate);
 
@@ -419,6 +420,12 @@ void LimeSDRInputGUI::on_record_toggled(bool checked)
     m_sampleSource->getInputMessageQueue()->push(message);
 }
 
+void LimeSDRInputGUI::on_recordNative_toggled(bool checked)
+{
+    m_settings.m_fileRecordNative = checked;
+    sendSettings();
+}
+
 void LimeSDRInputGUI::on_centerFrequency_changed(quint64 value)
 {
     m_settings.m_centerFrequency = value * 1000;
@@ -75,6 +75,7 @@ private slots:
 
     void on_startStop_toggled(bool checked);
     void on_record_toggled(bool checked);
+    void on_recordNative_toggled(bool checked);
     void on_centerFrequency_changed(quint64 value);
     void on_ncoFrequency_changed(quint64 value);
     void on_ncoEnable_toggled(bool checked);
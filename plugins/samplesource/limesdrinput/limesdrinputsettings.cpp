@@ -41,6 +41,7 @@ void LimeSDRInputSettings::resetToDefaults()
     m_lnaGain = 15;
     m_tiaGain = 2;
     m_pgaGain = 16;
+    m_fileRecordNative = false;
 }
 
 QByteArray LimeSDRInputSettings::serialize() const
@@ -63,6 +64,7 @@ QByteArray LimeSDRInputSettings::serialize() const
     s.writeU32(15, m_lnaGain);
     s.writeU32(16, m_tiaGain);
     s.writeU32(17, m_pgaGain);
+    s.writeBool(18, m_fileRecordNative);
 
     return s.final();
 }
@@ -99,6 +101,7 @@ bool LimeSDRInputSettings::deserialize(const QByteArray& data)
         d.readU32(15, &m_lnaGain, 15);
         d.readU32(16, &m_tiaGain, 2);
         d.readU32(17, &m_pgaGain, 16);
+        d.readBool(18, &m_fileRecordNative, false);
 
         return true;
     }
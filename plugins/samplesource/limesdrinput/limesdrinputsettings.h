@@ -66,6 +66,7 @@ struct LimeSDRInputSettings
     uint32_t m_lnaGain;      //!< Manual LAN gain
     uint32_t m_tiaGain;      //!< Manual TIA gain
     uint32_t m_pgaGain;      //!< Manual PGA gain
+    bool     m_fileRecordNative; //!< record at the native 12 bit depth in SigMF format instead of .sdriq
 
     LimeSDRInputSettings();
     void resetToDefaults();
@@ -220,6 +220,7 @@ void RTLSDRGui::displayGains()
 
 void RTLSDRGui::displaySettings()
 {
+	ui->recordNative->setChecked(m_settings.m_fileRecordNative);
 	ui->centerFrequency->setValue(m_settings.m_centerFrequency / 1000);
 	ui->sampleRate->setValue(m_settings.m_devSampleRate);
 	ui->dcOffset->setChecked(m_settings.m_dcBlock);
@@ -330,6 +331,12 @@ void RTLSDRGui::on_record_toggled(bool checked)
     m_sampleSource->getInputMessageQueue()->push(message);
 }
 
+void RTLSDRGui::on_recordNative_toggled(bool checked)
+{
+    m_settings.m_fileRecordNative = checked;
+    sendSettings();
+}
+
 void RTLSDRGui::queryDeviceReport()
 {
     RTLSDRInput::MsgQueryRTLSDR* message = RTLSDRInput::MsgQueryRTLSDR::create();
@@ -83,6 +83,7 @@ private slots:
     void on_agc_stateChanged(int state);
 	void on_startStop_toggled(bool checked);
     void on_record_toggled(bool checked);
+    void on_recordNative_toggled(bool checked);
 	void updateHardware();
 	void updateStatus();
 	void handleSourceMessages();
@@ -27,6 +27,7 @@
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
 #include "dsp/filerecord.h"
+#include "dsp/samplepacker.h"
 
 MESSAGE_CLASS_DEFINITION(RTLSDRInput::MsgConfigureRTLSDR, Message)
 MESSAGE_CLASS_DEFINITION(RTLSDRInput::MsgQueryRTLSDR, Message)
@@ -229,6 +230,29 @@ quint64 RTLSDRInput::getCenterFrequency() const
 	return m_settings.m_centerFrequency;
 }
 
+QByteArray RTLSDRInput::serialize() const
+{
+	return m_settings.serialize();
+}
+
+bool RTLSDRInput::deserialize(const QByteArray& data)
+{
+	RTLSDRSettings settings;
+	bool ok = settings.deserialize(data); // defaults if the data is not valid
+
+	// applied right away so that a following setCenterFrequency starts from these settings
+	applySettings(settings, false);
+
+	return ok;
+}
+
+void RTLSDRInput::setCenterFrequency(qint64 centerFrequency)
+{
+	RTLSDRSettings settings = m_settings;
+	settings.m_centerFrequency = centerFrequency;
+	applySettings(settings, false);
+}
+
 bool RTLSDRInput::handleMessage(const Message& message)
 {
     if (MsgConfigureRTLSDR::match(message))
@@ -260,9 +284,18 @@ bool RTLSDRInput::handleMessage(const Message& message)
         MsgFileRecord& conf = (MsgFileRecord&) message;
         qDebug() << "RTLSDRInput::handleMessage: MsgFileRecord: " << conf.getStartStop();
 
-        if (conf.getStartStop()) {
+        if (conf.getStartStop())
+        {
+            if (m_settings.m_fileRecordNative) {
+                m_fileSink->setRecordFormat(FileRecord::RecordSigMF, 8, SamplePacker::getNativeShift(8));
+            } else {
+                m_fileSink->setRecordFormat(FileRecord::RecordSDRIQ);
+            }
+
             m_fileSink->startRecording();
-        } else {
+        }
+        else
+        {
             m_fileSink->stopRecording();
         }
 
@@ -303,6 +336,8 @@ bool RTLSDRInput::applySettings(const RTLSDRSettings& settings, bool force)
         }
     }
 
+    m_settings.m_fileRecordNative = settings.m_fileRecordNative; // used when the next recording starts
+
     if ((m_settings.m_dcBlock != settings.m_dcBlock) || force)
     {
         m_settings.m_dcBlock = settings.m_dcBlock;
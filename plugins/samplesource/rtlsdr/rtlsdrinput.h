@@ -116,6 +116,10 @@ public:
 
 	virtual bool handleMessage(const Message& message);
 
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
 	const std::vector<int>& getGains() const { return m_gains; }
 	void set_ds_mode(int on);
 
@@ -8,6 +8,7 @@
 #include <device/devicesourceapi.h>
 
 #include "rtlsdrgui.h"
+#include "rtlsdrinput.h"
 
 const PluginDescriptor RTLSDRPlugin::m_pluginDescriptor = {
 	QString("RTL-SDR Input"),
@@ -72,3 +73,15 @@ PluginInstanceUI* RTLSDRPlugin::createSampleSourcePluginInstanceUI(const QString
 		return NULL;
 	}
 }
+
+DeviceSampleSource* RTLSDRPlugin::createSampleSourcePluginInstanceInput(const QString& sourceId, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer __attribute__((unused)))
+{
+	if(sourceId == m_deviceTypeID)
+	{
+		return new RTLSDRInput(deviceAPI);
+	}
+	else
+	{
+		return NULL;
+	}
+}
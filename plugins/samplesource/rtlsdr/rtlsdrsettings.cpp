@@ -35,6 +35,7 @@ void RTLSDRSettings::resetToDefaults()
 	m_dcBlock = false;
 	m_iqImbalance = false;
 	m_agc = false;
+	m_fileRecordNative = false;
 }
 
 QByteArray RTLSDRSettings::serialize() const
@@ -50,6 +51,7 @@ QByteArray RTLSDRSettings::serialize() const
     s.writeS32(8, m_devSampleRate);
     s.writeBool(9, m_lowSampleRate);
     s.writeBool(10, m_agc);
+    s.writeBool(11, m_fileRecordNative);
 
 	return s.final();
 }
@@ -78,6 +80,7 @@ bool RTLSDRSettings::deserialize(const QByteArray& data)
         d.readS32(8, &m_devSampleRate, 1024*1000);
         d.readBool(9, &m_lowSampleRate, false);
         d.readBool(10, &m_agc, false);
+        d.readBool(11, &m_fileRecordNative, false);
 
 		return true;
 	}
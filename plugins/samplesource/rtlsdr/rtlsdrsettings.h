@@ -34,6 +34,7 @@ struct RTLSDRSettings {
 	bool m_dcBlock;
 	bool m_iqImbalance;
 	bool m_agc;
+	bool m_fileRecordNative; //!< record at the native 8 bit depth in SigMF format instead of .sdriq
 
 	RTLSDRSettings();
 	void resetToDefaults();
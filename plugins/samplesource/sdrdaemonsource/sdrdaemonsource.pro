@@ -40,14 +40,16 @@ sdrdaemonsourcegui.cpp\
 sdrdaemonsourceinput.cpp\
 sdrdaemonsourcesettings.cpp\
 sdrdaemonsourceplugin.cpp\
-sdrdaemonsourceudphandler.cpp
+sdrdaemonsourceudphandler.cpp\
+sdrdaemonsourceudpthread.cpp
 
 HEADERS += sdrdaemonsourcebuffer.h\
 sdrdaemonsourcegui.h\
 sdrdaemonsourceinput.h\
 sdrdaemonsourcesettings.h\
 sdrdaemonsourceplugin.h\
-sdrdaemonsourceudphandler.h
+sdrdaemonsourceudphandler.h\
+sdrdaemonsourceudpthread.h
 
 FORMS += sdrdaemonsourcegui.ui
 
@@ -20,6 +20,8 @@
 #include <cmath>
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
+#include "dsp/samplecodec.h"
+#include "dsp/samplepacker.h"
 #include "sdrdaemonsourcebuffer.h"
 
 
@@ -45,7 +47,8 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer(uint32_t throttlems) :
         m_nbReads(0),
         m_nbWrites(0),
         m_balCorrection(0),
-	    m_balCorrLimit(0)
+	    m_balCorrLimit(0),
+	    m_nbDecodePending(0)
 {
 	m_currentMeta.init();
 	m_framesNbBytes = nbDecoderSlots * sizeof(BufferFrame);
@@ -53,19 +56,35 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer(uint32_t throttlems) :
 	m_tvOut_sec = 0;
 	m_tvOut_usec = 0;
 	m_readNbBytes = 1;
-    m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
-    m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
 
-    if (!m_cm256.isInitialized()) {
-        m_cm256_OK = false;
+    m_decoderPool = new JobPool();
+    m_cm256 = new CM256[m_decoderPool->getNbWorkers()];
+    m_cm256_OK = true;
+
+    for (int i = 0; i < m_decoderPool->getNbWorkers(); i++) {
+        m_cm256_OK = m_cm256_OK && m_cm256[i].isInitialized();
+    }
+
+    if (!m_cm256_OK) {
         qDebug() << "SDRdaemonSourceBuffer::SDRdaemonSourceBuffer: cannot initialize CM256 library";
-    } else {
-        m_cm256_OK = true;
     }
+
+    for (int i = 0; i < nbDecoderSlots; i++)
+    {
+        m_decodeJobs[i].m_buffer = this;
+        m_decodeJobs[i].m_slotIndex = i;
+        m_decodeJobs[i].m_params.BlockBytes = sizeof(ProtectedBlock); // never changes
+        m_decodePending[i] = false;
+    }
+
+    initDecodeAllSlots();
 }
 
 SDRdaemonSourceBuffer::~SDRdaemonSourceBuffer()
 {
+    delete m_decoderPool; // joins the workers before the slots and codecs go away
+    delete[] m_cm256;
+
 	if (m_readBuffer) {
 		delete[] m_readBuffer;
 	}
@@ -75,6 +94,8 @@ void SDRdaemonSourceBuffer::initDecodeAllSlots()
 {
     for (int i = 0; i < nbDecoderSlots; i++)
     {
+        waitDecoded(i);
+        m_decoderSlots[i].m_frameOriginalBlocks = m_nbOriginalBlocks;
         m_decoderSlots[i].m_blockCount = 0;
         m_decoderSlots[i].m_originalCount = 0;
         m_decoderSlots[i].m_recoveryCount = 0;
@@ -87,10 +108,13 @@ void SDRdaemonSourceBuffer::initDecodeAllSlots()
 
 void SDRdaemonSourceBuffer::initDecodeSlot(int slotIndex)
 {
-    // collect stats before voiding the slot
+    waitDecoded(slotIndex);
 
-    m_curNbBlocks = m_decoderSlots[slotIndex].m_blockCount;
-    m_curOriginalBlocks = m_decoderSlots[slotIndex].m_originalCount;
+    // collect stats before voiding the slot. Blocks saved by compression count as received.
+
+    int compressionSaving = m_nbOriginalBlocks - m_decoderSlots[slotIndex].m_frameOriginalBlocks;
+    m_curNbBlocks = m_decoderSlots[slotIndex].m_blockCount + compressionSaving;
+    m_curOriginalBlocks = m_decoderSlots[slotIndex].m_originalCount + compressionSaving;
     m_curNbRecovery = m_decoderSlots[slotIndex].m_recoveryCount;
     m_avgNbBlocks(m_curNbBlocks);
     m_avgOrigBlocks(m_curOriginalBlocks);
@@ -111,6 +135,7 @@ void SDRdaemonSourceBuffer::initDecodeSlot(int slotIndex)
 
     // void the slot
 
+    m_decoderSlots[slotIndex].m_frameOriginalBlocks = m_nbOriginalBlocks;
     m_decoderSlots[slotIndex].m_blockCount = 0;
     m_decoderSlots[slotIndex].m_originalCount = 0;
     m_decoderSlots[slotIndex].m_recoveryCount = 0;
@@ -213,7 +238,16 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
     // Block processing
 
-    if (m_decoderSlots[decoderIndex].m_blockCount < m_nbOriginalBlocks) // not enough blocks to decode -> store data
+    if (m_decoderSlots[decoderIndex].m_blockCount == 0) // first block of the frame gives its size
+    {
+        int nbOriginalBlocks = superBlock->header.nbOriginalBlocks;
+        m_decoderSlots[decoderIndex].m_frameOriginalBlocks = (nbOriginalBlocks > 1) && (nbOriginalBlocks < m_nbOriginalBlocks) ?
+                nbOriginalBlocks : m_nbOriginalBlocks;
+    }
+
+    int frameOriginalBlocks = m_decoderSlots[decoderIndex].m_frameOriginalBlocks;
+
+    if (m_decoderSlots[decoderIndex].m_blockCount < frameOriginalBlocks) // not enough blocks to decode -> store data
     {
         int blockIndex = superBlock->header.blockIndex;
         int blockCount = m_decoderSlots[decoderIndex].m_blockCount;
@@ -225,7 +259,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
             m_decoderSlots[decoderIndex].m_metaRetrieved = true;
         }
 
-        if (blockIndex < m_nbOriginalBlocks) // original data
+        if (blockIndex < frameOriginalBlocks) // original data
         {
             m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, superBlock->protectedBlock);
             m_decoderSlots[decoderIndex].m_originalCount++;
@@ -240,65 +274,32 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
     m_decoderSlots[decoderIndex].m_blockCount++;
 
-    if (m_decoderSlots[decoderIndex].m_blockCount == m_nbOriginalBlocks) // ready to decode
+    if (m_decoderSlots[decoderIndex].m_blockCount == frameOriginalBlocks) // ready to decode
     {
         m_decoderSlots[decoderIndex].m_decoded = true;
 
-        if (m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0)) // recovery data used => need to decode FEC
+        // recovery data used => decode FEC, compressed => expand samples. Done in the decoder pool.
+        if ((m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0)) || (frameOriginalBlocks < m_nbOriginalBlocks))
         {
-            m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
-            m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
+            DecodeJob& job = m_decodeJobs[decoderIndex];
+            job.m_params.OriginalCount = frameOriginalBlocks;
 
             if (m_decoderSlots[decoderIndex].m_metaRetrieved) {
-                m_paramsCM256.RecoveryCount = m_currentMeta.m_nbFECBlocks;
+                job.m_params.RecoveryCount = m_currentMeta.m_nbFECBlocks;
             } else {
-                m_paramsCM256.RecoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
+                job.m_params.RecoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
             }
 
-            if (m_cm256.cm256_decode(m_paramsCM256, m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks)) // CM256 decode
-            {
-                qDebug() << "SDRdaemonSourceBuffer::writeData: decode CM256 error:"
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
-            }
-            else
-            {
-                qDebug() << "SDRdaemonSourceBuffer::writeData: decode CM256 success:"
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
-
-                for (int ir = 0; ir < m_decoderSlots[decoderIndex].m_recoveryCount; ir++) // restore missing blocks
-                {
-                    int recoveryIndex = m_nbOriginalBlocks - m_decoderSlots[decoderIndex].m_recoveryCount + ir;
-                    int blockIndex = m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
-                    ProtectedBlock *recoveredBlock = (ProtectedBlock *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
-
-                    if (blockIndex == 0) // first block with meta
-                    {
-                        MetaDataFEC *metaData = (MetaDataFEC *) recoveredBlock;
-
-                        boost::crc_32_type crc32;
-                        crc32.process_bytes(metaData, 20);
-
-                        if (crc32.checksum() == metaData->m_crc32)
-                        {
-                            m_decoderSlots[decoderIndex].m_metaRetrieved = true;
-                            printMeta("SDRdaemonSourceBuffer::writeData: recovered meta", metaData);
-                        }
-                        else
-                        {
-                            qDebug() << "SDRdaemonSourceBuffer::writeData: recovered meta: invalid CRC32";
-                        }
-                    }
-
-                    storeOriginalBlock(decoderIndex, blockIndex, *recoveredBlock);
-
-                    qDebug() << "SDRdaemonSourceBuffer::writeData: recovered block #" << blockIndex;
-                } // restore missing blocks
-            } // CM256 decode
+            m_decodeMutex.lock();
+            m_decodePending[decoderIndex] = true;
+            m_nbDecodePending.fetchAndAddRelease(1);
+            m_decodeMutex.unlock();
+            m_decoderPool->push(&job);
         } // revovery
 
-        if (m_decoderSlots[decoderIndex].m_metaRetrieved) // block zero with its meta data has been received
+        // block zero with its meta data has been received. Meta data recovered by FEC is only checked
+        // in the decoder pool as the current meta cannot wait for the decoding.
+        if (m_decoderSlots[decoderIndex].m_metaRetrieved)
         {
             MetaDataFEC *metaData = getMetaData(decoderIndex);
 
@@ -320,6 +321,119 @@ void SDRdaemonSourceBuffer::writeData(char *array)
     } // decode
 }
 
+void SDRdaemonSourceBuffer::decodeSlot(DecodeJob& job, int workerIndex)
+{
+    DecoderSlot& slot = m_decoderSlots[job.m_slotIndex];
+    bool complete = true;
+
+    if (slot.m_recoveryCount > 0)
+    {
+        if (!m_cm256_OK || m_cm256[workerIndex].cm256_decode(job.m_params, slot.m_cm256DescriptorBlocks)) // CM256 decode
+        {
+            qDebug() << "SDRdaemonSourceBuffer::decodeSlot: decode CM256 error:"
+                    << " m_originalCount: " << slot.m_originalCount
+                    << " m_recoveryCount: " << slot.m_recoveryCount;
+            complete = false;
+        }
+        else
+        {
+            qDebug() << "SDRdaemonSourceBuffer::decodeSlot: decode CM256 success:"
+                    << " m_originalCount: " << slot.m_originalCount
+                    << " m_recoveryCount: " << slot.m_recoveryCount;
+
+            for (int ir = 0; ir < slot.m_recoveryCount; ir++) // restore missing blocks
+            {
+                int recoveryIndex = slot.m_frameOriginalBlocks - slot.m_recoveryCount + ir;
+                int blockIndex = slot.m_cm256DescriptorBlocks[recoveryIndex].Index;
+                ProtectedBlock *recoveredBlock = (ProtectedBlock *) slot.m_cm256DescriptorBlocks[recoveryIndex].Block;
+
+                if (blockIndex == 0) // first block with meta
+                {
+                    MetaDataFEC *metaData = (MetaDataFEC *) recoveredBlock;
+
+                    boost::crc_32_type crc32;
+                    crc32.process_bytes(metaData, 20);
+
+                    if (crc32.checksum() == metaData->m_crc32) {
+                        printMeta("SDRdaemonSourceBuffer::decodeSlot: recovered meta", metaData);
+                    } else {
+                        qDebug() << "SDRdaemonSourceBuffer::decodeSlot: recovered meta: invalid CRC32";
+                    }
+                }
+
+                storeOriginalBlock(job.m_slotIndex, blockIndex, *recoveredBlock);
+
+                qDebug() << "SDRdaemonSourceBuffer::decodeSlot: recovered block #" << blockIndex;
+            } // restore missing blocks
+        } // CM256 decode
+    }
+
+    if (complete && (slot.m_frameOriginalBlocks < m_nbOriginalBlocks) && !uncompressFrame(job.m_slotIndex))
+    {
+        qDebug() << "SDRdaemonSourceBuffer::decodeSlot: invalid compressed frame";
+        memset((void *) m_frames[job.m_slotIndex].m_blocks, 0, (m_nbOriginalBlocks - 1) * sizeof(ProtectedBlock));
+    }
+
+    QMutexLocker mutexLocker(&m_decodeMutex);
+    m_decodePending[job.m_slotIndex] = false;
+    m_nbDecodePending.fetchAndAddRelease(-1);
+    m_decodeDone.wakeAll();
+}
+
+bool SDRdaemonSourceBuffer::uncompressFrame(int slotIndex)
+{
+    const uint8_t *payload = (const uint8_t *) &m_decoderSlots[slotIndex].m_originalBlocks[1];
+    uint payloadSize = (m_decoderSlots[slotIndex].m_frameOriginalBlocks - 1) * sizeof(ProtectedBlock);
+    const CompressedFrameHeader *header = (const CompressedFrameHeader *) payload;
+    ::Sample *samples = (::Sample *) m_frames[slotIndex].m_blocks; // same layout as our 16 bit I/Q samples
+    int sampleBits = header->m_sampleBits;
+    uint bytesPerSample = SamplePacker::getBytesPerSample(sampleBits);
+    uint position = sizeof(CompressedFrameHeader);
+
+    if (bytesPerSample == 0) {
+        return false;
+    }
+
+    for (int i = 0; i < m_nbOriginalBlocks - 1; i++) // blocks are coded independently
+    {
+        if (header->m_codec == 1)
+        {
+            uint nbBytes = SampleCodec::decode(&payload[position], payloadSize - position,
+                    &samples[i * samplesPerBlock], samplesPerBlock, sampleBits, 16 - sampleBits);
+
+            if (nbBytes == 0) {
+                return false;
+            }
+
+            position += nbBytes;
+        }
+        else
+        {
+            if (position + samplesPerBlock * bytesPerSample > payloadSize) {
+                return false;
+            }
+
+            SamplePacker::unpack(&payload[position], samplesPerBlock, &samples[i * samplesPerBlock], sampleBits, 16 - sampleBits);
+            position += samplesPerBlock * bytesPerSample;
+        }
+    }
+
+    return true;
+}
+
+void SDRdaemonSourceBuffer::waitDecoded(int slotIndex)
+{
+    if (m_nbDecodePending.loadAcquire() == 0) { // nothing in the decoder pool
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_decodeMutex);
+
+    while (m_decodePending[slotIndex]) {
+        m_decodeDone.wait(&m_decodeMutex);
+    }
+}
+
 void SDRdaemonSourceBuffer::writeData0(char *array __attribute__((unused)), uint32_t length __attribute__((unused)))
 {
 // Kept as comments for the out of sync blocks algorithms
@@ -405,6 +519,11 @@ uint8_t *SDRdaemonSourceBuffer::readData(int32_t length)
         length = framesSize;
     }
 
+    // frames still being recovered by FEC in the decoder pool must be complete before they are read
+    for (int i = m_readIndex / sizeof(BufferFrame); i <= (int) ((m_readIndex + length - 1) / sizeof(BufferFrame)); i++) {
+        waitDecoded(i % nbDecoderSlots);
+    }
+
     if (m_readIndex + length < m_framesNbBytes) // ends before buffer bound
     {
         m_readIndex += length;
@@ -19,12 +19,20 @@
 
 #include <QString>
 #include <QDebug>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
 #include <cstdlib>
 #include "cm256.h"
 #include "util/movingaverage.h"
+#include "util/jobpool.h"
 
 
+#ifdef SDRDAEMON_JUMBO
+#define SDRDAEMONSOURCE_UDPSIZE 8192              // UDP payload size (jumbo frames)
+#else
 #define SDRDAEMONSOURCE_UDPSIZE 512               // UDP payload size
+#endif
 #define SDRDAEMONSOURCE_NBORIGINALBLOCKS 128      // number of sample blocks per frame excluding FEC blocks
 #define SDRDAEMONSOURCE_NBDECODERSLOTS 16         // power of two sub multiple of uint16_t size. A too large one is superfluous.
 
@@ -65,10 +73,18 @@ public:
     {
         uint16_t frameIndex;
         uint8_t  blockIndex;
-        uint8_t  filler;
+        uint8_t  nbOriginalBlocks;    //!< number of original blocks of a compressed frame. 0 for the nominal uncompressed frame.
+    };
+
+    /** Start of the payload of a compressed frame (original blocks 1 and up) */
+    struct CompressedFrameHeader
+    {
+        uint8_t  m_sampleBits;        //!< bits per I or Q value
+        uint8_t  m_codec;             //!< 0: values packed with SamplePacker, 1: SampleCodec
     };
 
     static const int samplesPerBlock = (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header)) / sizeof(Sample);
+    static const int samplesPerFrame = (SDRDAEMONSOURCE_NBORIGINALBLOCKS - 1) * samplesPerBlock; //!< block zero carries meta data only
     static const int framesSize = SDRDAEMONSOURCE_NBDECODERSLOTS * (SDRDAEMONSOURCE_NBORIGINALBLOCKS - 1) * (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header));
 
     struct ProtectedBlock
@@ -158,6 +174,7 @@ public:
 
     static const int m_udpPayloadSize = SDRDAEMONSOURCE_UDPSIZE;
     static const int m_nbOriginalBlocks = SDRDAEMONSOURCE_NBORIGINALBLOCKS;
+    static const uint8_t m_codecIndicator = 0x10; //!< Meta data m_sampleBytes indicator: samples are coded with SampleCodec
 	static const int m_sampleSize;
 	static const int m_iqSampleSize;
 
@@ -174,9 +191,10 @@ private:
     struct DecoderSlot
     {
         ProtectedBlock       m_blockZero;                                 //!< First block of a frame. Has meta data.
-        ProtectedBlock       m_originalBlocks[m_nbOriginalBlocks];        //!< Original blocks retrieved directly or by later FEC
+        ProtectedBlock       m_originalBlocks[m_nbOriginalBlocks];        //!< Original blocks of a compressed frame retrieved directly or by later FEC
         ProtectedBlock       m_recoveryBlocks[m_nbOriginalBlocks];        //!< Recovery blocks (FEC blocks) with max size
         CM256::cm256_block   m_cm256DescriptorBlocks[m_nbOriginalBlocks]; //!< CM256 decoder descriptors (block addresses and block indexes)
+        int                  m_frameOriginalBlocks; //!< number of original blocks of the frame. Less than nominal when compressed.
         int                  m_blockCount;         //!< number of blocks received for this frame
         int                  m_originalCount;      //!< number of original blocks received
         int                  m_recoveryCount;      //!< number of recovery blocks received
@@ -184,8 +202,17 @@ private:
         bool                 m_metaRetrieved;      //!< true if meta data (block zero) was retrieved
     };
 
+    /** FEC decoding of one slot run in the decoder pool */
+    struct DecodeJob : public JobPool::Job
+    {
+        SDRdaemonSourceBuffer      *m_buffer;
+        int                         m_slotIndex;
+        CM256::cm256_encoder_params m_params;
+
+        virtual void run(int workerIndex) { m_buffer->decodeSlot(*this, workerIndex); }
+    };
+
     MetaDataFEC          m_currentMeta;          //!< Stored current meta data
-    CM256::cm256_encoder_params m_paramsCM256;          //!< CM256 decoder parameters block
     DecoderSlot          m_decoderSlots[nbDecoderSlots]; //!< CM256 decoding control/buffer slots
     BufferFrame          m_frames[nbDecoderSlots];       //!< Samples buffer
     int                  m_framesNbBytes;                //!< Number of bytes in samples buffer
@@ -217,9 +244,16 @@ private:
     int      m_nbWrites;      //!< Number of buffer writes since start of auto R/W balance correction period
     int      m_balCorrection; //!< R/W balance correction in number of samples
     int      m_balCorrLimit;  //!< Correction absolute value limit in number of samples
-    CM256    m_cm256;         //!< CM256 library
+    JobPool* m_decoderPool;   //!< Decodes the frames with recovery blocks off the receiving thread
+    CM256*   m_cm256;         //!< CM256 library. One instance per decoder pool worker.
     bool     m_cm256_OK;      //!< CM256 library initialized OK
 
+    DecodeJob      m_decodeJobs[nbDecoderSlots];
+    bool           m_decodePending[nbDecoderSlots]; //!< slot FEC decoding is queued or running
+    QAtomicInt     m_nbDecodePending;               //!< number of slots pending decode (fast path of waitDecoded)
+    QMutex         m_decodeMutex;
+    QWaitCondition m_decodeDone;
+
     inline ProtectedBlock* storeOriginalBlock(int slotIndex, int blockIndex, const ProtectedBlock& protectedBlock)
     {
         if (blockIndex == 0) {
@@ -227,6 +261,9 @@ private:
             // return &m_decoderSlots[slotIndex].m_originalBlocks[0];
             m_decoderSlots[slotIndex].m_blockZero = protectedBlock;
             return &m_decoderSlots[slotIndex].m_blockZero;
+        } else if (m_decoderSlots[slotIndex].m_frameOriginalBlocks < m_nbOriginalBlocks) { // compressed: expanded in the samples buffer once complete
+            m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
+            return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
         } else {
             // m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
             // return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
@@ -264,6 +301,9 @@ private:
     void rwCorrectionEstimate(int slotIndex);
     void checkSlotData(int slotIndex);
     void initDecodeSlot(int slotIndex);
+    void decodeSlot(DecodeJob& job, int workerIndex);
+    bool uncompressFrame(int slotIndex); //!< Expand the compressed payload of the slot in the samples buffer
+    void waitDecoded(int slotIndex);  //!< Wait for the pending FEC decoding of the slot if any
 
     static void printMeta(const QString& header, MetaDataFEC *metaData);
 };
@@ -39,6 +39,7 @@
 
 #include <device/devicesourceapi.h>
 #include "sdrdaemonsourcegui.h"
+#include "sdrdaemonsourcebuffer.h"
 
 SDRdaemonSourceGui::SDRdaemonSourceGui(DeviceSourceAPI *deviceAPI, QWidget* parent) :
 	QWidget(parent),
@@ -54,6 +55,7 @@ SDRdaemonSourceGui::SDRdaemonSourceGui(DeviceSourceAPI *deviceAPI, QWidget* pare
     m_bufferGauge(-50),
 	m_nbOriginalBlocks(128),
     m_nbFECBlocks(0),
+    m_nbDatagramsDropped(0),
     m_samplesCount(0),
     m_tickCount(0),
     m_address("127.0.0.1"),
@@ -231,6 +233,7 @@ bool SDRdaemonSourceGui::handleMessage(const Message& message)
         m_avgNbOriginalBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getAvgNbOriginalBlocks();
         m_avgNbRecovery = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getAvgNbRecovery();
         m_nbOriginalBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getNbOriginalBlocksPerFrame();
+        m_nbDatagramsDropped = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getNbDatagramsDropped();
 
         int nbFECBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getNbFECBlocksPerFrame();
 
@@ -300,7 +303,7 @@ void SDRdaemonSourceGui::updateTxDelay()
     if (m_sampleRate == 0) {
         m_txDelay = 0.0; // 0 value will not set the Tx delay
     } else {
-        m_txDelay = ((127*127*m_settings.m_txDelay) / m_sampleRate)/(128 + m_nbFECBlocks);
+        m_txDelay = ((SDRdaemonSourceBuffer::samplesPerFrame*m_settings.m_txDelay) / m_sampleRate)/(SDRdaemonSourceBuffer::m_nbOriginalBlocks + m_nbFECBlocks);
     }
 
     ui->txDelayText->setToolTip(tr("%1 us").arg(QString::number(m_txDelay*1e6, 'f', 0)));
@@ -718,6 +721,8 @@ void SDRdaemonSourceGui::updateWithStreamTime()
     QString s1 = QString("%1").arg(m_nbFECBlocks, 2, 10, QChar('0'));
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s).arg(s1));
 
+    ui->nbDatagramsDroppedText->setText(tr("%1").arg(m_nbDatagramsDropped));
+
     if (updateEventCounts)
     {
         displayEventCounts();
@@ -77,6 +77,7 @@ private:
     float m_avgNbRecovery;
     int m_nbOriginalBlocks;
     int m_nbFECBlocks;
+    uint32_t m_nbDatagramsDropped;
 
 	int m_samplesCount;
 	std::size_t m_tickCount;
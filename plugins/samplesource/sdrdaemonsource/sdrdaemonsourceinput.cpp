@@ -32,10 +32,10 @@ MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonSource, Mess
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonUDPLink, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonAutoCorr, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonWork, Message)
-MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SDRdaemonSourceInput::MsgConfigureSDRdaemonStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgReportSDRdaemonAcquisition, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamData, Message)
-MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(SDRdaemonSourceInput::MsgFileRecord, Message)
 
 SDRdaemonSourceInput::SDRdaemonSourceInput(const QTimer& masterTimer, DeviceSourceAPI *deviceAPI) :
@@ -111,6 +111,30 @@ void SDRdaemonSourceInput::getRemoteAddress(QString &s)
 	}
 }
 
+QByteArray SDRdaemonSourceInput::serialize() const
+{
+    return m_settings.serialize();
+}
+
+bool SDRdaemonSourceInput::deserialize(const QByteArray& data)
+{
+    bool ok = m_settings.deserialize(data);
+
+    // the remote daemon control (center frequency, rate, FEC) is sent by the GUI only.
+    // Without GUI the daemon has to be configured on its side.
+    MsgConfigureSDRdaemonUDPLink* linkMessage = MsgConfigureSDRdaemonUDPLink::create(m_settings.m_address, m_settings.m_dataPort);
+    getInputMessageQueue()->push(linkMessage);
+    MsgConfigureSDRdaemonAutoCorr* corrMessage = MsgConfigureSDRdaemonAutoCorr::create(m_settings.m_dcBlock, m_settings.m_iqCorrection);
+    getInputMessageQueue()->push(corrMessage);
+
+    return ok;
+}
+
+void SDRdaemonSourceInput::setCenterFrequency(qint64 centerFrequency)
+{
+    m_settings.m_centerFrequency = centerFrequency;
+}
+
 
 bool SDRdaemonSourceInput::handleMessage(const Message& message)
 {
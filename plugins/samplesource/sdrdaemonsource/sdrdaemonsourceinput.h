@@ -121,7 +121,7 @@ public:
 	};
 
 	class MsgConfigureSDRdaemonStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 
@@ -187,7 +187,7 @@ public:
 	};
 
 	class MsgReportSDRdaemonSourceStreamTiming : public Message {
-		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED_DECLARATION
 
 	public:
 		uint32_t get_tv_sec() const { return m_tv_sec; }
@@ -204,6 +204,7 @@ public:
         float getAvgNbRecovery() const { return m_avgNbRecovery; }
         int getNbOriginalBlocksPerFrame() const { return m_nbOriginalBlocksPerFrame; }
         int getNbFECBlocksPerFrame() const { return m_nbFECBlocksPerFrame; }
+        uint32_t getNbDatagramsDropped() const { return m_nbDatagramsDropped; }
 
 		static MsgReportSDRdaemonSourceStreamTiming* create(uint32_t tv_sec,
 				uint32_t tv_usec,
@@ -218,7 +219,8 @@ public:
                 float avgNbOriginalBlocks,
                 float avgNbRecovery,
                 int nbOriginalBlocksPerFrame,
-                int nbFECBlocksPerFrame)
+                int nbFECBlocksPerFrame,
+                uint32_t nbDatagramsDropped)
 		{
 			return new MsgReportSDRdaemonSourceStreamTiming(tv_sec,
 					tv_usec,
@@ -233,7 +235,8 @@ public:
                     avgNbOriginalBlocks,
                     avgNbRecovery,
                     nbOriginalBlocksPerFrame,
-                    nbFECBlocksPerFrame);
+                    nbFECBlocksPerFrame,
+                    nbDatagramsDropped);
 		}
 
 	protected:
@@ -251,6 +254,7 @@ public:
         float    m_avgNbRecovery;
         int      m_nbOriginalBlocksPerFrame;
         int      m_nbFECBlocksPerFrame;
+        uint32_t m_nbDatagramsDropped; //!< datagrams dropped by the kernel since start
 
 		MsgReportSDRdaemonSourceStreamTiming(uint32_t tv_sec,
 				uint32_t tv_usec,
@@ -265,7 +269,8 @@ public:
                 float avgNbOriginalBlocks,
                 float avgNbRecovery,
                 int nbOriginalBlocksPerFrame,
-                int nbFECBlocksPerFrame) :
+                int nbFECBlocksPerFrame,
+                uint32_t nbDatagramsDropped) :
 			Message(),
 			m_tv_sec(tv_sec),
 			m_tv_usec(tv_usec),
@@ -280,7 +285,8 @@ public:
             m_avgNbOriginalBlocks(avgNbOriginalBlocks),
             m_avgNbRecovery(avgNbRecovery),
             m_nbOriginalBlocksPerFrame(nbOriginalBlocksPerFrame),
-            m_nbFECBlocksPerFrame(nbFECBlocksPerFrame)
+            m_nbFECBlocksPerFrame(nbFECBlocksPerFrame),
+            m_nbDatagramsDropped(nbDatagramsDropped)
 		{ }
 	};
 
@@ -317,8 +323,13 @@ public:
 
 	virtual bool handleMessage(const Message& message);
 
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
 private:
 	DeviceSourceAPI *m_deviceAPI;
+	SDRdaemonSourceSettings m_settings; //!< only used without GUI
 	QMutex m_mutex;
 	QString m_address;
 	quint16 m_port;
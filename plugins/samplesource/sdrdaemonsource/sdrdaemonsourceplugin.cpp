@@ -22,6 +22,7 @@
 #include <device/devicesourceapi.h>
 
 #include "sdrdaemonsourcegui.h"
+#include "sdrdaemonsourceinput.h"
 #include "sdrdaemonsourceplugin.h"
 
 const PluginDescriptor SDRdaemonSourcePlugin::m_pluginDescriptor = {
@@ -83,3 +84,15 @@ PluginInstanceUI* SDRdaemonSourcePlugin::createSampleSourcePluginInstanceUI(cons
 		return NULL;
 	}
 }
+
+DeviceSampleSource* SDRdaemonSourcePlugin::createSampleSourcePluginInstanceInput(const QString& sourceId, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer)
+{
+	if(sourceId == m_deviceTypeID)
+	{
+		return new SDRdaemonSourceInput(masterTimer, deviceAPI);
+	}
+	else
+	{
+		return NULL;
+	}
+}
@@ -37,6 +37,7 @@ public:
 
 	virtual SamplingDevices enumSampleSources();
 	virtual PluginInstanceUI* createSampleSourcePluginInstanceUI(const QString& sourceId, QWidget **widget, DeviceSourceAPI *deviceAPI);
+	virtual DeviceSampleSource* createSampleSourcePluginInstanceInput(const QString& sourceId, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer);
 
 	static const QString m_hardwareID;
     static const QString m_deviceTypeID;
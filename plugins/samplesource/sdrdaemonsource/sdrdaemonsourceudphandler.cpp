@@ -14,7 +14,6 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QUdpSocket>
 #include <QDebug>
 #include <QTimer>
 #include <unistd.h>
@@ -25,17 +24,15 @@
 
 #include "sdrdaemonsourceinput.h"
 #include "sdrdaemonsourceudphandler.h"
+#include "sdrdaemonsourceudpthread.h"
 
 SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo, MessageQueue *outputMessageQueueToGUI, DeviceSourceAPI *devieAPI) :
     m_deviceAPI(devieAPI),
 	m_sdrDaemonBuffer(m_rateDivider),
-	m_dataSocket(0),
+	m_udpThread(0),
 	m_dataAddress(QHostAddress::LocalHost),
-	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
 	m_dataConnected(false),
-	m_udpBuf(0),
-	m_udpReadBytes(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
 	m_centerFrequency(0),
@@ -52,13 +49,13 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_rateDivider(1000/SDRDAEMONSOURCE_THROTTLE_MS),
 	m_autoCorrBuffer(true)
 {
-    m_udpBuf = new char[SDRdaemonSourceBuffer::m_udpPayloadSize];
+    m_udpThread = new SDRdaemonSourceUDPThread(&m_sdrDaemonBuffer, &m_bufferMutex);
 }
 
 SDRdaemonSourceUDPHandler::~SDRdaemonSourceUDPHandler()
 {
 	stop();
-	delete[] m_udpBuf;
+	delete m_udpThread;
 #ifdef USE_INTERNAL_TIMER
     if (m_timer) {
         delete m_timer;
@@ -70,16 +67,9 @@ void SDRdaemonSourceUDPHandler::start()
 {
 	qDebug("SDRdaemonSourceUDPHandler::start");
 
-	if (!m_dataSocket)
-	{
-		m_dataSocket = new QUdpSocket(this);
-	}
-
     if (!m_dataConnected)
 	{
-        connect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()), Qt::QueuedConnection); // , Qt::QueuedConnection
-
-        if (m_dataSocket->bind(m_dataAddress, m_dataPort))
+        if (m_udpThread->startWork(m_dataAddress, m_dataPort))
 		{
 			qDebug("SDRdaemonSourceUDPHandler::start: bind data socket to %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
 			m_dataConnected = true;
@@ -87,7 +77,6 @@ void SDRdaemonSourceUDPHandler::start()
 		else
 		{
 			qWarning("SDRdaemonSourceUDPHandler::start: cannot bind data port %d", m_dataPort);
-	        disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
 			m_dataConnected = false;
 		}
 	}
@@ -105,14 +94,13 @@ void SDRdaemonSourceUDPHandler::stop()
     if (m_dataConnected)
     {
 		m_dataConnected = false;
-	    disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
+		m_udpThread->stopWork();
 	}
+}
 
-	if (m_dataSocket)
-	{
-		delete m_dataSocket;
-		m_dataSocket = 0;
-	}
+void SDRdaemonSourceUDPHandler::getRemoteAddress(QString& s) const
+{
+    s = m_udpThread->getRemoteAddress().toString();
 }
 
 void SDRdaemonSourceUDPHandler::configureUDPLink(const QString& address, quint16 port)
@@ -131,25 +119,8 @@ void SDRdaemonSourceUDPHandler::configureUDPLink(const QString& address, quint16
 	start();
 }
 
-void SDRdaemonSourceUDPHandler::dataReadyRead()
-{
-    m_udpReadBytes = 0;
-
-	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
-	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
-
-		if (m_udpReadBytes == SDRdaemonSourceBuffer::m_udpPayloadSize) {
-		    processData();
-		    m_udpReadBytes = 0;
-		}
-	}
-}
-
 void SDRdaemonSourceUDPHandler::processData()
 {
-    m_sdrDaemonBuffer.writeData(m_udpBuf);
     const SDRdaemonSourceBuffer::MetaDataFEC& metaData =  m_sdrDaemonBuffer.getCurrentMeta();
 
     bool change = false;
@@ -201,6 +172,11 @@ void SDRdaemonSourceUDPHandler::connectTimer(const QTimer* timer)
 
 void SDRdaemonSourceUDPHandler::tick()
 {
+    QMutexLocker mutexLocker(&m_bufferMutex);
+
+    // meta data changes from the blocks written by the UDP thread since last tick
+    processData();
+
     // auto throttling
     int throttlems = m_elapsedTimer.restart();
 
@@ -257,7 +233,8 @@ void SDRdaemonSourceUDPHandler::tick()
             m_sdrDaemonBuffer.getAvgOriginalBlocks(),
             m_sdrDaemonBuffer.getAvgNbRecovery(),
             nbOriginalBlocks,
-            nbFECblocks);
+            nbFECblocks,
+            m_udpThread->getNbDatagramsDropped());
             m_outputMessageQueueToGUI->push(report);
 	}
 }
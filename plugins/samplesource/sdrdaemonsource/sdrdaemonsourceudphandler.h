@@ -18,7 +18,6 @@
 #define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPHANDLER_H_
 
 #include <QObject>
-#include <QUdpSocket>
 #include <QHostAddress>
 #include <QMutex>
 #include <QElapsedTimer>
@@ -27,6 +26,7 @@
 
 #define SDRDAEMONSOURCE_THROTTLE_MS 50
 
+class SDRdaemonSourceUDPThread;
 class SampleSinkFifo;
 class MessageQueue;
 class QTimer;
@@ -42,21 +42,17 @@ public:
 	void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
-	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
+	void getRemoteAddress(QString& s) const;
     int getNbOriginalBlocks() const { return SDRdaemonSourceBuffer::m_nbOriginalBlocks; }
-public slots:
-	void dataReadyRead();
 
 private:
 	DeviceSourceAPI *m_deviceAPI;
 	SDRdaemonSourceBuffer m_sdrDaemonBuffer;
-	QUdpSocket *m_dataSocket;
+	QMutex m_bufferMutex;              //!< buffer is written by the UDP thread and read on tick
+	SDRdaemonSourceUDPThread *m_udpThread;
 	QHostAddress m_dataAddress;
-	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
-	char *m_udpBuf;
-	qint64 m_udpReadBytes;
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
 	uint32_t m_centerFrequency;
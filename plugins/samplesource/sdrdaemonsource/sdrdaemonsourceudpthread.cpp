@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDebug>
+#include <QUdpSocket>
+
+#ifdef __linux__
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+#include "sdrdaemonsourceudpthread.h"
+
+SDRdaemonSourceUDPThread::SDRdaemonSourceUDPThread(SDRdaemonSourceBuffer *sdrDaemonBuffer, QMutex *bufferMutex, QObject* parent) :
+    QThread(parent),
+    m_running(false),
+    m_startDone(false),
+    m_bound(false),
+    m_sdrDaemonBuffer(sdrDaemonBuffer),
+    m_bufferMutex(bufferMutex),
+    m_address(QHostAddress::LocalHost),
+    m_port(9090),
+    m_remoteAddress(0),
+    m_nbDatagramsDropped(0),
+    m_blocks(SDRDAEMONSOURCE_RECV_BATCH)
+{
+}
+
+SDRdaemonSourceUDPThread::~SDRdaemonSourceUDPThread()
+{
+    if (m_running) {
+        stopWork();
+    }
+}
+
+bool SDRdaemonSourceUDPThread::startWork(const QHostAddress& address, quint16 port)
+{
+    qDebug("SDRdaemonSourceUDPThread::startWork: %s:%d", qPrintable(address.toString()), port);
+    m_address = address;
+    m_port = port;
+    m_nbDatagramsDropped.storeRelease(0);
+
+    m_startWaitMutex.lock();
+    m_startDone = false;
+    start();
+
+    while (!m_startDone) { // woken up by run() once the socket is bound or has failed to bind
+        m_startWaiter.wait(&m_startWaitMutex);
+    }
+
+    bool bound = m_bound;
+    m_startWaitMutex.unlock();
+
+    if (!bound) {
+        wait();
+    }
+
+    return bound;
+}
+
+void SDRdaemonSourceUDPThread::stopWork()
+{
+    qDebug("SDRdaemonSourceUDPThread::stopWork");
+    m_running = false;
+    wait();
+}
+
+#ifdef __linux__
+
+bool SDRdaemonSourceUDPThread::bindSocket(int& sock)
+{
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (sock < 0)
+    {
+        qWarning("SDRdaemonSourceUDPThread::bindSocket: cannot create socket: %s", strerror(errno));
+        return false;
+    }
+
+    int rcvbuf = SDRDAEMONSOURCE_RCVBUF;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    int one = 1;
+    setsockopt(sock, SOL_SOCKET, SO_RXQ_OVFL, &one, sizeof(one)); // kernel drop count in ancillary data
+    timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = SDRDAEMONSOURCE_RECV_TIMEOUT_MS * 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    if (m_address.protocol() != QAbstractSocket::IPv4Protocol) {
+        qWarning("SDRdaemonSourceUDPThread::bindSocket: %s is not IPv4. Bind to any address.", qPrintable(m_address.toString()));
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(m_port);
+    addr.sin_addr.s_addr = htonl(m_address.toIPv4Address());
+
+    if (bind(sock, (const sockaddr *) &addr, sizeof(addr)) < 0)
+    {
+        qWarning("SDRdaemonSourceUDPThread::bindSocket: cannot bind data port %d: %s", m_port, strerror(errno));
+        close(sock);
+        return false;
+    }
+
+    return true;
+}
+
+void SDRdaemonSourceUDPThread::run()
+{
+    int sock = -1;
+
+    m_startWaitMutex.lock();
+    m_bound = bindSocket(sock);
+    m_running = m_bound;
+    m_startDone = true;
+    m_startWaiter.wakeAll();
+    m_startWaitMutex.unlock();
+
+    if (!m_bound) {
+        return;
+    }
+
+    mmsghdr msgs[SDRDAEMONSOURCE_RECV_BATCH];
+    iovec iovecs[SDRDAEMONSOURCE_RECV_BATCH];
+    sockaddr_in addrs[SDRDAEMONSOURCE_RECV_BATCH];
+    char controls[SDRDAEMONSOURCE_RECV_BATCH][CMSG_SPACE(sizeof(uint32_t))];
+
+    while (m_running)
+    {
+        memset(msgs, 0, sizeof(msgs));
+
+        for (int i = 0; i < SDRDAEMONSOURCE_RECV_BATCH; i++)
+        {
+            iovecs[i].iov_base = (void *) &m_blocks[i];
+            iovecs[i].iov_len = sizeof(SDRdaemonSourceBuffer::SuperBlock);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = (void *) &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            msgs[i].msg_hdr.msg_control = (void *) controls[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        }
+
+        // wait for the first datagram (until timeout) then take what is already queued
+        int nbReceived = recvmmsg(sock, msgs, SDRDAEMONSOURCE_RECV_BATCH, MSG_WAITFORONE, 0);
+
+        if (nbReceived < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+                continue;
+            }
+
+            qWarning("SDRdaemonSourceUDPThread::run: receive failed: %s", strerror(errno));
+            break;
+        }
+
+        m_bufferMutex->lock();
+
+        for (int i = 0; i < nbReceived; i++)
+        {
+            if ((msgs[i].msg_len == sizeof(SDRdaemonSourceBuffer::SuperBlock)) && ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) == 0)) {
+                m_sdrDaemonBuffer->writeData((char *) &m_blocks[i]);
+            }
+        }
+
+        m_bufferMutex->unlock();
+
+        if (nbReceived > 0)
+        {
+            msghdr *last = &msgs[nbReceived - 1].msg_hdr;
+            m_remoteAddress.storeRelease((int) ntohl(addrs[nbReceived - 1].sin_addr.s_addr));
+
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(last); cmsg != 0; cmsg = CMSG_NXTHDR(last, cmsg))
+            {
+                if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL))
+                {
+                    uint32_t nbDropped;
+                    memcpy(&nbDropped, CMSG_DATA(cmsg), sizeof(nbDropped));
+                    m_nbDatagramsDropped.storeRelease((int) nbDropped);
+                }
+            }
+        }
+    }
+
+    close(sock);
+    m_running = false;
+}
+
+#else // no recvmmsg: blocking reads of one datagram at a time in this thread
+
+void SDRdaemonSourceUDPThread::run()
+{
+    QUdpSocket socket;
+
+    m_startWaitMutex.lock();
+    m_bound = socket.bind(m_address, m_port);
+    m_running = m_bound;
+    m_startDone = true;
+    m_startWaiter.wakeAll();
+    m_startWaitMutex.unlock();
+
+    if (!m_bound)
+    {
+        qWarning("SDRdaemonSourceUDPThread::run: cannot bind data port %d", m_port);
+        return;
+    }
+
+    socket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, SDRDAEMONSOURCE_RCVBUF);
+
+    while (m_running)
+    {
+        if (!socket.waitForReadyRead(SDRDAEMONSOURCE_RECV_TIMEOUT_MS)) {
+            continue;
+        }
+
+        m_bufferMutex->lock();
+
+        while (socket.hasPendingDatagrams())
+        {
+            QHostAddress remoteAddress;
+            qint64 pendingDataSize = socket.pendingDatagramSize();
+            qint64 readBytes = socket.readDatagram((char *) &m_blocks[0], sizeof(SDRdaemonSourceBuffer::SuperBlock), &remoteAddress, 0);
+
+            if ((pendingDataSize == sizeof(SDRdaemonSourceBuffer::SuperBlock)) && (readBytes == pendingDataSize))
+            {
+                m_sdrDaemonBuffer->writeData((char *) &m_blocks[0]);
+                m_remoteAddress.storeRelease((int) remoteAddress.toIPv4Address());
+            }
+        }
+
+        m_bufferMutex->unlock();
+    }
+
+    m_running = false;
+}
+
+#endif
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+#define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHostAddress>
+#include <QAtomicInt>
+
+#include "sdrdaemonsourcebuffer.h"
+
+#define SDRDAEMONSOURCE_RECV_BATCH 64     // maximum number of datagrams received at once
+#define SDRDAEMONSOURCE_RECV_TIMEOUT_MS 100 // receive timeout to check for stop request
+#define SDRDAEMONSOURCE_RCVBUF (4*1024*1024) // requested socket receive buffer size
+
+/**
+ * Receives the UDP blocks in its own thread so that reception does not depend on the
+ * GUI event loop. Datagrams are read in batches (recvmmsg on Linux) and written to the
+ * decoder slots of the buffer under the buffer mutex shared with the reading side.
+ */
+class SDRdaemonSourceUDPThread : public QThread
+{
+    Q_OBJECT
+public:
+    SDRdaemonSourceUDPThread(SDRdaemonSourceBuffer *sdrDaemonBuffer, QMutex *bufferMutex, QObject* parent = 0);
+    ~SDRdaemonSourceUDPThread();
+
+    /** Bind to address and port and start receiving. Returns false if the socket cannot be bound */
+    bool startWork(const QHostAddress& address, quint16 port);
+    void stopWork();
+
+    QHostAddress getRemoteAddress() const { return QHostAddress((quint32) m_remoteAddress.loadAcquire()); }
+    /** Number of datagrams dropped by the kernel for lack of room in the socket buffer since start */
+    uint32_t getNbDatagramsDropped() const { return (uint32_t) m_nbDatagramsDropped.loadAcquire(); }
+
+private:
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+    bool m_startDone;
+    bool m_bound;
+
+    SDRdaemonSourceBuffer *m_sdrDaemonBuffer;
+    QMutex *m_bufferMutex;
+    QHostAddress m_address;
+    quint16 m_port;
+    QAtomicInt m_remoteAddress;       //!< IPv4 address of the last datagram source
+    QAtomicInt m_nbDatagramsDropped;
+    std::vector<SDRdaemonSourceBuffer::SuperBlock> m_blocks; //!< batch of received blocks
+
+    void run();
+#ifdef __linux__
+    bool bindSocket(int& sock);
+#endif
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_ */
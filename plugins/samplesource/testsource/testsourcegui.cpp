@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QMessageBox>
+
+#include "testsourcegui.h"
+
+#include <device/devicesourceapi.h>
+
+#include "ui_testsourcegui.h"
+#include "gui/colormapper.h"
+#include "gui/glspectrum.h"
+#include "dsp/dspengine.h"
+#include "dsp/dspcommands.h"
+
+TestSourceGui::TestSourceGui(DeviceSourceAPI *deviceAPI, QWidget* parent) :
+	QWidget(parent),
+	ui(new Ui::TestSourceGui),
+	m_deviceAPI(deviceAPI),
+	m_settings(),
+	m_sampleSource(0),
+	m_sampleRate(0),
+	m_deviceCenterFrequency(0),
+	m_lastEngineState((DSPDeviceSourceEngine::State)-1)
+{
+	m_sampleSource = new TestSourceInput(m_deviceAPI);
+	m_deviceAPI->setSource(m_sampleSource);
+
+	ui->setupUi(this);
+	ui->centerFrequency->setColorMapper(ColorMapper(ColorMapper::GrayGold));
+	ui->centerFrequency->setValueRange(7, 0, 9999999U);
+
+	ui->sampleRate->setColorMapper(ColorMapper(ColorMapper::GrayGreenYellow));
+	ui->sampleRate->setValueRange(8, 1000U, 99999999U);
+
+	connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateHardware()));
+	connect(&m_statusTimer, SIGNAL(timeout()), this, SLOT(updateStatus()));
+	m_statusTimer.start(500);
+
+	displaySettings();
+
+	connect(m_sampleSource->getOutputMessageQueueToGUI(), SIGNAL(messageEnqueued()), this, SLOT(handleSourceMessages()));
+	connect(m_deviceAPI->getDeviceOutputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleDSPMessages()), Qt::QueuedConnection);
+
+	sendSettings();
+}
+
+TestSourceGui::~TestSourceGui()
+{
+	delete ui;
+	delete m_sampleSource;
+}
+
+void TestSourceGui::destroy()
+{
+	delete this;
+}
+
+void TestSourceGui::setName(const QString& name)
+{
+	setObjectName(name);
+}
+
+QString TestSourceGui::getName() const
+{
+	return objectName();
+}
+
+void TestSourceGui::resetToDefaults()
+{
+	m_settings.resetToDefaults();
+	displaySettings();
+	sendSettings();
+}
+
+qint64 TestSourceGui::getCenterFrequency() const
+{
+	return m_settings.m_centerFrequency;
+}
+
+void TestSourceGui::setCenterFrequency(qint64 centerFrequency)
+{
+	m_settings.m_centerFrequency = centerFrequency;
+	displaySettings();
+	sendSettings();
+}
+
+QByteArray TestSourceGui::serialize() const
+{
+	return m_settings.serialize();
+}
+
+bool TestSourceGui::deserialize(const QByteArray& data)
+{
+	if (m_settings.deserialize(data))
+	{
+		displaySettings();
+		sendSettings();
+		return true;
+	}
+	else
+	{
+		resetToDefaults();
+		return false;
+	}
+}
+
+bool TestSourceGui::handleMessage(const Message& message)
+{
+	if (TestSourceInput::MsgReportTestSource::match(message))
+	{
+		TestSourceInput::MsgReportTestSource& report = (TestSourceInput::MsgReportTestSource&) message;
+		ui->sustainedRateText->setText(tr("%1k").arg(QString::number(report.getSustainedRate() / 1000.0, 'f', 0)));
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+void TestSourceGui::handleDSPMessages()
+{
+	Message* message;
+
+	while ((message = m_deviceAPI->getDeviceOutputMessageQueue()->pop()) != 0)
+	{
+		qDebug("TestSourceGui::handleDSPMessages: message: %s", message->getIdentifier());
+
+		if (DSPSignalNotification::match(*message))
+		{
+			DSPSignalNotification* notif = (DSPSignalNotification*) message;
+			m_sampleRate = notif->getSampleRate();
+			m_deviceCenterFrequency = notif->getCenterFrequency();
+			qDebug("TestSourceGui::handleDSPMessages: SampleRate:%d, CenterFrequency:%llu", notif->getSampleRate(), notif->getCenterFrequency());
+			updateSampleRateAndFrequency();
+
+			delete message;
+		}
+	}
+}
+
+void TestSourceGui::handleSourceMessages()
+{
+	Message* message;
+
+	while ((message = m_sampleSource->getOutputMessageQueueToGUI()->pop()) != 0)
+	{
+		if (handleMessage(*message))
+		{
+			delete message;
+		}
+	}
+}
+
+void TestSourceGui::updateSampleRateAndFrequency()
+{
+	m_deviceAPI->getSpectrum()->setSampleRate(m_sampleRate);
+	m_deviceAPI->getSpectrum()->setCenterFrequency(m_deviceCenterFrequency);
+	ui->deviceRateText->setText(tr("%1k").arg(QString::number(m_sampleRate / 1000.0f, 'g', 5)));
+}
+
+void TestSourceGui::displaySettings()
+{
+	ui->centerFrequency->setValue(m_settings.m_centerFrequency / 1000);
+	ui->sampleRate->setValue(m_settings.m_sampleRate);
+	ui->freeRun->setChecked(m_settings.m_freeRun);
+	ui->signalType->setCurrentIndex((int) m_settings.m_signalType);
+	ui->shift->setValue(m_settings.m_frequencyShift);
+	ui->amplitude->setValue(m_settings.m_amplitudeDb);
+	ui->amplitudeText->setText(tr("%1").arg(m_settings.m_amplitudeDb));
+	ui->noise->setValue(m_settings.m_noiseDb);
+	ui->noiseText->setText(m_settings.m_noiseDb <= TESTSOURCE_NOISE_OFF_DB ? tr("off") : tr("%1").arg(m_settings.m_noiseDb));
+	ui->modFrequency->setValue(m_settings.m_modulationFrequency);
+	ui->amModulation->setValue(m_settings.m_amModulation);
+	ui->fmDeviation->setValue(m_settings.m_fmDeviation);
+	ui->chirpSpan->setValue(m_settings.m_chirpSpan);
+	ui->chirpPeriod->setValue(m_settings.m_chirpPeriodMs);
+	ui->dcOffset->setChecked(m_settings.m_dcBlock);
+	ui->iqImbalance->setChecked(m_settings.m_iqImbalance);
+	displaySignalControls();
+}
+
+void TestSourceGui::displaySignalControls()
+{
+	bool modulated = (m_settings.m_signalType == TestSourceSettings::SignalAM)
+			|| (m_settings.m_signalType == TestSourceSettings::SignalFM)
+			|| (m_settings.m_signalType == TestSourceSettings::SignalUSB)
+			|| (m_settings.m_signalType == TestSourceSettings::SignalLSB);
+	bool chirp = m_settings.m_signalType == TestSourceSettings::SignalChirp;
+
+	ui->modFrequency->setEnabled(modulated);
+	ui->amModulation->setEnabled(m_settings.m_signalType == TestSourceSettings::SignalAM);
+	ui->fmDeviation->setEnabled(m_settings.m_signalType == TestSourceSettings::SignalFM);
+	ui->chirpSpan->setEnabled(chirp);
+	ui->chirpPeriod->setEnabled(chirp);
+	ui->shift->setEnabled(m_settings.m_signalType != TestSourceSettings::SignalNoise);
+}
+
+void TestSourceGui::sendSettings()
+{
+	if(!m_updateTimer.isActive())
+	{
+		m_updateTimer.start(100);
+	}
+}
+
+void TestSourceGui::on_centerFrequency_changed(quint64 value)
+{
+	m_settings.m_centerFrequency = value * 1000;
+	sendSettings();
+}
+
+void TestSourceGui::on_sampleRate_changed(quint64 value)
+{
+	m_settings.m_sampleRate = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_freeRun_toggled(bool checked)
+{
+	m_settings.m_freeRun = checked;
+	sendSettings();
+}
+
+void TestSourceGui::on_signalType_currentIndexChanged(int index)
+{
+	if ((index < (int) TestSourceSettings::SignalTone) || (index > (int) TestSourceSettings::SignalLSB))
+	{
+		return;
+	}
+
+	m_settings.m_signalType = (TestSourceSettings::SignalType) index;
+	displaySignalControls();
+	sendSettings();
+}
+
+void TestSourceGui::on_shift_valueChanged(int value)
+{
+	m_settings.m_frequencyShift = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_amplitude_valueChanged(int value)
+{
+	ui->amplitudeText->setText(tr("%1").arg(value));
+	m_settings.m_amplitudeDb = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_noise_valueChanged(int value)
+{
+	ui->noiseText->setText(value <= TESTSOURCE_NOISE_OFF_DB ? tr("off") : tr("%1").arg(value));
+	m_settings.m_noiseDb = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_modFrequency_valueChanged(int value)
+{
+	m_settings.m_modulationFrequency = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_amModulation_valueChanged(int value)
+{
+	m_settings.m_amModulation = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_fmDeviation_valueChanged(int value)
+{
+	m_settings.m_fmDeviation = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_chirpSpan_valueChanged(int value)
+{
+	m_settings.m_chirpSpan = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_chirpPeriod_valueChanged(int value)
+{
+	m_settings.m_chirpPeriodMs = value;
+	sendSettings();
+}
+
+void TestSourceGui::on_dcOffset_toggled(bool checked)
+{
+	m_settings.m_dcBlock = checked;
+	sendSettings();
+}
+
+void TestSourceGui::on_iqImbalance_toggled(bool checked)
+{
+	m_settings.m_iqImbalance = checked;
+	sendSettings();
+}
+
+void TestSourceGui::on_startStop_toggled(bool checked)
+{
+	if (checked)
+	{
+		if (m_deviceAPI->initAcquisition())
+		{
+			m_deviceAPI->startAcquisition();
+			DSPEngine::instance()->startAudioOutput();
+		}
+	}
+	else
+	{
+		m_deviceAPI->stopAcquisition();
+		DSPEngine::instance()->stopAudioOutput();
+	}
+}
+
+void TestSourceGui::updateHardware()
+{
+	TestSourceInput::MsgConfigureTestSource* message = TestSourceInput::MsgConfigureTestSource::create(m_settings);
+	m_sampleSource->getInputMessageQueue()->push(message);
+	m_updateTimer.stop();
+}
+
+void TestSourceGui::updateStatus()
+{
+	int state = m_deviceAPI->state();
+
+	if(m_lastEngineState != state)
+	{
+		switch(state)
+		{
+			case DSPDeviceSourceEngine::StNotStarted:
+				ui->startStop->setStyleSheet("QToolButton { background:rgb(79,79,79); }");
+				break;
+			case DSPDeviceSourceEngine::StIdle:
+				ui->startStop->setStyleSheet("QToolButton { background-color : blue; }");
+				break;
+			case DSPDeviceSourceEngine::StRunning:
+				ui->startStop->setStyleSheet("QToolButton { background-color : green; }");
+				break;
+			case DSPDeviceSourceEngine::StError:
+				ui->startStop->setStyleSheet("QToolButton { background-color : red; }");
+				QMessageBox::information(this, tr("Message"), m_deviceAPI->errorMessage());
+				break;
+			default:
+				break;
+		}
+
+		m_lastEngineState = state;
+	}
+
+	if (state == DSPDeviceSourceEngine::StRunning)
+	{
+		TestSourceInput::MsgQueryTestSource* message = TestSourceInput::MsgQueryTestSource::create();
+		m_sampleSource->getInputMessageQueue()->push(message);
+	}
+}
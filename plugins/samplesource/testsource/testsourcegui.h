@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_TESTSOURCEGUI_H
+#define INCLUDE_TESTSOURCEGUI_H
+
+#include <plugin/plugininstanceui.h>
+#include <QTimer>
+#include <QWidget>
+
+#include "testsourceinput.h"
+
+class DeviceSourceAPI;
+
+namespace Ui {
+	class TestSourceGui;
+}
+
+class TestSourceGui : public QWidget, public PluginInstanceUI {
+	Q_OBJECT
+
+public:
+	explicit TestSourceGui(DeviceSourceAPI *deviceAPI, QWidget* parent = NULL);
+	virtual ~TestSourceGui();
+	void destroy();
+
+	void setName(const QString& name);
+	QString getName() const;
+
+	void resetToDefaults();
+	virtual qint64 getCenterFrequency() const;
+	virtual void setCenterFrequency(qint64 centerFrequency);
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data);
+	virtual bool handleMessage(const Message& message);
+
+private:
+	Ui::TestSourceGui* ui;
+
+	DeviceSourceAPI* m_deviceAPI;
+	TestSourceSettings m_settings;
+	QTimer m_updateTimer;
+	QTimer m_statusTimer;
+	DeviceSampleSource* m_sampleSource;
+	int m_sampleRate;
+	quint64 m_deviceCenterFrequency; //!< Center frequency in device
+	int m_lastEngineState;
+
+	void displaySettings();
+	void displaySignalControls();
+	void sendSettings();
+	void updateSampleRateAndFrequency();
+
+private slots:
+	void handleDSPMessages();
+	void on_centerFrequency_changed(quint64 value);
+	void on_sampleRate_changed(quint64 value);
+	void on_freeRun_toggled(bool checked);
+	void on_signalType_currentIndexChanged(int index);
+	void on_shift_valueChanged(int value);
+	void on_amplitude_valueChanged(int value);
+	void on_noise_valueChanged(int value);
+	void on_modFrequency_valueChanged(int value);
+	void on_amModulation_valueChanged(int value);
+	void on_fmDeviation_valueChanged(int value);
+	void on_chirpSpan_valueChanged(int value);
+	void on_chirpPeriod_valueChanged(int value);
+	void on_dcOffset_toggled(bool checked);
+	void on_iqImbalance_toggled(bool checked);
+	void on_startStop_toggled(bool checked);
+	void updateHardware();
+	void updateStatus();
+	void handleSourceMessages();
+};
+
+#endif // INCLUDE_TESTSOURCEGUI_H
@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "testsourceinput.h"
+
+#include "device/devicesourceapi.h"
+
+#include "testsourcethread.h"
+#include "dsp/dspcommands.h"
+
+#define TESTSOURCE_FIFO_MIN_SIZE (1<<18) //!< samples
+#define TESTSOURCE_FIFO_MAX_SIZE (1<<24) //!< samples i.e. 64 MB
+
+MESSAGE_CLASS_DEFINITION(TestSourceInput::MsgConfigureTestSource, Message)
+MESSAGE_CLASS_DEFINITION(TestSourceInput::MsgQueryTestSource, Message)
+MESSAGE_CLASS_DEFINITION(TestSourceInput::MsgReportTestSource, Message)
+
+TestSourceInput::TestSourceInput(DeviceSourceAPI *deviceAPI) :
+	m_deviceAPI(deviceAPI),
+	m_settings(),
+	m_testSourceThread(0),
+	m_deviceDescription("TestSource"),
+	m_running(false),
+	m_rateSamplesCount(0)
+{
+}
+
+TestSourceInput::~TestSourceInput()
+{
+	if (m_running) stop();
+}
+
+bool TestSourceInput::start()
+{
+	if (m_running) stop();
+
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_sampleFifo.setSize(getFifoSize(m_settings.m_sampleRate)))
+	{
+		qCritical("TestSourceInput::start: could not allocate SampleFifo");
+		return false;
+	}
+
+	if ((m_testSourceThread = new TestSourceThread(&m_sampleFifo)) == NULL)
+	{
+		qFatal("TestSourceInput::start: out of memory");
+		return false;
+	}
+
+	m_testSourceThread->setSettings(m_settings);
+	m_testSourceThread->startWork();
+	m_runTimer.start();
+	m_rateTimer.start();
+	m_rateSamplesCount = 0;
+
+	mutexLocker.unlock();
+
+	applySettings(m_settings, true);
+	m_running = true;
+
+	return true;
+}
+
+void TestSourceInput::stop()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (m_testSourceThread != 0)
+	{
+		m_testSourceThread->stopWork();
+		qint64 elapsedMs = m_runTimer.elapsed();
+
+		if (elapsedMs > 0)
+		{
+			quint64 samplesCount = m_testSourceThread->getSamplesCount();
+			qDebug("TestSourceInput::stop: %llu samples in %lld ms: %.0f S/s sustained on average",
+					samplesCount, elapsedMs, (samplesCount * 1000.0) / elapsedMs);
+		}
+
+		delete m_testSourceThread;
+		m_testSourceThread = 0;
+	}
+
+	m_running = false;
+}
+
+uint TestSourceInput::getFifoSize(int sampleRate)
+{
+	// a quarter of a second of samples within bounds so that tens of MS/s do not take too much memory
+	uint fifoSize = sampleRate / 4;
+	return fifoSize < TESTSOURCE_FIFO_MIN_SIZE ? TESTSOURCE_FIFO_MIN_SIZE : fifoSize > TESTSOURCE_FIFO_MAX_SIZE ? TESTSOURCE_FIFO_MAX_SIZE : fifoSize;
+}
+
+const QString& TestSourceInput::getDeviceDescription() const
+{
+	return m_deviceDescription;
+}
+
+int TestSourceInput::getSampleRate() const
+{
+	return m_settings.m_sampleRate;
+}
+
+quint64 TestSourceInput::getCenterFrequency() const
+{
+	return m_settings.m_centerFrequency;
+}
+
+QByteArray TestSourceInput::serialize() const
+{
+	return m_settings.serialize();
+}
+
+bool TestSourceInput::deserialize(const QByteArray& data)
+{
+	TestSourceSettings settings = m_settings;
+	bool ok = settings.deserialize(data);
+	settings.m_centerFrequency = m_settings.m_centerFrequency; // comes with the preset
+
+	MsgConfigureTestSource* message = MsgConfigureTestSource::create(settings);
+	getInputMessageQueue()->push(message);
+
+	return ok;
+}
+
+void TestSourceInput::setCenterFrequency(qint64 centerFrequency)
+{
+	TestSourceSettings settings = m_settings;
+	settings.m_centerFrequency = centerFrequency;
+
+	MsgConfigureTestSource* message = MsgConfigureTestSource::create(settings);
+	getInputMessageQueue()->push(message);
+}
+
+bool TestSourceInput::handleMessage(const Message& message)
+{
+	if (MsgConfigureTestSource::match(message))
+	{
+		MsgConfigureTestSource& conf = (MsgConfigureTestSource&) message;
+		qDebug() << "TestSourceInput::handleMessage: MsgConfigureTestSource";
+		applySettings(conf.getSettings(), false);
+
+		// The lock free FIFO cannot be resized while the engine reads it so the acquisition is
+		// restarted the same way as from the GUI and start() allocates the FIFO for the new rate
+		if (m_running && (m_sampleFifo.size() < getFifoSize(m_settings.m_sampleRate)))
+		{
+			qDebug() << "TestSourceInput::handleMessage: restart acquisition to resize the FIFO";
+			m_deviceAPI->stopAcquisition();
+
+			if (m_deviceAPI->initAcquisition()) {
+				m_deviceAPI->startAcquisition();
+			}
+		}
+
+		return true;
+	}
+	else if (MsgQueryTestSource::match(message))
+	{
+		QMutexLocker mutexLocker(&m_mutex);
+		quint64 samplesCount = 0;
+		double sustainedRate = 0.0;
+
+		if (m_testSourceThread != 0)
+		{
+			samplesCount = m_testSourceThread->getSamplesCount();
+			qint64 elapsedNs = m_rateTimer.nsecsElapsed();
+
+			if (elapsedNs > 0) {
+				sustainedRate = ((samplesCount - m_rateSamplesCount) * 1e9) / elapsedNs;
+			}
+
+			m_rateTimer.restart();
+			m_rateSamplesCount = samplesCount;
+		}
+
+		MsgReportTestSource *report = MsgReportTestSource::create(samplesCount, sustainedRate);
+		getOutputMessageQueueToGUI()->push(report);
+
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool TestSourceInput::applySettings(const TestSourceSettings& settings, bool force)
+{
+	bool forwardChange = false;
+
+	if ((m_settings.m_dcBlock != settings.m_dcBlock) || (m_settings.m_iqImbalance != settings.m_iqImbalance) || force)
+	{
+		m_settings.m_dcBlock = settings.m_dcBlock;
+		m_settings.m_iqImbalance = settings.m_iqImbalance;
+		m_deviceAPI->configureCorrections(m_settings.m_dcBlock, m_settings.m_iqImbalance);
+	}
+
+	if ((m_settings.m_centerFrequency != settings.m_centerFrequency) || (m_settings.m_sampleRate != settings.m_sampleRate) || force)
+	{
+		forwardChange = true;
+	}
+
+	// signal parameters are all handled by the thread
+	m_settings = settings;
+
+	if (m_testSourceThread != 0) {
+		m_testSourceThread->setSettings(m_settings);
+	}
+
+	if (forwardChange)
+	{
+		qDebug() << "TestSourceInput::applySettings: center freq: " << m_settings.m_centerFrequency << " Hz"
+				<< " sample rate: " << m_settings.m_sampleRate << "S/s";
+
+		DSPSignalNotification *notif = new DSPSignalNotification(m_settings.m_sampleRate, m_settings.m_centerFrequency);
+		m_deviceAPI->getDeviceInputMessageQueue()->push(notif);
+	}
+
+	return true;
+}
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_TESTSOURCEINPUT_H
+#define INCLUDE_TESTSOURCEINPUT_H
+
+#include <dsp/devicesamplesource.h>
+
+#include "testsourcesettings.h"
+#include <QString>
+#include <QElapsedTimer>
+
+class DeviceSourceAPI;
+class TestSourceThread;
+
+class TestSourceInput : public DeviceSampleSource {
+public:
+	class MsgConfigureTestSource : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		const TestSourceSettings& getSettings() const { return m_settings; }
+
+		static MsgConfigureTestSource* create(const TestSourceSettings& settings)
+		{
+			return new MsgConfigureTestSource(settings);
+		}
+
+	private:
+		TestSourceSettings m_settings;
+
+		MsgConfigureTestSource(const TestSourceSettings& settings) :
+			Message(),
+			m_settings(settings)
+		{ }
+	};
+
+	class MsgQueryTestSource : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		static MsgQueryTestSource* create()
+		{
+			return new MsgQueryTestSource();
+		}
+
+	protected:
+		MsgQueryTestSource() :
+			Message()
+		{ }
+	};
+
+	class MsgReportTestSource : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		quint64 getSamplesCount() const { return m_samplesCount; }
+		double getSustainedRate() const { return m_sustainedRate; }
+
+		static MsgReportTestSource* create(quint64 samplesCount, double sustainedRate)
+		{
+			return new MsgReportTestSource(samplesCount, sustainedRate);
+		}
+
+	protected:
+		quint64 m_samplesCount;  //!< samples written to the FIFO since the start
+		double m_sustainedRate;  //!< samples per second written since the previous query
+
+		MsgReportTestSource(quint64 samplesCount, double sustainedRate) :
+			Message(),
+			m_samplesCount(samplesCount),
+			m_sustainedRate(sustainedRate)
+		{ }
+	};
+
+	TestSourceInput(DeviceSourceAPI *deviceAPI);
+	virtual ~TestSourceInput();
+
+	virtual bool start();
+	virtual void stop();
+
+	virtual const QString& getDeviceDescription() const;
+	virtual int getSampleRate() const;
+	virtual quint64 getCenterFrequency() const;
+
+	virtual bool handleMessage(const Message& message);
+
+	virtual QByteArray serialize() const;
+	virtual bool deserialize(const QByteArray& data);
+	virtual void setCenterFrequency(qint64 centerFrequency);
+
+private:
+	DeviceSourceAPI *m_deviceAPI;
+	QMutex m_mutex;
+	TestSourceSettings m_settings;
+	TestSourceThread* m_testSourceThread;
+	QString m_deviceDescription;
+	bool m_running;
+	QElapsedTimer m_runTimer;   //!< time since the start for the average rate
+	QElapsedTimer m_rateTimer;  //!< time since the previous query
+	quint64 m_rateSamplesCount; //!< samples count at the previous query
+
+	bool applySettings(const TestSourceSettings& settings, bool force);
+	static uint getFifoSize(int sampleRate); //!< FIFO size for a sample rate
+};
+
+#endif // INCLUDE_TESTSOURCEINPUT_H
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QtPlugin>
+#include <QAction>
+#include "plugin/pluginapi.h"
+#include "util/simpleserializer.h"
+
+#include "testsourcegui.h"
+#include "testsourceinput.h"
+#include "testsourceplugin.h"
+#include <device/devicesourceapi.h>
+
+const PluginDescriptor TestSourcePlugin::m_pluginDescriptor = {
+	QString("Test source input"),
+	QString("3.7.0"),
+	QString("(c) Edouard Griffiths, F4EXB"),
+	QString("https://github.com/f4exb/sdrangel"),
+	true,
+	QString("https://github.com/f4exb/sdrangel")
+};
+
+const QString TestSourcePlugin::m_hardwareID = "TestSource";
+const QString TestSourcePlugin::m_deviceTypeID = TESTSOURCE_DEVICE_TYPE_ID;
+
+TestSourcePlugin::TestSourcePlugin(QObject* parent) :
+	QObject(parent)
+{
+}
+
+const PluginDescriptor& TestSourcePlugin::getPluginDescriptor() const
+{
+	return m_pluginDescriptor;
+}
+
+void TestSourcePlugin::initPlugin(PluginAPI* pluginAPI)
+{
+	pluginAPI->registerSampleSource(m_deviceTypeID, this);
+}
+
+PluginInterface::SamplingDevices TestSourcePlugin::enumSampleSources()
+{
+	SamplingDevices result;
+	int count = 1;
+
+	for(int i = 0; i < count; i++)
+	{
+		QString displayedName(QString("TestSource[%1]").arg(i));
+
+		result.append(SamplingDevice(displayedName,
+		        m_hardwareID,
+				m_deviceTypeID,
+				QString::null,
+				i));
+	}
+
+	return result;
+}
+
+PluginInstanceUI* TestSourcePlugin::createSampleSourcePluginInstanceUI(const QString& sourceId, QWidget **widget, DeviceSourceAPI *deviceAPI)
+{
+	if(sourceId == m_deviceTypeID)
+	{
+		TestSourceGui* gui = new TestSourceGui(deviceAPI);
+		*widget = gui;
+		return gui;
+	}
+	else
+	{
+		return NULL;
+	}
+}
+
+DeviceSampleSource* TestSourcePlugin::createSampleSourcePluginInstanceInput(const QString& sourceId, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer __attribute__((unused)))
+{
+	if(sourceId == m_deviceTypeID)
+	{
+		return new TestSourceInput(deviceAPI);
+	}
+	else
+	{
+		return NULL;
+	}
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QtGlobal>
+#include "util/simpleserializer.h"
+#include "testsourcesettings.h"
+
+TestSourceSettings::TestSourceSettings()
+{
+	resetToDefaults();
+}
+
+void TestSourceSettings::resetToDefaults()
+{
+	m_centerFrequency = 435000*1000;
+	m_sampleRate = 2000*1000;
+	m_signalType = SignalTone;
+	m_frequencyShift = 100*1000;
+	m_amplitudeDb = -20;
+	m_noiseDb = -60;
+	m_modulationFrequency = 1000;
+	m_amModulation = 50;
+	m_fmDeviation = 5000;
+	m_chirpSpan = 500*1000;
+	m_chirpPeriodMs = 100;
+	m_freeRun = false;
+	m_dcBlock = false;
+	m_iqImbalance = false;
+}
+
+QByteArray TestSourceSettings::serialize() const
+{
+	SimpleSerializer s(1);
+
+	s.writeS32(1, m_sampleRate);
+	s.writeS32(2, (int) m_signalType);
+	s.writeS32(3, m_frequencyShift);
+	s.writeS32(4, m_amplitudeDb);
+	s.writeS32(5, m_noiseDb);
+	s.writeS32(6, m_modulationFrequency);
+	s.writeS32(7, m_amModulation);
+	s.writeS32(8, m_fmDeviation);
+	s.writeS32(9, m_chirpSpan);
+	s.writeS32(10, m_chirpPeriodMs);
+	s.writeBool(11, m_freeRun);
+	s.writeBool(12, m_dcBlock);
+	s.writeBool(13, m_iqImbalance);
+
+	return s.final();
+}
+
+bool TestSourceSettings::deserialize(const QByteArray& data)
+{
+	SimpleDeserializer d(data);
+
+	if (!d.isValid())
+	{
+		resetToDefaults();
+		return false;
+	}
+
+	if (d.getVersion() == 1)
+	{
+		int intval;
+
+		d.readS32(1, &m_sampleRate, 2000*1000);
+		d.readS32(2, &intval, (int) SignalTone);
+		m_signalType = (intval < (int) SignalTone) || (intval > (int) SignalLSB) ? SignalTone : (SignalType) intval;
+		d.readS32(3, &m_frequencyShift, 100*1000);
+		d.readS32(4, &m_amplitudeDb, -20);
+		d.readS32(5, &m_noiseDb, -60);
+		d.readS32(6, &m_modulationFrequency, 1000);
+		d.readS32(7, &m_amModulation, 50);
+		d.readS32(8, &m_fmDeviation, 5000);
+		d.readS32(9, &m_chirpSpan, 500*1000);
+		d.readS32(10, &m_chirpPeriodMs, 100);
+		d.readBool(11, &m_freeRun, false);
+		d.readBool(12, &m_dcBlock, false);
+		d.readBool(13, &m_iqImbalance, false);
+
+		return true;
+	}
+	else
+	{
+		resetToDefaults();
+		return false;
+	}
+}
@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TESTSOURCE_TESTSOURCESETTINGS_H_
+#define _TESTSOURCE_TESTSOURCESETTINGS_H_
+
+#include <QtGlobal>
+#include <QByteArray>
+
+struct TestSourceSettings {
+	typedef enum {
+		SignalTone = 0,
+		SignalChirp,
+		SignalNoise,
+		SignalAM,
+		SignalFM,
+		SignalUSB,
+		SignalLSB
+	} SignalType;
+
+	quint64 m_centerFrequency;
+	qint32 m_sampleRate;
+	SignalType m_signalType;
+	qint32 m_frequencyShift;      //!< carrier offset from the center frequency (Hz)
+	qint32 m_amplitudeDb;         //!< peak level of the signal (dB full scale)
+	qint32 m_noiseDb;             //!< level of the noise added to the signal (dB full scale). Off at TESTSOURCE_NOISE_OFF_DB
+	qint32 m_modulationFrequency; //!< modulating tone of AM, FM and SSB (Hz)
+	qint32 m_amModulation;        //!< AM depth (%)
+	qint32 m_fmDeviation;         //!< FM peak deviation (Hz)
+	qint32 m_chirpSpan;           //!< chirp sweep span centered on the carrier (Hz)
+	qint32 m_chirpPeriodMs;       //!< chirp sweep period (ms)
+	bool m_freeRun;               //!< fill the FIFO as fast as it is emptied instead of in real time
+	bool m_dcBlock;
+	bool m_iqImbalance;
+
+	TestSourceSettings();
+	void resetToDefaults();
+	QByteArray serialize() const;
+	bool deserialize(const QByteArray& data);
+};
+
+#define TESTSOURCE_NOISE_OFF_DB -100
+
+#endif /* _TESTSOURCE_TESTSOURCESETTINGS_H_ */
@@ -0,0 +1,321 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <QDebug>
+
+#include "testsourcethread.h"
+#include "dsp/samplesinkfifo.h"
+
+static inline FixReal clip(Real v)
+{
+	return v > 32767.0f ? 32767 : v < -32768.0f ? -32768 : (FixReal) v;
+}
+
+/** Fixed point phase in 2^-64 cycle units of a number of cycles. Negative values wrap around. */
+static quint64 cyclesToPhase(double cycles)
+{
+	double a = fabs(cycles);
+	a -= floor(a); // exact for positive values and strictly below one
+	quint64 phase = (quint64) (a * 18446744073709551616.0);
+	return cycles < 0 ? -phase : phase;
+}
+
+/** Radians in [-pi, pi) of a fixed point phase */
+static inline double phaseToRadians(quint64 phase)
+{
+	return (qint64) phase * (M_PI / 9223372036854775808.0);
+}
+
+TestSourceThread::TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent) :
+	QThread(parent),
+	m_running(false),
+	m_sampleFifo(sampleFifo),
+	m_buf(TESTSOURCE_CHUNK),
+	m_signal(TESTSOURCE_CHUNK),
+	m_settingsChanged(true),
+	m_samplesCount(0),
+	m_timedSamples(0),
+	m_amplitude(0),
+	m_noise(0),
+	m_carrier(1.0f, 0.0f),
+	m_carrierStep(1.0f, 0.0f),
+	m_chirpPhase(0),
+	m_chirpFreq(0),
+	m_chirpFreqStart(0),
+	m_chirpFreqInc(0),
+	m_chirpStepInc(1.0, 0.0),
+	m_chirpCount(0),
+	m_chirpLength(1),
+	m_modPhase(0),
+	m_modPhaseStep(0),
+	m_modTable(1<<TESTSOURCE_MOD_TABLE_BITS),
+	m_rng(0x2545F4914F6CDD1DULL)
+{
+}
+
+TestSourceThread::~TestSourceThread()
+{
+	if (m_running) {
+		stopWork();
+	}
+}
+
+void TestSourceThread::startWork()
+{
+	qDebug() << "TestSourceThread::startWork";
+	m_startWaitMutex.lock();
+	start();
+	while(!m_running)
+		m_startWaiter.wait(&m_startWaitMutex, 100);
+	m_startWaitMutex.unlock();
+}
+
+void TestSourceThread::stopWork()
+{
+	qDebug() << "TestSourceThread::stopWork";
+	m_running = false;
+	wait();
+}
+
+void TestSourceThread::setSettings(const TestSourceSettings& settings)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_pendingSettings = settings;
+	m_settingsChanged = true;
+}
+
+quint64 TestSourceThread::getSamplesCount() const
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	return m_samplesCount;
+}
+
+void TestSourceThread::run()
+{
+	m_running = true;
+	m_startWaiter.wakeAll();
+	m_elapsedTimer.start();
+	m_timedSamples = 0;
+
+	while (m_running)
+	{
+		applySettings();
+
+		if (m_settings.m_freeRun)
+		{
+			uint room = m_sampleFifo->size() - m_sampleFifo->fill();
+
+			if (room >= TESTSOURCE_CHUNK) {
+				generate(room);
+			} else {
+				usleep(100);
+			}
+		}
+		else
+		{
+			double sampleRate = m_settings.m_sampleRate;
+			double due = m_elapsedTimer.nsecsElapsed() * (sampleRate / 1e9) - m_timedSamples;
+			double lateMax = (sampleRate * TESTSOURCE_MAX_LATE_MS) / 1000.0;
+			double minBlock = sampleRate / 1000.0; // about one block per millisecond
+
+			if (due > lateMax) // the pipeline cannot keep up: skip the backlog
+			{
+				m_timedSamples += due - lateMax;
+				due = lateMax;
+			}
+
+			if ((due >= TESTSOURCE_CHUNK) || ((due >= 1.0) && (due >= minBlock)))
+			{
+				quint64 nbSamples = (quint64) due;
+				generate(nbSamples);
+				m_timedSamples += nbSamples;
+			}
+			else
+			{
+				usleep(1000);
+			}
+		}
+	}
+
+	m_running = false;
+}
+
+void TestSourceThread::applySettings()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (!m_settingsChanged) {
+		return;
+	}
+
+	m_settings = m_pendingSettings;
+	m_settingsChanged = false;
+	mutexLocker.unlock();
+
+	double fs = m_settings.m_sampleRate > 0 ? m_settings.m_sampleRate : 1;
+	double shift = m_settings.m_frequencyShift;
+
+	m_amplitude = 32767.0f * powf(10.0f, m_settings.m_amplitudeDb / 20.0f);
+	m_noise = m_settings.m_noiseDb <= TESTSOURCE_NOISE_OFF_DB ? 0.0f : 32767.0f * powf(10.0f, m_settings.m_noiseDb / 20.0f) * (Real) M_SQRT1_2;
+	m_carrierStep = std::polar(1.0f, (Real) (2.0 * M_PI * shift / fs));
+
+	double chirpLength = (m_settings.m_chirpPeriodMs * fs) / 1000.0;
+	m_chirpLength = chirpLength < 1.0 ? 1 : chirpLength > 4294967295.0 ? 4294967295U : (quint32) chirpLength;
+	m_chirpFreqStart = cyclesToPhase((shift - m_settings.m_chirpSpan / 2.0) / fs);
+	m_chirpFreqInc = cyclesToPhase(m_settings.m_chirpSpan / (m_chirpLength * fs));
+	m_chirpStepInc = std::polar(1.0, phaseToRadians(m_chirpFreqInc));
+	m_chirpFreq = m_chirpFreqStart;
+	m_chirpCount = 0;
+
+	m_modPhaseStep = (quint32) (qint64) ((m_settings.m_modulationFrequency / fs) * 4294967296.0);
+	double amDepth = m_settings.m_amModulation / 100.0;
+	double fmIndex = m_settings.m_modulationFrequency > 0 ? m_settings.m_fmDeviation / (double) m_settings.m_modulationFrequency : 0.0;
+
+	for (std::size_t i = 0; i < m_modTable.size(); i++)
+	{
+		double phi = (2.0 * M_PI * i) / m_modTable.size();
+
+		switch (m_settings.m_signalType)
+		{
+		case TestSourceSettings::SignalAM:
+			m_modTable[i] = Complex((1.0 + amDepth * cos(phi)) / (1.0 + amDepth), 0.0f);
+			break;
+		case TestSourceSettings::SignalFM:
+			m_modTable[i] = std::polar(1.0f, (Real) (fmIndex * sin(phi)));
+			break;
+		case TestSourceSettings::SignalUSB:
+			m_modTable[i] = std::polar(1.0f, (Real) phi);
+			break;
+		case TestSourceSettings::SignalLSB:
+			m_modTable[i] = std::polar(1.0f, (Real) -phi);
+			break;
+		default:
+			m_modTable[i] = Complex(1.0f, 0.0f);
+			break;
+		}
+	}
+
+	// the real time reference restarts with the new rate or when coming back from free running
+	m_elapsedTimer.restart();
+	m_timedSamples = 0;
+
+	qDebug() << "TestSourceThread::applySettings:"
+			<< " sampleRate: " << m_settings.m_sampleRate
+			<< " signalType: " << (int) m_settings.m_signalType
+			<< " shift: " << m_settings.m_frequencyShift
+			<< " freeRun: " << m_settings.m_freeRun;
+}
+
+void TestSourceThread::generate(quint64 nbSamples)
+{
+	while (nbSamples > 0)
+	{
+		uint len = nbSamples < TESTSOURCE_CHUNK ? nbSamples : TESTSOURCE_CHUNK;
+		generateBlock(len);
+		uint written = m_sampleFifo->write(m_buf.begin(), m_buf.begin() + len);
+		nbSamples -= len;
+
+		QMutexLocker mutexLocker(&m_mutex);
+		m_samplesCount += written; // samples the FIFO could take i.e. actually sustained
+	}
+}
+
+void TestSourceThread::generateBlock(uint len)
+{
+	Complex *signal = &m_signal[0];
+
+	switch (m_settings.m_signalType)
+	{
+	case TestSourceSettings::SignalTone:
+		for (uint i = 0; i < len; i++)
+		{
+			signal[i] = m_carrier * m_amplitude;
+			m_carrier *= m_carrierStep;
+		}
+		break;
+	case TestSourceSettings::SignalChirp:
+		generateChirp(signal, len);
+		break;
+	case TestSourceSettings::SignalNoise:
+		for (uint i = 0; i < len; i++)
+		{
+			Real re = gaussian();
+			signal[i] = Complex(re, gaussian()) * (m_amplitude * (Real) M_SQRT1_2);
+		}
+		break;
+	default: // modulations of the carrier by the modulating tone
+		for (uint i = 0; i < len; i++)
+		{
+			signal[i] = m_carrier * m_modTable[m_modPhase >> (32 - TESTSOURCE_MOD_TABLE_BITS)] * m_amplitude;
+			m_carrier *= m_carrierStep;
+			m_modPhase += m_modPhaseStep;
+		}
+		break;
+	}
+
+	m_carrier /= std::abs(m_carrier); // rounding errors of the phasor rotations
+
+	if (m_noise > 0.0f)
+	{
+		for (uint i = 0; i < len; i++) {
+			signal[i] += noise();
+		}
+	}
+
+	Sample *out = &m_buf[0];
+
+	for (uint i = 0; i < len; i++)
+	{
+		out[i].setReal(clip(signal[i].real()));
+		out[i].setImag(clip(signal[i].imag()));
+	}
+}
+
+void TestSourceThread::generateChirp(Complex *signal, uint len)
+{
+	uint i = 0;
+
+	while (i < len)
+	{
+		// segment up to the end of the block, of the sweep or of the phasor rotations run
+		quint32 n = m_chirpLength - m_chirpCount;
+		n = n < len - i ? n : len - i;
+		n = n < TESTSOURCE_CHIRP_SEGMENT ? n : TESTSOURCE_CHIRP_SEGMENT;
+
+		std::complex<double> carrier = std::polar(1.0, phaseToRadians(m_chirpPhase));
+		std::complex<double> step = std::polar(1.0, phaseToRadians(m_chirpFreq));
+
+		for (quint32 k = 0; k < n; k++, i++)
+		{
+			signal[i] = Complex(carrier.real() * m_amplitude, carrier.imag() * m_amplitude);
+			carrier *= step;
+			step *= m_chirpStepInc;
+		}
+
+		// quadratic phase: sum over the segment of the frequency increasing at each sample
+		quint64 n64 = n;
+		m_chirpPhase += n64 * m_chirpFreq + ((n64 * (n64 - 1)) / 2) * m_chirpFreqInc;
+		m_chirpFreq += n64 * m_chirpFreqInc;
+		m_chirpCount += n;
+
+		if (m_chirpCount >= m_chirpLength) // next period: the frequency jumps back and the phase is continuous
+		{
+			m_chirpCount = 0;
+			m_chirpFreq = m_chirpFreqStart;
+		}
+	}
+}
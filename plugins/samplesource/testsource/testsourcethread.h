@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_TESTSOURCETHREAD_H
+#define INCLUDE_TESTSOURCETHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "testsourcesettings.h"
+
+#define TESTSOURCE_CHUNK (1<<14)        //!< samples generated and written to the FIFO at once
+#define TESTSOURCE_MOD_TABLE_BITS 12    //!< modulation table of 4096 points over a period of the modulating tone
+#define TESTSOURCE_MAX_LATE_MS 100      //!< real time backlog above which the late samples are skipped
+#define TESTSOURCE_CHIRP_SEGMENT 1024   //!< chirp samples generated by phasor rotations between exact phase computations
+
+class SampleSinkFifo;
+
+/**
+ * Generates the test signal straight into the sample FIFO by blocks of TESTSOURCE_CHUNK samples.
+ * Oscillators are complex phasors rotated at each sample and the modulations are read from a table
+ * over the phase of the modulating tone so that there is no trigonometry per sample.
+ * The chirp phase is quadratic and kept in 64 bit fixed point accumulators (the frequency increment per
+ * sample is far below the resolution of a float step at high rates): the double precision phasors are
+ * computed from them every TESTSOURCE_CHIRP_SEGMENT samples and rotated in between.
+ * The thread paces itself on its own clock in real time (the master timer ticks in the GUI thread which
+ * could not keep up with tens of MS/s) or writes as fast as the FIFO is emptied when free running.
+ */
+class TestSourceThread : public QThread {
+	Q_OBJECT
+
+public:
+	TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent = NULL);
+	~TestSourceThread();
+
+	void startWork();
+	void stopWork();
+	void setSettings(const TestSourceSettings& settings); //!< taken into account at the next block
+	quint64 getSamplesCount() const; //!< samples written to the FIFO since the start
+
+private:
+	QMutex m_startWaitMutex;
+	QWaitCondition m_startWaiter;
+	bool m_running;
+
+	SampleSinkFifo* m_sampleFifo;
+	SampleVector m_buf;
+	std::vector<Complex> m_signal; //!< block before the noise and the conversion to samples
+	mutable QMutex m_mutex; //!< protects the pending settings and the samples count
+	TestSourceSettings m_pendingSettings;
+	bool m_settingsChanged;
+	TestSourceSettings m_settings;
+	quint64 m_samplesCount;
+
+	QElapsedTimer m_elapsedTimer;
+	double m_timedSamples;  //!< samples generated since the real time reference
+
+	Real m_amplitude;       //!< peak amplitude in sample units
+	Real m_noise;           //!< noise standard deviation per component in sample units
+	Complex m_carrier;
+	Complex m_carrierStep;
+	quint64 m_chirpPhase;     //!< chirp phase in 2^-64 cycle units
+	quint64 m_chirpFreq;      //!< current chirp frequency in 2^-64 cycles per sample
+	quint64 m_chirpFreqStart; //!< chirp frequency at the start of a period
+	quint64 m_chirpFreqInc;   //!< chirp frequency increment at each sample
+	std::complex<double> m_chirpStepInc; //!< rotation of the carrier step at each sample
+	quint32 m_chirpCount;
+	quint32 m_chirpLength;  //!< chirp period in samples
+	quint32 m_modPhase;
+	quint32 m_modPhaseStep;
+	std::vector<Complex> m_modTable;
+	quint64 m_rng;
+
+	void run();
+	void applySettings();
+	void generate(quint64 nbSamples);
+	void generateBlock(uint len);
+	void generateChirp(Complex *signal, uint len);
+
+	/** Gaussian noise from the sum of four 16 bit uniforms of a xorshift generator */
+	inline Real gaussian()
+	{
+		m_rng ^= m_rng << 13;
+		m_rng ^= m_rng >> 7;
+		m_rng ^= m_rng << 17;
+		int sum = (int) (m_rng & 0xFFFF) + (int) ((m_rng >> 16) & 0xFFFF)
+				+ (int) ((m_rng >> 32) & 0xFFFF) + (int) (m_rng >> 48) - 2*65535;
+		return sum * (1.0f / 37837.2f); // standard deviation of the sum is 65536/sqrt(3)
+	}
+
+	inline Complex noise()
+	{
+		Real re = gaussian();
+		return Complex(re, gaussian()) * m_noise;
+	}
+};
+
+#endif // INCLUDE_TESTSOURCETHREAD_H
@@ -10,6 +10,7 @@ SUBDIRS = sdrbase
 #SUBDIRS += libhackrf
 #SUBDIRS += libairspy
 SUBDIRS += plugins/samplesource/filesource
+SUBDIRS += plugins/samplesource/testsource
 SUBDIRS += plugins/samplesource/sdrdaemon
 #SUBDIRS += plugins/samplesource/rtlsdr
 #SUBDIRS += plugins/samplesource/hackrf
@@ -12,6 +12,7 @@ SUBDIRS += fcdlib
 SUBDIRS += mbelib
 SUBDIRS += dsdcc
 SUBDIRS += plugins/samplesource/filesource
+SUBDIRS += plugins/samplesource/testsource
 SUBDIRS += plugins/samplesource/sdrdaemon
 SUBDIRS += plugins/samplesource/rtlsdr
 SUBDIRS += plugins/samplesource/hackrfinput
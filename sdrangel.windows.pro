@@ -23,6 +23,7 @@ SUBDIRS += dsdcc
 SUBDIRS += serialdv
 CONFIG(MINGW64)SUBDIRS += cm256cc
 SUBDIRS += plugins/samplesource/filesource
+SUBDIRS += plugins/samplesource/testsource
 CONFIG(MINGW64)SUBDIRS += plugins/samplesource/sdrdaemonsource
 SUBDIRS += plugins/samplesource/rtlsdr
 SUBDIRS += plugins/samplesource/hackrfinput
@@ -16,7 +16,8 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
-#include <QTime>
+#include <QElapsedTimer>
+#include <QMutexLocker>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
 
@@ -25,11 +26,16 @@
 AudioFifo::AudioFifo() :
 	m_fifo(0),
 	m_sampleSize(sizeof(AudioSample)),
+	m_fill(0),
+	m_clearRequest(0),
+	m_overrunCount(0),
+	m_underrunCount(0),
+	m_readerWaiting(0),
 	m_udpSink(0),
 	m_copyToUDP(false)
 {
+	setOutputGain(1.0f);
 	m_size = 0;
-	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
 }
@@ -37,40 +43,36 @@ AudioFifo::AudioFifo() :
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
     m_sampleSize(sizeof(AudioSample)),
+    m_fill(0),
+    m_clearRequest(0),
+    m_overrunCount(0),
+    m_underrunCount(0),
+    m_readerWaiting(0),
     m_udpSink(0),
     m_copyToUDP(false)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
+	setOutputGain(1.0f);
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	if (m_fifo != 0)
 	{
 		delete[] m_fifo;
 		m_fifo = 0;
 	}
 
-	m_writeWaitCondition.wakeOne();
-	m_readWaitCondition.wakeOne();
-
 	m_size = 0;
 }
 
 bool AudioFifo::setSize(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	return create(numSamples);
 }
 
-uint AudioFifo::write(const quint8* data, uint32_t numSamples, int timeout_ms)
+uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 {
-	QTime time;
 	uint32_t total;
 	uint32_t remaining;
 	uint32_t copyLen;
@@ -85,76 +87,38 @@ uint AudioFifo::write(const quint8* data, uint32_t numSamples, int timeout_ms)
 		return 0;
 	}
 
-	time.start();
-	m_mutex.lock();
-
-	if(timeout_ms == 0)
-	{
-		total = MIN(numSamples, m_size - m_fill);
-	}
-	else
-	{
-		total = numSamples;
-	}
-
+	// the reader can only free more room meanwhile
+	total = MIN(numSamples, m_size - fill());
 	remaining = total;
 
 	while (remaining > 0)
 	{
-		if (isFull())
-		{
-			if (time.elapsed() < timeout_ms)
-			{
-				m_writeWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_writeWaitCondition.wait(&m_writeWaitLock, ms);
-				m_writeWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
-			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
-			}
-		}
-
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
+		copyLen = MIN(remaining, m_size - m_tail);
 		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
 		m_tail += copyLen;
 		m_tail %= m_size;
-		m_fill += copyLen;
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
+	}
+
+	m_fill.fetchAndAddOrdered(total); // publish samples to the reader
+
+	if (m_readerWaiting.loadAcquire())
+	{
+		QMutexLocker mutexLocker(&m_waitMutex);
 		m_readWaitCondition.wakeOne();
 	}
 
-	m_mutex.unlock();
+	if (total < numSamples)
+	{
+		m_overrunCount.fetchAndAddRelaxed(numSamples - total);
+	}
+
 	return total;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples, int timeout_ms)
 {
-	QTime time;
 	uint32_t total;
 	uint32_t remaining;
 	uint32_t copyLen;
@@ -164,98 +128,85 @@ uint AudioFifo::read(quint8* data, uint32_t numSamples, int timeout_ms)
 		return 0;
 	}
 
-	time.start();
-	m_mutex.lock();
-
-	if(timeout_ms == 0)
+	if (m_clearRequest.fetchAndStoreAcquire(0))
 	{
-		total = MIN(numSamples, m_fill);
+		drain(fill());
 	}
-	else
+
+	if ((timeout_ms > 0) && (fill() < MIN(numSamples, m_size)))
 	{
-		total = numSamples;
+		QElapsedTimer time;
+		time.start();
+		QMutexLocker mutexLocker(&m_waitMutex);
+		m_readerWaiting.fetchAndStoreOrdered(1); // before checking the fill so that the writer sees it or publishes before
+
+		while ((fill() < MIN(numSamples, m_size)) && (time.elapsed() < timeout_ms)) {
+			m_readWaitCondition.wait(&m_waitMutex, timeout_ms - time.elapsed());
+		}
+
+		m_readerWaiting.storeRelease(0);
 	}
 
+	// the writer can only add more samples meanwhile
+	total = MIN(numSamples, fill());
 	remaining = total;
 
 	while(remaining > 0)
 	{
-		if(isEmpty())
-		{
-			if(time.elapsed() < timeout_ms)
-			{
-				m_readWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_readWaitCondition.wait(&m_readWaitLock, ms);
-				m_readWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
-			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
-			}
-		}
-
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
+		copyLen = MIN(remaining, m_size - m_head);
 		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
 		m_head += copyLen;
 		m_head %= m_size;
-		m_fill -= copyLen;
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
-		m_writeWaitCondition.wakeOne();
 	}
 
-	m_mutex.unlock();
+	m_fill.fetchAndAddOrdered(-(int) total); // give room back to the writer
+
+	if (total < numSamples)
+	{
+		m_underrunCount.fetchAndAddRelaxed(numSamples - total);
+	}
+
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	uint32_t available = fill();
 
-	if(numSamples > m_fill)
+	if(numSamples > available)
 	{
-		numSamples = m_fill;
+		numSamples = available;
 	}
 
-	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	if (numSamples > 0)
+	{
+		m_head = (m_head + numSamples) % m_size;
+		m_fill.fetchAndAddOrdered(-(int) numSamples);
+	}
 
-	m_writeWaitCondition.wakeOne();
 	return numSamples;
 }
 
-void AudioFifo::clear()
+void AudioFifo::setOutputGain(float gain)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	qint32 bits;
+	memcpy(&bits, &gain, sizeof(bits));
+	m_outputGain.storeRelease(bits);
+}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+float AudioFifo::getOutputGain() const
+{
+	qint32 bits = m_outputGain.loadAcquire();
+	float gain;
+	memcpy(&gain, &bits, sizeof(gain));
+	return gain;
+}
 
-	m_writeWaitCondition.wakeOne();
+void AudioFifo::clear()
+{
+	m_clearRequest.storeRelease(1);
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -267,7 +218,7 @@ bool AudioFifo::create(uint32_t numSamples)
 	}
 
 	m_size = 0;
-	m_fill = 0;
+	m_fill.store(0);
 	m_head = 0;
 	m_tail = 0;
 
@@ -18,7 +18,9 @@
 #ifndef INCLUDE_AUDIOFIFO_H
 #define INCLUDE_AUDIOFIFO_H
 
+#include <climits>
 #include <QObject>
+#include <QAtomicInt>
 #include <QMutex>
 #include <QWaitCondition>
 
@@ -26,6 +28,13 @@
 #include "util/export.h"
 #include "util/udpsink.h"
 
+/**
+ * Single producer single consumer FIFO of audio samples between a channel and an audio device.
+ * The writer is a DSP thread and never waits: the samples that do not fit are dropped and counted as
+ * overrun. The reader waits up to its timeout for samples, then the samples missing are counted as
+ * underrun. With a zero timeout (audio callback) the reader does not wait or lock either: writer and
+ * reader only share the atomic fill count and the wait mutex is taken only to wake up a waiting reader.
+ */
 class SDRANGEL_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -33,39 +42,47 @@ public:
 	AudioFifo(uint32_t numSamples);
 	~AudioFifo();
 
-	bool setSize(uint32_t numSamples);
+	bool setSize(uint32_t numSamples); //!< Not thread safe: call before the FIFO is used
 
-	uint32_t write(const quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
-	uint32_t read(quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
+	uint32_t write(const quint8* data, uint32_t numSamples); //!< Never waits. Returns the samples written.
+	uint32_t read(quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX); //!< Waits up to timeout_ms for numSamples
 
-	uint32_t drain(uint32_t numSamples);
-	void clear();
+	uint32_t drain(uint32_t numSamples); //!< Reader side
+	void clear(); //!< Can be called by any side. Effective at the next read.
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return m_fill.loadAcquire(); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
+	uint32_t getOverrunCount() const { return m_overrunCount.loadAcquire(); }   //!< Samples dropped by write since last reset
+	uint32_t getUnderrunCount() const { return m_underrunCount.loadAcquire(); } //!< Samples missing in read since last reset
+	void resetCounters() { m_overrunCount.store(0); m_underrunCount.store(0); }
+
+	void setOutputGain(float gain); //!< Linear gain applied when mixed into the audio output. Any thread.
+	float getOutputGain() const;
+
 	void setUDPSink(UDPSink<AudioSample> *udpSink) { m_udpSink = udpSink; }
 	void setCopyToUDP(bool copyToUDP) { m_copyToUDP = copyToUDP; }
 
 private:
-	QMutex m_mutex;
-
 	qint8* m_fifo;
 
 	const uint32_t m_sampleSize;
 
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
-
-	QMutex m_writeWaitLock;
-	QMutex m_readWaitLock;
-	QWaitCondition m_writeWaitCondition;
-	QWaitCondition m_readWaitCondition;
+	QAtomicInt m_fill;           //!< published by the writer, released by the reader
+	uint32_t m_head;             //!< reader only
+	uint32_t m_tail;             //!< writer only
+	QAtomicInt m_clearRequest;
+	QAtomicInt m_overrunCount;
+	QAtomicInt m_underrunCount;
+	QAtomicInt m_outputGain;     //!< float bits: set by the GUI, read by the audio thread
+
+	QMutex m_waitMutex;
+	QWaitCondition m_readWaitCondition;  //!< samples published by the writer
+	QAtomicInt m_readerWaiting;
 
 	UDPSink<AudioSample> *m_udpSink;
 	bool m_copyToUDP;
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include "audio/audiomixer.h"
+
+#if USE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+void AudioMixer::accumulate(float* mix, const qint16* in, unsigned int nbSamples, float gain)
+{
+	unsigned int i = 0;
+
+#if USE_SSE2
+	__m128 g = _mm_set1_ps(gain);
+
+	for (; i + 8 <= nbSamples; i += 8)
+	{
+		__m128i s = _mm_loadu_si128((const __m128i*) (in + i));
+		__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16); // sign extension
+		__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+		_mm_storeu_ps(mix + i, _mm_add_ps(_mm_loadu_ps(mix + i), _mm_mul_ps(_mm_cvtepi32_ps(lo), g)));
+		_mm_storeu_ps(mix + i + 4, _mm_add_ps(_mm_loadu_ps(mix + i + 4), _mm_mul_ps(_mm_cvtepi32_ps(hi), g)));
+	}
+#elif defined(__aarch64__)
+	for (; i + 8 <= nbSamples; i += 8)
+	{
+		int16x8_t s = vld1q_s16(in + i);
+		float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+		float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+		vst1q_f32(mix + i, vmlaq_n_f32(vld1q_f32(mix + i), lo, gain));
+		vst1q_f32(mix + i + 4, vmlaq_n_f32(vld1q_f32(mix + i + 4), hi, gain));
+	}
+#endif
+
+	for (; i < nbSamples; i++) {
+		mix[i] += gain * in[i];
+	}
+}
+
+void AudioMixer::saturate(const float* mix, qint16* out, unsigned int nbSamples)
+{
+	unsigned int i = 0;
+
+#if USE_SSE2
+	// clamp before conversion as out of range floats convert to 0x80000000 whatever the sign
+	__m128 smin = _mm_set1_ps(-32768.0f);
+	__m128 smax = _mm_set1_ps(32767.0f);
+
+	for (; i + 8 <= nbSamples; i += 8)
+	{
+		__m128i lo = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i), smin), smax));
+		__m128i hi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i + 4), smin), smax));
+		_mm_storeu_si128((__m128i*) (out + i), _mm_packs_epi32(lo, hi));
+	}
+#elif defined(__aarch64__)
+	for (; i + 8 <= nbSamples; i += 8)
+	{
+		int32x4_t lo = vcvtnq_s32_f32(vld1q_f32(mix + i)); // saturating conversion
+		int32x4_t hi = vcvtnq_s32_f32(vld1q_f32(mix + i + 4));
+		vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+	}
+#endif
+
+	for (; i < nbSamples; i++)
+	{
+		float s = mix[i];
+
+		if (s < -32768.0f) {
+			s = -32768.0f;
+		} else if (s > 32767.0f) {
+			s = 32767.0f;
+		}
+
+		out[i] = (qint16) lrintf(s);
+	}
+}
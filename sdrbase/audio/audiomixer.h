@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_AUDIOMIXER_H
+#define INCLUDE_AUDIOMIXER_H
+
+#include <QtGlobal>
+#include "util/export.h"
+
+/**
+ * Mixing of the channel audio FIFOs into the audio device buffer. Samples are interleaved S16
+ * (stereo frames count as two samples). Channels are summed with their gain in a float buffer then
+ * the sum is saturated back to S16 once so that the channels do not clip each other.
+ */
+class SDRANGEL_API AudioMixer {
+public:
+	/** mix[i] += gain * in[i] */
+	static void accumulate(float* mix, const qint16* in, unsigned int nbSamples, float gain);
+	/** out[i] = mix[i] rounded and saturated to [-32768, 32767] */
+	static void saturate(const float* mix, qint16* out, unsigned int nbSamples);
+};
+
+#endif // INCLUDE_AUDIOMIXER_H
@@ -21,6 +21,7 @@
 #include <QAudioOutput>
 #include "audio/audiooutput.h"
 #include "audio/audiofifo.h"
+#include "audio/audiomixer.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(),
@@ -177,7 +178,7 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 
 	if (m_mixBuffer.size() < framesPerBuffer * 2)
 	{
-		m_mixBuffer.resize(framesPerBuffer * 2); // allocate 2 qint32 per frame (stereo)
+		m_mixBuffer.resize(framesPerBuffer * 2); // allocate 2 floats per frame (stereo)
 
 		if (m_mixBuffer.size() != framesPerBuffer * 2)
 		{
@@ -187,70 +188,17 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 
 	memset(&m_mixBuffer[0], 0x00, 2 * framesPerBuffer * sizeof(m_mixBuffer[0])); // start with silence
 
-	// sum up a block from all fifos
+	// sum up a block from all fifos. Reads do not wait: missing samples are silence counted as FIFO underrun.
 
 	for (AudioFifos::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
 	{
 		// use outputBuffer as temp - yes, one memcpy could be saved
-		uint samples = (*it)->read((quint8*) data, framesPerBuffer, 1);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
-
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
+		uint samples = (*it)->read((quint8*) data, framesPerBuffer, 0);
+		AudioMixer::accumulate(&m_mixBuffer[0], (const qint16*) data, 2 * samples, (*it)->getOutputGain());
+	}
 
-		for (uint i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
-    }
 	// convert to int16
-
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
-	qint16* dst = (qint16*) data;
-	qint32 s;
-
-	for (uint i = 0; i < framesPerBuffer; i++)
-	{
-		// left channel
-
-		//s = *src++; // Valgrind optim
-		s = m_mixBuffer[2*i];
-
-		if(s < -32768)
-		{
-			s = -32768;
-		}
-		else if (s > 32767)
-		{
-			s = 32767;
-		}
-
-		*dst++ = s;
-
-		// right channel
-
-		//s = *src++; // Valgrind optim
-		s = m_mixBuffer[2*i + 1];
-
-		if(s < -32768)
-		{
-			s = -32768;
-		}
-		else if (s > 32767)
-		{
-			s = 32767;
-		}
-
-		*dst++ = s;
-	}
+	AudioMixer::saturate(&m_mixBuffer[0], (qint16*) data, 2 * framesPerBuffer);
 
 	return framesPerBuffer * 4;
 }
@@ -51,7 +51,7 @@ private:
 
 	typedef std::list<AudioFifo*> AudioFifos;
 	AudioFifos m_audioFifos;
-	std::vector<qint32> m_mixBuffer;
+	std::vector<float> m_mixBuffer; //!< sum of the channels before saturation
 
 	QAudioFormat m_audioFormat;
 
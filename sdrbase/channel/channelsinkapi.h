@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_CHANNEL_CHANNELSINKAPI_H_
+#define SDRBASE_CHANNEL_CHANNELSINKAPI_H_
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+
+#include "util/export.h"
+
+/**
+ * Rx channel created by a plugin without its GUI. It owns the channel DSP objects registered with
+ * the device engine and reads and writes its settings in the same format as the channel GUI does
+ * in the presets so that presets saved by the GUI can be applied by the headless server.
+ */
+class SDRANGEL_API ChannelSinkAPI {
+public:
+    ChannelSinkAPI() { }
+    virtual ~ChannelSinkAPI() { }
+
+    virtual void destroy() = 0;
+
+    virtual void setName(const QString& name) = 0;
+    virtual QString getName() const = 0;
+
+    virtual qint64 getCenterFrequency() const = 0; //!< Frequency shift from the device center frequency
+    virtual void setCenterFrequency(qint64 centerFrequency) = 0;
+
+    virtual QByteArray serialize() const = 0;
+    virtual bool deserialize(const QByteArray& data) = 0;
+
+    virtual void purgeReports() { } //!< Drop the reports the channel sends to its GUI
+};
+
+#endif /* SDRBASE_CHANNEL_CHANNELSINKAPI_H_ */
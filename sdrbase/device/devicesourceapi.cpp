@@ -65,6 +65,11 @@ void DeviceSourceAPI::removeThreadedSink(ThreadedBasebandSampleSink* sink)
     m_deviceSourceEngine->removeThreadedSink(sink);
 }
 
+void DeviceSourceAPI::configureThreadedSinkSubBand(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate)
+{
+    m_deviceSourceEngine->configureThreadedSinkSubBand(sink, frequencyOffset, bandwidth, sampleRate);
+}
+
 void DeviceSourceAPI::setSource(DeviceSampleSource* source)
 {
     m_deviceSourceEngine->setSource(source);
@@ -127,7 +132,9 @@ GLSpectrum *DeviceSourceAPI::getSpectrum()
 
 void DeviceSourceAPI::addChannelMarker(ChannelMarker* channelMarker)
 {
-    m_spectrum->addChannelMarker(channelMarker);
+    if (m_spectrum) { // no spectrum display in the headless server
+        m_spectrum->addChannelMarker(channelMarker);
+    }
 }
 
 ChannelWindow *DeviceSourceAPI::getChannelWindow()
@@ -137,12 +144,16 @@ ChannelWindow *DeviceSourceAPI::getChannelWindow()
 
 void DeviceSourceAPI::addRollupWidget(QWidget *widget)
 {
-    m_channelWindow->addRollupWidget(widget);
+    if (m_channelWindow) {
+        m_channelWindow->addRollupWidget(widget);
+    }
 }
 
 void DeviceSourceAPI::setInputGUI(QWidget* inputGUI, const QString& sourceDisplayName)
 {
-    m_mainWindow->setDeviceGUI(m_deviceTabIndex, inputGUI, sourceDisplayName);
+    if (m_mainWindow) {
+        m_mainWindow->setDeviceGUI(m_deviceTabIndex, inputGUI, sourceDisplayName);
+    }
 }
 
 void DeviceSourceAPI::setHardwareId(const QString& id)
@@ -48,6 +48,7 @@ public:
     void removeSink(BasebandSampleSink* sink);    //!< Remove a sample sink from device engine
     void addThreadedSink(ThreadedBasebandSampleSink* sink);     //!< Add a sample sink that will run on its own thread to device engine
     void removeThreadedSink(ThreadedBasebandSampleSink* sink);  //!< Remove a sample sink that runs on its own thread from device engine
+    void configureThreadedSinkSubBand(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate); //!< Ask to feed a threaded sink from the shared filter bank
     void setSource(DeviceSampleSource* source); //!< Set device sample source
     DeviceSampleSource *getSource();      //!< Return pointer to the device sample source
     bool initAcquisition();               //!< Initialize device engine acquisition sequence
@@ -153,6 +154,7 @@ protected:
     bool m_isBuddyLeader;
 
     friend class MainWindow;
+    friend class MainCore;
     friend class DeviceSinkAPI;
 };
 
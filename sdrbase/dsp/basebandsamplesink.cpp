@@ -4,10 +4,16 @@
 BasebandSampleSink::BasebandSampleSink()
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+	DSPMetrics::instance()->addSink(this);
 }
 
 BasebandSampleSink::~BasebandSampleSink()
 {
+	DSPMetrics *metrics = DSPMetrics::instance();
+
+	if (metrics) { // null after the registry is destroyed at exit
+		metrics->removeSink(this);
+	}
 }
 
 void BasebandSampleSink::handleInputMessages()
@@ -20,6 +20,7 @@
 
 #include <QObject>
 #include "dsp/dsptypes.h"
+#include "dsp/dspmetrics.h"
 #include "util/export.h"
 #include "util/messagequeue.h"
 
@@ -38,10 +39,13 @@ public:
 
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
 	MessageQueue *getOutputMessageQueue() { return &m_outputMessageQueue; } //!< Get the queue for asynchronous outbound communication
+	SinkMetrics& getMetrics() { return m_metrics; }             //!< Updated by the thread calling feed
+	const SinkMetrics& getMetrics() const { return m_metrics; }
 
 protected:
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
 	MessageQueue m_outputMessageQueue; //!< Queue for asynchronous outbound communication
+	SinkMetrics m_metrics;
 
 protected slots:
 	void handleInputMessages();
@@ -48,10 +48,19 @@ void BasebandSampleSource::handleWriteToFifo(int nbSamples)
     m_sampleFifo.getWriteIterator(writeAt);
     pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
 
-    for (int i = 0; i < nbSamples; i++)
+    while (nbSamples > 0)
     {
-        pull((*writeAt));
-        m_sampleFifo.bumpIndex(writeAt);
+        unsigned int chunk = nbSamples < (int) m_sampleFifo.size() ? nbSamples : m_sampleFifo.size();
+        pull(writeAt, chunk);
+        m_sampleFifo.bumpIndex(writeAt, chunk);
+        nbSamples -= chunk;
+    }
+}
+
+void BasebandSampleSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pull(*begin);
     }
 }
 
@@ -35,6 +35,7 @@ public:
 	virtual void start() = 0;
 	virtual void stop() = 0;
 	virtual void pull(Sample& sample) = 0;
+	virtual void pull(SampleVector::iterator begin, unsigned int nbSamples); //!< Pull a block of samples. Default calls pull(Sample&) for each.
 	virtual void pullAudio(int nbSamples __attribute__((unused))) {}
 
     /** direct feeding of sample source FIFO */
@@ -44,10 +45,12 @@ public:
 	    sampleFifo->getWriteIterator(writeAt);
 	    pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
 
-	    for (int i = 0; i < nbSamples; i++)
+	    while (nbSamples > 0)
 	    {
-	        pull((*writeAt));
-	        sampleFifo->bumpIndex(writeAt);
+	        unsigned int chunk = nbSamples < (int) sampleFifo->size() ? nbSamples : sampleFifo->size();
+	        pull(writeAt, chunk);
+	        sampleFifo->bumpIndex(writeAt, chunk);
+	        nbSamples -= chunk;
 	    }
 	}
 
@@ -18,6 +18,7 @@
 #define INCLUDE_GPL_DSP_DECIMATORS_H_
 
 #include "dsp/dsptypes.h"
+#include "dsp/decimatorssimd.h"
 #ifdef USE_SSE4_1
 #include "dsp/inthalfbandfiltereo1.h"
 #else
@@ -102,6 +103,12 @@ template<typename T, uint SdrBits, uint InputBits>
 class Decimators
 {
 public:
+    Decimators() : m_kernels(DecimatorsSIMD::getKernels()) {}
+
+    /** Kernels used by the center decimations. Best ones for the CPU by default */
+    void setKernels(const DecimatorsSIMDKernels *kernels) { m_kernels = kernels; }
+    const DecimatorsSIMDKernels *getKernels() const { return m_kernels; }
+
     // interleaved I/Q input buffer
 	void decimate1(SampleVector::iterator* it, const T* buf, qint32 len);
 	void decimate2_u(SampleVector::iterator* it, const T* buf, qint32 len);
@@ -146,6 +153,12 @@ public:
     void decimate64_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
 
 private:
+    void decimateCen(SampleVector::iterator* it, const T* buf, qint32 len, int log2Decim, uint preShift, uint postShift);
+
+    const DecimatorsSIMDKernels *m_kernels;
+    DecimatorsHalfband m_cenStages[6];         // center decimation stages processed by blocks
+    qint32 m_cenBlock[2][DECIMATORS_SIMD_BLOCK_SIZE];
+
 #ifdef USE_SSE4_1
     IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> m_decimator2;  // 1st stages
     IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> m_decimator4;  // 2nd stages
@@ -888,25 +901,34 @@ void Decimators<T, SdrBits, InputBits>::decimate64_sup(SampleVector::iterator* i
 }
 
 template<typename T, uint SdrBits, uint InputBits>
-void Decimators<T, SdrBits, InputBits>::decimate2_cen(SampleVector::iterator* it, const T* buf, qint32 len)
+void Decimators<T, SdrBits, InputBits>::decimateCen(SampleVector::iterator* it, const T* buf, qint32 len, int log2Decim, uint preShift, uint postShift)
 {
-	qint32 intbuf[2];
+    // whole output samples only like the sample by sample implementation
+    int nbSamples = (len/2) & ~((1<<log2Decim) - 1);
 
-	for (int pos = 0; pos < len - 3; pos += 4)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre2;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre2;
+    for (int pos = 0; pos < nbSamples; pos += DECIMATORS_SIMD_BLOCK_SIZE)
+    {
+        int nb = nbSamples - pos < DECIMATORS_SIMD_BLOCK_SIZE ? nbSamples - pos : DECIMATORS_SIMD_BLOCK_SIZE;
 
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre2,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre2,
-				&intbuf[0],
-				&intbuf[1]);
+        DecimatorsSIMD::convert(m_kernels, &buf[2*pos], m_cenBlock[0], m_cenBlock[1], nb, preShift);
 
-		(**it).setReal(intbuf[0] >> decimation_shifts<SdrBits, InputBits>::post2);
-		(**it).setImag(intbuf[1] >> decimation_shifts<SdrBits, InputBits>::post2);
-		++(*it);
-	}
+        for (int stage = 0; stage < log2Decim; stage++) {
+            nb = m_kernels->halfband(&m_cenStages[stage], m_cenBlock[0], m_cenBlock[1], nb);
+        }
+
+        for (int k = 0; k < nb; k++)
+        {
+            (**it).setReal(m_cenBlock[0][k] >> postShift);
+            (**it).setImag(m_cenBlock[1][k] >> postShift);
+            ++(*it);
+        }
+    }
+}
+
+template<typename T, uint SdrBits, uint InputBits>
+void Decimators<T, SdrBits, InputBits>::decimate2_cen(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    decimateCen(it, buf, len, 1, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -934,36 +956,7 @@ void Decimators<T, SdrBits, InputBits>::decimate2_cen(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate4_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
-	qint32 intbuf[4];
-
-	for (int pos = 0; pos < len - 7; pos += 8)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre4;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre4;
-		intbuf[2]  = buf[pos+6] << decimation_shifts<SdrBits, InputBits>::pre4;
-		intbuf[3]  = buf[pos+7] << decimation_shifts<SdrBits, InputBits>::pre4;
-
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre4,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre4,
-				&intbuf[0],
-				&intbuf[1]);
-		m_decimator2.myDecimate(
-				buf[pos+4] << decimation_shifts<SdrBits, InputBits>::pre4,
-				buf[pos+5] << decimation_shifts<SdrBits, InputBits>::pre4,
-				&intbuf[2],
-				&intbuf[3]);
-
-		m_decimator4.myDecimate(
-				intbuf[0],
-				intbuf[1],
-				&intbuf[2],
-				&intbuf[3]);
-
-		(**it).setReal(intbuf[2] >> decimation_shifts<SdrBits, InputBits>::post4);
-		(**it).setImag(intbuf[3] >> decimation_shifts<SdrBits, InputBits>::post4);
-		++(*it);
-	}
+    decimateCen(it, buf, len, 2, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -1004,61 +997,7 @@ void Decimators<T, SdrBits, InputBits>::decimate4_cen(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate8_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
-	qint32 intbuf[8];
-
-	for (int pos = 0; pos < len - 15; pos += 16)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[2]  = buf[pos+6] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[3]  = buf[pos+7] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[4]  = buf[pos+10] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[5]  = buf[pos+11] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[6]  = buf[pos+14] << decimation_shifts<SdrBits, InputBits>::pre8;
-		intbuf[7]  = buf[pos+15] << decimation_shifts<SdrBits, InputBits>::pre8;
-
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre8,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre8,
-				&intbuf[0],
-				&intbuf[1]);
-		m_decimator2.myDecimate(
-				buf[pos+4] << decimation_shifts<SdrBits, InputBits>::pre8,
-				buf[pos+5] << decimation_shifts<SdrBits, InputBits>::pre8,
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator2.myDecimate(
-				buf[pos+8] << decimation_shifts<SdrBits, InputBits>::pre8,
-				buf[pos+9] << decimation_shifts<SdrBits, InputBits>::pre8,
-				&intbuf[4],
-				&intbuf[5]);
-		m_decimator2.myDecimate(
-				buf[pos+12] << decimation_shifts<SdrBits, InputBits>::pre8,
-				buf[pos+13] << decimation_shifts<SdrBits, InputBits>::pre8,
-				&intbuf[6],
-				&intbuf[7]);
-
-		m_decimator4.myDecimate(
-				intbuf[0],
-				intbuf[1],
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator4.myDecimate(
-				intbuf[4],
-				intbuf[5],
-				&intbuf[6],
-				&intbuf[7]);
-
-		m_decimator8.myDecimate(
-				intbuf[2],
-				intbuf[3],
-				&intbuf[6],
-				&intbuf[7]);
-
-		(**it).setReal(intbuf[6] >> decimation_shifts<SdrBits, InputBits>::post8);
-		(**it).setImag(intbuf[7] >> decimation_shifts<SdrBits, InputBits>::post8);
-		++(*it);
-	}
+    decimateCen(it, buf, len, 3, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -1124,110 +1063,7 @@ void Decimators<T, SdrBits, InputBits>::decimate8_cen(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate16_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
-	qint32 intbuf[16];
-
-	for (int pos = 0; pos < len - 31; pos += 32)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[2]  = buf[pos+6] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[3]  = buf[pos+7] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[4]  = buf[pos+10] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[5]  = buf[pos+11] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[6]  = buf[pos+14] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[7]  = buf[pos+15] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[8]  = buf[pos+18] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[9]  = buf[pos+19] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[10] = buf[pos+22] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[11] = buf[pos+23] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[12] = buf[pos+26] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[13] = buf[pos+27] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[14] = buf[pos+30] << decimation_shifts<SdrBits, InputBits>::pre16;
-		intbuf[15] = buf[pos+31] << decimation_shifts<SdrBits, InputBits>::pre16;
-
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[0],
-				&intbuf[1]);
-		m_decimator2.myDecimate(
-				buf[pos+4] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+5] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator2.myDecimate(
-				buf[pos+8] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+9] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[4],
-				&intbuf[5]);
-		m_decimator2.myDecimate(
-				buf[pos+12] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+13] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator2.myDecimate(
-				buf[pos+16] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+17] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[8],
-				&intbuf[9]);
-		m_decimator2.myDecimate(
-				buf[pos+20] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+21] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator2.myDecimate(
-				buf[pos+24] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+25] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[12],
-				&intbuf[13]);
-		m_decimator2.myDecimate(
-				buf[pos+28] << decimation_shifts<SdrBits, InputBits>::pre16,
-				buf[pos+29] << decimation_shifts<SdrBits, InputBits>::pre16,
-				&intbuf[14],
-				&intbuf[15]);
-
-		m_decimator4.myDecimate(
-				intbuf[0],
-				intbuf[1],
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator4.myDecimate(
-				intbuf[4],
-				intbuf[5],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator4.myDecimate(
-				intbuf[8],
-				intbuf[9],
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator4.myDecimate(
-				intbuf[12],
-				intbuf[13],
-				&intbuf[14],
-				&intbuf[15]);
-
-		m_decimator8.myDecimate(
-				intbuf[2],
-				intbuf[3],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator8.myDecimate(
-				intbuf[10],
-				intbuf[11],
-				&intbuf[14],
-				&intbuf[15]);
-
-		m_decimator16.myDecimate(
-				intbuf[6],
-				intbuf[7],
-				&intbuf[14],
-				&intbuf[15]);
-
-		(**it).setReal(intbuf[14] >> decimation_shifts<SdrBits, InputBits>::post16);
-		(**it).setImag(intbuf[15] >> decimation_shifts<SdrBits, InputBits>::post16);
-		++(*it);
-	}
+    decimateCen(it, buf, len, 4, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -1342,207 +1178,7 @@ void Decimators<T, SdrBits, InputBits>::decimate16_cen(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate32_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
-	qint32 intbuf[32];
-
-	for (int pos = 0; pos < len - 63; pos += 64)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[2]  = buf[pos+6] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[3]  = buf[pos+7] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[4]  = buf[pos+10] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[5]  = buf[pos+11] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[6]  = buf[pos+14] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[7]  = buf[pos+15] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[8]  = buf[pos+18] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[9]  = buf[pos+19] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[10] = buf[pos+22] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[11] = buf[pos+23] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[12] = buf[pos+26] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[13] = buf[pos+27] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[14] = buf[pos+30] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[15] = buf[pos+31] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[16] = buf[pos+34] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[17] = buf[pos+35] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[18] = buf[pos+38] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[19] = buf[pos+39] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[20] = buf[pos+42] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[21] = buf[pos+43] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[22] = buf[pos+46] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[23] = buf[pos+47] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[24] = buf[pos+50] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[25] = buf[pos+51] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[26] = buf[pos+54] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[27] = buf[pos+55] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[28] = buf[pos+58] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[29] = buf[pos+59] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[30] = buf[pos+62] << decimation_shifts<SdrBits, InputBits>::pre32;
-		intbuf[31] = buf[pos+63] << decimation_shifts<SdrBits, InputBits>::pre32;
-
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[0],
-				&intbuf[1]);
-		m_decimator2.myDecimate(
-				buf[pos+4] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+5] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator2.myDecimate(
-				buf[pos+8] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+9] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[4],
-				&intbuf[5]);
-		m_decimator2.myDecimate(
-				buf[pos+12] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+13] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator2.myDecimate(
-				buf[pos+16] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+17] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[8],
-				&intbuf[9]);
-		m_decimator2.myDecimate(
-				buf[pos+20] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+21] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator2.myDecimate(
-				buf[pos+24] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+25] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[12],
-				&intbuf[13]);
-		m_decimator2.myDecimate(
-				buf[pos+28] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+29] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator2.myDecimate(
-				buf[pos+32] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+33] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[16],
-				&intbuf[17]);
-		m_decimator2.myDecimate(
-				buf[pos+36] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+37] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[18],
-				&intbuf[19]);
-		m_decimator2.myDecimate(
-				buf[pos+40] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+41] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[20],
-				&intbuf[21]);
-		m_decimator2.myDecimate(
-				buf[pos+44] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+45] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator2.myDecimate(
-				buf[pos+48] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+49] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[24],
-				&intbuf[25]);
-		m_decimator2.myDecimate(
-				buf[pos+52] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+53] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[26],
-				&intbuf[27]);
-		m_decimator2.myDecimate(
-				buf[pos+56] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+57] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[28],
-				&intbuf[29]);
-		m_decimator2.myDecimate(
-				buf[pos+60] << decimation_shifts<SdrBits, InputBits>::pre32,
-				buf[pos+61] << decimation_shifts<SdrBits, InputBits>::pre32,
-				&intbuf[30],
-				&intbuf[31]);
-
-		m_decimator4.myDecimate(
-				intbuf[0],
-				intbuf[1],
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator4.myDecimate(
-				intbuf[4],
-				intbuf[5],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator4.myDecimate(
-				intbuf[8],
-				intbuf[9],
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator4.myDecimate(
-				intbuf[12],
-				intbuf[13],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator4.myDecimate(
-				intbuf[16],
-				intbuf[17],
-				&intbuf[18],
-				&intbuf[19]);
-		m_decimator4.myDecimate(
-				intbuf[20],
-				intbuf[21],
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator4.myDecimate(
-				intbuf[24],
-				intbuf[25],
-				&intbuf[26],
-				&intbuf[27]);
-		m_decimator4.myDecimate(
-				intbuf[28],
-				intbuf[29],
-				&intbuf[30],
-				&intbuf[31]);
-
-		m_decimator8.myDecimate(
-				intbuf[2],
-				intbuf[3],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator8.myDecimate(
-				intbuf[10],
-				intbuf[11],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator8.myDecimate(
-				intbuf[18],
-				intbuf[19],
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator8.myDecimate(
-				intbuf[26],
-				intbuf[27],
-				&intbuf[30],
-				&intbuf[31]);
-
-		m_decimator16.myDecimate(
-				intbuf[6],
-				intbuf[7],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator16.myDecimate(
-				intbuf[22],
-				intbuf[23],
-				&intbuf[30],
-				&intbuf[31]);
-
-		m_decimator32.myDecimate(
-				intbuf[14],
-				intbuf[15],
-				&intbuf[30],
-				&intbuf[31]);
-
-		(**it).setReal(intbuf[30] >> decimation_shifts<SdrBits, InputBits>::post32);
-		(**it).setImag(intbuf[31] >> decimation_shifts<SdrBits, InputBits>::post32);
-		++(*it);
-	}
+    decimateCen(it, buf, len, 5, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -1754,401 +1390,7 @@ void Decimators<T, SdrBits, InputBits>::decimate32_cen(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate64_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
-	qint32 intbuf[64];
-
-	for (int pos = 0; pos < len - 127; pos += 128)
-	{
-		intbuf[0]  = buf[pos+2] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[1]  = buf[pos+3] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[2]  = buf[pos+6] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[3]  = buf[pos+7] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[4]  = buf[pos+10] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[5]  = buf[pos+11] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[6]  = buf[pos+14] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[7]  = buf[pos+15] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[8]  = buf[pos+18] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[9]  = buf[pos+19] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[10] = buf[pos+22] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[11] = buf[pos+23] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[12] = buf[pos+26] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[13] = buf[pos+27] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[14] = buf[pos+30] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[15] = buf[pos+31] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[16] = buf[pos+34] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[17] = buf[pos+35] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[18] = buf[pos+38] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[19] = buf[pos+39] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[20] = buf[pos+42] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[21] = buf[pos+43] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[22] = buf[pos+46] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[23] = buf[pos+47] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[24] = buf[pos+50] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[25] = buf[pos+51] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[26] = buf[pos+54] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[27] = buf[pos+55] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[28] = buf[pos+58] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[29] = buf[pos+59] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[30] = buf[pos+62] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[31] = buf[pos+63] << decimation_shifts<SdrBits, InputBits>::pre64;
-
-		intbuf[32] = buf[pos+66] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[33] = buf[pos+67] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[34] = buf[pos+70] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[35] = buf[pos+71] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[36] = buf[pos+74] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[37] = buf[pos+75] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[38] = buf[pos+78] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[39] = buf[pos+79] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[40] = buf[pos+82] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[41] = buf[pos+83] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[42] = buf[pos+86] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[43] = buf[pos+87] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[44] = buf[pos+90] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[45] = buf[pos+91] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[46] = buf[pos+94] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[47] = buf[pos+95] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[48] = buf[pos+98] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[49] = buf[pos+99] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[50] = buf[pos+102] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[51] = buf[pos+103] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[52] = buf[pos+106] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[53] = buf[pos+107] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[54] = buf[pos+110] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[55] = buf[pos+111] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[56] = buf[pos+114] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[57] = buf[pos+115] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[58] = buf[pos+118] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[59] = buf[pos+119] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[60] = buf[pos+122] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[61] = buf[pos+123] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[62] = buf[pos+126] << decimation_shifts<SdrBits, InputBits>::pre64;
-		intbuf[63] = buf[pos+127] << decimation_shifts<SdrBits, InputBits>::pre64;
-
-		m_decimator2.myDecimate(
-				buf[pos+0] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+1] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[0],
-				&intbuf[1]);
-		m_decimator2.myDecimate(
-				buf[pos+4] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+5] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator2.myDecimate(
-				buf[pos+8] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+9] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[4],
-				&intbuf[5]);
-		m_decimator2.myDecimate(
-				buf[pos+12] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+13] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator2.myDecimate(
-				buf[pos+16] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+17] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[8],
-				&intbuf[9]);
-		m_decimator2.myDecimate(
-				buf[pos+20] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+21] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator2.myDecimate(
-				buf[pos+24] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+25] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[12],
-				&intbuf[13]);
-		m_decimator2.myDecimate(
-				buf[pos+28] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+29] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator2.myDecimate(
-				buf[pos+32] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+33] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[16],
-				&intbuf[17]);
-		m_decimator2.myDecimate(
-				buf[pos+36] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+37] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[18],
-				&intbuf[19]);
-		m_decimator2.myDecimate(
-				buf[pos+40] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+41] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[20],
-				&intbuf[21]);
-		m_decimator2.myDecimate(
-				buf[pos+44] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+45] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator2.myDecimate(
-				buf[pos+48] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+49] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[24],
-				&intbuf[25]);
-		m_decimator2.myDecimate(
-				buf[pos+52] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+53] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[26],
-				&intbuf[27]);
-		m_decimator2.myDecimate(
-				buf[pos+56] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+57] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[28],
-				&intbuf[29]);
-		m_decimator2.myDecimate(
-				buf[pos+60] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+61] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[30],
-				&intbuf[31]);
-		m_decimator2.myDecimate(
-				buf[pos+64] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+65] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[32],
-				&intbuf[33]);
-		m_decimator2.myDecimate(
-				buf[pos+68] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+69] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[34],
-				&intbuf[35]);
-		m_decimator2.myDecimate(
-				buf[pos+72] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+73] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[36],
-				&intbuf[37]);
-		m_decimator2.myDecimate(
-				buf[pos+76] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+77] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[38],
-				&intbuf[39]);
-		m_decimator2.myDecimate(
-				buf[pos+80] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+81] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[40],
-				&intbuf[41]);
-		m_decimator2.myDecimate(
-				buf[pos+84] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+85] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[42],
-				&intbuf[43]);
-		m_decimator2.myDecimate(
-				buf[pos+88] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+89] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[44],
-				&intbuf[45]);
-		m_decimator2.myDecimate(
-				buf[pos+92] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+93] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[46],
-				&intbuf[47]);
-		m_decimator2.myDecimate(
-				buf[pos+96] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+97] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[48],
-				&intbuf[49]);
-		m_decimator2.myDecimate(
-				buf[pos+100] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+101] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[50],
-				&intbuf[51]);
-		m_decimator2.myDecimate(
-				buf[pos+104] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+105] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[52],
-				&intbuf[53]);
-		m_decimator2.myDecimate(
-				buf[pos+108] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+109] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[54],
-				&intbuf[55]);
-		m_decimator2.myDecimate(
-				buf[pos+112] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+113] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[56],
-				&intbuf[57]);
-		m_decimator2.myDecimate(
-				buf[pos+116] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+117] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[58],
-				&intbuf[59]);
-		m_decimator2.myDecimate(
-				buf[pos+120] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+121] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[60],
-				&intbuf[61]);
-		m_decimator2.myDecimate(
-				buf[pos+124] << decimation_shifts<SdrBits, InputBits>::pre64,
-				buf[pos+125] << decimation_shifts<SdrBits, InputBits>::pre64,
-				&intbuf[62],
-				&intbuf[63]);
-
-		m_decimator4.myDecimate(
-				intbuf[0],
-				intbuf[1],
-				&intbuf[2],
-				&intbuf[3]);
-		m_decimator4.myDecimate(
-				intbuf[4],
-				intbuf[5],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator4.myDecimate(
-				intbuf[8],
-				intbuf[9],
-				&intbuf[10],
-				&intbuf[11]);
-		m_decimator4.myDecimate(
-				intbuf[12],
-				intbuf[13],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator4.myDecimate(
-				intbuf[16],
-				intbuf[17],
-				&intbuf[18],
-				&intbuf[19]);
-		m_decimator4.myDecimate(
-				intbuf[20],
-				intbuf[21],
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator4.myDecimate(
-				intbuf[24],
-				intbuf[25],
-				&intbuf[26],
-				&intbuf[27]);
-		m_decimator4.myDecimate(
-				intbuf[28],
-				intbuf[29],
-				&intbuf[30],
-				&intbuf[31]);
-		m_decimator4.myDecimate(
-				intbuf[32],
-				intbuf[33],
-				&intbuf[34],
-				&intbuf[35]);
-		m_decimator4.myDecimate(
-				intbuf[36],
-				intbuf[37],
-				&intbuf[38],
-				&intbuf[39]);
-		m_decimator4.myDecimate(
-				intbuf[40],
-				intbuf[41],
-				&intbuf[42],
-				&intbuf[43]);
-		m_decimator4.myDecimate(
-				intbuf[44],
-				intbuf[45],
-				&intbuf[46],
-				&intbuf[47]);
-		m_decimator4.myDecimate(
-				intbuf[48],
-				intbuf[49],
-				&intbuf[50],
-				&intbuf[51]);
-		m_decimator4.myDecimate(
-				intbuf[52],
-				intbuf[53],
-				&intbuf[54],
-				&intbuf[55]);
-		m_decimator4.myDecimate(
-				intbuf[56],
-				intbuf[57],
-				&intbuf[58],
-				&intbuf[59]);
-		m_decimator4.myDecimate(
-				intbuf[60],
-				intbuf[61],
-				&intbuf[62],
-				&intbuf[63]);
-
-		m_decimator8.myDecimate(
-				intbuf[2],
-				intbuf[3],
-				&intbuf[6],
-				&intbuf[7]);
-		m_decimator8.myDecimate(
-				intbuf[10],
-				intbuf[11],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator8.myDecimate(
-				intbuf[18],
-				intbuf[19],
-				&intbuf[22],
-				&intbuf[23]);
-		m_decimator8.myDecimate(
-				intbuf[26],
-				intbuf[27],
-				&intbuf[30],
-				&intbuf[31]);
-		m_decimator8.myDecimate(
-				intbuf[34],
-				intbuf[35],
-				&intbuf[38],
-				&intbuf[39]);
-		m_decimator8.myDecimate(
-				intbuf[42],
-				intbuf[43],
-				&intbuf[46],
-				&intbuf[47]);
-		m_decimator8.myDecimate(
-				intbuf[50],
-				intbuf[51],
-				&intbuf[54],
-				&intbuf[55]);
-		m_decimator8.myDecimate(
-				intbuf[58],
-				intbuf[59],
-				&intbuf[62],
-				&intbuf[63]);
-
-		m_decimator16.myDecimate(
-				intbuf[6],
-				intbuf[7],
-				&intbuf[14],
-				&intbuf[15]);
-		m_decimator16.myDecimate(
-				intbuf[22],
-				intbuf[23],
-				&intbuf[30],
-				&intbuf[31]);
-		m_decimator16.myDecimate(
-				intbuf[38],
-				intbuf[39],
-				&intbuf[46],
-				&intbuf[47]);
-		m_decimator16.myDecimate(
-				intbuf[54],
-				intbuf[55],
-				&intbuf[62],
-				&intbuf[63]);
-
-		m_decimator32.myDecimate(
-				intbuf[14],
-				intbuf[15],
-				&intbuf[30],
-				&intbuf[31]);
-		m_decimator32.myDecimate(
-				intbuf[46],
-				intbuf[47],
-				&intbuf[62],
-				&intbuf[63]);
-
-		m_decimator64.myDecimate(
-				intbuf[30],
-				intbuf[31],
-				&intbuf[62],
-				&intbuf[63]);
-
-		(**it).setReal(intbuf[62] >> decimation_shifts<SdrBits, InputBits>::post64);
-		(**it).setImag(intbuf[63] >> decimation_shifts<SdrBits, InputBits>::post64);
-		++(*it);
-	}
+    decimateCen(it, buf, len, 6, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64);
 }
 
 template<typename T, uint SdrBits, uint InputBits>
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include <QDebug>
+
+#include "decimatorssimd.h"
+
+DecimatorsHalfband::DecimatorsHalfband()
+{
+    reset();
+}
+
+void DecimatorsHalfband::reset()
+{
+    memset(m_a, 0, sizeof(m_a));
+    memset(m_b, 0, sizeof(m_b));
+}
+
+namespace
+{
+
+template<typename T>
+void convertScalar(const T *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    for (int k = 0; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+int halfbandScalar(DecimatorsHalfband *hb, qint32 *x, qint32 *y, int nbSamples)
+{
+    int nbOut = hb->deinterleave(x, y, nbSamples);
+
+    for (int k = 0; k < nbOut; k++)
+    {
+        x[k] = hb->fir(0, k);
+        y[k] = hb->fir(1, k);
+    }
+
+    hb->shiftHistory(nbOut);
+    return nbOut;
+}
+
+const DecimatorsSIMDKernels kernelsScalar = {
+    "scalar",
+    convertScalar<quint8>,
+    convertScalar<qint8>,
+    convertScalar<qint16>,
+    halfbandScalar
+};
+
+} // namespace
+
+bool DecimatorsSIMD::isSupported(Arch arch)
+{
+    switch (arch)
+    {
+    case ArchScalar:
+        return true;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    case ArchSSE4_1:
+        return __builtin_cpu_supports("sse4.1");
+    case ArchAVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    case ArchNEON:
+        return true; // only built when the target has NEON
+    default:
+        return false;
+    }
+}
+
+const DecimatorsSIMDKernels *DecimatorsSIMD::getKernels(Arch arch)
+{
+    const DecimatorsSIMDKernels *kernels;
+
+    switch (arch)
+    {
+    case ArchScalar:
+        kernels = &kernelsScalar;
+        break;
+    case ArchSSE4_1:
+        kernels = getDecimatorsKernelsSSE4_1();
+        break;
+    case ArchAVX2:
+        kernels = getDecimatorsKernelsAVX2();
+        break;
+    case ArchNEON:
+        kernels = getDecimatorsKernelsNEON();
+        break;
+    default:
+        kernels = 0;
+        break;
+    }
+
+    return (kernels && isSupported(arch)) ? kernels : 0;
+}
+
+const DecimatorsSIMDKernels *DecimatorsSIMD::selectKernels()
+{
+    const Arch archs[] = {ArchAVX2, ArchNEON, ArchSSE4_1};
+    const DecimatorsSIMDKernels *kernels = &kernelsScalar;
+
+    for (unsigned int i = 0; i < sizeof(archs)/sizeof(archs[0]); i++)
+    {
+        if (getKernels(archs[i]))
+        {
+            kernels = getKernels(archs[i]);
+            break;
+        }
+    }
+
+    qDebug("DecimatorsSIMD::selectKernels: using %s kernels", kernels->m_name);
+    return kernels;
+}
+
+const DecimatorsSIMDKernels *DecimatorsSIMD::getKernels()
+{
+    static const DecimatorsSIMDKernels *best = selectKernels(); // thread safe initialization
+    return best;
+}
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#ifndef SDRBASE_DSP_DECIMATORSSIMD_H_
+#define SDRBASE_DSP_DECIMATORSSIMD_H_
+
+#include <QtGlobal>
+
+#include "dsp/hbfiltertraits.h"
+#include "util/export.h"
+
+#define DECIMATORS_SIMD_HB_FILTER_ORDER 64
+#define DECIMATORS_SIMD_BLOCK_SIZE 2048 //!< complex samples converted and filtered at once
+#define DECIMATORS_SIMD_HISTORY 32      //!< samples kept per phase between blocks (hbOrder/2 - 1 rounded up)
+
+/**
+ * State of one half-band decimate by 2 (center) stage processed by blocks.
+ *
+ * The input is split in its two polyphase components: A holds the second sample of each pair and
+ * B the first one. With h the half-band coefficients and Q = hbOrder/4 the output is:
+ *   out[m] = (sum(i=0..Q-1) h[i] * (A[m-i] + A[m-2Q+1+i]) + (B[m-Q+1] << (hbShift-1))) >> (hbShift-1)
+ * which is exactly what IntHalfbandFilterEO1::myDecimate and IntHalfbandFilterDB::myDecimate compute
+ * one sample pair at a time. Outputs are independent so the kernels compute several at once.
+ */
+class SDRANGEL_API DecimatorsHalfband
+{
+public:
+    DecimatorsHalfband();
+    void reset();
+
+    /** split n (even) samples at the end of the history. Returns the number of outputs n/2 */
+    int deinterleave(const qint32 *x, const qint32 *y, int nbSamples)
+    {
+        int nbOut = nbSamples/2;
+
+        for (int k = 0; k < nbOut; k++)
+        {
+            m_b[0][DECIMATORS_SIMD_HISTORY + k] = x[2*k];
+            m_b[1][DECIMATORS_SIMD_HISTORY + k] = y[2*k];
+            m_a[0][DECIMATORS_SIMD_HISTORY + k] = x[2*k+1];
+            m_a[1][DECIMATORS_SIMD_HISTORY + k] = y[2*k+1];
+        }
+
+        return nbOut;
+    }
+
+    /** scalar computation of output k of the current block for I (c = 0) or Q (c = 1) */
+    qint32 fir(int c, int k) const
+    {
+        const qint32 *a = &m_a[c][DECIMATORS_SIMD_HISTORY + k];
+        qint32 acc = 0;
+
+        for (int i = 0; i < nbCoeffs; i++) {
+            acc += (a[-i] + a[i + 1 - 2*nbCoeffs]) * HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbCoeffs[i];
+        }
+
+        acc += m_b[c][DECIMATORS_SIMD_HISTORY + k + 1 - nbCoeffs] << (HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbShift - 1);
+        return acc >> (HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbShift - 1);
+    }
+
+    /** keep the last samples of the block as history for the next one */
+    void shiftHistory(int nbOut)
+    {
+        for (int c = 0; c < 2; c++)
+        {
+            for (int k = 0; k < DECIMATORS_SIMD_HISTORY; k++)
+            {
+                m_a[c][k] = m_a[c][nbOut + k];
+                m_b[c][k] = m_b[c][nbOut + k];
+            }
+        }
+    }
+
+    static const int nbCoeffs = HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbOrder / 4;
+
+    qint32 m_a[2][DECIMATORS_SIMD_HISTORY + DECIMATORS_SIMD_BLOCK_SIZE/2]; //!< [0]: I [1]: Q
+    qint32 m_b[2][DECIMATORS_SIMD_HISTORY + DECIMATORS_SIMD_BLOCK_SIZE/2];
+};
+
+/**
+ * Conversion and half-band kernels for one instruction set. All kernels give the same results
+ * sample for sample. The half-band kernel decimates in place and returns the number of outputs.
+ */
+struct DecimatorsSIMDKernels
+{
+    const char *m_name;
+    void (*convertU8)(const quint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift);
+    void (*convertS8)(const qint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift);
+    void (*convertS16)(const qint16 *buf, qint32 *x, qint32 *y, int nbSamples, int shift);
+    int (*halfband)(DecimatorsHalfband *hb, qint32 *x, qint32 *y, int nbSamples);
+};
+
+class SDRANGEL_API DecimatorsSIMD
+{
+public:
+    typedef enum
+    {
+        ArchScalar,
+        ArchSSE4_1,
+        ArchAVX2,
+        ArchNEON
+    } Arch;
+
+    static const DecimatorsSIMDKernels *getKernels();          //!< best kernels for this CPU, detected once
+    static const DecimatorsSIMDKernels *getKernels(Arch arch); //!< NULL if not built or not supported by this CPU
+    static bool isSupported(Arch arch);                        //!< instruction set usable on this CPU
+
+    static void convert(const DecimatorsSIMDKernels *kernels, const quint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift) {
+        kernels->convertU8(buf, x, y, nbSamples, shift);
+    }
+    static void convert(const DecimatorsSIMDKernels *kernels, const qint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift) {
+        kernels->convertS8(buf, x, y, nbSamples, shift);
+    }
+    static void convert(const DecimatorsSIMDKernels *kernels, const qint16 *buf, qint32 *x, qint32 *y, int nbSamples, int shift) {
+        kernels->convertS16(buf, x, y, nbSamples, shift);
+    }
+
+private:
+    static const DecimatorsSIMDKernels *selectKernels();
+};
+
+// kernels of the instruction set specific translation units. NULL when not built.
+const DecimatorsSIMDKernels *getDecimatorsKernelsSSE4_1();
+const DecimatorsSIMDKernels *getDecimatorsKernelsAVX2();
+const DecimatorsSIMDKernels *getDecimatorsKernelsNEON();
+
+#endif /* SDRBASE_DSP_DECIMATORSSIMD_H_ */
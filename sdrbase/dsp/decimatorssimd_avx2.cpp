@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+// Compiled with AVX2 code generation enabled. Only called when the CPU supports it.
+
+#include "decimatorssimd.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace
+{
+
+const int hbShift = HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbShift - 1;
+
+// [I0 Q0 .. I3 Q3] [I4 Q4 .. I7 Q7] -> [I0 .. I7] [Q0 .. Q7]
+inline void split(__m256i v0, __m256i v1, qint32 *x, qint32 *y, __m128i shift)
+{
+    const __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    v0 = _mm256_permutevar8x32_epi32(v0, idx);
+    v1 = _mm256_permutevar8x32_epi32(v1, idx);
+    _mm256_storeu_si256((__m256i*) x, _mm256_sll_epi32(_mm256_permute2x128_si256(v0, v1, 0x20), shift));
+    _mm256_storeu_si256((__m256i*) y, _mm256_sll_epi32(_mm256_permute2x128_si256(v0, v1, 0x31), shift));
+}
+
+void convertU8(const quint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &buf[2*k]);
+        split(_mm256_cvtepu8_epi32(v), _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS8(const qint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &buf[2*k]);
+        split(_mm256_cvtepi8_epi32(v), _mm256_cvtepi8_epi32(_mm_srli_si128(v, 8)), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS16(const qint16 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        split(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) &buf[2*k])),
+                _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) &buf[2*k + 8])),
+                &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+inline __m256i fir(const qint32 *a, const qint32 *b, const __m256i *h)
+{
+    __m256i acc = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*) (b + 1 - DecimatorsHalfband::nbCoeffs)), hbShift);
+
+    for (int i = 0; i < DecimatorsHalfband::nbCoeffs; i++)
+    {
+        __m256i sum = _mm256_add_epi32(
+                _mm256_loadu_si256((const __m256i*) (a - i)),
+                _mm256_loadu_si256((const __m256i*) (a + i + 1 - 2*DecimatorsHalfband::nbCoeffs)));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(sum, h[i]));
+    }
+
+    return _mm256_srai_epi32(acc, hbShift);
+}
+
+int halfband(DecimatorsHalfband *hb, qint32 *x, qint32 *y, int nbSamples)
+{
+    int nbOut = hb->deinterleave(x, y, nbSamples);
+    __m256i h[DecimatorsHalfband::nbCoeffs];
+    int k = 0;
+
+    for (int i = 0; i < DecimatorsHalfband::nbCoeffs; i++) {
+        h[i] = _mm256_set1_epi32(HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbCoeffs[i]);
+    }
+
+    for (; k < nbOut - 7; k += 8)
+    {
+        _mm256_storeu_si256((__m256i*) &x[k], fir(&hb->m_a[0][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[0][DECIMATORS_SIMD_HISTORY + k], h));
+        _mm256_storeu_si256((__m256i*) &y[k], fir(&hb->m_a[1][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[1][DECIMATORS_SIMD_HISTORY + k], h));
+    }
+
+    for (; k < nbOut; k++)
+    {
+        x[k] = hb->fir(0, k);
+        y[k] = hb->fir(1, k);
+    }
+
+    hb->shiftHistory(nbOut);
+    return nbOut;
+}
+
+const DecimatorsSIMDKernels kernels = {
+    "AVX2",
+    convertU8,
+    convertS8,
+    convertS16,
+    halfband
+};
+
+} // namespace
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsAVX2()
+{
+    return &kernels;
+}
+
+#else
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsAVX2()
+{
+    return 0;
+}
+
+#endif
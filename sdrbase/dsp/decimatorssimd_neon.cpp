@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+// Compiled with NEON code generation enabled (armv7 with -mfpu=neon or aarch64).
+
+#include "decimatorssimd.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+namespace
+{
+
+const int hbShift = HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbShift - 1;
+
+inline void store(int16x8_t i, int16x8_t q, qint32 *x, qint32 *y, int32x4_t shift)
+{
+    vst1q_s32(x,     vshlq_s32(vmovl_s16(vget_low_s16(i)), shift));
+    vst1q_s32(x + 4, vshlq_s32(vmovl_s16(vget_high_s16(i)), shift));
+    vst1q_s32(y,     vshlq_s32(vmovl_s16(vget_low_s16(q)), shift));
+    vst1q_s32(y + 4, vshlq_s32(vmovl_s16(vget_high_s16(q)), shift));
+}
+
+void convertU8(const quint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    int32x4_t s = vdupq_n_s32(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        uint8x8x2_t v = vld2_u8(&buf[2*k]);
+        store(vreinterpretq_s16_u16(vmovl_u8(v.val[0])), vreinterpretq_s16_u16(vmovl_u8(v.val[1])), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS8(const qint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    int32x4_t s = vdupq_n_s32(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        int8x8x2_t v = vld2_s8((const int8_t*) &buf[2*k]);
+        store(vmovl_s8(v.val[0]), vmovl_s8(v.val[1]), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS16(const qint16 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    int32x4_t s = vdupq_n_s32(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 7; k += 8)
+    {
+        int16x8x2_t v = vld2q_s16(&buf[2*k]);
+        store(v.val[0], v.val[1], &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+inline int32x4_t fir(const qint32 *a, const qint32 *b)
+{
+    int32x4_t acc = vshlq_n_s32(vld1q_s32(b + 1 - DecimatorsHalfband::nbCoeffs), hbShift);
+
+    for (int i = 0; i < DecimatorsHalfband::nbCoeffs; i++)
+    {
+        int32x4_t sum = vaddq_s32(vld1q_s32(a - i), vld1q_s32(a + i + 1 - 2*DecimatorsHalfband::nbCoeffs));
+        acc = vmlaq_n_s32(acc, sum, HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbCoeffs[i]);
+    }
+
+    return vshrq_n_s32(acc, hbShift);
+}
+
+int halfband(DecimatorsHalfband *hb, qint32 *x, qint32 *y, int nbSamples)
+{
+    int nbOut = hb->deinterleave(x, y, nbSamples);
+    int k = 0;
+
+    for (; k < nbOut - 3; k += 4)
+    {
+        vst1q_s32(&x[k], fir(&hb->m_a[0][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[0][DECIMATORS_SIMD_HISTORY + k]));
+        vst1q_s32(&y[k], fir(&hb->m_a[1][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[1][DECIMATORS_SIMD_HISTORY + k]));
+    }
+
+    for (; k < nbOut; k++)
+    {
+        x[k] = hb->fir(0, k);
+        y[k] = hb->fir(1, k);
+    }
+
+    hb->shiftHistory(nbOut);
+    return nbOut;
+}
+
+const DecimatorsSIMDKernels kernels = {
+    "NEON",
+    convertU8,
+    convertS8,
+    convertS16,
+    halfband
+};
+
+} // namespace
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsNEON()
+{
+    return &kernels;
+}
+
+#else
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsNEON()
+{
+    return 0;
+}
+
+#endif
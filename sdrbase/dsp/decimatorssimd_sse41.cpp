@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+// Compiled with SSE 4.1 code generation enabled. Only called when the CPU supports it.
+
+#include "decimatorssimd.h"
+
+#if defined(__SSE4_1__)
+
+#include <smmintrin.h>
+
+namespace
+{
+
+const int hbShift = HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbShift - 1;
+
+// [I0 Q0 I1 Q1] [I2 Q2 I3 Q3] -> [I0 I1 I2 I3] [Q0 Q1 Q2 Q3]
+inline void split(__m128i v0, __m128i v1, qint32 *x, qint32 *y, __m128i shift)
+{
+    v0 = _mm_shuffle_epi32(v0, _MM_SHUFFLE(3,1,2,0));
+    v1 = _mm_shuffle_epi32(v1, _MM_SHUFFLE(3,1,2,0));
+    _mm_storeu_si128((__m128i*) x, _mm_sll_epi32(_mm_unpacklo_epi64(v0, v1), shift));
+    _mm_storeu_si128((__m128i*) y, _mm_sll_epi32(_mm_unpackhi_epi64(v0, v1), shift));
+}
+
+void convertU8(const quint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 3; k += 4)
+    {
+        __m128i v = _mm_loadl_epi64((const __m128i*) &buf[2*k]);
+        split(_mm_cvtepu8_epi32(v), _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS8(const qint8 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 3; k += 4)
+    {
+        __m128i v = _mm_loadl_epi64((const __m128i*) &buf[2*k]);
+        split(_mm_cvtepi8_epi32(v), _mm_cvtepi8_epi32(_mm_srli_si128(v, 4)), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+void convertS16(const qint16 *buf, qint32 *x, qint32 *y, int nbSamples, int shift)
+{
+    __m128i s = _mm_cvtsi32_si128(shift);
+    int k = 0;
+
+    for (; k < nbSamples - 3; k += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &buf[2*k]);
+        split(_mm_cvtepi16_epi32(v), _mm_cvtepi16_epi32(_mm_srli_si128(v, 8)), &x[k], &y[k], s);
+    }
+
+    for (; k < nbSamples; k++)
+    {
+        x[k] = ((qint32) buf[2*k]) << shift;
+        y[k] = ((qint32) buf[2*k+1]) << shift;
+    }
+}
+
+inline __m128i fir(const qint32 *a, const qint32 *b, const __m128i *h)
+{
+    __m128i acc = _mm_slli_epi32(_mm_loadu_si128((const __m128i*) (b + 1 - DecimatorsHalfband::nbCoeffs)), hbShift);
+
+    for (int i = 0; i < DecimatorsHalfband::nbCoeffs; i++)
+    {
+        __m128i sum = _mm_add_epi32(
+                _mm_loadu_si128((const __m128i*) (a - i)),
+                _mm_loadu_si128((const __m128i*) (a + i + 1 - 2*DecimatorsHalfband::nbCoeffs)));
+        acc = _mm_add_epi32(acc, _mm_mullo_epi32(sum, h[i]));
+    }
+
+    return _mm_srai_epi32(acc, hbShift);
+}
+
+int halfband(DecimatorsHalfband *hb, qint32 *x, qint32 *y, int nbSamples)
+{
+    int nbOut = hb->deinterleave(x, y, nbSamples);
+    __m128i h[DecimatorsHalfband::nbCoeffs];
+    int k = 0;
+
+    for (int i = 0; i < DecimatorsHalfband::nbCoeffs; i++) {
+        h[i] = _mm_set1_epi32(HBFIRFilterTraits<DECIMATORS_SIMD_HB_FILTER_ORDER>::hbCoeffs[i]);
+    }
+
+    for (; k < nbOut - 3; k += 4)
+    {
+        _mm_storeu_si128((__m128i*) &x[k], fir(&hb->m_a[0][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[0][DECIMATORS_SIMD_HISTORY + k], h));
+        _mm_storeu_si128((__m128i*) &y[k], fir(&hb->m_a[1][DECIMATORS_SIMD_HISTORY + k], &hb->m_b[1][DECIMATORS_SIMD_HISTORY + k], h));
+    }
+
+    for (; k < nbOut; k++)
+    {
+        x[k] = hb->fir(0, k);
+        y[k] = hb->fir(1, k);
+    }
+
+    hb->shiftHistory(nbOut);
+    return nbOut;
+}
+
+const DecimatorsSIMDKernels kernels = {
+    "SSE4.1",
+    convertU8,
+    convertS8,
+    convertS16,
+    halfband
+};
+
+} // namespace
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsSSE4_1()
+{
+    return &kernels;
+}
+
+#else
+
+const DecimatorsSIMDKernels *getDecimatorsKernelsSSE4_1()
+{
+    return 0;
+}
+
+#endif
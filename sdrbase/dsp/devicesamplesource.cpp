@@ -19,6 +19,7 @@
 
 DeviceSampleSource::DeviceSampleSource()
 {
+	m_sampleFifo.setLockFree(true); // written by the device thread only and read by the DSP engine thread only
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 }
 
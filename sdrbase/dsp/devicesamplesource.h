@@ -19,6 +19,7 @@
 #define INCLUDE_SAMPLESOURCE_H
 
 #include <QtGlobal>
+#include <QByteArray>
 
 #include "samplesinkfifo.h"
 #include "util/message.h"
@@ -40,6 +41,11 @@ public:
 
 	virtual bool handleMessage(const Message& message) = 0;
 
+	// Settings in the format of the device GUI in the presets. Sources that can run without their GUI (headless server) implement these.
+	virtual QByteArray serialize() const { return QByteArray(); }
+	virtual bool deserialize(const QByteArray& data __attribute__((unused))) { return false; }
+	virtual void setCenterFrequency(qint64 centerFrequency __attribute__((unused))) { }
+
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	MessageQueue *getOutputMessageQueueToGUI() { return &m_outputMessageQueueToGUI; }
     SampleSinkFifo* getSampleFifo() { return &m_sampleFifo; }
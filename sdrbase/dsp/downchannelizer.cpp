@@ -19,6 +19,7 @@
 #include "dsp/inthalfbandfilter.h"
 #include "dsp/dspcommands.h"
 
+#include <algorithm>
 #include <QString>
 #include <QDebug>
 
@@ -27,10 +28,12 @@ MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgChannelizerNotification, Message)
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
+	m_subBandFrequencyOffset(0),
 	m_requestedOutputSampleRate(0),
 	m_requestedCenterFrequency(0),
 	m_currentOutputSampleRate(0),
-	m_currentCenterFrequency(0)
+	m_currentCenterFrequency(0),
+	m_stageBuffer(DOWNCHANNELIZER_BLOCK_SIZE/2 + 1)
 {
 	QString name = "DownChannelizer(" + m_sampleSink->objectName() + ")";
 	setObjectName(name);
@@ -62,31 +65,40 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 	{
 		m_mutex.lock();
 
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
+		unsigned int nbStages = m_filterStages.size();
+		int nbInput = end - begin;
+		int outCount = 0;
+
+		if (m_sampleBuffer.size() < (std::size_t) (nbInput >> nbStages) + 1) {
+			m_sampleBuffer.resize((nbInput >> nbStages) + 1);
+		}
+
+		// take each block through the whole chain stage by stage so that it stays in cache
+		for (int blockIndex = 0; blockIndex < nbInput; blockIndex += DOWNCHANNELIZER_BLOCK_SIZE)
 		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
+			int count = std::min(nbInput - blockIndex, DOWNCHANNELIZER_BLOCK_SIZE);
+			const Sample *in = &(*(begin + blockIndex));
+			unsigned int stageIndex = 1;
 
-			for (; stage != m_filterStages.end(); ++stage)
+			for (FilterStages::iterator stage = m_filterStages.begin(); stage != m_filterStages.end(); ++stage, ++stageIndex)
 			{
-				if(!(*stage)->work(&s))
+				if (stageIndex == nbStages) // last stage outputs scaled samples directly
 				{
-					break;
+					count = (*stage)->workBlock(in, count, m_sampleBuffer.data() + outCount, nbStages);
+				}
+				else // intermediate stages work in place in the stage buffer
+				{
+					count = (*stage)->workBlock(in, count, m_stageBuffer.data(), 0);
+					in = m_stageBuffer.data();
 				}
 			}
 
-			if(stage == m_filterStages.end())
-			{
-			    s.m_real /= (1<<(m_filterStages.size()));
-			    s.m_imag /= (1<<(m_filterStages.size()));
-				m_sampleBuffer.push_back(s);
-			}
+			outCount += count;
 		}
 
 		m_mutex.unlock();
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
-		m_sampleBuffer.clear();
+		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + outCount, positiveOnly);
 	}
 }
 
@@ -118,6 +130,7 @@ bool DownChannelizer::handleMessage(const Message& cmd)
 	{
 		DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
 		m_inputSampleRate = notif.getSampleRate();
+		m_subBandFrequencyOffset = 0;
 		qDebug() << "DownChannelizer::handleMessage: DSPSignalNotification: m_inputSampleRate: " << m_inputSampleRate;
 		applyConfiguration();
 
@@ -129,6 +142,24 @@ bool DownChannelizer::handleMessage(const Message& cmd)
 		emit inputSampleRateChanged();
 		return true;
 	}
+	else if (DSPSubBandNotification::match(cmd))
+	{
+		DSPSubBandNotification& notif = (DSPSubBandNotification&) cmd;
+		m_inputSampleRate = notif.getSampleRate();
+		m_subBandFrequencyOffset = notif.getSubBandFrequencyOffset();
+		qDebug() << "DownChannelizer::handleMessage: DSPSubBandNotification: m_inputSampleRate: " << m_inputSampleRate
+				<< " m_subBandFrequencyOffset: " << m_subBandFrequencyOffset;
+		applyConfiguration();
+
+		if (m_sampleSink != 0)
+		{
+			DSPSignalNotification sinkNotif(m_inputSampleRate, notif.getCenterFrequency());
+			m_sampleSink->handleMessage(sinkNotif);
+		}
+
+		emit inputSampleRateChanged();
+		return true;
+	}
 	else if (DSPConfigureChannelizer::match(cmd))
 	{
 		DSPConfigureChannelizer& chan = (DSPConfigureChannelizer&) cmd;
@@ -168,9 +199,12 @@ void DownChannelizer::applyConfiguration()
 
 	freeFilterChain();
 
+	// requested center frequency is relative to the device center but the chain works relative to its input center
+	int requestedCenterFrequency = m_requestedCenterFrequency - m_subBandFrequencyOffset;
+
 	m_currentCenterFrequency = createFilterChain(
 		m_inputSampleRate / -2, m_inputSampleRate / 2,
-		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
+		requestedCenterFrequency - m_requestedOutputSampleRate / 2, requestedCenterFrequency + m_requestedOutputSampleRate / 2);
 
 	m_mutex.unlock();
 
@@ -239,6 +273,63 @@ DownChannelizer::FilterStage::~FilterStage()
 	delete m_filter;
 }
 
+namespace {
+
+template<typename HBFilter, bool (HBFilter::*WorkFunction)(Sample*)>
+int decimateBlock(HBFilter* filter, const Sample* in, int count, Sample* out, unsigned int log2Scale)
+{
+	Sample *o = out;
+
+	if (log2Scale == 0)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			Sample s(in[i]);
+
+			if ((filter->*WorkFunction)(&s)) {
+				*o++ = s;
+			}
+		}
+	}
+	else
+	{
+		// rounding towards zero like integer division: add divisor - 1 to negative values before shifting
+		int bias = (1<<log2Scale) - 1;
+
+		for (int i = 0; i < count; i++)
+		{
+			Sample s(in[i]);
+
+			if ((filter->*WorkFunction)(&s))
+			{
+				int re = s.m_real;
+				int im = s.m_imag;
+				o->m_real = (re + ((re >> 31) & bias)) >> log2Scale;
+				o->m_imag = (im + ((im >> 31) & bias)) >> log2Scale;
+				o++;
+			}
+		}
+	}
+
+	return o - out;
+}
+
+} // namespace
+
+int DownChannelizer::FilterStage::workBlock(const Sample* in, int count, Sample* out, unsigned int log2Scale)
+{
+	switch(m_mode)
+	{
+		case ModeLowerHalf:
+			return decimateBlock<HBFilter, &HBFilter::workDecimateLowerHalf>(m_filter, in, count, out, log2Scale);
+		case ModeUpperHalf:
+			return decimateBlock<HBFilter, &HBFilter::workDecimateUpperHalf>(m_filter, in, count, out, log2Scale);
+		case ModeCenter:
+		default:
+			return decimateBlock<HBFilter, &HBFilter::workDecimateCenter>(m_filter, in, count, out, log2Scale);
+	}
+}
+
 bool DownChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const
 {
 	//qDebug("   testing signal [%f, %f], channel [%f, %f]", sigStart, sigEnd, chanStart, chanEnd);
@@ -30,6 +30,7 @@
 #endif
 
 #define DOWNCHANNELIZER_HB_FILTER_ORDER 48
+#define DOWNCHANNELIZER_BLOCK_SIZE 4096 // number of input samples taken through the whole filter chain at once
 
 class MessageQueue;
 
@@ -74,12 +75,12 @@ protected:
 		};
 
 #ifdef USE_SSE4_1
-		typedef bool (IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-		IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+		typedef IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
 #else
-		typedef bool (IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-		IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+		typedef IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
 #endif
+		typedef bool (HBFilter::*WorkFunction)(Sample* s);
+		HBFilter* m_filter;
 		WorkFunction m_workFunction;
 		Mode m_mode;
 		bool m_sse;
@@ -91,16 +92,25 @@ protected:
 		{
 			return (m_filter->*m_workFunction)(sample);
 		}
+
+		/**
+		 * Decimate a block of count samples from in to out and return the number of output samples.
+		 * Output can be done in place (out == in). If log2Scale is not zero output samples are divided
+		 * by 2^log2Scale (final scaling of the filter chain).
+		 */
+		int workBlock(const Sample* in, int count, Sample* out, unsigned int log2Scale);
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
+	qint64 m_subBandFrequencyOffset; //!< center of the input relative to the device center when fed by the filter bank
 	int m_requestedOutputSampleRate;
 	int m_requestedCenterFrequency;
 	int m_currentOutputSampleRate;
 	int m_currentCenterFrequency;
-	SampleVector m_sampleBuffer;
+	SampleVector m_sampleBuffer; //!< output of the filter chain passed to the sink (grows only)
+	SampleVector m_stageBuffer;  //!< intermediate results of the filter chain for one block
 	QMutex m_mutex;
 
 	void applyConfiguration();
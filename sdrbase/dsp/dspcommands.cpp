@@ -46,4 +46,6 @@ MESSAGE_CLASS_DEFINITION(DSPConfigureCorrection, Message)
 MESSAGE_CLASS_DEFINITION(DSPEngineReport, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureScopeVis, Message)
 MESSAGE_CLASS_DEFINITION(DSPSignalNotification, Message)
+MESSAGE_CLASS_DEFINITION(DSPSubBandNotification, Message)
+MESSAGE_CLASS_DEFINITION(DSPConfigureThreadedSinkSubBand, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureChannelizer, Message)
@@ -357,6 +357,51 @@ private:
 	qint64 m_centerFrequency;
 };
 
+class SDRANGEL_API DSPSubBandNotification : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPSubBandNotification(int samplerate, qint64 centerFrequency, qint64 subBandFrequencyOffset) :
+		Message(),
+		m_sampleRate(samplerate),
+		m_centerFrequency(centerFrequency),
+		m_subBandFrequencyOffset(subBandFrequencyOffset)
+	{ }
+
+	int getSampleRate() const { return m_sampleRate; } //!< sample rate of the sub-band
+	qint64 getCenterFrequency() const { return m_centerFrequency; } //!< device center frequency
+	qint64 getSubBandFrequencyOffset() const { return m_subBandFrequencyOffset; } //!< sub-band center relative to device center
+
+private:
+	int m_sampleRate;
+	qint64 m_centerFrequency;
+	qint64 m_subBandFrequencyOffset;
+};
+
+class SDRANGEL_API DSPConfigureThreadedSinkSubBand : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPConfigureThreadedSinkSubBand(ThreadedBasebandSampleSink* threadedSampleSink, qint64 frequencyOffset, int bandwidth, int sampleRate) :
+		Message(),
+		m_threadedSampleSink(threadedSampleSink),
+		m_frequencyOffset(frequencyOffset),
+		m_bandwidth(bandwidth),
+		m_sampleRate(sampleRate)
+	{ }
+
+	ThreadedBasebandSampleSink* getThreadedSampleSink() const { return m_threadedSampleSink; }
+	qint64 getFrequencyOffset() const { return m_frequencyOffset; }
+	int getBandwidth() const { return m_bandwidth; }
+	int getSampleRate() const { return m_sampleRate; }
+
+private:
+	ThreadedBasebandSampleSink* m_threadedSampleSink;
+	qint64 m_frequencyOffset;
+	int m_bandwidth;
+	int m_sampleRate;
+};
+
 class SDRANGEL_API DSPConfigureChannelizer : public Message {
 	MESSAGE_CLASS_DECLARATION
 
@@ -16,6 +16,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <stdio.h>
+#include <algorithm>
 #include <QDebug>
 #include <QThread>
 
@@ -25,6 +26,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/dspcommands.h"
+#include "dsp/samplemixer.h"
 #include "samplesourcefifo.h"
 #include "threadedbasebandsamplesource.h"
 
@@ -255,9 +257,6 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 
 	    SampleVector::iterator writeBegin;
 	    sampleFifo->getWriteIterator(writeBegin);
-	    SampleVector::iterator writeAt = writeBegin;
-	    Sample s;
-	    int sourceOccurence = 0;
 
 	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
 	    {
@@ -269,41 +268,31 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	        (*it)->pullAudio(nbWriteSamples);
 	    }
 
-	    for (int is = 0; is < nbWriteSamples; is++)
-		{
-			// pull data from threaded sources and merge them in the device sample FIFO
-			for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
-			{
-				(*it)->pull(s);
-				s /= m_multipleSourcesDivisionFactor;
-
-				if (sourceOccurence == 0) {
-				    (*writeAt) = s;
-				} else {
-	                (*writeAt) += s;
-				}
-
-				sourceOccurence++;
-			}
+	    if (m_sourceSampleBuffer.size() < (unsigned int) nbWriteSamples)
+	    {
+	        m_sourceSampleBuffer.resize(nbWriteSamples);
+	        m_sourceMixBuffer.resize(2 * nbWriteSamples); // I and Q
+	    }
 
-			// pull data from direct sources and merge them in the device sample FIFO
-			for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
-			{
-				(*it)->pull(s);
-				s /= m_multipleSourcesDivisionFactor;
+	    std::fill(m_sourceMixBuffer.begin(), m_sourceMixBuffer.begin() + 2 * nbWriteSamples, 0);
 
-                if (sourceOccurence == 0) {
-                    (*writeAt) = s;
-                } else {
-                    (*writeAt) += s;
-                }
+	    // pull a block from each threaded source and sum it
+	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
+	    {
+	        (*it)->pull(m_sourceSampleBuffer.begin(), nbWriteSamples);
+	        SampleMixer::accumulate(&m_sourceMixBuffer[0], &m_sourceSampleBuffer[0], nbWriteSamples);
+	    }
 
-                sourceOccurence++;
-			}
+	    // pull a block from each direct source and sum it
+	    for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
+	    {
+	        (*it)->pull(m_sourceSampleBuffer.begin(), nbWriteSamples);
+	        SampleMixer::accumulate(&m_sourceMixBuffer[0], &m_sourceSampleBuffer[0], nbWriteSamples);
+	    }
 
-			sampleFifo->bumpIndex(writeAt);
-            sourceOccurence = 0;
-		}
+	    // scale the sum in the device sample FIFO
+	    SampleMixer::scale(&m_sourceMixBuffer[0], &(*writeBegin), nbWriteSamples, m_multipleSourcesDivisionFactor);
+	    sampleFifo->bumpIndex(writeBegin, nbWriteSamples);
 
 		// feed the mix to the main spectrum sink
 //		if (m_spectrumSink)
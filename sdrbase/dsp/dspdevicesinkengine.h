@@ -116,6 +116,8 @@ private:
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
 	uint32_t m_multipleSourcesDivisionFactor;
+	SampleVector m_sourceSampleBuffer;    //!< block pulled from one source when there are multiple sources
+	std::vector<qint32> m_sourceMixBuffer; //!< sum of the sources blocks before scaling
 
 	void run();
 	void work(int nbWriteSamples); //!< transfer samples from beseband sources to sink if in running state
@@ -21,6 +21,7 @@
 #include <dsp/devicesamplesource.h>
 #include <dsp/downchannelizer.h>
 #include <stdio.h>
+#include <algorithm>
 #include <QDebug>
 #include "dsp/dspcommands.h"
 #include "samplesinkfifo.h"
@@ -33,6 +34,7 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_deviceSampleSource(0),
 	m_sampleSourceSequence(0),
 	m_basebandSampleSinks(),
+	m_nextChannelIndex(0),
 	m_sampleRate(0),
 	m_centerFrequency(0),
 	m_dcOffsetCorrection(false),
@@ -43,6 +45,9 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_qRange(1 << 16),
 	m_imbalance(65536)
 {
+	m_threadedSinksFifo.setSize(DSPDEVICESOURCEENGINE_THREADEDSINKSFIFO_SIZE);
+	m_threadedSinksFifo.setMetricsName(QString("device%1 channels").arg(m_uid));
+	m_metricsTimer.start();
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
 
@@ -147,6 +152,16 @@ void DSPDeviceSourceEngine::removeThreadedSink(ThreadedBasebandSampleSink* sink)
 	m_syncMessenger.sendWait(cmd);
 }
 
+void DSPDeviceSourceEngine::configureThreadedSinkSubBand(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate)
+{
+	qDebug() << "DSPDeviceSourceEngine::configureThreadedSinkSubBand: " << sink->getSampleSinkObjectName().toStdString().c_str()
+			<< " offset: " << frequencyOffset
+			<< " bandwidth: " << bandwidth
+			<< " sampleRate: " << sampleRate;
+	DSPConfigureThreadedSinkSubBand* cmd = new DSPConfigureThreadedSinkSubBand(sink, frequencyOffset, bandwidth, sampleRate);
+	m_inputMessageQueue.push(cmd);
+}
+
 void DSPDeviceSourceEngine::configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection)
 {
 	qDebug() << "DSPDeviceSourceEngine::configureCorrections";
@@ -246,7 +261,7 @@ void DSPDeviceSourceEngine::work()
 	std::size_t samplesDone = 0;
 	bool positiveOnly = false;
 
-	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_sampleRate))
+	while ((sampleFifo->fill() > 0) && m_inputMessageQueue.isEmpty() && (samplesDone < m_sampleRate))
 	{
 		SampleVector::iterator part1begin;
 		SampleVector::iterator part1end;
@@ -272,13 +287,21 @@ void DSPDeviceSourceEngine::work()
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
 			{
+				qint64 feedStart = m_metricsTimer.nsecsElapsed();
 				(*it)->feed(part1begin, part1end, positiveOnly);
+				(*it)->getMetrics().feed(part1end - part1begin, m_metricsTimer.nsecsElapsed() - feedStart);
 			}
 
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+			// feed data once to the threaded sinks not served by the filter bank that read it in place
+			if (m_threadedSinksFifo.getNbReaders() > 0)
 			{
-				(*it)->feed(part1begin, part1end, positiveOnly);
+				m_threadedSinksFifo.write(part1begin, part1end);
+			}
+
+			// feed the filter bank that feeds its subscribed threaded sinks
+			if (m_filterBank.hasSubscribers())
+			{
+				m_filterBank.feed(part1begin, part1end);
 			}
 		}
 
@@ -299,13 +322,21 @@ void DSPDeviceSourceEngine::work()
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); it++)
 			{
+				qint64 feedStart = m_metricsTimer.nsecsElapsed();
 				(*it)->feed(part2begin, part2end, positiveOnly);
+				(*it)->getMetrics().feed(part2end - part2begin, m_metricsTimer.nsecsElapsed() - feedStart);
 			}
 
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+			// feed data once to the threaded sinks not served by the filter bank that read it in place
+			if (m_threadedSinksFifo.getNbReaders() > 0)
 			{
-				(*it)->feed(part2begin, part2end, positiveOnly);
+				m_threadedSinksFifo.write(part2begin, part2end);
+			}
+
+			// feed the filter bank that feeds its subscribed threaded sinks
+			if (m_filterBank.hasSubscribers())
+			{
+				m_filterBank.feed(part2begin, part2end);
 			}
 		}
 
@@ -413,6 +444,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoInit()
 		(*it)->handleSinkMessage(notif);
 	}
 
+	routeThreadedSinks();
+
 	// pass data to listeners
 
 	DSPSignalNotification* rep = new DSPSignalNotification(notif); // make a copy for the output queue
@@ -495,6 +528,7 @@ void DSPDeviceSourceEngine::handleSetSource(DeviceSampleSource* source)
 	if(m_deviceSampleSource != 0)
 	{
 		qDebug("DSPDeviceSourceEngine::handleSetSource: set %s", qPrintable(source->getDeviceDescription()));
+		m_deviceSampleSource->getSampleFifo()->setMetricsName(QString("device%1").arg(m_uid));
 		connect(m_deviceSampleSource->getSampleFifo(), SIGNAL(dataReady()), this, SLOT(handleData()), Qt::QueuedConnection);
 	}
 	else
@@ -573,6 +607,10 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 		// initialize sample rate and center frequency in the sink:
 		DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
 		threadedSink->handleSinkMessage(msg);
+		// the sinks of all channels of a kind have the same name so the metrics are reported by channel:
+		threadedSink->setMetricsChannel(QString("device%1.channel%2").arg(m_uid).arg(m_nextChannelIndex++));
+		// read full rate samples from the shared FIFO until routed to the filter bank:
+		threadedSink->attachBroadcastFifo(&m_threadedSinksFifo);
 		// start the sink:
 		threadedSink->start();
 	}
@@ -580,6 +618,9 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 	{
 		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedSampleSink*) message)->getThreadedSampleSink();
 		threadedSink->stop();
+		threadedSink->detachBroadcastFifo();
+		m_filterBank.unsubscribe(threadedSink);
+		m_subBandRequests.erase(threadedSink);
 		m_threadedBasebandSampleSinks.remove(threadedSink);
 	}
 
@@ -643,6 +684,8 @@ void DSPDeviceSourceEngine::handleInputMessages()
 				(*it)->handleSinkMessage(*message);
 			}
 
+			routeThreadedSinks();
+
 			// forward changes to listeners on DSP output queue
 
 			DSPSignalNotification* rep = new DSPSignalNotification(*notif); // make a copy for the output queue
@@ -650,5 +693,69 @@ void DSPDeviceSourceEngine::handleInputMessages()
 
 			delete message;
 		}
+		else if (DSPConfigureThreadedSinkSubBand::match(*message))
+		{
+			DSPConfigureThreadedSinkSubBand *conf = (DSPConfigureThreadedSinkSubBand *) message;
+			ThreadedBasebandSampleSink *threadedSink = conf->getThreadedSampleSink();
+
+			// the sink may have been removed since the request was posted
+			if (std::find(m_threadedBasebandSampleSinks.begin(), m_threadedBasebandSampleSinks.end(), threadedSink) != m_threadedBasebandSampleSinks.end())
+			{
+				SubBandRequest& request = m_subBandRequests[threadedSink];
+				request.m_frequencyOffset = conf->getFrequencyOffset();
+				request.m_bandwidth = conf->getBandwidth();
+				request.m_sampleRate = conf->getSampleRate();
+				routeThreadedSink(threadedSink);
+			}
+
+			delete message;
+		}
+	}
+}
+
+void DSPDeviceSourceEngine::routeThreadedSink(ThreadedBasebandSampleSink* sink)
+{
+	SubBandRequests::const_iterator request = m_subBandRequests.find(sink);
+	int channelIndex = -1;
+
+	if ((request != m_subBandRequests.end()) && (m_filterBank.getInputSampleRate() == (int) m_sampleRate))
+	{
+		channelIndex = m_filterBank.getChannelIndex(
+				request->second.m_frequencyOffset,
+				request->second.m_bandwidth,
+				request->second.m_sampleRate);
+	}
+
+	if (channelIndex == m_filterBank.getSubscribedChannel(sink)) {
+		return; // no change
+	}
+
+	if (channelIndex < 0)
+	{
+		qDebug() << "DSPDeviceSourceEngine::routeThreadedSink: " << sink->getSampleSinkObjectName().toStdString().c_str()
+				<< " at full rate";
+		m_filterBank.unsubscribe(sink);
+		DSPSubBandNotification notif(m_sampleRate, m_centerFrequency, 0);
+		sink->handleSinkMessage(notif);
+		sink->attachBroadcastFifo(&m_threadedSinksFifo);
+	}
+	else
+	{
+		qDebug() << "DSPDeviceSourceEngine::routeThreadedSink: " << sink->getSampleSinkObjectName().toStdString().c_str()
+				<< " on filter bank channel " << channelIndex;
+		sink->detachBroadcastFifo(); // a sink that does not read would hold back the shared FIFO
+		m_filterBank.subscribe(sink, channelIndex);
+		DSPSubBandNotification notif(m_filterBank.getOutputSampleRate(), m_centerFrequency, m_filterBank.getChannelFrequency(channelIndex));
+		sink->handleSinkMessage(notif);
+	}
+}
+
+void DSPDeviceSourceEngine::routeThreadedSinks()
+{
+	// sinks have just been notified of the full rate so start over with no subscription
+	m_filterBank.configure(m_sampleRate);
+
+	for (SubBandRequests::const_iterator it = m_subBandRequests.begin(); it != m_subBandRequests.end(); ++it) {
+		routeThreadedSink(it->first);
 	}
 }
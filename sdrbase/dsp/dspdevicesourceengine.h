@@ -18,16 +18,22 @@
 #ifndef INCLUDE_DSPDEVICEENGINE_H
 #define INCLUDE_DSPDEVICEENGINE_H
 
+#include <map>
 #include <QThread>
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QElapsedTimer>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/polyphasefilterbank.h"
+#include "dsp/samplesinkbroadcastfifo.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "util/export.h"
 
+#define DSPDEVICESOURCEENGINE_THREADEDSINKSFIFO_SIZE (1<<19)
+
 class DeviceSampleSource;
 class BasebandSampleSink;
 class ThreadedBasebandSampleSink;
@@ -68,6 +74,12 @@ public:
 
 	void addThreadedSink(ThreadedBasebandSampleSink* sink); //!< Add a sample sink that will run on its own thread
 	void removeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Remove a sample sink that runs on its own thread
+	/**
+	 * Request to feed a threaded sink with the shared filter bank channel that contains the band of given bandwidth
+	 * centered on frequencyOffset at a sample rate of at least sampleRate. When no filter bank channel is suitable
+	 * the sink is fed with the full device sample rate. The sink is notified with a DSPSubBandNotification.
+	 */
+	void configureThreadedSinkSubBand(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate);
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
 
@@ -97,6 +109,17 @@ private:
 	typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
 	ThreadedBasebandSampleSinks m_threadedBasebandSampleSinks; //!< sample sinks on their own threads (usually channels)
 
+	struct SubBandRequest {
+		qint64 m_frequencyOffset;
+		int m_bandwidth;
+		int m_sampleRate;
+	};
+	typedef std::map<ThreadedBasebandSampleSink*, SubBandRequest> SubBandRequests;
+	SubBandRequests m_subBandRequests; //!< threaded sinks that asked to be fed by the filter bank
+	PolyphaseFilterBank m_filterBank;  //!< channelizer shared by the threaded sinks
+	SampleSinkBroadcastFifo m_threadedSinksFifo; //!< full rate samples shared by the threaded sinks
+	int m_nextChannelIndex;                      //!< names the threaded sinks in the metrics
+
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
 
@@ -107,6 +130,8 @@ private:
 	qint32 m_qRange;
 	qint32 m_imbalance;
 
+	QElapsedTimer m_metricsTimer; //!< times the feed of the direct sinks
+
 	void run();
 
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
@@ -119,6 +144,8 @@ private:
 	State gotoError(const QString& errorMsg); //!< Go to an error state
 
 	void handleSetSource(DeviceSampleSource* source); //!< Manage source setting
+	void routeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Feed threaded sink from the filter bank or at full rate
+	void routeThreadedSinks(); //!< Re-configure the filter bank and route all threaded sinks that requested a sub-band
 
 private slots:
 	void handleData(); //!< Handle data when samples from source FIFO are ready to be processed
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QGlobalStatic>
+#include <QMutexLocker>
+#include <cmath>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/samplesinkbroadcastfifo.h"
+#include "dsp/dspmetrics.h"
+
+double FifoMetrics::getMeanIntervalNs() const
+{
+    return m_writeCount > 1 ? (double) m_intervalSumNs / (m_writeCount - 1) : 0.0;
+}
+
+double FifoMetrics::getJitterNs() const
+{
+    if (m_writeCount < 2) {
+        return 0.0;
+    }
+
+    double mean = getMeanIntervalNs();
+    double variance = m_intervalSqSumNs / (m_writeCount - 1) - mean * mean;
+
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+Q_GLOBAL_STATIC(DSPMetrics, dspMetrics)
+DSPMetrics *DSPMetrics::instance()
+{
+    return dspMetrics;
+}
+
+DSPMetrics::DSPMetrics() :
+    m_nextId(0)
+{ }
+
+DSPMetrics::~DSPMetrics()
+{ }
+
+void DSPMetrics::addFifo(const FifoMetrics *fifoMetrics, const SampleSinkBroadcastFifo *broadcastFifo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    FifoRegistration registration;
+    registration.m_id = m_nextId++;
+    registration.m_name = "fifo";
+    registration.m_metrics = fifoMetrics;
+    registration.m_broadcastFifo = broadcastFifo;
+    m_fifos.append(registration);
+}
+
+void DSPMetrics::removeFifo(const FifoMetrics *fifoMetrics)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < m_fifos.size(); i++)
+    {
+        if (m_fifos[i].m_metrics == fifoMetrics)
+        {
+            m_fifos.removeAt(i);
+            return;
+        }
+    }
+}
+
+void DSPMetrics::setFifoName(const FifoMetrics *fifoMetrics, const QString& name)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < m_fifos.size(); i++)
+    {
+        if (m_fifos[i].m_metrics == fifoMetrics)
+        {
+            m_fifos[i].m_name = name;
+            return;
+        }
+    }
+}
+
+void DSPMetrics::addSink(const BasebandSampleSink *sink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    SinkRegistration registration;
+    registration.m_id = m_nextId++;
+    registration.m_sink = sink;
+    m_sinks.append(registration);
+}
+
+void DSPMetrics::removeSink(const BasebandSampleSink *sink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < m_sinks.size(); i++)
+    {
+        if (m_sinks[i].m_sink == sink)
+        {
+            m_sinks.removeAt(i);
+            return;
+        }
+    }
+}
+
+void DSPMetrics::setSinkChannel(const BasebandSampleSink *sink, const QString& channel)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < m_sinks.size(); i++)
+    {
+        if (m_sinks[i].m_sink == sink)
+        {
+            m_sinks[i].m_channel = channel;
+            return;
+        }
+    }
+}
+
+void DSPMetrics::getFifoReports(QList<FifoReport>& reports) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    reports.clear();
+
+    for (int i = 0; i < m_fifos.size(); i++)
+    {
+        FifoReport report;
+        report.m_id = m_fifos[i].m_id;
+        report.m_name = m_fifos[i].m_name;
+        report.m_metrics = *m_fifos[i].m_metrics;
+        reports.append(report);
+    }
+}
+
+void DSPMetrics::getSinkReports(QList<SinkReport>& reports) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    reports.clear();
+
+    for (int i = 0; i < m_sinks.size(); i++)
+    {
+        SinkReport report;
+        report.m_id = m_sinks[i].m_id;
+        report.m_name = m_sinks[i].m_sink->objectName();
+        report.m_channel = m_sinks[i].m_channel;
+        report.m_metrics = m_sinks[i].m_sink->getMetrics();
+        reports.append(report);
+    }
+}
+
+void DSPMetrics::getReaderReports(QList<ReaderReport>& reports) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    reports.clear();
+
+    for (int i = 0; i < m_fifos.size(); i++)
+    {
+        if (m_fifos[i].m_broadcastFifo == 0) {
+            continue;
+        }
+
+        QList<ReaderMetrics> readers;
+        m_fifos[i].m_broadcastFifo->getReaderMetrics(readers);
+
+        for (int j = 0; j < readers.size(); j++)
+        {
+            ReaderReport report;
+            report.m_fifoId = m_fifos[i].m_id;
+            report.m_fifoName = m_fifos[i].m_name;
+            report.m_metrics = readers[j];
+            reports.append(report);
+        }
+    }
+}
+
+static QString prometheusEscape(const QString& value)
+{
+    QString escaped(value);
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    return escaped;
+}
+
+static QByteArray prometheusLabels(const QString& kind, const QString& name, int id)
+{
+    return QString("{%1=\"%2\",id=\"%3\"}").arg(kind).arg(prometheusEscape(name)).arg(id).toUtf8();
+}
+
+static QByteArray prometheusLabels(const QString& kind, const QString& name, int id, const QString& channel)
+{
+    return QString("{%1=\"%2\",channel=\"%3\",id=\"%4\"}").arg(kind).arg(prometheusEscape(name)).arg(prometheusEscape(channel)).arg(id).toUtf8();
+}
+
+static void prometheusHeader(QByteArray& out, const char *metric, const char *type, const char *help)
+{
+    out += QByteArray("# HELP ") + metric + " " + help + "\n";
+    out += QByteArray("# TYPE ") + metric + " " + type + "\n";
+}
+
+static void prometheusValue(QByteArray& out, const char *metric, const QByteArray& labels, double value)
+{
+    out += metric + labels + " " + QByteArray::number(value, 'g', 12) + "\n";
+}
+
+QByteArray DSPMetrics::serializePrometheus() const
+{
+    QList<FifoReport> fifos;
+    QList<SinkReport> sinks;
+    QList<ReaderReport> readers;
+    getFifoReports(fifos);
+    getSinkReports(sinks);
+    getReaderReports(readers);
+
+    QList<QByteArray> fifoLabels;
+    QList<QByteArray> sinkLabels;
+    QList<QByteArray> readerLabels;
+
+    for (int i = 0; i < fifos.size(); i++) {
+        fifoLabels.append(prometheusLabels("fifo", fifos[i].m_name, fifos[i].m_id));
+    }
+
+    for (int i = 0; i < sinks.size(); i++) {
+        sinkLabels.append(prometheusLabels("sink", sinks[i].m_name, sinks[i].m_id, sinks[i].m_channel));
+    }
+
+    for (int i = 0; i < readers.size(); i++) {
+        readerLabels.append(prometheusLabels("fifo", readers[i].m_fifoName, readers[i].m_fifoId, readers[i].m_metrics.m_channel));
+    }
+
+    QByteArray out;
+
+    prometheusHeader(out, "sdrangel_fifo_size_samples", "gauge", "Sample FIFO size");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_size_samples", fifoLabels[i], fifos[i].m_metrics.m_size);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_high_water_samples", "gauge", "Highest sample FIFO fill");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_high_water_samples", fifoLabels[i], fifos[i].m_metrics.m_highWaterMark);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_written_samples_total", "counter", "Samples written to the FIFO");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_written_samples_total", fifoLabels[i], fifos[i].m_metrics.m_writtenCount);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_dropped_samples_total", "counter", "Samples dropped on FIFO overflow");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_dropped_samples_total", fifoLabels[i], fifos[i].m_metrics.m_droppedCount);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_writes_total", "counter", "Writes to the FIFO");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_writes_total", fifoLabels[i], fifos[i].m_metrics.m_writeCount);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_write_interval_seconds", "gauge", "Mean interval between two FIFO writes");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_write_interval_seconds", fifoLabels[i], fifos[i].m_metrics.getMeanIntervalNs() * 1e-9);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_write_interval_max_seconds", "gauge", "Longest interval between two FIFO writes");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_write_interval_max_seconds", fifoLabels[i], fifos[i].m_metrics.m_maxIntervalNs * 1e-9);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_write_jitter_seconds", "gauge", "Standard deviation of the interval between two FIFO writes");
+    for (int i = 0; i < fifos.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_write_jitter_seconds", fifoLabels[i], fifos[i].m_metrics.getJitterNs() * 1e-9);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_reader_lag_samples", "gauge", "Samples of the shared FIFO not yet read by the channel");
+    for (int i = 0; i < readers.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_reader_lag_samples", readerLabels[i], readers[i].m_metrics.m_lag);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_reader_max_lag_samples", "gauge", "Highest lag of the channel on the shared FIFO");
+    for (int i = 0; i < readers.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_reader_max_lag_samples", readerLabels[i], readers[i].m_metrics.m_maxLag);
+    }
+
+    prometheusHeader(out, "sdrangel_fifo_reader_overflow_samples_total", "counter", "Shared FIFO samples dropped while the channel was lagging");
+    for (int i = 0; i < readers.size(); i++) {
+        prometheusValue(out, "sdrangel_fifo_reader_overflow_samples_total", readerLabels[i], readers[i].m_metrics.m_overflowCount);
+    }
+
+    prometheusHeader(out, "sdrangel_sink_feeds_total", "counter", "Calls to the sink feed method");
+    for (int i = 0; i < sinks.size(); i++) {
+        prometheusValue(out, "sdrangel_sink_feeds_total", sinkLabels[i], sinks[i].m_metrics.m_feedCount);
+    }
+
+    prometheusHeader(out, "sdrangel_sink_samples_total", "counter", "Samples fed to the sink");
+    for (int i = 0; i < sinks.size(); i++) {
+        prometheusValue(out, "sdrangel_sink_samples_total", sinkLabels[i], sinks[i].m_metrics.m_sampleCount);
+    }
+
+    prometheusHeader(out, "sdrangel_sink_feed_seconds_total", "counter", "Time spent in the sink feed method");
+    for (int i = 0; i < sinks.size(); i++) {
+        prometheusValue(out, "sdrangel_sink_feed_seconds_total", sinkLabels[i], sinks[i].m_metrics.m_feedTimeNs * 1e-9);
+    }
+
+    prometheusHeader(out, "sdrangel_sink_feed_max_seconds", "gauge", "Longest call to the sink feed method");
+    for (int i = 0; i < sinks.size(); i++) {
+        prometheusValue(out, "sdrangel_sink_feed_max_seconds", sinkLabels[i], sinks[i].m_metrics.m_maxFeedTimeNs * 1e-9);
+    }
+
+    return out;
+}
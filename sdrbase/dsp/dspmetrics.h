@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DSPMETRICS_H_
+#define SDRBASE_DSP_DSPMETRICS_H_
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <QByteArray>
+
+#include "util/export.h"
+
+class BasebandSampleSink;
+class SampleSinkBroadcastFifo;
+
+/**
+ * Counters of a sample FIFO. They are updated by the writer with plain stores so that the instrumentation
+ * costs next to nothing in the device threads. Readers may see slightly stale values.
+ */
+struct SDRANGEL_API FifoMetrics
+{
+    uint m_size;
+    uint m_highWaterMark;      //!< highest fill seen right after a write
+    quint64 m_writtenCount;    //!< samples written
+    quint64 m_droppedCount;    //!< samples dropped on overflow
+    quint64 m_writeCount;      //!< number of writes i.e. device callbacks for a device FIFO
+    qint64 m_lastWriteNs;
+    quint64 m_intervalSumNs;   //!< sum of the intervals between two writes
+    double m_intervalSqSumNs;  //!< sum of their squares for the jitter
+    quint64 m_maxIntervalNs;
+
+    FifoMetrics() :
+        m_size(0),
+        m_highWaterMark(0),
+        m_writtenCount(0),
+        m_droppedCount(0),
+        m_writeCount(0),
+        m_lastWriteNs(0),
+        m_intervalSumNs(0),
+        m_intervalSqSumNs(0.0),
+        m_maxIntervalNs(0)
+    { }
+
+    void write(uint count, uint written, uint fill, qint64 nowNs)
+    {
+        m_writtenCount += written;
+        m_droppedCount += count - written;
+        m_highWaterMark = fill > m_highWaterMark ? fill : m_highWaterMark;
+
+        if (m_writeCount > 0)
+        {
+            quint64 interval = nowNs - m_lastWriteNs;
+            m_intervalSumNs += interval;
+            m_intervalSqSumNs += (double) interval * (double) interval;
+            m_maxIntervalNs = interval > m_maxIntervalNs ? interval : m_maxIntervalNs;
+        }
+
+        m_lastWriteNs = nowNs;
+        m_writeCount++;
+    }
+
+    double getMeanIntervalNs() const;
+    double getJitterNs() const; //!< standard deviation of the intervals between two writes
+};
+
+/**
+ * Processing time spent in the feed method of a baseband sample sink. Updated by the thread feeding the sink.
+ */
+struct SDRANGEL_API SinkMetrics
+{
+    quint64 m_feedCount;
+    quint64 m_sampleCount;
+    quint64 m_feedTimeNs;
+    quint64 m_maxFeedTimeNs;
+
+    SinkMetrics() :
+        m_feedCount(0),
+        m_sampleCount(0),
+        m_feedTimeNs(0),
+        m_maxFeedTimeNs(0)
+    { }
+
+    void feed(uint nbSamples, qint64 timeNs)
+    {
+        m_feedCount++;
+        m_sampleCount += nbSamples;
+        m_feedTimeNs += timeNs;
+        m_maxFeedTimeNs = (quint64) timeNs > m_maxFeedTimeNs ? timeNs : m_maxFeedTimeNs;
+    }
+};
+
+/**
+ * Counters of one reader of a broadcast FIFO i.e. of one channel reading the full rate samples. They are
+ * updated by the writer and copied under the statistics lock of the FIFO.
+ */
+struct SDRANGEL_API ReaderMetrics
+{
+    QString m_channel;
+    uint m_lag;              //!< samples not yet consumed by the reader
+    uint m_maxLag;           //!< highest lag seen by the writer
+    quint64 m_overflowCount; //!< samples dropped while this reader was lagging
+
+    ReaderMetrics() :
+        m_lag(0),
+        m_maxLag(0),
+        m_overflowCount(0)
+    { }
+};
+
+/**
+ * Registry of the FIFO and sink counters. FIFOs and sinks register themselves at construction. Reports
+ * copy the counters under the registry lock so they can be taken from any thread. Sinks that run a
+ * channel are reported by channel as their object names are the same for all channels of a kind.
+ */
+class SDRANGEL_API DSPMetrics
+{
+public:
+    struct FifoReport
+    {
+        int m_id;
+        QString m_name;
+        FifoMetrics m_metrics;
+    };
+
+    struct SinkReport
+    {
+        int m_id;
+        QString m_name;
+        QString m_channel; //!< empty if the sink does not run a channel
+        SinkMetrics m_metrics;
+    };
+
+    struct ReaderReport
+    {
+        int m_fifoId;
+        QString m_fifoName;
+        ReaderMetrics m_metrics;
+    };
+
+    DSPMetrics();
+    ~DSPMetrics();
+
+    static DSPMetrics *instance();
+
+    void addFifo(const FifoMetrics *fifoMetrics, const SampleSinkBroadcastFifo *broadcastFifo = 0); //!< The readers of a broadcast FIFO are reported too
+    void removeFifo(const FifoMetrics *fifoMetrics);
+    void setFifoName(const FifoMetrics *fifoMetrics, const QString& name);
+    void addSink(const BasebandSampleSink *sink);
+    void removeSink(const BasebandSampleSink *sink);
+    void setSinkChannel(const BasebandSampleSink *sink, const QString& channel);
+
+    void getFifoReports(QList<FifoReport>& reports) const;
+    void getSinkReports(QList<SinkReport>& reports) const;
+    void getReaderReports(QList<ReaderReport>& reports) const;
+    QByteArray serializePrometheus() const; //!< Prometheus text exposition format
+
+private:
+    struct FifoRegistration
+    {
+        int m_id;
+        QString m_name;
+        const FifoMetrics *m_metrics;
+        const SampleSinkBroadcastFifo *m_broadcastFifo; //!< null for a single reader FIFO
+    };
+
+    struct SinkRegistration
+    {
+        int m_id;
+        QString m_channel;
+        const BasebandSampleSink *m_sink;
+    };
+
+    mutable QMutex m_mutex;
+    QList<FifoRegistration> m_fifos;
+    QList<SinkRegistration> m_sinks;
+    int m_nextId;
+};
+
+#endif /* SDRBASE_DSP_DSPMETRICS_H_ */
@@ -20,7 +20,7 @@
 #include "dsp/dvserialworker.h"
 #include "audio/audiofifo.h"
 
-MESSAGE_CLASS_DEFINITION(DVSerialWorker::MsgMbeDecode, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(DVSerialWorker::MsgMbeDecode, Message)
 MESSAGE_CLASS_DEFINITION(DVSerialWorker::MsgTest, Message)
 
 DVSerialWorker::DVSerialWorker() :
@@ -97,7 +97,7 @@ void DVSerialWorker::handleInputMessages()
 
     if (audioFifo)
     {
-        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
         if (res != m_audioBufferFill)
         {
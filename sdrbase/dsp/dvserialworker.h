@@ -48,7 +48,7 @@ public:
 
     class MsgMbeDecode : public Message
     {
-        MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED_DECLARATION
     public:
         const unsigned char *getMbeFrame() const { return m_mbeFrame; }
         SerialDV::DVRate getMbeRate() const { return m_mbeRate; }
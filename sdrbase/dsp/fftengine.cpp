@@ -24,3 +24,41 @@ FFTEngine* FFTEngine::create()
 	qCritical("FFT: no engine built");
 	return NULL;
 }
+
+bool FFTEngine::loadWisdom(const QString& fileName)
+{
+#ifdef USE_FFTW
+	return FFTWEngine::importWisdom(fileName);
+#else
+	(void) fileName;
+	return false;
+#endif // USE_FFTW
+}
+
+bool FFTEngine::saveWisdom(const QString& fileName)
+{
+#ifdef USE_FFTW
+	return FFTWEngine::exportWisdom(fileName);
+#else
+	(void) fileName;
+	return false;
+#endif // USE_FFTW
+}
+
+qint64 FFTEngine::getPlanningTimeMs()
+{
+#ifdef USE_FFTW
+	return FFTWEngine::getPlanningTimeMs();
+#else
+	return 0;
+#endif // USE_FFTW
+}
+
+int FFTEngine::getPlansCount()
+{
+#ifdef USE_FFTW
+	return FFTWEngine::getPlansCount();
+#else
+	return 0;
+#endif // USE_FFTW
+}
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_FFTENGINE_H
 #define INCLUDE_FFTENGINE_H
 
+#include <QString>
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 
@@ -15,6 +16,12 @@ public:
 	virtual Complex* out() = 0;
 
 	static FFTEngine* create();
+
+	/** Engine knowledge about the fastest plans (FFTW wisdom) kept between runs. No-op for engines without planning. */
+	static bool loadWisdom(const QString& fileName);
+	static bool saveWisdom(const QString& fileName);
+	static qint64 getPlanningTimeMs(); //!< time spent in planning since the start of the process
+	static int getPlansCount();
 };
 
 #endif // INCLUDE_FFTENGINE_H
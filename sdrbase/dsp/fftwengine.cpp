@@ -1,4 +1,5 @@
 #include <QTime>
+#include <QFile>
 #include "dsp/fftwengine.h"
 
 FFTWEngine::FFTWEngine() :
@@ -26,19 +27,14 @@ void FFTWEngine::configure(int n, bool inverse)
 	m_currentPlan->inverse = inverse;
 	m_currentPlan->in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
 	m_currentPlan->out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
-	QTime t;
-	t.start();
-	m_globalPlanMutex.lock();
-	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
-	m_globalPlanMutex.unlock();
-	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	m_currentPlan->plan = getSharedPlan(n, inverse);
 	m_plans.push_back(m_currentPlan);
 }
 
 void FFTWEngine::transform()
 {
 	if(m_currentPlan != NULL)
-		fftwf_execute(m_currentPlan->plan);
+		fftwf_execute_dft(m_currentPlan->plan, m_currentPlan->in, m_currentPlan->out);
 }
 
 Complex* FFTWEngine::in()
@@ -56,11 +52,92 @@ Complex* FFTWEngine::out()
 }
 
 QMutex FFTWEngine::m_globalPlanMutex;
+FFTWEngine::SharedPlans FFTWEngine::m_sharedPlans;
+qint64 FFTWEngine::m_planningTimeMs = 0;
+bool FFTWEngine::m_wisdomChanged = false;
+
+fftwf_plan FFTWEngine::getSharedPlan(int n, bool inverse)
+{
+	// the lock is held while planning so that a concurrent request of the same plan waits for it instead of planning it again
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	for(SharedPlans::const_iterator it = m_sharedPlans.begin(); it != m_sharedPlans.end(); ++it) {
+		if(((*it)->n == n) && ((*it)->inverse == inverse)) {
+			return (*it)->plan;
+		}
+	}
+
+	// planning overwrites the arrays so it is done on scratch buffers with the same alignment as the engines' buffers
+	fftwf_complex* in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
+	fftwf_complex* out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
+	QTime t;
+	t.start();
+	SharedPlan* sharedPlan = new SharedPlan;
+	sharedPlan->n = n;
+	sharedPlan->inverse = inverse;
+	sharedPlan->plan = fftwf_plan_dft_1d(n, in, out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+	int elapsed = t.elapsed();
+	fftwf_free(in);
+	fftwf_free(out);
+	m_sharedPlans.push_back(sharedPlan);
+	m_planningTimeMs += elapsed;
+	m_wisdomChanged = true;
+	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", elapsed);
+
+	return sharedPlan->plan;
+}
+
+bool FFTWEngine::importWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if(!QFile::exists(fileName)) {
+		qDebug("FFT: no FFTW wisdom in %s", qPrintable(fileName));
+		return false;
+	}
+
+	if(fftwf_import_wisdom_from_filename(QFile::encodeName(fileName).constData()) == 0) {
+		qWarning("FFT: cannot import FFTW wisdom from %s", qPrintable(fileName));
+		return false;
+	}
+
+	qDebug("FFT: imported FFTW wisdom from %s", qPrintable(fileName));
+	return true;
+}
+
+bool FFTWEngine::exportWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if(!m_wisdomChanged) {
+		return true; // nothing new since the import
+	}
+
+	if(fftwf_export_wisdom_to_filename(QFile::encodeName(fileName).constData()) == 0) {
+		qWarning("FFT: cannot export FFTW wisdom to %s", qPrintable(fileName));
+		return false;
+	}
+
+	m_wisdomChanged = false;
+	qDebug("FFT: exported FFTW wisdom to %s", qPrintable(fileName));
+	return true;
+}
+
+qint64 FFTWEngine::getPlanningTimeMs()
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+	return m_planningTimeMs;
+}
+
+int FFTWEngine::getPlansCount()
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+	return m_sharedPlans.size();
+}
 
 void FFTWEngine::freeAll()
 {
 	for(Plans::iterator it = m_plans.begin(); it != m_plans.end(); ++it) {
-		fftwf_destroy_plan((*it)->plan);
 		fftwf_free((*it)->in);
 		fftwf_free((*it)->out);
 		delete *it;
@@ -2,6 +2,7 @@
 #define INCLUDE_FFTWENGINE_H
 
 #include <QMutex>
+#include <QString>
 #include <fftw3.h>
 #include <list>
 #include "dsp/fftengine.h"
@@ -17,9 +18,25 @@ public:
 	Complex* in();
 	Complex* out();
 
+	static bool importWisdom(const QString& fileName);
+	static bool exportWisdom(const QString& fileName);
+	static qint64 getPlanningTimeMs();
+	static int getPlansCount();
+
 protected:
 	static QMutex m_globalPlanMutex;
 
+	/** FFTW plan shared by all engines. It is executed on the buffers of each engine with the new-array interface. */
+	struct SharedPlan {
+		int n;
+		bool inverse;
+		fftwf_plan plan;
+	};
+	typedef std::list<SharedPlan*> SharedPlans;
+	static SharedPlans m_sharedPlans;   //!< process wide cache, plans are kept until exit
+	static qint64 m_planningTimeMs;     //!< cumulated time spent creating plans
+	static bool m_wisdomChanged;        //!< plans were created that were not in the imported wisdom
+
 	struct Plan {
 		int n;
 		bool inverse;
@@ -31,6 +48,7 @@ protected:
 	Plans m_plans;
 	Plan* m_currentPlan;
 
+	static fftwf_plan getSharedPlan(int n, bool inverse);
 	void freeAll();
 };
 
@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "dsp/fftengine.h"
+#include "dsp/fftwisdom.h"
+#include "settings/mainsettings.h"
+
+FFTWisdom::FFTWisdom() :
+	m_fileName(MainSettings::getFFTWisdomFileName())
+{
+	FFTEngine::loadWisdom(m_fileName);
+}
+
+FFTWisdom::~FFTWisdom()
+{
+	FFTEngine::saveWisdom(m_fileName);
+}
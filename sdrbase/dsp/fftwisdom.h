@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FFTWISDOM_H_
+#define SDRBASE_DSP_FFTWISDOM_H_
+
+#include <QString>
+#include "util/export.h"
+
+/**
+ * Keeps the FFT engine wisdom of the programs during their lifetime: it is loaded from the file next to
+ * the settings at construction and saved back with the plans made meanwhile at destruction. Each entry
+ * point (GUI, server, batch and benchmarks) holds one so that they all share the same plans.
+ */
+class SDRANGEL_API FFTWisdom
+{
+public:
+	FFTWisdom();
+	~FFTWisdom();
+
+private:
+	QString m_fileName;
+};
+
+#endif /* SDRBASE_DSP_FFTWISDOM_H_ */
@@ -4,6 +4,10 @@
 #include "util/message.h"
 
 #include <QDebug>
+#include <QDateTime>
+#include <cstring>
+
+#include "dsp/samplepacker.h"
 
 FileRecord::FileRecord() :
 	BasebandSampleSink(),
@@ -12,7 +16,12 @@ FileRecord::FileRecord() :
     m_centerFrequency(0),
 	m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_byteCount(0),
+    m_recordFormat(RecordSDRIQ),
+    m_sampleBits(16),
+    m_sampleShift(0),
+    m_sampleCount(0),
+    m_captureDue(false)
 {
 	setObjectName("FileSink");
 }
@@ -24,7 +33,12 @@ FileRecord::FileRecord(const std::string& filename) :
     m_centerFrequency(0),
     m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_byteCount(0),
+    m_recordFormat(RecordSDRIQ),
+    m_sampleBits(16),
+    m_sampleShift(0),
+    m_sampleCount(0),
+    m_captureDue(false)
 {
     setObjectName("FileRecord");
 }
@@ -42,13 +56,27 @@ void FileRecord::setFileName(const std::string& filename)
     }
 }
 
+void FileRecord::setRecordFormat(RecordFormat format, int sampleBits, int sampleShift)
+{
+    if (!m_recordOn)
+    {
+        m_recordFormat = format;
+        m_sampleBits = SamplePacker::getBytesPerSample(sampleBits) > 0 ? sampleBits : 16;
+        m_sampleShift = (m_sampleBits == 16) || (sampleShift < 0) ? 0 : sampleShift > 8 ? 8 : sampleShift;
+    }
+}
+
 void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
 {
     // if no recording is active, send the samples to /dev/null
     if(!m_recordOn)
         return;
 
-    if (begin < end) // if there is something to put out
+    if ((begin < end) && (m_recordFormat == RecordSigMF))
+    {
+        feedSigMF(begin, end);
+    }
+    else if (begin < end) // if there is something to put out
     {
         if (m_recordStart)
         {
@@ -56,9 +84,47 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
-        m_byteCount += end - begin;
+        uint size = (end - begin)*sizeof(Sample);
+
+        // only copies to the writer ring: the engine thread never waits for the disk
+        if (m_writer.write(reinterpret_cast<const char*>(&*(begin)), size)) {
+            m_byteCount += size;
+        }
+    }
+}
+
+void FileRecord::feedSigMF(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    uint nbSamples = end - begin;
+    uint size = nbSamples * SamplePacker::getBytesPerSample(m_sampleBits);
+
+    if ((m_captureDue) || (m_sampleCount >= m_meta.m_captures.back().m_sampleStart + (quint64) m_sampleRate * FILERECORD_SIGMF_CAPTURE_PERIOD))
+    {
+        addCapture();
+        m_captureDue = false;
+    }
+
+    if (m_packBuffer.size() < size) {
+        m_packBuffer.resize(size);
+    }
+
+    SamplePacker::pack(&*begin, nbSamples, &m_packBuffer[0], m_sampleBits, m_sampleShift);
+
+    if (m_writer.write((const char *) &m_packBuffer[0], size))
+    {
+        m_sampleCount += nbSamples;
+        m_byteCount += size;
     }
+    else
+    {
+        m_captureDue = true; // samples are missing: timestamps must be anchored again
+    }
+}
+
+void FileRecord::addCapture()
+{
+    QMutexLocker mutexLocker(&m_metaMutex);
+    m_meta.m_captures.append(SigMFMeta::Capture(m_sampleCount, m_centerFrequency, m_sampleRate, QDateTime::currentMSecsSinceEpoch()));
 }
 
 void FileRecord::start()
@@ -72,10 +138,29 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    if (!m_writer.isRunning())
     {
     	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.c_str(), std::ios::binary);
+        QString fileName = QString::fromStdString(m_fileName);
+
+        if (m_recordFormat == RecordSigMF)
+        {
+            m_packBuffer.resize(FILERECORD_PACK_SIZE * SamplePacker::getBytesPerSample(m_sampleBits));
+            m_sampleCount = 0;
+            m_captureDue = false;
+            m_meta.clear();
+            m_meta.m_sampleRate = m_sampleRate;
+            m_meta.m_sampleBits = m_sampleBits;
+            m_meta.m_sampleShift = m_sampleShift;
+            addCapture();
+            m_meta.write(SigMFMeta::getMetaFileName(fileName)); // so that the data is usable if not stopped properly
+            fileName = SigMFMeta::getDataFileName(fileName);
+        }
+
+        if (!m_writer.startWork(fileName)) {
+            return;
+        }
+
         m_recordOn = true;
         m_recordStart = true;
         m_byteCount = 0;
@@ -84,12 +169,19 @@ void FileRecord::startRecording()
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    if (m_writer.isRunning())
     {
-    	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
         m_recordOn = false;
         m_recordStart = false;
+    	qDebug() << "FileRecord::stopRecording: written: " << m_writer.getBytesWritten()
+    	        << " dropped blocks: " << m_writer.getDroppedBlocks();
+        m_writer.stopWork();
+
+        if (m_recordFormat == RecordSigMF)
+        {
+            QMutexLocker mutexLocker(&m_metaMutex);
+            m_meta.write(SigMFMeta::getMetaFileName(QString::fromStdString(m_fileName)));
+        }
     }
 }
 
@@ -100,8 +192,14 @@ bool FileRecord::handleMessage(const Message& message)
 	if (DSPSignalNotification::match(message))
 	{
 		DSPSignalNotification& notif = (DSPSignalNotification&) message;
+		bool changed = (m_sampleRate != notif.getSampleRate()) || (m_centerFrequency != (quint64) notif.getCenterFrequency());
 		m_sampleRate = notif.getSampleRate();
 		m_centerFrequency = notif.getCenterFrequency();
+
+		if (changed && m_recordOn) {
+		    m_captureDue = true; // new SigMF capture segment
+		}
+
 		qDebug() << "FileRecord::handleMessage: DSPSignalNotification: m_inputSampleRate: " << m_sampleRate
 				<< " m_centerFrequency: " << m_centerFrequency;
 		return true;
@@ -124,10 +222,12 @@ void FileRecord::handleConfigure(const std::string& fileName)
 
 void FileRecord::writeHeader()
 {
-    m_sampleFile.write((const char *) &m_sampleRate, sizeof(int));
-    m_sampleFile.write((const char *) &m_centerFrequency, sizeof(quint64));
+    char header[sizeof(int) + sizeof(quint64) + sizeof(std::time_t)];
     std::time_t ts = time(0);
-    m_sampleFile.write((const char *) &ts, sizeof(std::time_t));
+    memcpy(&header[0], &m_sampleRate, sizeof(int));
+    memcpy(&header[sizeof(int)], &m_centerFrequency, sizeof(quint64));
+    memcpy(&header[sizeof(int) + sizeof(quint64)], &ts, sizeof(std::time_t));
+    m_writer.write(header, sizeof(header));
 }
 
 void FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -136,3 +236,19 @@ void FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
     sampleFile.read((char *) &(header.centerFrequency), sizeof(quint64));
     sampleFile.read((char *) &(header.startTimeStamp), sizeof(std::time_t));
 }
+
+bool FileRecord::readHeader(QFile& sampleFile, Header& header)
+{
+    bool ok = sampleFile.read((char *) &(header.sampleRate), sizeof(int)) == sizeof(int);
+    ok = ok && (sampleFile.read((char *) &(header.centerFrequency), sizeof(quint64)) == sizeof(quint64));
+    ok = ok && (sampleFile.read((char *) &(header.startTimeStamp), sizeof(std::time_t)) == sizeof(std::time_t));
+    return ok;
+}
+
+bool FileRecord::writeHeader(QFile& sampleFile, const Header& header)
+{
+    bool ok = sampleFile.write((const char *) &(header.sampleRate), sizeof(int)) == sizeof(int);
+    ok = ok && (sampleFile.write((const char *) &(header.centerFrequency), sizeof(quint64)) == sizeof(quint64));
+    ok = ok && (sampleFile.write((const char *) &(header.startTimeStamp), sizeof(std::time_t)) == sizeof(std::time_t));
+    return ok;
+}
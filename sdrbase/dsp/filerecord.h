@@ -7,12 +7,24 @@
 #include <fstream>
 
 #include <ctime>
+#include <vector>
+#include <QMutex>
+#include "dsp/filerecordwriter.h"
+#include "dsp/sigmfmeta.h"
 #include "util/export.h"
 
+#define FILERECORD_SIGMF_CAPTURE_PERIOD 60 //!< seconds of samples between SigMF capture segments
+#define FILERECORD_PACK_SIZE (1<<20)        //!< samples preallocated for packing
+
 class Message;
 
 class SDRANGEL_API FileRecord : public BasebandSampleSink {
 public:
+    typedef enum
+    {
+        RecordSDRIQ, //!< header followed by 16 bit I/Q
+        RecordSigMF  //!< .sigmf-data with I/Q packed to the native bit depth and .sigmf-meta
+    } RecordFormat;
 
     struct Header
     {
@@ -25,9 +37,15 @@ public:
     FileRecord(const std::string& filename);
 	virtual ~FileRecord();
 
-    quint64 getByteCount() const { return m_byteCount; }
+    quint64 getByteCount() const { return m_byteCount; }         //!< bytes accepted for writing
+    quint64 getBytesWritten() const { return m_writer.getBytesWritten(); }
+    uint getBytesPending() const { return m_writer.getBytesPending(); } //!< bytes waiting in the writer ring
+    int getDroppedBlocks() const { return m_writer.getDroppedBlocks(); } //!< blocks dropped because the writer ring was full
 
     void setFileName(const std::string& filename);
+    /** Takes effect at the next recording. sampleBits is 8, 12 or 16 and samples are shifted right by sampleShift before packing (SigMF only) */
+    void setRecordFormat(RecordFormat format, int sampleBits = 16, int sampleShift = 0);
+    RecordFormat getRecordFormat() const { return m_recordFormat; }
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
 	virtual void start();
@@ -36,6 +54,9 @@ public:
     void startRecording();
     void stopRecording();
     static void readHeader(std::ifstream& samplefile, Header& header);
+    static bool readHeader(QFile& sampleFile, Header& header); //!< false if the file is too short
+    static bool writeHeader(QFile& sampleFile, const Header& header); //!< .sdriq header of a file written without the recorder
+    static quint64 getHeaderSize() { return sizeof(int) + sizeof(quint64) + sizeof(std::time_t); } //!< header size in the file (not sizeof(Header))
 
 private:
 	std::string m_fileName;
@@ -43,11 +64,21 @@ private:
 	quint64 m_centerFrequency;
 	bool m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
+    FileRecordWriter m_writer;
     quint64 m_byteCount;
+    RecordFormat m_recordFormat;
+    int m_sampleBits;
+    int m_sampleShift;
+    std::vector<quint8> m_packBuffer;
+    quint64 m_sampleCount;   //!< samples written in the SigMF data file
+    bool m_captureDue;       //!< start a new SigMF capture segment at the next block
+    SigMFMeta m_meta;
+    QMutex m_metaMutex;
 
 	void handleConfigure(const std::string& fileName);
     void writeHeader();
+    void feedSigMF(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void addCapture();
 };
 
 #endif // INCLUDE_FILESINK_H
@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDebug>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+#include "dsp/filerecordwriter.h"
+
+FileRecordWriter::FileRecordWriter(QObject* parent) :
+	QThread(parent),
+	m_size(0),
+	m_mask(0),
+	m_running(false),
+	m_stopRequest(0),
+	m_writeError(0),
+	m_droppedBlocks(0),
+	m_bytesWritten(0),
+	m_fadviseOffset(0),
+	m_head(0),
+	m_tail(0)
+{
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+	stopWork();
+}
+
+bool FileRecordWriter::setSize(uint size)
+{
+	if (m_running)
+	{
+		qCritical("FileRecordWriter::setSize: cannot resize while writing");
+		return false;
+	}
+
+	uint s = 1;
+
+	while ((s < size) && (s < (1U<<30))) {
+		s <<= 1;
+	}
+
+	if (s != m_size)
+	{
+		m_size = 0;
+		m_mask = 0;
+		m_data.clear();
+		std::vector<char>(s).swap(m_data); // allocated and touched here rather than on the producer thread
+		m_size = s;
+		m_mask = s - 1;
+	}
+
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
+	return true;
+}
+
+bool FileRecordWriter::startWork(const QString& fileName)
+{
+	if (m_running) {
+		return true;
+	}
+
+	if (m_size == 0) { // allocated on the first recording only as every device has a file record
+		setSize(FILERECORDWRITER_SIZE);
+	}
+
+	m_file.setFileName(fileName);
+
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qCritical() << "FileRecordWriter::startWork: cannot open " << fileName << ": " << m_file.errorString();
+		return false;
+	}
+
+	qDebug() << "FileRecordWriter::startWork: " << fileName;
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
+	m_stopRequest.storeRelease(0);
+	m_writeError.storeRelease(0);
+	m_droppedBlocks.storeRelease(0);
+	m_statsMutex.lock();
+	m_bytesWritten = 0;
+	m_statsMutex.unlock();
+	m_fadviseOffset = 0;
+
+	m_startWaitMutex.lock();
+	start();
+	while(!m_running)
+		m_startWaiter.wait(&m_startWaitMutex, 100);
+	m_startWaitMutex.unlock();
+
+	return true;
+}
+
+void FileRecordWriter::stopWork()
+{
+	if (!m_running) {
+		return;
+	}
+
+	qDebug() << "FileRecordWriter::stopWork: pending: " << getBytesPending()
+			<< " dropped blocks: " << getDroppedBlocks();
+	m_stopRequest.storeRelease(1);
+	m_dataWaiter.wakeAll();
+	wait();
+	m_file.close();
+	m_running = false;
+}
+
+bool FileRecordWriter::write(const char* data, uint size)
+{
+	uint tail = (uint) m_tail.load();
+	uint pending = tail - (uint) m_head.loadAcquire();
+
+	if ((size > m_size - pending) || m_writeError.load())
+	{
+		m_droppedBlocks.fetchAndAddRelaxed(1);
+		return false;
+	}
+
+	uint index = tail & m_mask;
+	uint part1 = m_size - index;
+
+	if (size <= part1)
+	{
+		std::memcpy(&m_data[index], data, size);
+	}
+	else
+	{
+		std::memcpy(&m_data[index], data, part1);
+		std::memcpy(&m_data[0], data + part1, size - part1);
+	}
+
+	m_tail.storeRelease(tail + size);
+
+	if ((pending < FILERECORDWRITER_BATCH) && (pending + size >= FILERECORDWRITER_BATCH)) {
+		m_dataWaiter.wakeOne();
+	}
+
+	return true;
+}
+
+quint64 FileRecordWriter::getBytesWritten() const
+{
+	QMutexLocker mutexLocker(&m_statsMutex);
+	return m_bytesWritten;
+}
+
+void FileRecordWriter::run()
+{
+	m_running = true;
+	m_startWaiter.wakeAll();
+
+	while (!m_stopRequest.loadAcquire())
+	{
+		if (getBytesPending() < FILERECORDWRITER_BATCH)
+		{
+			// the producer does not take this mutex: a wake up lost between the test and the wait
+			// only delays the write by the timeout
+			m_dataWaitMutex.lock();
+			m_dataWaiter.wait(&m_dataWaitMutex, FILERECORDWRITER_TIMEOUT_MS);
+			m_dataWaitMutex.unlock();
+		}
+
+		writePending();
+	}
+
+	writePending(); // drain
+	m_file.flush();
+}
+
+void FileRecordWriter::writePending()
+{
+	uint head = (uint) m_head.load();
+	uint pending = (uint) m_tail.loadAcquire() - head;
+
+	while (pending > 0)
+	{
+		uint index = head & m_mask;
+		uint count = pending < m_size - index ? pending : m_size - index; // contiguous part
+		qint64 written = m_writeError.load() ? count : m_file.write(&m_data[index], count);
+
+		if (written != (qint64) count)
+		{
+			qCritical() << "FileRecordWriter::writePending: write error: " << m_file.errorString();
+			m_writeError.storeRelease(1); // discard from now on so that the producer is never stalled
+			written = count;
+		}
+
+		head += count;
+		pending -= count;
+		m_head.storeRelease(head);
+
+		m_statsMutex.lock();
+		m_bytesWritten += written;
+		m_statsMutex.unlock();
+	}
+
+	releasePages();
+}
+
+void FileRecordWriter::releasePages()
+{
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+	quint64 bytesWritten = getBytesWritten();
+
+	// keep the last window in the cache: it is probably still being written back
+	if (bytesWritten >= m_fadviseOffset + 2*FILERECORDWRITER_FADVISE)
+	{
+		m_file.flush();
+		posix_fadvise(m_file.handle(), m_fadviseOffset, FILERECORDWRITER_FADVISE, POSIX_FADV_DONTNEED);
+		m_fadviseOffset += FILERECORDWRITER_FADVISE;
+	}
+#endif
+}
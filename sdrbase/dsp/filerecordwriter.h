@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_FILERECORDWRITER_H
+#define INCLUDE_FILERECORDWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+#include "util/export.h"
+
+#define FILERECORDWRITER_SIZE (64*1024*1024)     //!< default ring size in bytes (power of two)
+#define FILERECORDWRITER_BATCH (1024*1024)       //!< pending bytes that wake up the writer thread
+#define FILERECORDWRITER_TIMEOUT_MS 50           //!< maximum time data sits in the ring below the batch size
+#define FILERECORDWRITER_FADVISE (16*1024*1024)  //!< written bytes between page cache releases
+#define FILERECORDWRITER_CACHE_LINE 64
+
+/**
+ * Writes a record file from a dedicated thread. The producer (normally the DSP engine thread)
+ * copies data into a preallocated single producer / single consumer ring and never waits for
+ * the disk: if the ring is full the block is dropped and counted. The writer thread wakes up when
+ * a batch is pending or on a timeout and writes the contiguous parts of the ring in one go.
+ * On Linux the written pages are released from the page cache as the file grows so that long
+ * recordings do not evict everything else.
+ */
+class SDRANGEL_API FileRecordWriter : public QThread {
+	Q_OBJECT
+
+public:
+	FileRecordWriter(QObject* parent = NULL);
+	~FileRecordWriter();
+
+	bool setSize(uint size);         //!< ring size rounded up to a power of two. Only when stopped. Default on first start.
+	uint size() const { return m_size; }
+
+	bool startWork(const QString& fileName);
+	void stopWork();                 //!< writes what is pending then closes the file
+	bool isRunning() const { return m_running; }
+
+	/** Producer side. Returns false and counts a dropped block if it does not fit. Never blocks. */
+	bool write(const char* data, uint size);
+
+	uint getBytesPending() const { return (uint) m_tail.loadAcquire() - (uint) m_head.loadAcquire(); }
+	quint64 getBytesWritten() const;
+	int getDroppedBlocks() const { return m_droppedBlocks.load(); }
+	bool hasWriteError() const { return m_writeError.load() != 0; }
+
+private:
+	std::vector<char> m_data;
+	uint m_size;
+	uint m_mask;
+
+	QFile m_file;
+	bool m_running;
+	QAtomicInt m_stopRequest;
+	QAtomicInt m_writeError;
+	QAtomicInt m_droppedBlocks;
+	QMutex m_startWaitMutex;
+	QWaitCondition m_startWaiter;
+	QMutex m_dataWaitMutex;
+	QWaitCondition m_dataWaiter;
+
+	mutable QMutex m_statsMutex;
+	quint64 m_bytesWritten;  //!< updated by the writer thread only
+	quint64 m_fadviseOffset; //!< file offset up to which pages were released
+
+	char m_pad0[FILERECORDWRITER_CACHE_LINE];
+	QAtomicInt m_head;       //!< consumer index (written by the writer thread only)
+	char m_pad1[FILERECORDWRITER_CACHE_LINE - sizeof(QAtomicInt)];
+	QAtomicInt m_tail;       //!< producer index (written by the producer thread only)
+	char m_pad2[FILERECORDWRITER_CACHE_LINE - sizeof(QAtomicInt)];
+
+	void run();
+	void writePending();
+	void releasePages();
+};
+
+#endif // INCLUDE_FILERECORDWRITER_H
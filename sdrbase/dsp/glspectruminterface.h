@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_GLSPECTRUMINTERFACE_H_
+#define SDRBASE_DSP_GLSPECTRUMINTERFACE_H_
+
+#include <vector>
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * What SpectrumVis needs from its display. Implemented by GLSpectrum and by the benchmarks
+ * so that the spectrum can be computed without any widget.
+ */
+class SDRANGEL_API GLSpectrumInterface
+{
+public:
+    GLSpectrumInterface() {}
+    virtual ~GLSpectrumInterface() {}
+    /** lineSamples is the number of input samples since the previous spectrum i.e. the time span of a waterfall line */
+    virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize, int lineSamples) = 0;
+};
+
+#endif /* SDRBASE_DSP_GLSPECTRUMINTERFACE_H_ */
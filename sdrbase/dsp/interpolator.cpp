@@ -1,7 +1,70 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <vector>
+#include <list>
+#include <QMutex>
 #include "dsp/interpolator.h"
+#include "dsp/decimatorssimd.h"
+
+namespace
+{
+
+struct PolyphaseTaps
+{
+	int m_phaseSteps;
+	double m_sampleRate;
+	double m_cutoff;
+	double m_nbTapsPerPhase;
+	std::vector<Real> m_polyphase;
+};
+
+// most recently used first
+QMutex polyphaseTapsMutex;
+std::list<PolyphaseTaps> polyphaseTapsCache;
+
+void firBlockScalar(const Complex *samples, const float *taps, int nbTaps, const int *pos, const int *phase, int nbOut, Complex *out)
+{
+	for (int k = 0; k < nbOut; k++)
+	{
+		const Complex *src = samples + pos[k];
+		const float *coeff = taps + phase[k] * 2 * nbTaps;
+		Real rAcc = 0;
+		Real iAcc = 0;
+
+		for (int t = 0; t < nbTaps; t++)
+		{
+			rAcc += coeff[2*t] * src[t].real();
+			iAcc += coeff[2*t] * src[t].imag();
+		}
+
+		out[k] = Complex(rAcc, iAcc);
+	}
+}
+
+#if USE_SSE2
+void firBlockSSE2(const Complex *samples, const float *taps, int nbTaps, const int *pos, const int *phase, int nbOut, Complex *out)
+{
+	for (int k = 0; k < nbOut; k++)
+	{
+		const float *src = (const float*) (samples + pos[k]);
+		const __m128 *coeff = (const __m128*) (taps + phase[k] * 2 * nbTaps);
+		__m128 sum0 = _mm_setzero_ps();
+		__m128 sum1 = _mm_setzero_ps();
+
+		for (int t = 0; t < nbTaps / 2; t += 2)
+		{
+			sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(src), coeff[t]));
+			sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(src + 4), coeff[t + 1]));
+			src += 8;
+		}
+
+		sum0 = _mm_add_ps(sum0, sum1);
+		_mm_storel_pi((__m64*) &out[k], _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0)));
+	}
+}
+#endif
+
+} // namespace
 
 
 void Interpolator::createPolyphaseLowPass(
@@ -62,7 +125,11 @@ Interpolator::Interpolator() :
 	m_alignedTaps2(0),
     m_ptr(0),
 	m_phaseSteps(1),
-    m_nTaps(1)
+    m_nTaps(1),
+    m_blockTaps(0),
+    m_alignedBlockTaps(0),
+    m_blockNTaps(INTERPOLATOR_BLOCK_TAPS_MULTIPLE),
+    m_firBlockKernel(getFIRBlockKernel())
 {
 }
 
@@ -75,6 +142,69 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 {
 	free();
 
+	std::vector<Real> polyphase;
+	getPolyphaseTaps(polyphase, phaseSteps, sampleRate, cutoff, nbTapsPerPhase);
+
+	// init state
+	m_ptr = 0;
+	m_nTaps = polyphase.size() / phaseSteps;
+	m_phaseSteps = phaseSteps;
+	m_samples.resize(m_nTaps + 2);
+	for(int i = 0; i < m_nTaps + 2; i++)
+		m_samples[i] = 0;
+
+	// move taps around to match sse storage requirements
+	m_taps = new float[2 * polyphase.size() + 8];
+	for(uint i = 0; i < 2 * polyphase.size() + 8; ++i)
+		m_taps[i] = 0;
+	m_alignedTaps = (float*)((((quint64)m_taps) + 15) & ~15);
+	for(uint i = 0; i < polyphase.size(); ++i) {
+		m_alignedTaps[2 * i + 0] = polyphase[i];
+		m_alignedTaps[2 * i + 1] = polyphase[i];
+	}
+	m_taps2 = new float[2 * polyphase.size() + 8];
+	for(uint i = 0; i < 2 * polyphase.size() + 8; ++i)
+		m_taps2[i] = 0;
+	m_alignedTaps2 = (float*)((((quint64)m_taps2) + 15) & ~15);
+	for(uint i = 1; i < polyphase.size(); ++i) {
+		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
+		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
+	}
+
+	// block filters: oldest sample first so that the dot product runs on contiguous samples
+	m_blockNTaps = ((m_nTaps + INTERPOLATOR_BLOCK_TAPS_MULTIPLE - 1) / INTERPOLATOR_BLOCK_TAPS_MULTIPLE) * INTERPOLATOR_BLOCK_TAPS_MULTIPLE;
+	m_blockTaps = new float[2 * m_blockNTaps * phaseSteps + 8];
+	for(int i = 0; i < 2 * m_blockNTaps * phaseSteps + 8; ++i)
+		m_blockTaps[i] = 0;
+	m_alignedBlockTaps = (float*)((((quint64)m_blockTaps) + 31) & ~31);
+	for(int phase = 0; phase < phaseSteps; phase++) {
+		for(int i = 0; i < m_nTaps; i++) { // i is the age of the sample
+			int t = m_blockNTaps - 1 - i;
+			m_alignedBlockTaps[2 * (phase * m_blockNTaps + t) + 0] = polyphase[phase * m_nTaps + i];
+			m_alignedBlockTaps[2 * (phase * m_blockNTaps + t) + 1] = polyphase[phase * m_nTaps + i];
+		}
+	}
+}
+
+void Interpolator::getPolyphaseTaps(
+        std::vector<Real>& polyphase,
+        int phaseSteps,
+        double sampleRate,
+        double cutoff,
+        double nbTapsPerPhase)
+{
+	QMutexLocker mutexLocker(&polyphaseTapsMutex);
+
+	for(std::list<PolyphaseTaps>::iterator it = polyphaseTapsCache.begin(); it != polyphaseTapsCache.end(); ++it)
+	{
+		if((it->m_phaseSteps == phaseSteps) && (it->m_sampleRate == sampleRate) && (it->m_cutoff == cutoff) && (it->m_nbTapsPerPhase == nbTapsPerPhase))
+		{
+			polyphase = it->m_polyphase;
+			polyphaseTapsCache.splice(polyphaseTapsCache.begin(), polyphaseTapsCache, it);
+			return;
+		}
+	}
+
 	std::vector<Real> taps;
 
 	createPolyphaseLowPass(
@@ -85,47 +215,109 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 		cutoff, // hz beginning of transition band
 		nbTapsPerPhase);
 
-	// init state
-	m_ptr = 0;
-	m_nTaps = taps.size() / phaseSteps;
-	m_phaseSteps = phaseSteps;
-	m_samples.resize(m_nTaps + 2);
-	for(int i = 0; i < m_nTaps + 2; i++)
-		m_samples[i] = 0;
+	int nTaps = taps.size() / phaseSteps;
 
 	// reorder into polyphase
-	std::vector<Real> polyphase(taps.size());
+	polyphase.resize(taps.size());
 	for(int phase = 0; phase < phaseSteps; phase++) {
-		for(int i = 0; i < m_nTaps; i++)
-			polyphase[phase * m_nTaps + i] = taps[i * phaseSteps + phase];
+		for(int i = 0; i < nTaps; i++)
+			polyphase[phase * nTaps + i] = taps[i * phaseSteps + phase];
 	}
 
 	// normalize phase filters
 	for(int phase = 0; phase < phaseSteps; phase++) {
 		Real sum = 0;
-		for(int i = phase * m_nTaps; i < phase * m_nTaps + m_nTaps; i++)
+		for(int i = phase * nTaps; i < phase * nTaps + nTaps; i++)
 			sum += polyphase[i];
-		for(int i = phase * m_nTaps; i < phase * m_nTaps + m_nTaps; i++)
+		for(int i = phase * nTaps; i < phase * nTaps + nTaps; i++)
 			polyphase[i] /= sum;
 	}
 
-	// move taps around to match sse storage requirements
-	m_taps = new float[2 * taps.size() + 8];
-	for(uint i = 0; i < 2 * taps.size() + 8; ++i)
-		m_taps[i] = 0;
-	m_alignedTaps = (float*)((((quint64)m_taps) + 15) & ~15);
-	for(uint i = 0; i < taps.size(); ++i) {
-		m_alignedTaps[2 * i + 0] = polyphase[i];
-		m_alignedTaps[2 * i + 1] = polyphase[i];
+	PolyphaseTaps entry;
+	entry.m_phaseSteps = phaseSteps;
+	entry.m_sampleRate = sampleRate;
+	entry.m_cutoff = cutoff;
+	entry.m_nbTapsPerPhase = nbTapsPerPhase;
+	entry.m_polyphase = polyphase;
+	polyphaseTapsCache.push_front(entry);
+
+	if(polyphaseTapsCache.size() > INTERPOLATOR_TAPS_CACHE_SIZE)
+		polyphaseTapsCache.pop_back();
+}
+
+int Interpolator::decimate(Real *distanceRemain, Real distance, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	if(nbIn <= 0)
+		return 0;
+
+	int history = m_blockNTaps - 1;
+
+	if((int) m_blockSamples.size() < history + nbIn) {
+		m_blockSamples.resize(history + nbIn);
+		m_blockPos.resize(nbIn);
+		m_blockPhase.resize(nbIn);
 	}
-	m_taps2 = new float[2 * taps.size() + 8];
-	for(uint i = 0; i < 2 * taps.size() + 8; ++i)
-		m_taps2[i] = 0;
-	m_alignedTaps2 = (float*)((((quint64)m_taps2) + 15) & ~15);
-	for(uint i = 1; i < taps.size(); ++i) {
-		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
-		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
+
+	// the ring buffer is the state shared with the per sample methods: unroll it in time order
+	Complex* samples = &m_blockSamples[0];
+	for(int i = 0; i < history; i++) {
+		int age = history - 1 - i;
+		samples[i] = age < m_nTaps ? m_samples[(m_ptr + age) % m_nTaps] : Complex(0, 0);
 	}
+	std::copy(in, in + nbIn, samples + history);
+
+	// outputs and their phases exactly as decimate() would produce them
+	int nbOut = 0;
+	for(int k = 0; k < nbIn; k++) {
+		*distanceRemain -= 1.0;
+		if(*distanceRemain < 1.0) {
+			int phase = (int) floor(*distanceRemain * (Real)m_phaseSteps);
+			m_blockPos[nbOut] = k; // window of the output ends at input k
+			m_blockPhase[nbOut] = phase < 0 ? 0 : phase;
+			nbOut++;
+			*distanceRemain += distance;
+		}
+	}
+
+	if((int) out.size() < nbOut)
+		out.resize(nbOut);
+
+	if(nbOut > 0)
+		m_firBlockKernel(samples, m_alignedBlockTaps, m_blockNTaps, &m_blockPos[0], &m_blockPhase[0], nbOut, &out[0]);
+
+	// back to the ring with the newest sample first
+	m_ptr = 0;
+	for(int age = 0; age < m_nTaps; age++)
+		m_samples[age] = samples[history + nbIn - 1 - age];
+
+	return nbOut;
+}
+
+Interpolator::FIRBlockKernel Interpolator::selectFIRBlockKernel()
+{
+	FIRBlockKernel kernel = firBlockScalar;
+	const char* name = "scalar";
+#if USE_SSE2
+	kernel = firBlockSSE2;
+	name = "SSE2";
+#endif
+
+	if(getInterpolatorKernelAVX2() && DecimatorsSIMD::isSupported(DecimatorsSIMD::ArchAVX2)) {
+		kernel = getInterpolatorKernelAVX2();
+		name = "AVX2";
+	} else if(getInterpolatorKernelNEON() && DecimatorsSIMD::isSupported(DecimatorsSIMD::ArchNEON)) {
+		kernel = getInterpolatorKernelNEON();
+		name = "NEON";
+	}
+
+	qDebug("Interpolator::selectFIRBlockKernel: using %s kernel", name);
+	return kernel;
+}
+
+Interpolator::FIRBlockKernel Interpolator::getFIRBlockKernel()
+{
+	static FIRBlockKernel best = selectFIRBlockKernel(); // thread safe initialization
+	return best;
 }
 
 void Interpolator::free()
@@ -137,5 +329,8 @@ void Interpolator::free()
 		delete[] m_taps2;
 		m_taps2 = NULL;
 		m_alignedTaps2 = NULL;
+		delete[] m_blockTaps;
+		m_blockTaps = NULL;
+		m_alignedBlockTaps = NULL;
 	}
 }
@@ -7,12 +7,22 @@
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 #include <stdio.h>
+#include <vector>
 #ifndef __WINDOWS__
 #include <unistd.h>
 #endif
 
+#define INTERPOLATOR_BLOCK_TAPS_MULTIPLE 4 //!< taps of the block filters are padded to a multiple of this (one AVX register of complex)
+#define INTERPOLATOR_TAPS_CACHE_SIZE 32    //!< number of polyphase filters kept for reuse by create()
+
 class SDRANGEL_API Interpolator {
 public:
+	/**
+	 * Block FIR kernel: out[k] = sum(t = 0..nbTaps-1) taps[phase[k] * 2 * nbTaps + 2t] * samples[pos[k] + t]
+	 * with interleaved (duplicated) real taps aligned to 32 bytes and nbTaps a multiple of INTERPOLATOR_BLOCK_TAPS_MULTIPLE
+	 */
+	typedef void (*FIRBlockKernel)(const Complex *samples, const float *taps, int nbTaps, const int *pos, const int *phase, int nbOut, Complex *out);
+
 	Interpolator();
 	~Interpolator();
 
@@ -75,6 +85,15 @@ public:
 		return true;
 	}
 
+	/**
+	 * Block equivalent of decimate() called for each of the nbIn samples of in with distance added to
+	 * *distanceRemain after each output. Outputs are written at the start of out which is only grown.
+	 * Returns the number of outputs. Both forms can be used in turn on the same interpolator.
+	 */
+	int decimate(Real *distanceRemain, Real distance, const Complex *in, int nbIn, std::vector<Complex>& out);
+
+	static FIRBlockKernel getFIRBlockKernel(); //!< best kernel for this CPU, detected once
+
 private:
 	float* m_taps;
 	float* m_alignedTaps;
@@ -85,6 +104,23 @@ private:
 	int m_phaseSteps;
 	int m_nTaps;
 
+	// block processing
+	float* m_blockTaps;
+	float* m_alignedBlockTaps;     //!< per phase taps in time order padded in front with zeros
+	int m_blockNTaps;              //!< m_nTaps rounded up to INTERPOLATOR_BLOCK_TAPS_MULTIPLE
+	std::vector<Complex> m_blockSamples; //!< linear history followed by the input block
+	std::vector<int> m_blockPos;
+	std::vector<int> m_blockPhase;
+	FIRBlockKernel m_firBlockKernel;
+
+	static void getPolyphaseTaps(
+	    std::vector<Real>& polyphase,
+	    int phaseSteps,
+	    double sampleRate,
+	    double cutoff,
+	    double nbTapsPerPhase);
+	static FIRBlockKernel selectFIRBlockKernel();
+
 	static void createPolyphaseLowPass(
 	    std::vector<Real>& taps,
 	    int phaseSteps,
@@ -197,4 +233,8 @@ private:
 	}
 };
 
+// kernels of the instruction set specific translation units. NULL when not built.
+Interpolator::FIRBlockKernel getInterpolatorKernelAVX2();
+Interpolator::FIRBlockKernel getInterpolatorKernelNEON();
+
 #endif // INCLUDE_INTERPOLATOR_H
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+// Compiled with AVX2 code generation enabled. Only called when the CPU supports it.
+
+#include "interpolator.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace
+{
+
+void firBlock(const Complex *samples, const float *taps, int nbTaps, const int *pos, const int *phase, int nbOut, Complex *out)
+{
+	for (int k = 0; k < nbOut; k++)
+	{
+		const float *src = (const float*) (samples + pos[k]);
+		const float *coeff = taps + phase[k] * 2 * nbTaps;
+		__m256 sum = _mm256_setzero_ps();
+
+		for (int t = 0; t < 2 * nbTaps; t += 8) {
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(src + t), _mm256_load_ps(coeff + t)));
+		}
+
+		// [r0 i0 r1 i1 r2 i2 r3 i3] -> r0+r1+r2+r3 i0+i1+i2+i3
+		__m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+		_mm_storel_pi((__m64*) &out[k], _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4)));
+	}
+}
+
+} // namespace
+
+Interpolator::FIRBlockKernel getInterpolatorKernelAVX2()
+{
+	return firBlock;
+}
+
+#else
+
+Interpolator::FIRBlockKernel getInterpolatorKernelAVX2()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+// Compiled with NEON code generation enabled (armv7 with -mfpu=neon or aarch64).
+
+#include "interpolator.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+namespace
+{
+
+void firBlock(const Complex *samples, const float *taps, int nbTaps, const int *pos, const int *phase, int nbOut, Complex *out)
+{
+	for (int k = 0; k < nbOut; k++)
+	{
+		const float *src = (const float*) (samples + pos[k]);
+		const float *coeff = taps + phase[k] * 2 * nbTaps;
+		float32x4_t sum0 = vdupq_n_f32(0.0f);
+		float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+		for (int t = 0; t < 2 * nbTaps; t += 8)
+		{
+			sum0 = vmlaq_f32(sum0, vld1q_f32(src + t), vld1q_f32(coeff + t));
+			sum1 = vmlaq_f32(sum1, vld1q_f32(src + t + 4), vld1q_f32(coeff + t + 4));
+		}
+
+		// [r0 i0 r1 i1] -> r0+r1 i0+i1
+		sum0 = vaddq_f32(sum0, sum1);
+		float32x2_t sum2 = vadd_f32(vget_low_f32(sum0), vget_high_f32(sum0));
+		vst1_f32((float*) &out[k], sum2);
+	}
+}
+
+} // namespace
+
+Interpolator::FIRBlockKernel getInterpolatorKernelNEON()
+{
+	return firBlock;
+}
+
+#else
+
+Interpolator::FIRBlockKernel getInterpolatorKernelNEON()
+{
+	return 0;
+}
+
+#endif
@@ -20,6 +20,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "dsp/nco.h"
+#include "dsp/ncomixer.h"
 
 Real NCO::m_table[NCO::TableSize];
 bool NCO::m_tableInitialized = false;
@@ -102,3 +103,24 @@ void NCO::getQI(Complex& c)
 	c.imag(m_table[m_phase]);
 	c.real(-m_table[(m_phase + TableSize / 4) % TableSize]);
 }
+
+void NCO::mixIQ(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, std::vector<Complex>& out)
+{
+	std::size_t nbSamples = end - begin;
+
+	if (nbSamples == 0) {
+		return;
+	}
+
+	if (out.size() < nbSamples) {
+		out.resize(nbSamples);
+	}
+
+	// nextIQ increments the phase before the lookup
+	NCOMixer::mix(&(*begin), nbSamples, &out[0],
+			(2.0 * M_PI * (m_phase + m_phaseIncrement)) / TableSize,
+			(2.0 * M_PI * m_phaseIncrement) / TableSize);
+
+	long long phase = (m_phase + (long long) m_phaseIncrement * (long long) nbSamples) % TableSize;
+	m_phase = phase < 0 ? phase + TableSize : phase;
+}
@@ -19,6 +19,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "dsp/ncof.h"
+#include "dsp/ncomixer.h"
 
 Real NCOF::m_table[NCOF::TableSize];
 bool NCOF::m_tableInitialized = false;
@@ -90,3 +91,28 @@ void NCOF::getQI(Complex& c)
 	c.imag(m_table[(int) m_phase]);
 	c.real(-m_table[((int) m_phase + TableSize / 4) % TableSize]);
 }
+
+void NCOF::mixIQ(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, std::vector<Complex>& out)
+{
+	std::size_t nbSamples = end - begin;
+
+	if (nbSamples == 0) {
+		return;
+	}
+
+	if (out.size() < nbSamples) {
+		out.resize(nbSamples);
+	}
+
+	// nextIQ increments the phase before the lookup. The rotator uses the fractional phase that the table truncates.
+	NCOMixer::mix(&(*begin), nbSamples, &out[0],
+			(2.0 * M_PI * (m_phase + m_phaseIncrement)) / TableSize,
+			(2.0 * M_PI * m_phaseIncrement) / TableSize);
+
+	double phase = fmod(m_phase + (double) m_phaseIncrement * nbSamples, (double) TableSize);
+	m_phase = phase < 0 ? phase + TableSize : phase;
+
+	if (m_phase >= TableSize) { // rounding of a phase just below 0
+		m_phase -= TableSize;
+	}
+}
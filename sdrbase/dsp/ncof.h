@@ -57,6 +57,12 @@ public:
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();        //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c); //!< Sets to the current complex sample (no phase increment, reversed)
+
+	/**
+	 * Block equivalent of Complex(s.real(), s.imag()) * nextIQ() for each sample of [begin, end) written
+	 * at the start of out. out is only grown so that the caller's buffer is allocated once.
+	 */
+	void mixIQ(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, std::vector<Complex>& out);
 };
 
 #endif // INCLUDE_NCO_H
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include "dsp/ncomixer.h"
+
+void NCOMixer::mix(const Sample* in, std::size_t nbSamples, Complex* out, double phase, double phaseIncrement)
+{
+	Real *o = reinterpret_cast<Real*>(out); // std::complex is two contiguous floats
+	Real pr[NCOMIXER_LANES], pi[NCOMIXER_LANES];
+	Real wr = cos(NCOMIXER_LANES * phaseIncrement);
+	Real wi = sin(NCOMIXER_LANES * phaseIncrement);
+	std::size_t i = 0;
+
+	while (i < nbSamples)
+	{
+		std::size_t run = nbSamples - i < NCOMIXER_RUN ? nbSamples - i : NCOMIXER_RUN;
+		std::size_t runEnd = i + run;
+		std::size_t end = i + (run / NCOMIXER_LANES) * NCOMIXER_LANES;
+
+		for (int k = 0; k < NCOMIXER_LANES; k++)
+		{
+			pr[k] = cos(phase + k * phaseIncrement);
+			pi[k] = sin(phase + k * phaseIncrement);
+		}
+
+		for (; i < end; i += NCOMIXER_LANES)
+		{
+			for (int k = 0; k < NCOMIXER_LANES; k++)
+			{
+				Real x = in[i + k].real();
+				Real y = in[i + k].imag();
+				o[2 * (i + k)]     = x * pr[k] - y * pi[k];
+				o[2 * (i + k) + 1] = x * pi[k] + y * pr[k];
+				Real t = pr[k] * wr - pi[k] * wi;
+				pi[k]  = pr[k] * wi + pi[k] * wr;
+				pr[k]  = t;
+			}
+		}
+
+		// samples of a short last run that do not fill all the lanes
+		for (int k = 0; i < runEnd; i++, k++)
+		{
+			Real x = in[i].real();
+			Real y = in[i].imag();
+			o[2 * i]     = x * pr[k] - y * pi[k];
+			o[2 * i + 1] = x * pi[k] + y * pr[k];
+		}
+
+		phase = fmod(phase + run * phaseIncrement, 2.0 * M_PI);
+	}
+}
@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_NCOMIXER_H
+#define INCLUDE_NCOMIXER_H
+
+#include <cstddef>
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Block frequency shifter used by NCO::mixIQ and NCOF::mixIQ.
+ *
+ * out[k] = Complex(in[k].real(), in[k].imag()) * exp(j * (phase + k * phaseIncrement))
+ *
+ * The oscillator is a recursive phasor rotator: NCOMIXER_LANES independent phasors advance by
+ * NCOMIXER_LANES increments at each step so that the loop has no dependency between adjacent
+ * samples and no table lookup, and the compiler vectorizes it. The phasors are recomputed exactly
+ * every NCOMIXER_RUN samples which prevents the amplitude and phase from drifting.
+ */
+#define NCOMIXER_LANES 4
+#define NCOMIXER_RUN 256
+
+class SDRANGEL_API NCOMixer {
+public:
+	/** phase and phaseIncrement in radians, phase is the one of the first sample */
+	static void mix(const Sample* in, std::size_t nbSamples, Complex* out, double phase, double phaseIncrement);
+};
+
+#endif // INCLUDE_NCOMIXER_H
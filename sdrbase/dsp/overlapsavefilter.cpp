@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+
+#include "dsp/fftengine.h"
+#include "dsp/overlapsavefilter.h"
+
+namespace {
+
+inline float fsinc(float fc, int i, int len)
+{
+    return (i == len/2) ? 2.0 * fc : sin(2 * M_PI * fc * (i - len/2)) / (M_PI * (i - len/2));
+}
+
+inline float blackman(int i, int len)
+{
+    return (0.42 - 0.50 * cos(2.0 * M_PI * i / len) + 0.08 * cos(4.0 * M_PI * i / len));
+}
+
+} // namespace
+
+OverlapSaveFilter::Response::Response(int fftSize) :
+    m_fftSize(fftSize),
+    m_bins(fftSize)
+{
+    createDSBFilter(0.5f);
+}
+
+void OverlapSaveFilter::Response::createFilter(float f1, float f2)
+{
+    int len = m_fftSize / 2;
+    bool lowpass = (f2 != 0);
+    bool highpass = (f1 != 0);
+
+    std::fill(m_bins.begin(), m_bins.end(), Complex(0, 0));
+
+    for (int i = 0; i < len; i++)
+    {
+        float tap = 0;
+
+        if (lowpass) {
+            tap += fsinc(f2, i, len);
+        }
+        if (highpass) {
+            tap -= fsinc(f1, i, len);
+        }
+
+        m_bins[i] = tap;
+    }
+
+    if (highpass && (f2 < f1)) { // band reject is delta[len/2] - h(t)
+        m_bins[len / 2] += 1;
+    }
+
+    for (int i = 0; i < len; i++) {
+        m_bins[i] *= blackman(i, len);
+    }
+
+    transform();
+}
+
+void OverlapSaveFilter::Response::createDSBFilter(float f2)
+{
+    int len = m_fftSize / 2;
+
+    std::fill(m_bins.begin(), m_bins.end(), Complex(0, 0));
+
+    for (int i = 0; i < len; i++) {
+        m_bins[i] = fsinc(f2, i, len) * blackman(i, len);
+    }
+
+    transform();
+}
+
+void OverlapSaveFilter::Response::createSSBFilter(float f1, float f2, bool usb, bool getDC)
+{
+    int len = m_fftSize / 2;
+    float center = usb ? (f1 + f2) / 2 : -(f1 + f2) / 2;
+
+    std::fill(m_bins.begin(), m_bins.end(), Complex(0, 0));
+
+    // low pass of half the band width shifted to the center of the side band: the impulse response
+    // stays within half the FFT size so there is no time aliasing unlike the one side of a real band pass
+    for (int i = 0; i < len; i++)
+    {
+        float a = 2 * M_PI * center * (i - len/2);
+        m_bins[i] = Complex(cos(a), sin(a)) * (fsinc((f2 - f1) / 2, i, len) * blackman(i, len));
+    }
+
+    transform();
+
+    if (!getDC) {
+        m_bins[0] = 0;
+    }
+}
+
+void OverlapSaveFilter::Response::transform()
+{
+    FFTEngine *fft = FFTEngine::create();
+    fft->configure(m_fftSize, false);
+    std::copy(m_bins.begin(), m_bins.end(), fft->in());
+    fft->transform();
+    std::copy(fft->out(), fft->out() + m_fftSize, m_bins.begin());
+    delete fft;
+
+    // unity gain and the 1/N of the inverse FFT
+    float scale = 0;
+
+    for (int i = 0; i < m_fftSize; i++) {
+        scale = std::max(scale, std::abs(m_bins[i]));
+    }
+
+    if (scale != 0)
+    {
+        for (int i = 0; i < m_fftSize; i++) {
+            m_bins[i] /= scale * m_fftSize;
+        }
+    }
+}
+
+OverlapSaveFilter::OverlapSaveFilter(const Response *response) :
+    m_response(response),
+    m_fftSize(response->getFFTSize()),
+    m_hop(m_fftSize / 2),
+    m_fill(0),
+    m_time(m_fftSize),
+    m_output(m_hop),
+    m_fwd(FFTEngine::create()),
+    m_inv(FFTEngine::create())
+{
+    m_fwd->configure(m_fftSize, false);
+    m_inv->configure(m_fftSize, true);
+}
+
+OverlapSaveFilter::~OverlapSaveFilter()
+{
+    delete m_fwd;
+    delete m_inv;
+}
+
+void OverlapSaveFilter::setResponse(const Response *response)
+{
+    if (response->getFFTSize() != m_fftSize)
+    {
+        qWarning("OverlapSaveFilter::setResponse: FFT size %d instead of %d", response->getFFTSize(), m_fftSize);
+        return;
+    }
+
+    m_response = response;
+}
+
+void OverlapSaveFilter::reset()
+{
+    std::fill(m_time.begin(), m_time.end(), Complex(0, 0));
+    std::fill(m_output.begin(), m_output.end(), Complex(0, 0));
+    m_fill = 0;
+}
+
+void OverlapSaveFilter::process(const Complex *in, Complex *out, int nbSamples)
+{
+    int done = 0;
+
+    while (done < nbSamples)
+    {
+        int chunk = std::min(nbSamples - done, m_hop - m_fill);
+
+        // input is read before the output is written so that in place works
+        std::copy(in + done, in + done + chunk, m_time.begin() + m_hop + m_fill);
+        std::copy(m_output.begin() + m_fill, m_output.begin() + m_fill + chunk, out + done);
+        m_fill += chunk;
+        done += chunk;
+
+        if (m_fill == m_hop)
+        {
+            runFFT();
+            m_fill = 0;
+        }
+    }
+}
+
+void OverlapSaveFilter::runFFT()
+{
+    std::copy(m_time.begin(), m_time.end(), m_fwd->in());
+    m_fwd->transform();
+
+    const Complex *x = m_fwd->out();
+    const Complex *h = m_response->getBins();
+    Complex *y = m_inv->in();
+
+    for (int i = 0; i < m_fftSize; i++) // written out so that it does not go through the NaN checks of std::complex
+    {
+        y[i] = Complex(x[i].real() * h[i].real() - x[i].imag() * h[i].imag(),
+                x[i].real() * h[i].imag() + x[i].imag() * h[i].real());
+    }
+
+    m_inv->transform();
+
+    // the first half is aliased by the circular convolution: the second half is the linear convolution of the current hop
+    std::copy(m_inv->out() + m_hop, m_inv->out() + m_fftSize, m_output.begin());
+    std::copy(m_time.begin() + m_hop, m_time.end(), m_time.begin());
+}
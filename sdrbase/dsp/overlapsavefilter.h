@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_OVERLAPSAVEFILTER_H_
+#define SDRBASE_DSP_OVERLAPSAVEFILTER_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+class FFTEngine;
+
+/**
+ * Block FFT filter with the overlap-save method on the FFT engine of the project (FFTW plans and wisdom
+ * when available). This is the block counterpart of fftfilt which is fed one sample at a time: for the
+ * same FFT size and response shape the output is the same.
+ */
+class SDRANGEL_API OverlapSaveFilter
+{
+public:
+    /**
+     * Frequency response for an FFT size including the inverse FFT scaling. Shapes are the ones of fftfilt:
+     * Blackman windowed sinc over half the FFT size normalized for unity gain. A response can be shared by
+     * any number of filters that must not outlive it and sees its changes at their next FFT.
+     */
+    class SDRANGEL_API Response
+    {
+    public:
+        Response(int fftSize);
+
+        void createFilter(float f1, float f2); //!< f1 < f2 band pass, f1 > f2 band reject, f1 = 0 low pass, f2 = 0 high pass. Relative to the sample rate.
+        void createDSBFilter(float f2);        //!< low pass at f2 relative to the sample rate
+        void createSSBFilter(float f1, float f2, bool usb, bool getDC = true); //!< one side band between f1 and f2 (0 <= f1 < f2) as fftfilt::runSSB
+
+        int getFFTSize() const { return m_fftSize; }
+        const Complex *getBins() const { return &m_bins[0]; }
+
+    private:
+        int m_fftSize;
+        std::vector<Complex> m_bins;
+
+        void transform(); //!< taps in m_bins to normalized response
+    };
+
+    OverlapSaveFilter(const Response *response);
+    ~OverlapSaveFilter();
+
+    void setResponse(const Response *response); //!< response of the same FFT size
+    void reset();                                //!< clear history
+
+    /**
+     * Filter nbSamples from in to out. out can be in for in place filtering. Outputs are delayed by
+     * getLatency() samples in addition to the group delay of the filter.
+     */
+    void process(const Complex *in, Complex *out, int nbSamples);
+    int getLatency() const { return m_hop; }
+
+private:
+    const Response *m_response;
+    int m_fftSize;
+    int m_hop;                    //!< new samples per FFT: half the FFT size which is the length of the filters
+    int m_fill;                   //!< new samples in the current hop
+    std::vector<Complex> m_time;  //!< previous hop followed by the current one
+    std::vector<Complex> m_output;//!< outputs of the last FFT delivered during the current hop
+    FFTEngine *m_fwd;
+    FFTEngine *m_inv;
+
+    void runFFT();
+};
+
+#endif /* SDRBASE_DSP_OVERLAPSAVEFILTER_H_ */
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include <algorithm>
+#include <QDebug>
+
+#include "dsp/fftengine.h"
+#include "dsp/wfir.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "polyphasefilterbank.h"
+
+PolyphaseFilterBank::PolyphaseFilterBank() :
+    m_inputSampleRate(0),
+    m_nbChannels(0),
+    m_decimation(0),
+    m_nbTaps(0),
+    m_historyPtr(0),
+    m_inputCount(0),
+    m_outputCount(0),
+    m_fft(0)
+{
+}
+
+PolyphaseFilterBank::~PolyphaseFilterBank()
+{
+    delete m_fft;
+}
+
+void PolyphaseFilterBank::configure(int inputSampleRate)
+{
+    m_subscriptions.clear();
+    m_activeChannels.clear();
+    m_inputSampleRate = inputSampleRate;
+
+    int nbChannels = 4;
+
+    while ((nbChannels < POLYPHASEFILTERBANK_MAX_CHANNELS) && (inputSampleRate / (2*nbChannels) >= POLYPHASEFILTERBANK_MIN_CHANNEL_SPACING)) {
+        nbChannels *= 2;
+    }
+
+    if (nbChannels != m_nbChannels)
+    {
+        m_nbChannels = nbChannels;
+        m_decimation = nbChannels / 2;
+        m_nbTaps = nbChannels * POLYPHASEFILTERBANK_TAPS_PER_PHASE;
+
+        // prototype low pass with -6dB cutoff at the channel spacing: pass band up to 0.75 and
+        // stop band from 1.25 times the spacing so that aliasing after decimation by M/2 stays
+        // out of +/- 0.75 times the spacing. Kaiser beta 7 gives ~70 dB of stop band rejection.
+        std::vector<double> taps(m_nbTaps);
+        WFIR::BasicFIR(taps.data(), m_nbTaps, WFIR::LPF, 2.0 / m_nbChannels, 0.0, WFIR::wtKAISER, 7.0);
+
+        double sum = 0.0;
+
+        for (int i = 0; i < m_nbTaps; i++) {
+            sum += taps[i];
+        }
+
+        m_polyTaps.resize(m_nbTaps);
+
+        for (int r = 0; r < m_nbChannels; r++)
+        {
+            for (int p = 0; p < POLYPHASEFILTERBANK_TAPS_PER_PHASE; p++) {
+                m_polyTaps[r*POLYPHASEFILTERBANK_TAPS_PER_PHASE + p] = taps[p*m_nbChannels + r] / sum; // unity gain at DC
+            }
+        }
+
+        if (m_fft == 0) {
+            m_fft = FFTEngine::create();
+        }
+
+        m_fft->configure(m_nbChannels, true);
+        m_channelBuffers.resize(m_nbChannels);
+    }
+
+    m_history.assign(2*m_nbTaps, Complex(0.0, 0.0));
+    m_historyPtr = 0;
+    m_inputCount = 0;
+    m_outputCount = 0;
+
+    qDebug("PolyphaseFilterBank::configure: input rate: %d channels: %d output rate: %d",
+            m_inputSampleRate, m_nbChannels, getOutputSampleRate());
+}
+
+qint64 PolyphaseFilterBank::getChannelFrequency(int channelIndex) const
+{
+    if (m_nbChannels == 0) {
+        return 0;
+    }
+
+    int k = channelIndex < m_nbChannels/2 ? channelIndex : channelIndex - m_nbChannels;
+    return ((qint64) k * m_inputSampleRate) / m_nbChannels;
+}
+
+int PolyphaseFilterBank::getChannelIndex(qint64 frequencyOffset, int bandwidth, int minSampleRate) const
+{
+    if ((m_inputSampleRate == 0) || (m_fft == 0) || (getOutputSampleRate() < minSampleRate)) {
+        return -1;
+    }
+
+    double spacing = (double) m_inputSampleRate / m_nbChannels;
+    int k = (int) round(frequencyOffset / spacing);
+
+    // the channel at Nyquist is not usable as it folds both edges of the spectrum
+    if ((k <= -m_nbChannels/2) || (k >= m_nbChannels/2)) {
+        return -1;
+    }
+
+    if (fabs(frequencyOffset - k*spacing) + bandwidth/2.0 > POLYPHASEFILTERBANK_PASSBAND * spacing) {
+        return -1;
+    }
+
+    return k < 0 ? k + m_nbChannels : k;
+}
+
+void PolyphaseFilterBank::subscribe(ThreadedBasebandSampleSink* sink, int channelIndex)
+{
+    if ((channelIndex < 0) || (channelIndex >= m_nbChannels)) {
+        return;
+    }
+
+    unsubscribe(sink);
+    m_subscriptions.push_back(Subscription(sink, channelIndex));
+    updateActiveChannels();
+}
+
+void PolyphaseFilterBank::unsubscribe(ThreadedBasebandSampleSink* sink)
+{
+    for (Subscriptions::iterator it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it)
+    {
+        if (it->m_sink == sink)
+        {
+            m_subscriptions.erase(it);
+            updateActiveChannels();
+            return;
+        }
+    }
+}
+
+int PolyphaseFilterBank::getSubscribedChannel(const ThreadedBasebandSampleSink* sink) const
+{
+    for (Subscriptions::const_iterator it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it)
+    {
+        if (it->m_sink == sink) {
+            return it->m_channelIndex;
+        }
+    }
+
+    return -1;
+}
+
+void PolyphaseFilterBank::updateActiveChannels()
+{
+    m_activeChannels.clear();
+
+    for (Subscriptions::const_iterator it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it)
+    {
+        if (std::find(m_activeChannels.begin(), m_activeChannels.end(), it->m_channelIndex) == m_activeChannels.end()) {
+            m_activeChannels.push_back(it->m_channelIndex);
+        }
+    }
+}
+
+void PolyphaseFilterBank::feed(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    if (m_activeChannels.size() == 0) {
+        return;
+    }
+
+    for (std::vector<int>::const_iterator k = m_activeChannels.begin(); k != m_activeChannels.end(); ++k) {
+        m_channelBuffers[*k].clear(); // keeps allocation
+    }
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real(), it->imag());
+        m_history[m_historyPtr] = c;
+        m_history[m_historyPtr + m_nbTaps] = c;
+
+        if (++m_inputCount == m_decimation)
+        {
+            computeOutput(&m_history[m_historyPtr + m_nbTaps]);
+            m_inputCount = 0;
+        }
+
+        m_historyPtr = m_historyPtr < m_nbTaps - 1 ? m_historyPtr + 1 : 0;
+    }
+
+    for (Subscriptions::const_iterator it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it)
+    {
+        const SampleVector& buffer = m_channelBuffers[it->m_channelIndex];
+        it->m_sink->feed(buffer.begin(), buffer.end(), false);
+    }
+}
+
+void PolyphaseFilterBank::computeOutput(const Complex* newest)
+{
+    Complex *u = m_fft->in();
+    const float *taps = m_polyTaps.data();
+
+    // polyphase branches: u[r] = sum over p of h[p*M + r] * x[n - p*M - r]
+    for (int r = 0; r < m_nbChannels; r++, taps += POLYPHASEFILTERBANK_TAPS_PER_PHASE)
+    {
+        const Complex *x = newest - r;
+        Real accI = 0.0f;
+        Real accQ = 0.0f;
+
+        for (int p = 0; p < POLYPHASEFILTERBANK_TAPS_PER_PHASE; p++, x -= m_nbChannels)
+        {
+            accI += taps[p] * x->real();
+            accQ += taps[p] * x->imag();
+        }
+
+        u[r] = Complex(accI, accQ);
+    }
+
+    // inverse FFT gives all channels at once: bin k is centered on k*fs/M
+    m_fft->transform();
+
+    const Complex *y = m_fft->out();
+    bool oddOutput = (m_outputCount & 1) != 0;
+
+    for (std::vector<int>::const_iterator k = m_activeChannels.begin(); k != m_activeChannels.end(); ++k)
+    {
+        Complex v = y[*k];
+
+        // decimation by M/2 leaves odd channels mixed by (-1)^n
+        if (oddOutput && ((*k & 1) != 0)) {
+            v = -v;
+        }
+
+        Real re = std::min(std::max(v.real(), (Real) -32768.0f), (Real) 32767.0f);
+        Real im = std::min(std::max(v.imag(), (Real) -32768.0f), (Real) 32767.0f);
+        m_channelBuffers[*k].push_back(Sample((FixReal) lrintf(re), (FixReal) lrintf(im)));
+    }
+
+    m_outputCount++;
+}
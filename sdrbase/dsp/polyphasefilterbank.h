@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#ifndef SDRBASE_DSP_POLYPHASEFILTERBANK_H_
+#define SDRBASE_DSP_POLYPHASEFILTERBANK_H_
+
+#include <list>
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+#define POLYPHASEFILTERBANK_TAPS_PER_PHASE 10      // prototype filter length is this times the number of channels
+#define POLYPHASEFILTERBANK_MIN_CHANNEL_SPACING 25000 // the number of channels is the largest power of two giving at least this spacing
+#define POLYPHASEFILTERBANK_MAX_CHANNELS 1024
+#define POLYPHASEFILTERBANK_PASSBAND 0.75          // alias free half bandwidth of a channel relative to the channel spacing
+
+class FFTEngine;
+class ThreadedBasebandSampleSink;
+
+/**
+ * Uniform DFT analysis filter bank (polyphase channelizer) that splits the device baseband
+ * into M channels spaced by fs/M. Channels are oversampled by 2 (decimation by M/2) so that
+ * a channel is alias free over +/- 0.75 times the channel spacing around its center.
+ *
+ * The polyphase filtering and the M points FFT are done once for all channels so the cost
+ * per input sample is 2*P multiply-adds plus 2*log2(M) FFT butterflies whatever the number
+ * of channels used. Threaded sinks subscribe to one channel and are fed with its samples.
+ */
+class SDRANGEL_API PolyphaseFilterBank
+{
+public:
+    PolyphaseFilterBank();
+    ~PolyphaseFilterBank();
+
+    void configure(int inputSampleRate); //!< Design the bank for this input sample rate. This removes all subscriptions.
+    int getInputSampleRate() const { return m_inputSampleRate; }
+    int getOutputSampleRate() const { return m_nbChannels > 0 ? (2 * m_inputSampleRate) / m_nbChannels : 0; }
+    int getNbChannels() const { return m_nbChannels; }
+    qint64 getChannelFrequency(int channelIndex) const; //!< Channel center frequency relative to the input center frequency
+    /**
+     * Return the index of the channel that contains the band of given bandwidth centered on
+     * frequencyOffset (relative to the input center frequency) at a sample rate of at least
+     * minSampleRate or -1 if there is none.
+     */
+    int getChannelIndex(qint64 frequencyOffset, int bandwidth, int minSampleRate) const;
+
+    void subscribe(ThreadedBasebandSampleSink* sink, int channelIndex);
+    void unsubscribe(ThreadedBasebandSampleSink* sink);
+    int getSubscribedChannel(const ThreadedBasebandSampleSink* sink) const; //!< Channel index the sink is subscribed to or -1
+    bool hasSubscribers() const { return m_subscriptions.size() > 0; }
+
+    void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end); //!< Process input and feed subscribers
+
+private:
+    struct Subscription
+    {
+        ThreadedBasebandSampleSink* m_sink;
+        int m_channelIndex;
+
+        Subscription(ThreadedBasebandSampleSink* sink, int channelIndex) :
+            m_sink(sink),
+            m_channelIndex(channelIndex)
+        {}
+    };
+
+    typedef std::list<Subscription> Subscriptions;
+
+    int m_inputSampleRate;
+    int m_nbChannels;                 //!< M: number of channels and FFT size
+    int m_decimation;                 //!< M/2
+    int m_nbTaps;                     //!< L = M * P
+    std::vector<float> m_polyTaps;    //!< prototype filter taps arranged by phase: [r*P + p] = h[p*M + r]
+    std::vector<Complex> m_history;   //!< last L input samples stored twice so that the window is always contiguous
+    int m_historyPtr;
+    int m_inputCount;                 //!< input samples since last output
+    quint64 m_outputCount;            //!< number of outputs (parity gives the phase correction of odd channels)
+    FFTEngine* m_fft;
+    std::vector<SampleVector> m_channelBuffers; //!< output of the subscribed channels for the current block
+    std::vector<int> m_activeChannels;          //!< indexes of the channels with at least one subscriber
+    Subscriptions m_subscriptions;
+
+    void updateActiveChannels();
+    void computeOutput(const Complex* newest);
+};
+
+#endif /* SDRBASE_DSP_POLYPHASEFILTERBANK_H_ */
@@ -0,0 +1,308 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include "dsp/samplecodec.h"
+#include "dsp/samplepacker.h"
+
+#define SAMPLECODEC_GROUP 32 // values per coding group
+#define SAMPLECODEC_MAXK 24  // largest Rice parameter (values are at most 17 bits after differentiation)
+
+namespace {
+
+class BitWriter
+{
+public:
+	BitWriter(quint8 *out, uint size) : m_out(out), m_size(size), m_pos(0), m_acc(0), m_nbBits(0), m_overflow(false) {}
+
+	inline void put(quint32 value, int nbBits) //!< nbBits <= 32
+	{
+		m_acc = (m_acc << nbBits) | (value & (quint32) ((1ULL << nbBits) - 1));
+		m_nbBits += nbBits;
+
+		while (m_nbBits >= 8)
+		{
+			m_nbBits -= 8;
+
+			if (m_pos < m_size) {
+				m_out[m_pos++] = (m_acc >> m_nbBits) & 0xFF;
+			} else {
+				m_overflow = true;
+			}
+		}
+	}
+
+	inline void putUnary(quint32 count) //!< count zeros followed by a one
+	{
+		while (count > 24)
+		{
+			put(0, 24);
+			count -= 24;
+		}
+
+		put(1, count + 1);
+	}
+
+	uint flush() //!< pad the last byte with zeros. Returns the number of bytes or 0 on overflow.
+	{
+		if (m_nbBits > 0) {
+			put(0, 8 - m_nbBits);
+		}
+
+		return m_overflow ? 0 : m_pos;
+	}
+
+private:
+	quint8 *m_out;
+	uint m_size;
+	uint m_pos;
+	quint64 m_acc;
+	int m_nbBits;
+	bool m_overflow;
+};
+
+class BitReader
+{
+public:
+	BitReader(const quint8 *in, uint size) : m_in(in), m_size(size), m_pos(0), m_acc(0), m_nbBits(0) {}
+
+	inline bool get(int nbBits, quint32& value) //!< nbBits <= 32
+	{
+		while (m_nbBits < nbBits)
+		{
+			if (m_pos >= m_size) {
+				return false;
+			}
+
+			m_acc = (m_acc << 8) | m_in[m_pos++];
+			m_nbBits += 8;
+		}
+
+		m_nbBits -= nbBits;
+		value = (m_acc >> m_nbBits) & (quint32) ((1ULL << nbBits) - 1);
+		return true;
+	}
+
+	inline bool getUnary(quint32 limit, quint32& count) //!< count zeros up to a one, byte by byte
+	{
+		count = 0;
+
+		while (count <= limit)
+		{
+			if (m_nbBits == 0)
+			{
+				if (m_pos >= m_size) {
+					return false;
+				}
+
+				m_acc = (m_acc << 8) | m_in[m_pos++];
+				m_nbBits = 8;
+			}
+
+			quint32 bits = m_acc & ((1U << m_nbBits) - 1); // unread bits (less than 8)
+
+			if (bits == 0)
+			{
+				count += m_nbBits;
+				m_nbBits = 0;
+				continue;
+			}
+
+			while ((bits & (1U << (m_nbBits - 1))) == 0)
+			{
+				m_nbBits--;
+				count++;
+			}
+
+			m_nbBits--; // the one
+			return count <= limit;
+		}
+
+		return false;
+	}
+
+	uint getPosition() const { return m_pos; }
+
+private:
+	const quint8 *m_in;
+	uint m_size;
+	uint m_pos;
+	quint64 m_acc;
+	int m_nbBits;
+};
+
+inline quint32 zigzag(qint32 x)
+{
+	return ((quint32) x << 1) ^ (quint32) (x >> 31);
+}
+
+inline qint32 unzigzag(quint32 z)
+{
+	return (qint32) (z >> 1) ^ -(qint32) (z & 1);
+}
+
+/** Group header: 2 bits mode (0: packed values, 1: Rice coded values, 2: Rice coded differences) then 5 bits Rice parameter */
+void encodeGroup(BitWriter& writer, const qint32 *values, int n, qint32 prev, int sampleBits)
+{
+	quint32 z[2][SAMPLECODEC_GROUP];
+	quint64 sum[2] = {0, 0};
+
+	for (int i = 0; i < n; i++)
+	{
+		z[0][i] = zigzag(values[i]);
+		z[1][i] = zigzag(values[i] - (i == 0 ? prev : values[i-1]));
+		sum[0] += z[0][i];
+		sum[1] += z[1][i];
+	}
+
+	int order = sum[1] < sum[0] ? 1 : 0;
+	int k = 0;
+
+	while ((k < SAMPLECODEC_MAXK) && (((quint64) n << (k + 1)) <= sum[order])) { // 2^k close to the mean
+		k++;
+	}
+
+	quint64 riceBits = (quint64) n * (k + 1);
+
+	for (int i = 0; i < n; i++) {
+		riceBits += z[order][i] >> k;
+	}
+
+	if (riceBits < (quint64) n * sampleBits)
+	{
+		writer.put(order + 1, 2);
+		writer.put(k, 5);
+
+		for (int i = 0; i < n; i++)
+		{
+			writer.putUnary(z[order][i] >> k);
+
+			if (k > 0) {
+				writer.put(z[order][i], k);
+			}
+		}
+	}
+	else
+	{
+		writer.put(0, 2);
+
+		for (int i = 0; i < n; i++) {
+			writer.put((quint32) values[i], sampleBits);
+		}
+	}
+}
+
+bool decodeGroup(BitReader& reader, qint32 *values, int n, qint32 prev, int sampleBits)
+{
+	quint32 mode, k, q, r;
+
+	if (!reader.get(2, mode)) {
+		return false;
+	}
+
+	if (mode == 0)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			if (!reader.get(sampleBits, r)) {
+				return false;
+			}
+
+			values[i] = ((qint32) (r << (32 - sampleBits))) >> (32 - sampleBits); // sign extension
+		}
+
+		return true;
+	}
+	else if (mode > 2)
+	{
+		return false;
+	}
+
+	if (!reader.get(5, k) || (k > SAMPLECODEC_MAXK)) {
+		return false;
+	}
+
+	quint32 limit = SAMPLECODEC_GROUP * 32; // a Rice coded group is shorter than its packed values
+
+	for (int i = 0; i < n; i++)
+	{
+		r = 0;
+
+		if (!reader.getUnary(limit, q) || ((k > 0) && !reader.get(k, r))) {
+			return false;
+		}
+
+		qint32 x = unzigzag((q << k) | r);
+		values[i] = mode == 2 ? x + (i == 0 ? prev : values[i-1]) : x;
+	}
+
+	return true;
+}
+
+} // namespace
+
+uint SampleCodec::encode(const Sample *in, uint nbSamples, quint8 *out, uint outSize, int sampleBits, int sampleShift)
+{
+	BitWriter writer(out, outSize);
+	qint32 max = (1 << (sampleBits - 1)) - 1;
+	qint32 re[SAMPLECODEC_GROUP], im[SAMPLECODEC_GROUP];
+	qint32 prevRe = 0, prevIm = 0;
+
+	for (uint i0 = 0; i0 < nbSamples; i0 += SAMPLECODEC_GROUP)
+	{
+		int n = nbSamples - i0 < SAMPLECODEC_GROUP ? nbSamples - i0 : SAMPLECODEC_GROUP;
+
+		for (int i = 0; i < n; i++)
+		{
+			re[i] = SamplePacker::packValue(in[i0 + i].real(), sampleShift, max);
+			im[i] = SamplePacker::packValue(in[i0 + i].imag(), sampleShift, max);
+		}
+
+		encodeGroup(writer, re, n, prevRe, sampleBits);
+		encodeGroup(writer, im, n, prevIm, sampleBits);
+		prevRe = re[n-1];
+		prevIm = im[n-1];
+	}
+
+	return writer.flush();
+}
+
+uint SampleCodec::decode(const quint8 *in, uint inSize, Sample *out, uint nbSamples, int sampleBits, int sampleShift)
+{
+	BitReader reader(in, inSize);
+	qint32 re[SAMPLECODEC_GROUP], im[SAMPLECODEC_GROUP];
+	qint32 prevRe = 0, prevIm = 0;
+
+	for (uint i0 = 0; i0 < nbSamples; i0 += SAMPLECODEC_GROUP)
+	{
+		int n = nbSamples - i0 < SAMPLECODEC_GROUP ? nbSamples - i0 : SAMPLECODEC_GROUP;
+
+		if (!decodeGroup(reader, re, n, prevRe, sampleBits) || !decodeGroup(reader, im, n, prevIm, sampleBits)) {
+			return 0;
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			out[i0 + i].setReal(re[i] * (1 << sampleShift));
+			out[i0 + i].setImag(im[i] * (1 << sampleShift));
+		}
+
+		prevRe = re[n-1];
+		prevIm = im[n-1];
+	}
+
+	return reader.getPosition();
+}
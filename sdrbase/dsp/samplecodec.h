@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_SAMPLECODEC_H
+#define INCLUDE_SAMPLECODEC_H
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Fast lossless compression of I/Q samples for network transport.
+ * Samples are first reduced to sampleBits bits with SamplePacker::packValue. I and Q are then coded separately
+ * by groups of 32 values. Each group is coded as the values or their first difference,
+ * whichever is smaller, mapped to positive integers and Rice coded with the best parameter of the group.
+ * Groups that would not be shorter than the values packed on sampleBits bits are stored as such.
+ * The output is byte aligned so that independent blocks of samples can be concatenated.
+ */
+class SDRANGEL_API SampleCodec
+{
+public:
+	/** Number of bytes written to out or 0 if it does not fit in outSize bytes */
+	static uint encode(const Sample *in, uint nbSamples, quint8 *out, uint outSize, int sampleBits, int sampleShift);
+	/** Number of bytes read from in or 0 if the input is truncated or corrupt */
+	static uint decode(const quint8 *in, uint inSize, Sample *out, uint nbSamples, int sampleBits, int sampleShift);
+};
+
+#endif // INCLUDE_SAMPLECODEC_H
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include "dsp/samplemixer.h"
+
+#if USE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+void SampleMixer::accumulate(qint32* acc, const Sample* in, unsigned int nbSamples)
+{
+	const qint16 *s = (const qint16*) in; // packed I/Q pairs
+	unsigned int n = 2 * nbSamples;
+	unsigned int i = 0;
+
+#if USE_SSE2
+	for (; i + 8 <= n; i += 8)
+	{
+		__m128i x = _mm_loadu_si128((const __m128i*) (s + i));
+		__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16); // sign extension
+		__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+		_mm_storeu_si128((__m128i*) (acc + i), _mm_add_epi32(_mm_loadu_si128((const __m128i*) (acc + i)), lo));
+		_mm_storeu_si128((__m128i*) (acc + i + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i*) (acc + i + 4)), hi));
+	}
+#elif defined(__aarch64__)
+	for (; i + 8 <= n; i += 8)
+	{
+		int16x8_t x = vld1q_s16(s + i);
+		vst1q_s32(acc + i, vaddw_s16(vld1q_s32(acc + i), vget_low_s16(x)));
+		vst1q_s32(acc + i + 4, vaddw_s16(vld1q_s32(acc + i + 4), vget_high_s16(x)));
+	}
+#endif
+
+	for (; i < n; i++) {
+		acc[i] += s[i];
+	}
+}
+
+void SampleMixer::scale(const qint32* acc, Sample* out, unsigned int nbSamples, unsigned int divisor)
+{
+	qint16 *d = (qint16*) out;
+	unsigned int n = 2 * nbSamples;
+	float factor = 1.0f / (divisor == 0 ? 1 : divisor);
+	unsigned int i = 0;
+
+#if USE_SSE2
+	__m128 f = _mm_set1_ps(factor);
+
+	for (; i + 8 <= n; i += 8)
+	{
+		__m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) (acc + i))), f));
+		__m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) (acc + i + 4))), f));
+		_mm_storeu_si128((__m128i*) (d + i), _mm_packs_epi32(lo, hi));
+	}
+#elif defined(__aarch64__)
+	for (; i + 8 <= n; i += 8)
+	{
+		int32x4_t lo = vcvtnq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(acc + i)), factor));
+		int32x4_t hi = vcvtnq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(acc + i + 4)), factor));
+		vst1q_s16(d + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+	}
+#endif
+
+	for (; i < n; i++)
+	{
+		long v = lrintf(acc[i] * factor);
+		d[i] = v < -32768 ? -32768 : v > 32767 ? 32767 : v;
+	}
+}
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SAMPLEMIXER_H
+#define INCLUDE_SAMPLEMIXER_H
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Mixing of the channel sources on the transmit path. Each source block is summed into a 32 bit
+ * accumulator (two per sample for I and Q) then the sum is scaled by the number of sources once,
+ * rounded and saturated back to samples.
+ */
+class SDRANGEL_API SampleMixer {
+public:
+	/** acc[2k] += in[k].real(), acc[2k+1] += in[k].imag() */
+	static void accumulate(qint32* acc, const Sample* in, unsigned int nbSamples);
+	/** out[k] = acc[2k..2k+1] / divisor rounded and saturated */
+	static void scale(const qint32* acc, Sample* out, unsigned int nbSamples, unsigned int divisor);
+};
+
+#endif // INCLUDE_SAMPLEMIXER_H
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include "dsp/samplepacker.h"
+
+uint SamplePacker::getBytesPerSample(int sampleBits)
+{
+	switch (sampleBits)
+	{
+	case 16:
+		return 4;
+	case 12:
+		return 3;
+	case 8:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+int SamplePacker::getNativeShift(int inputBits)
+{
+	if (inputBits == 8) {
+		return 6;
+	} else if (inputBits == 12) {
+		return 4;
+	} else {
+		return 0;
+	}
+}
+
+void SamplePacker::pack(const Sample *in, uint nbSamples, quint8 *out, int sampleBits, int sampleShift)
+{
+	if (sampleBits == 12)
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			qint32 re = packValue(in[i].real(), sampleShift, 2047);
+			qint32 im = packValue(in[i].imag(), sampleShift, 2047);
+			out[0] = re & 0xFF;
+			out[1] = ((re >> 8) & 0x0F) | ((im & 0x0F) << 4);
+			out[2] = (im >> 4) & 0xFF;
+			out += 3;
+		}
+	}
+	else if (sampleBits == 8)
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			out[0] = packValue(in[i].real(), sampleShift, 127) & 0xFF;
+			out[1] = packValue(in[i].imag(), sampleShift, 127) & 0xFF;
+			out += 2;
+		}
+	}
+	else
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			qint32 re = in[i].real();
+			qint32 im = in[i].imag();
+			out[0] = re & 0xFF;
+			out[1] = (re >> 8) & 0xFF;
+			out[2] = im & 0xFF;
+			out[3] = (im >> 8) & 0xFF;
+			out += 4;
+		}
+	}
+}
+
+void SamplePacker::unpack(const quint8 *in, uint nbSamples, Sample *out, int sampleBits, int sampleShift)
+{
+	if (sampleBits == 12)
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			qint32 re = in[0] | ((in[1] & 0x0F) << 8);
+			qint32 im = (in[1] >> 4) | (in[2] << 4);
+			re = (re ^ 0x800) - 0x800; // sign extension
+			im = (im ^ 0x800) - 0x800;
+			out[i].setReal(re * (1 << sampleShift));
+			out[i].setImag(im * (1 << sampleShift));
+			in += 3;
+		}
+	}
+	else if (sampleBits == 8)
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			out[i].setReal(((qint32) (qint8) in[0]) * (1 << sampleShift));
+			out[i].setImag(((qint32) (qint8) in[1]) * (1 << sampleShift));
+			in += 2;
+		}
+	}
+	else
+	{
+		for (uint i = 0; i < nbSamples; i++)
+		{
+			out[i].setReal((qint16) (in[0] | (in[1] << 8)));
+			out[i].setImag((qint16) (in[2] | (in[3] << 8)));
+			in += 4;
+		}
+	}
+}
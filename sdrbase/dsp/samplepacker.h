@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_SAMPLEPACKER_H
+#define INCLUDE_SAMPLEPACKER_H
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Packing of I/Q samples to their native bit depth for recording.
+ * - 16 bits: I and Q as little endian 16 bit words (4 bytes per sample)
+ * - 12 bits: I[7:0], Q[3:0] << 4 | I[11:8], Q[11:4] (3 bytes per sample)
+ * - 8 bits: I, Q as signed bytes (2 bytes per sample)
+ * Samples are shifted right by sampleShift with rounding and saturated when packing, and
+ * shifted back left when unpacking.
+ */
+class SDRANGEL_API SamplePacker
+{
+public:
+	static uint getBytesPerSample(int sampleBits); //!< 0 if the bit depth is not supported
+	/**
+	 * Shift that brings the decimated samples of a device with inputBits bits back to inputBits bits.
+	 * It does not depend on the decimation: the smaller pre shift of the higher ratios is compensated
+	 * by the gain of 2 of each half-band stage (see decimation_shifts).
+	 */
+	static int getNativeShift(int inputBits);
+	static void pack(const Sample *in, uint nbSamples, quint8 *out, int sampleBits, int sampleShift);
+
+	/** One I or Q value shifted right by sampleShift with rounding and saturated to [-max-1, max] */
+	static inline qint32 packValue(qint32 x, int sampleShift, qint32 max)
+	{
+		if (sampleShift > 0) {
+			x = (x + (1 << (sampleShift - 1))) >> sampleShift;
+		}
+
+		return x > max ? max : x < -max - 1 ? -max - 1 : x;
+	}
+
+	static void unpack(const quint8 *in, uint nbSamples, Sample *out, int sampleBits, int sampleShift);
+};
+
+#endif // INCLUDE_SAMPLEPACKER_H
@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include "samplesinkbroadcastfifo.h"
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+SampleSinkBroadcastFifo::SampleSinkBroadcastFifo(QObject* parent) :
+	QObject(parent),
+	m_data(),
+	m_size(0),
+	m_mask(0),
+	m_tail(0),
+	m_nbReaders(0),
+	m_suppressed(-1)
+{
+	m_metricsTimer.start();
+	DSPMetrics::instance()->addFifo(&m_metrics, this);
+}
+
+SampleSinkBroadcastFifo::~SampleSinkBroadcastFifo()
+{
+	DSPMetrics *metrics = DSPMetrics::instance();
+
+	if (metrics) { // null after the registry is destroyed at exit
+		metrics->removeFifo(&m_metrics);
+	}
+}
+
+void SampleSinkBroadcastFifo::setMetricsName(const QString& name)
+{
+	DSPMetrics::instance()->setFifoName(&m_metrics, name);
+}
+
+bool SampleSinkBroadcastFifo::setSize(uint size)
+{
+	if (m_nbReaders > 0)
+	{
+		qCritical("SampleSinkBroadcastFifo::setSize: cannot resize with readers attached");
+		return false;
+	}
+
+	uint p2 = 1;
+
+	while (p2 < size) {
+		p2 <<= 1;
+	}
+
+	m_data.resize(p2);
+	m_size = m_data.size();
+	m_tail.storeRelease(0);
+
+	if (m_size != p2)
+	{
+		qCritical("SampleSinkBroadcastFifo: out of memory");
+		m_size = 0;
+		m_mask = 0;
+		return false;
+	}
+
+	m_mask = m_size - 1;
+	m_metrics.m_size = m_size;
+	return true;
+}
+
+bool SampleSinkBroadcastFifo::isActive(int readerId) const
+{
+	return (readerId >= 0) && (readerId < SAMPLESINKBROADCASTFIFO_MAX_READERS) && (m_readers[readerId].m_active.loadAcquire() != 0);
+}
+
+int SampleSinkBroadcastFifo::addReader()
+{
+	for (int i = 0; i < SAMPLESINKBROADCASTFIFO_MAX_READERS; i++)
+	{
+		if (m_readers[i].m_active.load() == 0)
+		{
+			QMutexLocker mutexLocker(&m_statsMutex);
+			m_readers[i].m_head.storeRelease(m_tail.load());
+			m_readers[i].m_maxLag = 0;
+			m_readers[i].m_overflowCount = 0;
+			m_readerChannels[i].clear();
+			m_readers[i].m_active.storeRelease(1);
+			m_nbReaders++;
+			return i;
+		}
+	}
+
+	qCritical("SampleSinkBroadcastFifo::addReader: too many readers");
+	return -1;
+}
+
+void SampleSinkBroadcastFifo::setReaderChannel(int readerId, const QString& channel)
+{
+	QMutexLocker mutexLocker(&m_statsMutex);
+
+	if (isActive(readerId)) {
+		m_readerChannels[readerId] = channel;
+	}
+}
+
+void SampleSinkBroadcastFifo::removeReader(int readerId)
+{
+	if (isActive(readerId))
+	{
+		m_readers[readerId].m_active.storeRelease(0);
+		m_nbReaders--;
+	}
+}
+
+uint SampleSinkBroadcastFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+	uint count = end - begin;
+	uint tail = (uint) m_tail.load();
+	uint maxLag = 0;
+	uint total;
+	uint remaining;
+	uint len;
+	uint index;
+
+	if (m_nbReaders == 0) {
+		return 0;
+	}
+
+	// the slowest reader gives the room available
+	QMutexLocker mutexLocker(&m_statsMutex);
+
+	for (int i = 0; i < SAMPLESINKBROADCASTFIFO_MAX_READERS; i++)
+	{
+		if (m_readers[i].m_active.load() != 0)
+		{
+			uint lag = tail - (uint) m_readers[i].m_head.loadAcquire();
+			maxLag = lag > maxLag ? lag : maxLag;
+			m_readers[i].m_maxLag = lag > m_readers[i].m_maxLag ? lag : m_readers[i].m_maxLag;
+
+			if (lag + count > m_size) {
+				m_readers[i].m_overflowCount += lag + count - m_size;
+			}
+		}
+	}
+
+	mutexLocker.unlock();
+	total = MIN(count, m_size - maxLag);
+
+	if (total < count)
+	{
+		if (m_suppressed < 0) {
+			m_suppressed = 0;
+			m_msgRateTimer.start();
+			qCritical("SampleSinkBroadcastFifo: overflow - dropping %u samples", count - total);
+		} else {
+			if (m_msgRateTimer.elapsed() > 2500) {
+				qCritical("SampleSinkBroadcastFifo: %u messages dropped", m_suppressed);
+				qCritical("SampleSinkBroadcastFifo: overflow - dropping %u samples", count - total);
+				m_suppressed = -1;
+			} else {
+				m_suppressed++;
+			}
+		}
+	}
+
+	remaining = total;
+
+	while (remaining > 0)
+	{
+		index = tail & m_mask;
+		len = MIN(remaining, m_size - index);
+		std::copy(begin, begin + len, m_data.begin() + index);
+		tail += len;
+		begin += len;
+		remaining -= len;
+	}
+
+	// publish the samples to all readers
+	m_tail.storeRelease((int) tail);
+	m_metrics.write(count, total, maxLag + total, m_metricsTimer.nsecsElapsed());
+
+	if (total > 0) {
+		emit dataReady();
+	}
+
+	return total;
+}
+
+uint SampleSinkBroadcastFifo::fill(int readerId) const
+{
+	if (!isActive(readerId)) {
+		return 0;
+	}
+
+	return (uint) m_tail.loadAcquire() - (uint) m_readers[readerId].m_head.load();
+}
+
+uint SampleSinkBroadcastFifo::readBegin(int readerId, uint count,
+	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
+{
+	uint total = MIN(count, fill(readerId));
+	uint remaining = total;
+	uint len;
+	uint index = isActive(readerId) ? (uint) m_readers[readerId].m_head.load() & m_mask : 0;
+
+	if (remaining > 0)
+	{
+		len = MIN(remaining, m_size - index);
+		*part1Begin = m_data.begin() + index;
+		*part1End = m_data.begin() + index + len;
+		index = (index + len) & m_mask;
+		remaining -= len;
+	}
+	else
+	{
+		*part1Begin = m_data.end();
+		*part1End = m_data.end();
+	}
+
+	if (remaining > 0)
+	{
+		*part2Begin = m_data.begin() + index;
+		*part2End = m_data.begin() + index + remaining;
+	}
+	else
+	{
+		*part2Begin = m_data.end();
+		*part2End = m_data.end();
+	}
+
+	return total;
+}
+
+uint SampleSinkBroadcastFifo::readCommit(int readerId, uint count)
+{
+	uint fill = this->fill(readerId);
+
+	if (count > fill)
+	{
+		qCritical("SampleSinkBroadcastFifo: cannot commit more than available samples");
+		count = fill;
+	}
+
+	if (count > 0)
+	{
+		uint head = (uint) m_readers[readerId].m_head.load();
+		m_readers[readerId].m_head.storeRelease((int) (head + count));
+	}
+
+	return count;
+}
+
+uint SampleSinkBroadcastFifo::getMaxLag(int readerId) const
+{
+	QMutexLocker mutexLocker(&m_statsMutex);
+	return isActive(readerId) ? m_readers[readerId].m_maxLag : 0;
+}
+
+quint64 SampleSinkBroadcastFifo::getOverflowCount(int readerId) const
+{
+	QMutexLocker mutexLocker(&m_statsMutex);
+	return isActive(readerId) ? m_readers[readerId].m_overflowCount : 0;
+}
+
+void SampleSinkBroadcastFifo::getReaderMetrics(QList<ReaderMetrics>& readers) const
+{
+	QMutexLocker mutexLocker(&m_statsMutex);
+	readers.clear();
+
+	for (int i = 0; i < SAMPLESINKBROADCASTFIFO_MAX_READERS; i++)
+	{
+		if (m_readers[i].m_active.loadAcquire() != 0)
+		{
+			ReaderMetrics metrics;
+			metrics.m_channel = m_readerChannels[i];
+			metrics.m_lag = fill(i);
+			metrics.m_maxLag = m_readers[i].m_maxLag;
+			metrics.m_overflowCount = m_readers[i].m_overflowCount;
+			readers.append(metrics);
+		}
+	}
+}
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#ifndef SDRBASE_DSP_SAMPLESINKBROADCASTFIFO_H_
+#define SDRBASE_DSP_SAMPLESINKBROADCASTFIFO_H_
+
+#include <QObject>
+#include <QTime>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QList>
+
+#include "dsp/dsptypes.h"
+#include "dsp/dspmetrics.h"
+#include "util/export.h"
+
+#define SAMPLESINKBROADCASTFIFO_MAX_READERS 32
+#define SAMPLESINKBROADCASTFIFO_CACHE_LINE 64
+
+/**
+ * Single writer multiple readers sample FIFO. Samples are written once and each reader reads them
+ * in place with its own read cursor using the same readBegin/readCommit API as SampleSinkFifo.
+ * Room is only made for new samples when the slowest reader commits. When there is not enough room
+ * the samples in excess are dropped for all readers and accounted on the readers that lag behind.
+ *
+ * The writer thread is the only one to write samples and to add or remove readers. Each reader
+ * must be used from one thread only. The size is a power of two and indexes are free running.
+ * The readers statistics are updated by the writer under a lock so that they can be taken from any
+ * thread. The FIFO and its readers are registered with DSPMetrics.
+ */
+class SDRANGEL_API SampleSinkBroadcastFifo : public QObject {
+	Q_OBJECT
+
+public:
+	SampleSinkBroadcastFifo(QObject* parent = NULL);
+	~SampleSinkBroadcastFifo();
+
+	bool setSize(uint size); //!< Rounded up to a power of two. Only with no reader.
+	uint size() const { return m_size; }
+
+	// writer side
+	int addReader();                  //!< Returns the reader id or -1 if there are too many readers. Reader starts at the current write position.
+	void removeReader(int readerId);  //!< The reader thread must be done with the reader as its id is reused by the next addReader()
+	int getNbReaders() const { return m_nbReaders; }
+	void setReaderChannel(int readerId, const QString& channel); //!< Name of the reader in the metrics reports
+	void setMetricsName(const QString& name);                    //!< Name of the FIFO in the metrics reports
+	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+	// reader side
+	uint fill(int readerId) const;
+	uint readBegin(int readerId, uint count,
+		SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
+	uint readCommit(int readerId, uint count);
+
+	// statistics
+	uint getLag(int readerId) const { return fill(readerId); } //!< Samples not yet consumed by the reader
+	uint getMaxLag(int readerId) const;                         //!< Highest lag observed by the writer
+	quint64 getOverflowCount(int readerId) const;               //!< Samples dropped while this reader was lagging
+	void getReaderMetrics(QList<ReaderMetrics>& readers) const; //!< Statistics of all the active readers
+
+signals:
+	void dataReady();
+
+private:
+	struct Reader
+	{
+		QAtomicInt m_head;        //!< read index written by the reader thread only
+		QAtomicInt m_active;      //!< written by the writer thread only
+		uint m_maxLag;            //!< written by the writer thread only under the statistics lock
+		quint64 m_overflowCount;  //!< written by the writer thread only under the statistics lock
+		char m_pad[SAMPLESINKBROADCASTFIFO_CACHE_LINE - 2*sizeof(QAtomicInt) - sizeof(uint) - sizeof(quint64)];
+
+		Reader() : m_head(0), m_active(0), m_maxLag(0), m_overflowCount(0) {}
+	};
+
+	SampleVector m_data;
+	uint m_size;
+	uint m_mask;
+	char m_pad0[SAMPLESINKBROADCASTFIFO_CACHE_LINE];
+	QAtomicInt m_tail;            //!< write index written by the writer thread only
+	char m_pad1[SAMPLESINKBROADCASTFIFO_CACHE_LINE - sizeof(QAtomicInt)];
+	Reader m_readers[SAMPLESINKBROADCASTFIFO_MAX_READERS];
+	int m_nbReaders;
+	QTime m_msgRateTimer;
+	int m_suppressed;
+
+	mutable QMutex m_statsMutex;  //!< protects the readers statistics and channel names
+	QString m_readerChannels[SAMPLESINKBROADCASTFIFO_MAX_READERS];
+	FifoMetrics m_metrics;        //!< updated by the writer
+	QElapsedTimer m_metricsTimer;
+
+	bool isActive(int readerId) const;
+};
+
+#endif /* SDRBASE_DSP_SAMPLESINKBROADCASTFIFO_H_ */
@@ -19,78 +19,145 @@
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
-void SampleSinkFifo::create(uint s)
+bool SampleSinkFifo::create(uint s)
 {
 	m_size = 0;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	m_mask = 0;
+	m_lfHead.storeRelease(0);
+	m_lfTail.storeRelease(0);
+
+	if (m_lockFree && (s > 0))
+	{
+		uint p2 = 1;
+
+		while (p2 < s) {
+			p2 <<= 1;
+		}
+
+		s = p2;
+	}
 
 	m_data.resize(s);
 	m_size = m_data.size();
 
 	if(m_size != s)
+	{
 		qCritical("SampleSinkFifo: out of memory");
+		return false;
+	}
+
+	if (m_lockFree) {
+		m_mask = m_size - 1;
+	}
+
+	m_metrics.m_size = m_size;
+
+	return true;
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_lockFree(false),
+	m_mask(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	m_metricsTimer.start();
+	DSPMetrics::instance()->addFifo(&m_metrics);
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_lockFree(false),
+	m_mask(0)
 {
 	m_suppressed = -1;
 
 	create(size);
+	m_metricsTimer.start();
+	DSPMetrics::instance()->addFifo(&m_metrics);
 }
 
 SampleSinkFifo::~SampleSinkFifo()
 {
+	DSPMetrics *metrics = DSPMetrics::instance();
+
+	if (metrics) { // null after the registry is destroyed at exit
+		metrics->removeFifo(&m_metrics);
+	}
+
 	QMutexLocker mutexLocker(&m_mutex);
 
 	m_size = 0;
 }
 
+void SampleSinkFifo::setMetricsName(const QString& name)
+{
+	DSPMetrics::instance()->setFifoName(&m_metrics, name);
+}
+
 bool SampleSinkFifo::setSize(int size)
 {
-	create(size);
+	return create(size);
+}
 
-	return m_data.size() == (uint)size;
+void SampleSinkFifo::setLockFree(bool lockFree)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (lockFree == m_lockFree) {
+		return;
+	}
+
+	m_lockFree = lockFree;
+
+	if (m_size > 0) {
+		create(m_size);
+	}
+}
+
+void SampleSinkFifo::reportOverflow(uint count, uint total)
+{
+	if(m_suppressed < 0) {
+		m_suppressed = 0;
+		m_msgRateTimer.start();
+		qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+	} else {
+		if(m_msgRateTimer.elapsed() > 2500) {
+			qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
+			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+			m_suppressed = -1;
+		} else {
+			m_suppressed++;
+		}
+	}
 }
 
 uint SampleSinkFifo::write(const quint8* data, uint count)
 {
+	const Sample* begin = (const Sample*)data;
+	count /= 4;
+
+	if (m_lockFree) {
+		return writeLockFree(begin, count);
+	}
+
 	QMutexLocker mutexLocker(&m_mutex);
 	uint total;
 	uint remaining;
 	uint len;
-	const Sample* begin = (const Sample*)data;
-	count /= 4;
 
 	total = MIN(count, m_size - m_fill);
 	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
+		reportOverflow(count, total);
 	}
 
 	remaining = total;
@@ -104,6 +171,8 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 		remaining -= len;
 	}
 
+	m_metrics.write(count, total, m_fill, m_metricsTimer.nsecsElapsed());
+
 	if(m_fill > 0)
 		emit dataReady();
 
@@ -112,27 +181,20 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 
 uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint count = end - begin;
+
+	if (m_lockFree) {
+		return writeLockFree(begin, count);
+	}
+
+	QMutexLocker mutexLocker(&m_mutex);
 	uint total;
 	uint remaining;
 	uint len;
 
 	total = MIN(count, m_size - m_fill);
 	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
+		reportOverflow(count, total);
 	}
 
 	remaining = total;
@@ -146,6 +208,8 @@ uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::con
 		remaining -= len;
 	}
 
+	m_metrics.write(count, total, m_fill, m_metricsTimer.nsecsElapsed());
+
 	if(m_fill > 0)
 		emit dataReady();
 
@@ -154,8 +218,13 @@ uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::con
 
 uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint count = end - begin;
+
+	if (m_lockFree) {
+		return readLockFree(begin, count);
+	}
+
+	QMutexLocker mutexLocker(&m_mutex);
 	uint total;
 	uint remaining;
 	uint len;
@@ -182,6 +251,10 @@ uint SampleSinkFifo::readBegin(uint count,
 	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
 {
+	if (m_lockFree) {
+		return readBeginLockFree(count, part1Begin, part1End, part2Begin, part2End);
+	}
+
 	QMutexLocker mutexLocker(&m_mutex);
 	uint total;
 	uint remaining;
@@ -218,6 +291,10 @@ uint SampleSinkFifo::readBegin(uint count,
 
 uint SampleSinkFifo::readCommit(uint count)
 {
+	if (m_lockFree) {
+		return readCommitLockFree(count);
+	}
+
 	QMutexLocker mutexLocker(&m_mutex);
 
 	if(count > m_fill) {
@@ -229,3 +306,121 @@ uint SampleSinkFifo::readCommit(uint count)
 
 	return count;
 }
+
+template<typename InputIterator>
+uint SampleSinkFifo::writeLockFree(InputIterator begin, uint count)
+{
+	// the tail index is only written by this (producer) thread
+	uint tail = (uint) m_lfTail.load();
+	uint head = (uint) m_lfHead.loadAcquire();
+	uint total;
+	uint remaining;
+	uint len;
+	uint index;
+
+	total = MIN(count, m_size - (tail - head));
+	if(total < count) {
+		reportOverflow(count, total);
+	}
+
+	remaining = total;
+	while(remaining > 0) {
+		index = tail & m_mask;
+		len = MIN(remaining, m_size - index);
+		std::copy(begin, begin + len, m_data.begin() + index);
+		tail += len;
+		begin += len;
+		remaining -= len;
+	}
+
+	// publish the samples to the consumer
+	m_lfTail.storeRelease((int) tail);
+	m_metrics.write(count, total, tail - head, m_metricsTimer.nsecsElapsed());
+
+	if(tail != head)
+		emit dataReady();
+
+	return total;
+}
+
+uint SampleSinkFifo::readLockFree(SampleVector::iterator begin, uint count)
+{
+	// the head index is only written by this (consumer) thread
+	uint head = (uint) m_lfHead.load();
+	uint fill = (uint) m_lfTail.loadAcquire() - head;
+	uint total;
+	uint remaining;
+	uint len;
+	uint index;
+
+	total = MIN(count, fill);
+	if(total < count)
+		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
+
+	remaining = total;
+	while(remaining > 0) {
+		index = head & m_mask;
+		len = MIN(remaining, m_size - index);
+		std::copy(m_data.begin() + index, m_data.begin() + index + len, begin);
+		head += len;
+		begin += len;
+		remaining -= len;
+	}
+
+	// release the space to the producer
+	m_lfHead.storeRelease((int) head);
+
+	return total;
+}
+
+uint SampleSinkFifo::readBeginLockFree(uint count,
+	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
+{
+	uint head = (uint) m_lfHead.load();
+	uint fill = (uint) m_lfTail.loadAcquire() - head;
+	uint total;
+	uint remaining;
+	uint len;
+	uint index = head & m_mask;
+
+	total = MIN(count, fill);
+	if(total < count)
+		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
+
+	remaining = total;
+	if(remaining > 0) {
+		len = MIN(remaining, m_size - index);
+		*part1Begin = m_data.begin() + index;
+		*part1End = m_data.begin() + index + len;
+		index = (index + len) & m_mask;
+		remaining -= len;
+	} else {
+		*part1Begin = m_data.end();
+		*part1End = m_data.end();
+	}
+	if(remaining > 0) {
+		*part2Begin = m_data.begin() + index;
+		*part2End = m_data.begin() + index + remaining;
+	} else {
+		*part2Begin = m_data.end();
+		*part2End = m_data.end();
+	}
+
+	return total;
+}
+
+uint SampleSinkFifo::readCommitLockFree(uint count)
+{
+	uint head = (uint) m_lfHead.load();
+	uint fill = (uint) m_lfTail.loadAcquire() - head;
+
+	if(count > fill) {
+		qCritical("SampleSinkFifo: cannot commit more than available samples");
+		count = fill;
+	}
+
+	m_lfHead.storeRelease((int) (head + count));
+
+	return count;
+}
@@ -21,9 +21,14 @@
 #include <QObject>
 #include <QMutex>
 #include <QTime>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 #include "dsp/dsptypes.h"
+#include "dsp/dspmetrics.h"
 #include "util/export.h"
 
+#define SAMPLESINKFIFO_CACHE_LINE 64
+
 class SDRANGEL_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
@@ -39,7 +44,30 @@ private:
 	uint m_head;
 	uint m_tail;
 
-	void create(uint s);
+	// Lock free single producer / single consumer mode. Indexes are free running and
+	// masked with the power of two size. Producer and consumer indexes are kept on
+	// separate cache lines so that the device and engine threads do not share a line.
+	bool m_lockFree;
+	uint m_mask;
+	char m_lfPad0[SAMPLESINKFIFO_CACHE_LINE];
+	QAtomicInt m_lfHead; //!< consumer index (written by reader thread only)
+	char m_lfPad1[SAMPLESINKFIFO_CACHE_LINE - sizeof(QAtomicInt)];
+	QAtomicInt m_lfTail; //!< producer index (written by writer thread only)
+	char m_lfPad2[SAMPLESINKFIFO_CACHE_LINE - sizeof(QAtomicInt)];
+
+	FifoMetrics m_metrics;          //!< updated by the writer
+	QElapsedTimer m_metricsTimer;
+
+	bool create(uint s);
+	void reportOverflow(uint count, uint total);
+
+	template<typename InputIterator>
+	uint writeLockFree(InputIterator begin, uint count);
+	uint readLockFree(SampleVector::iterator begin, uint count);
+	uint readBeginLockFree(uint count,
+		SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
+	uint readCommitLockFree(uint count);
 
 public:
 	SampleSinkFifo(QObject* parent = NULL);
@@ -47,8 +75,24 @@ public:
 	~SampleSinkFifo();
 
 	bool setSize(int size);
+	/**
+	 * Select the lock free single producer / single consumer mode. In this mode the size is
+	 * rounded up to the next power of two and write() must be called from one thread only while
+	 * read(), readBegin() and readCommit() are called from one other thread only. The FIFO is
+	 * re-created so this must be done while no thread is using it.
+	 */
+	void setLockFree(bool lockFree);
+	inline bool isLockFree() const { return m_lockFree; }
+	void setMetricsName(const QString& name); //!< Name of the FIFO in the metrics reports
 	inline uint size() const { return m_size; }
-	inline uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
+	inline uint fill()
+	{
+		if (m_lockFree) {
+			return (uint) m_lfTail.loadAcquire() - (uint) m_lfHead.loadAcquire();
+		} else {
+			QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill;
+		}
+	}
 
 	uint write(const quint8* data, uint count);
 	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
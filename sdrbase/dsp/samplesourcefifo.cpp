@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <assert.h>
+#include <algorithm>
 #include "samplesourcefifo.h"
 
 SampleSourceFifo::SampleSourceFifo(uint32_t size) :
@@ -89,3 +90,22 @@ void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt)
 
     writeAt = m_data.begin() + m_iw;
 }
+
+void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt, unsigned int nbSamples)
+{
+    assert(nbSamples <= m_size);
+    unsigned int end = m_iw + nbSamples;
+
+    if (end <= m_size) // all in the first buffer: copy to the second buffer
+    {
+        std::copy(m_data.begin() + m_iw, m_data.begin() + end, m_data.begin() + m_iw + m_size);
+    }
+    else // wrapped part was written in the second buffer: copy it back to the first
+    {
+        std::copy(m_data.begin() + m_iw, m_data.begin() + m_size, m_data.begin() + m_iw + m_size);
+        std::copy(m_data.begin() + m_size, m_data.begin() + end, m_data.begin());
+    }
+
+    m_iw = end % m_size;
+    writeAt = m_data.begin() + m_iw;
+}
@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "dsp/sigmfmeta.h"
+
+SigMFMeta::SigMFMeta() :
+	m_sampleRate(0),
+	m_sampleBits(16),
+	m_sampleShift(0)
+{
+}
+
+void SigMFMeta::clear()
+{
+	m_sampleRate = 0;
+	m_sampleBits = 16;
+	m_sampleShift = 0;
+	m_captures.clear();
+}
+
+bool SigMFMeta::write(const QString& metaFileName) const
+{
+	QJsonObject global;
+	global["core:datatype"] = m_sampleBits == 8 ? QString("ci8") : m_sampleBits == 12 ? QString("ci12_le") : QString("ci16_le");
+	global["core:sample_rate"] = (double) m_sampleRate;
+	global["core:version"] = QString("0.0.1");
+	global["core:recorder"] = QString("SDRangel");
+	global["sdrangel:sample_bits"] = m_sampleBits;
+	global["sdrangel:sample_shift"] = m_sampleShift;
+
+	// ci12_le is not a core datatype: the extension can only be ignored by readers of 8 and 16 bit records
+	QJsonObject extension;
+	extension["name"] = QString("sdrangel");
+	extension["version"] = QString("1.0.0");
+	extension["optional"] = m_sampleBits != 12;
+	QJsonArray extensions;
+	extensions.append(extension);
+	global["core:extensions"] = extensions;
+
+	QJsonArray captures;
+
+	for (int i = 0; i < m_captures.size(); i++)
+	{
+		QJsonObject capture;
+		capture["core:sample_start"] = (double) m_captures[i].m_sampleStart; // exact up to 2^53
+		capture["core:frequency"] = (double) m_captures[i].m_frequency;
+		capture["core:datetime"] = QDateTime::fromMSecsSinceEpoch(m_captures[i].m_timestampMs).toUTC().toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+		capture["sdrangel:sample_rate"] = m_captures[i].m_sampleRate;
+		captures.append(capture);
+	}
+
+	QJsonObject root;
+	root["global"] = global;
+	root["captures"] = captures;
+	root["annotations"] = QJsonArray();
+
+	QFile file(metaFileName);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qCritical() << "SigMFMeta::write: cannot open " << metaFileName << ": " << file.errorString();
+		return false;
+	}
+
+	file.write(QJsonDocument(root).toJson());
+	file.close();
+	return true;
+}
+
+bool SigMFMeta::read(const QString& metaFileName)
+{
+	clear();
+	QFile file(metaFileName);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		qCritical() << "SigMFMeta::read: cannot open " << metaFileName << ": " << file.errorString();
+		return false;
+	}
+
+	QJsonParseError error;
+	QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+
+	if (!doc.isObject())
+	{
+		qCritical() << "SigMFMeta::read: " << metaFileName << ": " << error.errorString();
+		return false;
+	}
+
+	QJsonObject global = doc.object()["global"].toObject();
+	QString datatype = global["core:datatype"].toString();
+	m_sampleRate = (int) global["core:sample_rate"].toDouble();
+
+	if (global.contains("sdrangel:sample_bits"))
+	{
+		m_sampleBits = global["sdrangel:sample_bits"].toInt();
+		m_sampleShift = global["sdrangel:sample_shift"].toInt();
+	}
+	else if (datatype == "ci8") // recorded by another application
+	{
+		m_sampleBits = 8;
+		m_sampleShift = 8;
+	}
+	else if (datatype == "ci16_le")
+	{
+		m_sampleBits = 16;
+		m_sampleShift = 0;
+	}
+	else if (datatype == "ci12_le") // sdrangel extension datatype
+	{
+		m_sampleBits = 12;
+		m_sampleShift = 4;
+	}
+	else
+	{
+		qCritical() << "SigMFMeta::read: " << metaFileName << ": unsupported datatype " << datatype;
+		return false;
+	}
+
+	QJsonArray captures = doc.object()["captures"].toArray();
+
+	for (int i = 0; i < captures.size(); i++)
+	{
+		QJsonObject capture = captures[i].toObject();
+		QDateTime dateTime = QDateTime::fromString(capture["core:datetime"].toString(), Qt::ISODate);
+		m_captures.append(Capture(
+			(quint64) capture["core:sample_start"].toDouble(),
+			(quint64) capture["core:frequency"].toDouble(),
+			capture.contains("sdrangel:sample_rate") ? capture["sdrangel:sample_rate"].toInt() : m_sampleRate,
+			dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0));
+	}
+
+	return true;
+}
+
+bool SigMFMeta::getSampleIndex(qint64 timestampMs, quint64& sampleIndex) const
+{
+	int i = m_captures.size() - 1;
+
+	while ((i >= 0) && (m_captures[i].m_timestampMs > timestampMs)) {
+		i--;
+	}
+
+	if (i < 0) {
+		return false;
+	}
+
+	const Capture& capture = m_captures[i];
+	sampleIndex = capture.m_sampleStart + ((timestampMs - capture.m_timestampMs) * capture.m_sampleRate) / 1000;
+	return true;
+}
+
+bool SigMFMeta::isSigMF(const QString& fileName)
+{
+	return fileName.endsWith(".sigmf-meta") || fileName.endsWith(".sigmf-data");
+}
+
+static QString getBaseName(const QString& fileName)
+{
+	int dot = fileName.lastIndexOf('.');
+	int slash = fileName.lastIndexOf('/');
+	return dot > slash ? fileName.left(dot) : fileName;
+}
+
+QString SigMFMeta::getMetaFileName(const QString& fileName)
+{
+	return getBaseName(fileName) + ".sigmf-meta";
+}
+
+QString SigMFMeta::getDataFileName(const QString& fileName)
+{
+	return getBaseName(fileName) + ".sigmf-data";
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_SIGMFMETA_H
+#define INCLUDE_SIGMFMETA_H
+
+#include <QString>
+#include <QList>
+
+#include "util/export.h"
+
+/**
+ * Metadata of a SigMF style recording (http://sigmf.org). The samples are in the .sigmf-data file
+ * and this is in the .sigmf-meta JSON file next to it. Samples may be packed to 8 or 12 bits (see
+ * SamplePacker). A capture segment is added at each frequency or sample rate change and periodically
+ * so that timestamps stay accurate over long recordings and after dropped blocks.
+ *
+ * The "sdrangel" extension (declared in core:extensions) defines:
+ * - the ci12_le datatype: complex 12 bit integers packed in 3 bytes as I[7:0], Q[3:0] << 4 | I[11:8],
+ *   Q[11:4]. The extension is marked as not optional in these records only. The values are
+ *   shifted left by 4 when read unless sdrangel:sample_shift says otherwise.
+ * - global sdrangel:sample_bits and sdrangel:sample_shift: bit depth and left shift that restores
+ *   the 16 bit scale of the samples.
+ * - capture sdrangel:sample_rate: sample rate from this capture onward.
+ */
+struct SDRANGEL_API SigMFMeta
+{
+	struct Capture
+	{
+		quint64 m_sampleStart;
+		quint64 m_frequency;
+		int m_sampleRate;
+		qint64 m_timestampMs; //!< ms since epoch of the first sample of the capture
+
+		Capture() : m_sampleStart(0), m_frequency(0), m_sampleRate(0), m_timestampMs(0) {}
+		Capture(quint64 sampleStart, quint64 frequency, int sampleRate, qint64 timestampMs) :
+			m_sampleStart(sampleStart), m_frequency(frequency), m_sampleRate(sampleRate), m_timestampMs(timestampMs) {}
+	};
+
+	int m_sampleRate;
+	int m_sampleBits;
+	int m_sampleShift;
+	QList<Capture> m_captures;
+
+	SigMFMeta();
+	void clear();
+
+	bool write(const QString& metaFileName) const;
+	bool read(const QString& metaFileName);
+
+	/** Sample index of a timestamp using the capture it falls in. False if before the first capture. */
+	bool getSampleIndex(qint64 timestampMs, quint64& sampleIndex) const;
+
+	static bool isSigMF(const QString& fileName); //!< fileName has a .sigmf-meta or .sigmf-data extension
+	static QString getMetaFileName(const QString& fileName);
+	static QString getDataFileName(const QString& fileName);
+};
+
+#endif // INCLUDE_SIGMFMETA_H
@@ -1,9 +1,12 @@
 #include "dsp/spectrumvis.h"
-#include "gui/glspectrum.h"
+#include "dsp/glspectruminterface.h"
 #include "dsp/dspcommands.h"
 #include "util/messagequeue.h"
 
-#define MAX_FFT_SIZE 4096
+#include <cstring>
+#include <stdint.h>
+
+#define MAX_FFT_SIZE 16384
 
 #ifndef LINUX
 inline double log2f(double n)
@@ -14,18 +17,42 @@ inline double log2f(double n)
 
 MESSAGE_CLASS_DEFINITION(SpectrumVis::MsgConfigureSpectrumVis, Message)
 
-SpectrumVis::SpectrumVis(GLSpectrum* glSpectrum) :
+/**
+ * log2 from the float exponent and a short series of the mantissa. The absolute error is below 2e-5
+ * (6e-5 dB) and unlike log2f it has no branches so that the loop over the bins is vectorized.
+ */
+static inline Real fastLog2(float x)
+{
+	uint32_t i;
+	std::memcpy(&i, &x, sizeof(i));
+	float e = (float) ((int) ((i >> 23) & 0xFF) - 127);
+	i = (i & 0x007FFFFF) | 0x3F800000; // mantissa in [1,2)
+	float m;
+	std::memcpy(&m, &i, sizeof(m));
+	float t = (m - 1.0f) / (m + 1.0f);
+	float t2 = t * t;
+	return e + t * (2.885390082f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+}
+
+SpectrumVis::SpectrumVis(GLSpectrumInterface* glSpectrum) :
 	BasebandSampleSink(),
 	m_fft(FFTEngine::create()),
 	m_fftBuffer(MAX_FFT_SIZE),
+	m_framePower(MAX_FFT_SIZE),
+	m_powerSpectrum(MAX_FFT_SIZE),
 	m_logPowerSpectrum(MAX_FFT_SIZE),
 	m_fftBufferFill(0),
 	m_needMoreSamples(false),
+	m_avgMode(AvgModeNone),
+	m_avgNb(1),
+	m_avgCount(0),
+	m_lineSamples(0),
+	m_powFFTDiv(0),
 	m_glSpectrum(glSpectrum),
 	m_mutex(QMutex::Recursive)
 {
 	setObjectName("SpectrumVis");
-	handleConfigure(1024, 0, FFTWindow::BlackmanHarris);
+	handleConfigure(1024, 0, FFTWindow::BlackmanHarris, AvgModeNone, 1);
 }
 
 SpectrumVis::~SpectrumVis()
@@ -33,9 +60,10 @@ SpectrumVis::~SpectrumVis()
 	delete m_fft;
 }
 
-void SpectrumVis::configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window)
+void SpectrumVis::configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window,
+		AvgMode avgMode, int avgNb)
 {
-	MsgConfigureSpectrumVis* cmd = new MsgConfigureSpectrumVis(fftSize, overlapPercent, window);
+	MsgConfigureSpectrumVis* cmd = new MsgConfigureSpectrumVis(fftSize, overlapPercent, window, avgMode, avgNb);
 	msgQueue->push(cmd);
 }
 
@@ -70,11 +98,12 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	}
 
 	SampleVector::const_iterator begin(cbegin);
+	const Real scale = 1.0f / 32768.0f;
 
 	while (begin < end)
 	{
 		std::size_t todo = end - begin;
-		std::size_t samplesNeeded = m_refillSize - m_fftBufferFill;
+		std::size_t samplesNeeded = m_fftSize - m_fftBufferFill; // the buffer starts with the overlap of the previous FFT
 
 		if (todo >= samplesNeeded)
 		{
@@ -85,55 +114,24 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 
 			for (std::size_t i = 0; i < samplesNeeded; ++i, ++begin)
 			{
-				*it++ = Complex(begin->real() / 32768.0f, begin->imag() / 32768.0f);
+				*it++ = Complex(begin->real() * scale, begin->imag() * scale);
 			}
 
-			// apply fft window (and copy from m_fftBuffer to m_fftIn)
-			m_window.apply(&m_fftBuffer[0], m_fft->in());
+			bool updateDue = !m_updateTimer.isValid() || (m_updateTimer.elapsed() >= SPECTRUMVIS_UPDATE_MS);
+			m_lineSamples += m_refillSize;
 
-			// calculate FFT
-			m_fft->transform();
-
-			// extract power spectrum and reorder buckets
-			Real ofs = 20.0f * log10f(1.0f / m_fftSize);
-			Real mult = (10.0f / log2f(10.0f));
-			const Complex* fftOut = m_fft->out();
-			Complex c;
-			Real v;
-			std::size_t halfSize = m_fftSize / 2;
-
-			if ( positiveOnly )
-			{
-				for (std::size_t i = 0; i < halfSize; i++)
-				{
-					c = fftOut[i];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i * 2] = v;
-					m_logPowerSpectrum[i * 2 + 1] = v;
-				}
-			}
-			else
-			{
-				for (std::size_t i = 0; i < halfSize; i++)
-				{
-					c = fftOut[i + halfSize];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i] = v;
-
-					c = fftOut[i];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i + halfSize] = v;
-				}
+			// FFTs that would not be displayed are not computed: without averaging all but the one due
+			// and with averaging the ones past a complete average waiting for the display
+			if ((m_avgCount < m_avgNb) && (updateDue || (m_avgMode != AvgModeNone))) {
+				processFFT(positiveOnly);
 			}
 
-			// send new data to visualisation
-			m_glSpectrum->newSpectrum(m_logPowerSpectrum, m_fftSize);
+			if (updateDue && (m_avgCount >= m_avgNb)) {
+				sendSpectrum();
+			}
 
 			// advance buffer respecting the fft overlap factor
-			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.end(), m_fftBuffer.begin());
+			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.begin() + m_fftSize, m_fftBuffer.begin());
 
 			// start over
 			m_fftBufferFill = m_overlapSize;
@@ -144,7 +142,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 			// not enough samples for FFT - just fill in new data and return
 			for(std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill; begin < end; ++begin)
 			{
-				*it++ = Complex(begin->real() / 32768.0f, begin->imag() / 32768.0f);
+				*it++ = Complex(begin->real() * scale, begin->imag() * scale);
 			}
 
 			m_fftBufferFill += todo;
@@ -153,6 +151,96 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	}
 }
 
+void SpectrumVis::processFFT(bool positiveOnly)
+{
+	// apply fft window (and copy from m_fftBuffer to m_fftIn)
+	m_window.apply(&m_fftBuffer[0], m_fft->in());
+
+	// calculate FFT
+	m_fft->transform();
+
+	// extract power spectrum and reorder buckets
+	const Complex* fftOut = m_fft->out();
+	Real *framePower = &m_framePower[0];
+	std::size_t halfSize = m_fftSize / 2;
+
+	if (positiveOnly)
+	{
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			Real v = fftOut[i].real() * fftOut[i].real() + fftOut[i].imag() * fftOut[i].imag();
+			framePower[i * 2] = v;
+			framePower[i * 2 + 1] = v;
+		}
+	}
+	else
+	{
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			const Complex& c = fftOut[i + halfSize];
+			framePower[i] = c.real() * c.real() + c.imag() * c.imag();
+		}
+
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			const Complex& c = fftOut[i];
+			framePower[i + halfSize] = c.real() * c.real() + c.imag() * c.imag();
+		}
+	}
+
+	// average linearly over the frames
+	Real *power = &m_powerSpectrum[0];
+
+	if ((m_avgCount == 0) || (m_avgMode == AvgModeNone))
+	{
+		std::copy(framePower, framePower + m_fftSize, power);
+	}
+	else if (m_avgMode == AvgModeMean)
+	{
+		for (std::size_t i = 0; i < m_fftSize; i++) {
+			power[i] += framePower[i];
+		}
+	}
+	else if (m_avgMode == AvgModePeak)
+	{
+		for (std::size_t i = 0; i < m_fftSize; i++) {
+			power[i] = framePower[i] > power[i] ? framePower[i] : power[i];
+		}
+	}
+	else
+	{
+		for (std::size_t i = 0; i < m_fftSize; i++) {
+			power[i] = framePower[i] < power[i] ? framePower[i] : power[i];
+		}
+	}
+
+	m_avgCount = m_avgMode == AvgModeNone ? 1 : m_avgCount + 1;
+}
+
+void SpectrumVis::sendSpectrum()
+{
+	// single conversion to dB of the averaged power. Mean division is folded in the offset.
+	const Real mult = 10.0f / log2f(10.0f);
+	Real ofs = m_powFFTDiv;
+
+	if ((m_avgMode == AvgModeMean) && (m_avgCount > 1)) {
+		ofs -= 10.0f * log10f((float) m_avgCount);
+	}
+
+	const Real *power = &m_powerSpectrum[0];
+	Real *logPower = &m_logPowerSpectrum[0];
+
+	for (std::size_t i = 0; i < m_fftSize; i++) {
+		logPower[i] = mult * fastLog2(power[i]) + ofs;
+	}
+
+	// send new data to visualisation
+	m_glSpectrum->newSpectrum(m_logPowerSpectrum, m_fftSize, m_lineSamples);
+	m_avgCount = 0;
+	m_lineSamples = 0;
+	m_updateTimer.start();
+}
+
 void SpectrumVis::start()
 {
 }
@@ -166,7 +254,7 @@ bool SpectrumVis::handleMessage(const Message& message)
 	if (MsgConfigureSpectrumVis::match(message))
 	{
 		MsgConfigureSpectrumVis& conf = (MsgConfigureSpectrumVis&) message;
-		handleConfigure(conf.getFFTSize(), conf.getOverlapPercent(), conf.getWindow());
+		handleConfigure(conf.getFFTSize(), conf.getOverlapPercent(), conf.getWindow(), conf.getAvgMode(), conf.getAvgNb());
 		return true;
 	}
 	else
@@ -175,7 +263,7 @@ bool SpectrumVis::handleMessage(const Message& message)
 	}
 }
 
-void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window)
+void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window, AvgMode avgMode, int avgNb)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -188,13 +276,13 @@ void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Fu
 		fftSize = 64;
 	}
 
-	if (overlapPercent > 100)
+	if (overlapPercent > 99) // 100% would never advance
 	{
-		m_overlapPercent = 100;
+		overlapPercent = 99;
 	}
 	else if (overlapPercent < 0)
 	{
-		m_overlapPercent = 0;
+		overlapPercent = 0;
 	}
 
 	m_fftSize = fftSize;
@@ -204,4 +292,9 @@ void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Fu
 	m_overlapSize = (m_fftSize * m_overlapPercent) / 100;
 	m_refillSize = m_fftSize - m_overlapSize;
 	m_fftBufferFill = m_overlapSize;
+	m_avgMode = avgMode;
+	m_avgNb = ((avgMode == AvgModeNone) || (avgNb < 1)) ? 1 : avgNb; // without averaging every FFT is a complete line
+	m_avgCount = 0;
+	m_lineSamples = 0;
+	m_powFFTDiv = 20.0f * log10f(1.0f / m_fftSize);
 }
@@ -3,42 +3,65 @@
 
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
+#include <QElapsedTimer>
 #include "dsp/fftengine.h"
 #include "fftwindow.h"
 #include "util/export.h"
 #include "util/message.h"
 
-class GLSpectrum;
+class GLSpectrumInterface;
 class MessageQueue;
 
+#define SPECTRUMVIS_UPDATE_MS 50 //!< minimum time between two spectrums sent to the display (display refresh period)
+
 class SDRANGEL_API SpectrumVis : public BasebandSampleSink {
 
 public:
+	typedef enum
+	{
+		AvgModeNone, //!< last FFT
+		AvgModeMean, //!< mean of the power over the frames
+		AvgModePeak, //!< peak hold over the frames
+		AvgModeMin   //!< minimum over the frames
+	} AvgMode;
+
 	class SDRANGEL_API MsgConfigureSpectrumVis : public Message {
 		MESSAGE_CLASS_DECLARATION
 
 	public:
-		MsgConfigureSpectrumVis(int fftSize, int overlapPercent, FFTWindow::Function window) :
+		MsgConfigureSpectrumVis(int fftSize, int overlapPercent, FFTWindow::Function window, AvgMode avgMode, int avgNb) :
 			Message(),
 			m_fftSize(fftSize),
 			m_overlapPercent(overlapPercent),
-			m_window(window)
+			m_window(window),
+			m_avgMode(avgMode),
+			m_avgNb(avgNb)
 		{ }
 
 		int getFFTSize() const { return m_fftSize; }
 		int getOverlapPercent() const { return m_overlapPercent; }
 		FFTWindow::Function getWindow() const { return m_window; }
+		AvgMode getAvgMode() const { return m_avgMode; }
+		int getAvgNb() const { return m_avgNb; }
 
 	private:
 		int m_fftSize;
 		int m_overlapPercent;
 		FFTWindow::Function m_window;
+		AvgMode m_avgMode;
+		int m_avgNb;
 	};
 
-	SpectrumVis(GLSpectrum* glSpectrum = NULL);
+	SpectrumVis(GLSpectrumInterface* glSpectrum = NULL);
 	virtual ~SpectrumVis();
 
-	void configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window);
+	/**
+	 * Power is averaged linearly over exactly avgNb FFTs with avgMode before the conversion to dB.
+	 * Spectrums are sent to the display at most every SPECTRUMVIS_UPDATE_MS: a complete average is held
+	 * until then and the FFTs in between are skipped, as are all FFTs not due for display without averaging.
+	 */
+	void configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window,
+			AvgMode avgMode = AvgModeNone, int avgNb = 1);
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
 	void feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly);
@@ -51,6 +74,8 @@ private:
 	FFTWindow m_window;
 
 	std::vector<Complex> m_fftBuffer;
+	std::vector<Real> m_framePower;       //!< linear power of the last FFT in display order
+	std::vector<Real> m_powerSpectrum;    //!< linear power accumulated over the frames
 	std::vector<Real> m_logPowerSpectrum;
 
 	std::size_t m_fftSize;
@@ -59,12 +84,20 @@ private:
 	std::size_t m_refillSize;
 	std::size_t m_fftBufferFill;
 	bool m_needMoreSamples;
+	AvgMode m_avgMode;
+	int m_avgNb;
+	int m_avgCount;          //!< FFTs accumulated in m_powerSpectrum
+	int m_lineSamples;       //!< input samples since the last spectrum sent
+	Real m_powFFTDiv;        //!< dB offset of the FFT size
+	QElapsedTimer m_updateTimer;
 
-	GLSpectrum* m_glSpectrum;
+	GLSpectrumInterface* m_glSpectrum;
 
 	QMutex m_mutex;
 
-	void handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window);
+	void handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window, AvgMode avgMode, int avgNb);
+	void processFFT(bool positiveOnly);
+	void sendSpectrum();
 };
 
 #endif // INCLUDE_SPECTRUMVIS_H
@@ -6,14 +6,24 @@
 #include "util/message.h"
 
 ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink, std::size_t size) :
-	m_sampleSink(sampleSink)
+	m_sampleSink(sampleSink),
+	m_broadcastFifo(0),
+	m_broadcastReaderId(-1)
 {
 	connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
+	m_sampleFifo.setLockFree(true); // written by the DSP engine thread only and read by the sink thread only
 	m_sampleFifo.setSize(size);
+
+	if (sampleSink) {
+		m_sampleFifo.setMetricsName(sampleSink->objectName());
+	}
+
+	m_metricsTimer.start();
 }
 
 ThreadedBasebandSampleSinkFifo::~ThreadedBasebandSampleSinkFifo()
 {
+	detachBroadcastFifo();
 	m_sampleFifo.readCommit(m_sampleFifo.fill());
 }
 
@@ -22,11 +32,112 @@ void ThreadedBasebandSampleSinkFifo::writeToFifo(SampleVector::const_iterator& b
 	m_sampleFifo.write(begin, end);
 }
 
+void ThreadedBasebandSampleSinkFifo::feedSink(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly)
+{
+	qint64 feedStart = m_metricsTimer.nsecsElapsed();
+	m_sampleSink->feed(begin, end, positiveOnly);
+	m_sampleSink->getMetrics().feed(end - begin, m_metricsTimer.nsecsElapsed() - feedStart);
+}
+
+void ThreadedBasebandSampleSinkFifo::attachBroadcastFifo(SampleSinkBroadcastFifo* broadcastFifo)
+{
+	if (m_broadcastReaderId.load() >= 0) {
+		return;
+	}
+
+	int readerId = broadcastFifo->addReader();
+
+	if (readerId < 0) {
+		return;
+	}
+
+	broadcastFifo->setReaderChannel(readerId, m_metricsChannel);
+
+	if (m_broadcastFifo != broadcastFifo)
+	{
+		if (m_broadcastFifo) {
+			disconnect(m_broadcastFifo, SIGNAL(dataReady()), this, SLOT(handleBroadcastFifoData()));
+		}
+
+		m_broadcastFifo = broadcastFifo;
+		connect(m_broadcastFifo, SIGNAL(dataReady()), this, SLOT(handleBroadcastFifoData()), Qt::QueuedConnection);
+	}
+
+	m_broadcastReaderId.storeRelease(readerId);
+}
+
+void ThreadedBasebandSampleSinkFifo::detachBroadcastFifo()
+{
+	// wait for the sink thread to leave handleBroadcastFifoData so that it never reads or commits
+	// with a reader id that the next addReader() could give to another sink
+	QMutexLocker mutexLocker(&m_broadcastMutex);
+	int readerId = m_broadcastReaderId.fetchAndStoreOrdered(-1);
+
+	if (readerId >= 0) {
+		m_broadcastFifo->removeReader(readerId); // the FIFO pointer is kept so the reader thread never sees it change
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::setMetricsChannel(const QString& channel)
+{
+	int readerId = m_broadcastReaderId.load();
+	m_metricsChannel = channel;
+	m_sampleFifo.setMetricsName(channel + " subband"); // only written when the sink is fed by the filter bank
+	DSPMetrics::instance()->setSinkChannel(m_sampleSink, channel);
+
+	if (readerId >= 0) {
+		m_broadcastFifo->setReaderChannel(readerId, channel);
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::handleBroadcastFifoData()
+{
+	bool positiveOnly = false;
+	QMutexLocker mutexLocker(&m_broadcastMutex);
+	int readerId = m_broadcastReaderId.loadAcquire();
+
+	if (readerId < 0) {
+		return;
+	}
+
+	while ((m_broadcastFifo->fill(readerId) > 0) && m_sampleSink->getInputMessageQueue()->isEmpty())
+	{
+		SampleVector::iterator part1begin;
+		SampleVector::iterator part1end;
+		SampleVector::iterator part2begin;
+		SampleVector::iterator part2end;
+
+		std::size_t count = m_broadcastFifo->readBegin(readerId, m_broadcastFifo->fill(readerId), &part1begin, &part1end, &part2begin, &part2end);
+
+		// samples are read in place and released to the writer on commit
+
+		if (count > 0)
+		{
+			if(m_sampleSink != NULL)
+			{
+				feedSink(part1begin, part1end, positiveOnly);
+			}
+
+			m_broadcastFifo->readCommit(readerId, part1end - part1begin);
+		}
+
+		if(part2begin != part2end)
+		{
+			if(m_sampleSink != NULL)
+			{
+				feedSink(part2begin, part2end, positiveOnly);
+			}
+
+			m_broadcastFifo->readCommit(readerId, part2end - part2begin);
+		}
+	}
+}
+
 void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
 {
 	bool positiveOnly = false;
 
-	while ((m_sampleFifo.fill() > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
+	while ((m_sampleFifo.fill() > 0) && m_sampleSink->getInputMessageQueue()->isEmpty())
 	{
 		SampleVector::iterator part1begin;
 		SampleVector::iterator part1end;
@@ -42,7 +153,7 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 			// handle data
 			if(m_sampleSink != NULL)
 			{
-				m_sampleSink->feed(part1begin, part1end, positiveOnly);
+				feedSink(part1begin, part1end, positiveOnly);
 			}
 
 			m_sampleFifo.readCommit(part1end - part1begin);
@@ -55,7 +166,7 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 			// handle data
 			if(m_sampleSink != NULL)
 			{
-				m_sampleSink->feed(part2begin, part2end, positiveOnly);
+				feedSink(part2begin, part2end, positiveOnly);
 			}
 
 			m_sampleFifo.readCommit(part2end - part2begin);
@@ -111,6 +222,44 @@ void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, Sample
 	m_threadedBasebandSampleSinkFifo->writeToFifo(begin, end);
 }
 
+void ThreadedBasebandSampleSink::attachBroadcastFifo(SampleSinkBroadcastFifo* broadcastFifo)
+{
+	m_threadedBasebandSampleSinkFifo->attachBroadcastFifo(broadcastFifo);
+}
+
+void ThreadedBasebandSampleSink::detachBroadcastFifo()
+{
+	m_threadedBasebandSampleSinkFifo->detachBroadcastFifo();
+}
+
+void ThreadedBasebandSampleSink::setMetricsChannel(const QString& channel)
+{
+	m_threadedBasebandSampleSinkFifo->setMetricsChannel(channel);
+}
+
+bool ThreadedBasebandSampleSink::isAttachedToBroadcastFifo() const
+{
+	return m_threadedBasebandSampleSinkFifo->m_broadcastReaderId.load() >= 0;
+}
+
+uint ThreadedBasebandSampleSink::getBroadcastFifoLag() const
+{
+	int readerId = m_threadedBasebandSampleSinkFifo->m_broadcastReaderId.load();
+	return readerId < 0 ? 0 : m_threadedBasebandSampleSinkFifo->m_broadcastFifo->getLag(readerId);
+}
+
+uint ThreadedBasebandSampleSink::getBroadcastFifoMaxLag() const
+{
+	int readerId = m_threadedBasebandSampleSinkFifo->m_broadcastReaderId.load();
+	return readerId < 0 ? 0 : m_threadedBasebandSampleSinkFifo->m_broadcastFifo->getMaxLag(readerId);
+}
+
+quint64 ThreadedBasebandSampleSink::getBroadcastFifoOverflowCount() const
+{
+	int readerId = m_threadedBasebandSampleSinkFifo->m_broadcastReaderId.load();
+	return readerId < 0 ? 0 : m_threadedBasebandSampleSinkFifo->m_broadcastFifo->getOverflowCount(readerId);
+}
+
 bool ThreadedBasebandSampleSink::handleSinkMessage(const Message& cmd)
 {
 	return m_basebandSampleSink->handleMessage(cmd);
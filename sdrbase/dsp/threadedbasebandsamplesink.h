@@ -20,8 +20,10 @@
 
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
+#include <QElapsedTimer>
 
 #include "samplesinkfifo.h"
+#include "samplesinkbroadcastfifo.h"
 #include "util/messagequeue.h"
 #include "util/export.h"
 
@@ -39,12 +41,22 @@ public:
 	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink, std::size_t size = 1<<18);
 	~ThreadedBasebandSampleSinkFifo();
 	void writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end);
+	void attachBroadcastFifo(SampleSinkBroadcastFifo* broadcastFifo);
+	void detachBroadcastFifo();
+	void setMetricsChannel(const QString& channel);
+	void feedSink(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed the sink and account its processing time
 
 	BasebandSampleSink* m_sampleSink;
-	SampleSinkFifo m_sampleFifo;
+	SampleSinkFifo m_sampleFifo;                //!< private FIFO filled by writeToFifo
+	SampleSinkBroadcastFifo* m_broadcastFifo;   //!< shared FIFO read in place when attached
+	QAtomicInt m_broadcastReaderId;             //!< -1 when not attached
+	QMutex m_broadcastMutex;                    //!< held while the sink thread reads the shared FIFO
+	QString m_metricsChannel;                   //!< channel of the sink in the metrics reports
+	QElapsedTimer m_metricsTimer;
 
 public slots:
 	void handleFifoData();
+	void handleBroadcastFifoData();
 };
 
 /**
@@ -67,6 +79,14 @@ public:
 	bool handleSinkMessage(const Message& cmd); //!< Send message to sink synchronously
 	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples
 
+	void attachBroadcastFifo(SampleSinkBroadcastFifo* broadcastFifo); //!< Read samples in place from the engine shared FIFO. Call from the writer thread.
+	void detachBroadcastFifo();                                       //!< Stop reading from the shared FIFO. Call from the writer thread. Waits for the samples being processed.
+	void setMetricsChannel(const QString& channel);                   //!< Report the sink, its FIFOs and reader by channel in the metrics. Call from the writer thread.
+	bool isAttachedToBroadcastFifo() const;
+	uint getBroadcastFifoLag() const;              //!< Samples waiting in the shared FIFO for this sink
+	uint getBroadcastFifoMaxLag() const;           //!< Highest lag seen by the writer
+	quint64 getBroadcastFifoOverflowCount() const; //!< Samples dropped while this sink was lagging
+
 	QString getSampleSinkObjectName() const;
 
 protected:
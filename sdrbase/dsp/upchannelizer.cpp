@@ -31,7 +31,8 @@ UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
     m_requestedInputSampleRate(0),
     m_requestedCenterFrequency(0),
     m_currentInputSampleRate(0),
-    m_currentCenterFrequency(0)
+    m_currentCenterFrequency(0),
+    m_sampleBufferIndex(0)
 {
     QString name = "UpChannelizer(" + m_sampleSource->objectName() + ")";
     setObjectName(name);
@@ -52,6 +53,7 @@ void UpChannelizer::pull(Sample& sample)
 {
     if(m_sampleSource == 0) {
         m_sampleBuffer.clear();
+        m_sampleBufferIndex = 0;
         return;
     }
 
@@ -62,29 +64,72 @@ void UpChannelizer::pull(Sample& sample)
     else
     {
         m_mutex.lock();
+        pullStages(sample);
+        m_mutex.unlock();
+    }
+}
+
+void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if(m_sampleSource == 0) {
+        m_sampleBuffer.clear();
+        m_sampleBufferIndex = 0;
+        return;
+    }
 
-        FilterStages::iterator stage = m_filterStages.begin();
-        std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+    if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+    {
+        m_sampleSource->pull(begin, nbSamples);
+    }
+    else
+    {
+        m_mutex.lock();
+
+        // the chain takes one input sample every 2^stages output samples: pull them from the modulator
+        // as a block. Samples left over are kept for the next block.
+        unsigned int nbInputs = (nbSamples >> m_filterStages.size()) + 1;
+        m_sampleBuffer.erase(m_sampleBuffer.begin(), m_sampleBuffer.begin() + m_sampleBufferIndex);
+        m_sampleBufferIndex = 0;
+        unsigned int nbBuffered = m_sampleBuffer.size();
 
-        for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+        if (nbBuffered < nbInputs)
         {
-            if(stage == m_filterStages.end() - 1)
+            m_sampleBuffer.resize(nbInputs);
+            m_sampleSource->pull(m_sampleBuffer.begin() + nbBuffered, nbInputs - nbBuffered);
+        }
+
+        for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+            pullStages(*begin);
+        }
+
+        m_mutex.unlock();
+    }
+}
+
+void UpChannelizer::pullStages(Sample& sample)
+{
+    FilterStages::iterator stage = m_filterStages.begin();
+    std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+
+    for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    {
+        if(stage == m_filterStages.end() - 1)
+        {
+            if ((*stage)->work(&m_sampleIn, &(*stageSample)))
             {
-                if ((*stage)->work(&m_sampleIn, &(*stageSample)))
-                {
-                    m_sampleSource->pull(m_sampleIn); // get new input sample
-                }
+                pullInput(m_sampleIn); // get new input sample
             }
-            else
+        }
+        else
+        {
+            if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
             {
-                if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
-                {
-                    break;
-                }
+                break;
             }
         }
+    }
 
-        sample = *m_stageSamples.begin();
+    sample = *m_stageSamples.begin();
 
 //		for (; stage != m_filterStages.end(); ++stage)
 //		{
@@ -97,9 +142,6 @@ void UpChannelizer::pull(Sample& sample)
 //				}
 //			}
 //		}
-
-        m_mutex.unlock();
-    }
 }
 
 void UpChannelizer::start()
@@ -179,6 +221,8 @@ void UpChannelizer::applyConfiguration()
     m_mutex.lock();
 
     freeFilterChain();
+    m_sampleBuffer.clear(); // samples pulled ahead were for the former chain
+    m_sampleBufferIndex = 0;
 
     m_currentCenterFrequency = createFilterChain(
         m_outputSampleRate / -2, m_outputSampleRate / 2,
@@ -66,6 +66,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples) { if (m_sampleSource) m_sampleSource->pullAudio(nbSamples); }
 
     virtual bool handleMessage(const Message& cmd);
@@ -104,11 +105,21 @@ protected:
     int m_requestedCenterFrequency;
     int m_currentInputSampleRate;
     int m_currentCenterFrequency;
-    SampleVector m_sampleBuffer;
+    SampleVector m_sampleBuffer;       //!< modulator samples pulled ahead by the block pull
+    unsigned int m_sampleBufferIndex;  //!< next sample to take from m_sampleBuffer
     Sample m_sampleIn;
     QMutex m_mutex;
 
     void applyConfiguration();
+    void pullStages(Sample& sample);   //!< one output sample through the filter chain. m_mutex must be held.
+    void pullInput(Sample& sample)     //!< next modulator sample. m_mutex must be held.
+    {
+        if (m_sampleBufferIndex < m_sampleBuffer.size()) {
+            sample = m_sampleBuffer[m_sampleBufferIndex++];
+        } else {
+            m_sampleSource->pull(sample);
+        }
+    }
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
     Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
     void freeFilterChain();
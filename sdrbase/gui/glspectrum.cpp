@@ -39,6 +39,8 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_decay(0),
 	m_sampleRate(500000),
 	m_fftSize(512),
+	m_lineSamples(0),
+	m_scaleLineSamples(0),
 	m_displayGrid(true),
 	m_displayGridIntensity(5),
 	m_displayTraceIntensity(50),
@@ -304,12 +306,23 @@ void GLSpectrum::removeChannelMarker(ChannelMarker* channelMarker)
 	}
 }
 
-void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
+void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize, int lineSamples)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
 	m_displayChanged = true;
 
+	// a waterfall line per spectrum i.e. per display period or per average: the time scale follows
+	// the mean number of samples per line and is redone when it is off by more than 10%
+	if (lineSamples > 0)
+	{
+		m_lineSamples = m_lineSamples > 0 ? m_lineSamples + 0.1f * (lineSamples - m_lineSamples) : lineSamples;
+
+		if (qAbs(m_lineSamples - m_scaleLineSamples) > 0.1f * m_scaleLineSamples) {
+			m_changesPending = true;
+		}
+	}
+
 	if(m_changesPending) {
 		m_fftSize = fftSize;
 		return;
@@ -1034,6 +1047,7 @@ void GLSpectrum::applyChanges()
 		}
 
 		m_timeScale.setSize(waterfallHeight);
+		m_scaleLineSamples = m_lineSamples > 0 ? m_lineSamples : m_fftSize;
 
 		if(m_sampleRate > 0)
 		{
@@ -1041,11 +1055,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(Unit::Time, (waterfallHeight * m_scaleLineSamples) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(Unit::Time, 0, (waterfallHeight * m_scaleLineSamples) / scaleDiv);
 			}
 		}
 		else
@@ -1132,6 +1146,7 @@ void GLSpectrum::applyChanges()
 		histogramTop = 0;
 
 		m_timeScale.setSize(waterfallHeight);
+		m_scaleLineSamples = m_lineSamples > 0 ? m_lineSamples : m_fftSize;
 
 		if(m_sampleRate > 0)
 		{
@@ -1139,11 +1154,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(Unit::Time, (waterfallHeight * m_scaleLineSamples) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(Unit::Time, 0, (waterfallHeight * m_scaleLineSamples) / scaleDiv);
 			}
 		}
 		else
@@ -32,11 +32,12 @@
 #include "gui/glshadersimple.h"
 #include "gui/glshadertextured.h"
 #include "dsp/channelmarker.h"
+#include "dsp/glspectruminterface.h"
 #include "util/export.h"
 
 class QOpenGLShaderProgram;
 
-class SDRANGEL_API GLSpectrum : public QGLWidget {
+class SDRANGEL_API GLSpectrum : public QGLWidget, public GLSpectrumInterface {
 	Q_OBJECT
 
 public:
@@ -64,7 +65,7 @@ public:
 	void addChannelMarker(ChannelMarker* channelMarker);
 	void removeChannelMarker(ChannelMarker* channelMarker);
 
-	void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize, int lineSamples);
 	void clearSpectrumHistogram();
 
 	Real getWaterfallShare() const { return m_waterfallShare; }
@@ -111,6 +112,8 @@ private:
 	quint32 m_sampleRate;
 
 	int m_fftSize;
+	float m_lineSamples;      //!< mean input samples per waterfall line
+	float m_scaleLineSamples; //!< samples per line of the time scale
 
 	bool m_displayGrid;
 	int m_displayGridIntensity;
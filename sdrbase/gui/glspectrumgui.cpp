@@ -5,6 +5,9 @@
 #include "util/simpleserializer.h"
 #include "ui_glspectrumgui.h"
 
+static const int avgNbValues[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+static const int avgNbCount = sizeof(avgNbValues) / sizeof(avgNbValues[0]);
+
 GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	QWidget(parent),
 	ui(new Ui::GLSpectrumGUI),
@@ -14,6 +17,8 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	m_fftSize(1024),
 	m_fftOverlap(0),
 	m_fftWindow(FFTWindow::Hamming),
+	m_avgMode(SpectrumVis::AvgModeNone),
+	m_avgNb(1),
 	m_refLevel(0),
 	m_powerRange(100),
 	m_decay(0),
@@ -34,6 +39,8 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 		ui->refLevel->addItem(QString("%1").arg(ref));
 	for(int range = 100; range >= 5; range -= 5)
 		ui->levelRange->addItem(QString("%1").arg(range));
+	for(int i = 0; i < avgNbCount; i++)
+		ui->avgNb->addItem(QString("%1").arg(avgNbValues[i]));
 }
 
 GLSpectrumGUI::~GLSpectrumGUI()
@@ -54,6 +61,8 @@ void GLSpectrumGUI::resetToDefaults()
 	m_fftSize = 1024;
 	m_fftOverlap = 0;
 	m_fftWindow = FFTWindow::Hamming;
+	m_avgMode = SpectrumVis::AvgModeNone;
+	m_avgNb = 1;
 	m_refLevel = 0;
 	m_powerRange = 100;
 	m_decay = 0;
@@ -90,6 +99,8 @@ QByteArray GLSpectrumGUI::serialize() const
 	s.writeBool(16, m_displayCurrent);
 	s.writeS32(17, m_displayTraceIntensity);
 	s.writeReal(18, m_glSpectrum->getWaterfallShare());
+	s.writeS32(19, m_avgMode);
+	s.writeS32(20, m_avgNb);
 	return s.final();
 }
 
@@ -122,6 +133,8 @@ bool GLSpectrumGUI::deserialize(const QByteArray& data)
 		d.readS32(17, &m_displayTraceIntensity, 50);
 		Real waterfallShare;
 		d.readReal(18, &waterfallShare, 0.66);
+		d.readS32(19, &m_avgMode, SpectrumVis::AvgModeNone);
+		d.readS32(20, &m_avgNb, 1);
 		m_glSpectrum->setWaterfallShare(waterfallShare);
 		applySettings();
 		return true;
@@ -134,12 +147,20 @@ bool GLSpectrumGUI::deserialize(const QByteArray& data)
 void GLSpectrumGUI::applySettings()
 {
 	ui->fftWindow->setCurrentIndex(m_fftWindow);
-	for(int i = 0; i < 6; i++) {
+	for(int i = 0; i < 8; i++) {
 		if(m_fftSize == (1 << (i + 7))) {
 			ui->fftSize->setCurrentIndex(i);
 			break;
 		}
 	}
+	ui->avgMode->setCurrentIndex(m_avgMode);
+	for(int i = 0; i < avgNbCount; i++) {
+		if(m_avgNb <= avgNbValues[i]) {
+			ui->avgNb->setCurrentIndex(i);
+			break;
+		}
+	}
+	ui->avgNb->setEnabled(m_avgMode != SpectrumVis::AvgModeNone);
 	ui->refLevel->setCurrentIndex(-m_refLevel / 5);
 	ui->levelRange->setCurrentIndex((100 - m_powerRange) / 5);
 	ui->decay->setSliderPosition(m_decay);
@@ -171,7 +192,8 @@ void GLSpectrumGUI::applySettings()
 	m_glSpectrum->setDisplayGrid(m_displayGrid);
 	m_glSpectrum->setDisplayGridIntensity(m_displayGridIntensity);
 
-	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow,
+			(SpectrumVis::AvgMode)m_avgMode, m_avgNb);
 }
 
 void GLSpectrumGUI::on_fftWindow_currentIndexChanged(int index)
@@ -179,14 +201,35 @@ void GLSpectrumGUI::on_fftWindow_currentIndexChanged(int index)
 	m_fftWindow = index;
 	if(m_spectrumVis == NULL)
 		return;
-	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow,
+			(SpectrumVis::AvgMode)m_avgMode, m_avgNb);
 }
 
 void GLSpectrumGUI::on_fftSize_currentIndexChanged(int index)
 {
 	m_fftSize = 1 << (7 + index);
 	if(m_spectrumVis != NULL)
-		m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+		m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow,
+			(SpectrumVis::AvgMode)m_avgMode, m_avgNb);
+}
+
+void GLSpectrumGUI::on_avgMode_currentIndexChanged(int index)
+{
+	m_avgMode = index;
+	ui->avgNb->setEnabled(m_avgMode != SpectrumVis::AvgModeNone); // no averaging: one FFT per line
+	if(m_spectrumVis != NULL)
+		m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow,
+			(SpectrumVis::AvgMode)m_avgMode, m_avgNb);
+}
+
+void GLSpectrumGUI::on_avgNb_currentIndexChanged(int index)
+{
+	if((index < 0) || (index >= avgNbCount))
+		return;
+	m_avgNb = avgNbValues[index];
+	if(m_spectrumVis != NULL)
+		m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow,
+			(SpectrumVis::AvgMode)m_avgMode, m_avgNb);
 }
 
 void GLSpectrumGUI::on_refLevel_currentIndexChanged(int index)
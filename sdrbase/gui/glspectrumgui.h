@@ -36,6 +36,8 @@ private:
 	qint32 m_fftSize;
 	qint32 m_fftOverlap;
 	qint32 m_fftWindow;
+	qint32 m_avgMode;
+	qint32 m_avgNb;
 	Real m_refLevel;
 	Real m_powerRange;
 	int m_decay;
@@ -56,6 +58,8 @@ private:
 private slots:
 	void on_fftWindow_currentIndexChanged(int index);
 	void on_fftSize_currentIndexChanged(int index);
+	void on_avgMode_currentIndexChanged(int index);
+	void on_avgNb_currentIndexChanged(int index);
 	void on_refLevel_currentIndexChanged(int index);
 	void on_levelRange_currentIndexChanged(int index);
 	void on_decay_valueChanged(int index);
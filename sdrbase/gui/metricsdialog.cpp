@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "dsp/dspmetrics.h"
+#include "gui/metricsdialog.h"
+#include "ui_metricsdialog.h"
+
+MetricsDialog::MetricsDialog(QWidget* parent) :
+    QDialog(parent),
+    ui(new Ui::MetricsDialog)
+{
+    ui->setupUi(this);
+    connect(&m_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    refresh();
+    m_refreshTimer.start(1000);
+}
+
+MetricsDialog::~MetricsDialog()
+{
+    delete ui;
+}
+
+void MetricsDialog::refresh()
+{
+    QList<DSPMetrics::FifoReport> fifos;
+    QList<DSPMetrics::SinkReport> sinks;
+    QList<DSPMetrics::ReaderReport> readers;
+    DSPMetrics::instance()->getFifoReports(fifos);
+    DSPMetrics::instance()->getSinkReports(sinks);
+    DSPMetrics::instance()->getReaderReports(readers);
+
+    ui->fifoTree->clear();
+
+    for (int i = 0; i < fifos.size(); i++)
+    {
+        const FifoMetrics& metrics = fifos[i].m_metrics;
+        QStringList sl;
+        sl.append(QString("%1 (%2)").arg(fifos[i].m_name).arg(fifos[i].m_id));
+        sl.append(QString::number(metrics.m_size));
+        sl.append(QString::number(metrics.m_highWaterMark));
+        sl.append(QString::number(metrics.m_droppedCount));
+        sl.append(QString::number(metrics.m_writeCount));
+        sl.append(QString::number(metrics.getMeanIntervalNs() * 1e-6, 'f', 2));
+        sl.append(QString::number(metrics.getJitterNs() * 1e-6, 'f', 2));
+        sl.append(QString::number(metrics.m_maxIntervalNs * 1e-6, 'f', 2));
+        new QTreeWidgetItem(ui->fifoTree, sl);
+    }
+
+    ui->readerTree->clear();
+
+    for (int i = 0; i < readers.size(); i++)
+    {
+        const ReaderMetrics& metrics = readers[i].m_metrics;
+        QStringList sl;
+        sl.append(metrics.m_channel);
+        sl.append(QString("%1 (%2)").arg(readers[i].m_fifoName).arg(readers[i].m_fifoId));
+        sl.append(QString::number(metrics.m_lag));
+        sl.append(QString::number(metrics.m_maxLag));
+        sl.append(QString::number(metrics.m_overflowCount));
+        new QTreeWidgetItem(ui->readerTree, sl);
+    }
+
+    qint64 elapsedNs = m_elapsedTimer.isValid() ? m_elapsedTimer.nsecsElapsed() : 0;
+    m_elapsedTimer.start();
+    QHash<int, quint64> feedTimeNs;
+
+    ui->sinkTree->clear();
+
+    for (int i = 0; i < sinks.size(); i++)
+    {
+        const SinkMetrics& metrics = sinks[i].m_metrics;
+        QStringList sl;
+        sl.append(QString("%1 (%2)").arg(sinks[i].m_name).arg(sinks[i].m_id));
+        sl.append(sinks[i].m_channel);
+        sl.append(QString::number(metrics.m_sampleCount));
+        sl.append(QString::number(metrics.m_feedTimeNs * 1e-9, 'f', 3));
+
+        if ((elapsedNs > 0) && m_lastFeedTimeNs.contains(sinks[i].m_id)) {
+            sl.append(QString::number(((metrics.m_feedTimeNs - m_lastFeedTimeNs[sinks[i].m_id]) * 100.0) / elapsedNs, 'f', 1));
+        } else {
+            sl.append("-");
+        }
+
+        sl.append(QString::number(metrics.m_maxFeedTimeNs * 1e-6, 'f', 2));
+        new QTreeWidgetItem(ui->sinkTree, sl);
+        feedTimeNs[sinks[i].m_id] = metrics.m_feedTimeNs;
+    }
+
+    m_lastFeedTimeNs = feedTimeNs;
+}
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_GUI_METRICSDIALOG_H_
+#define SDRBASE_GUI_METRICSDIALOG_H_
+
+#include <QDialog>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+
+namespace Ui {
+    class MetricsDialog;
+}
+
+/**
+ * Shows the DSP metrics: FIFO fill and drops, device callbacks timing and the processing time of the sinks.
+ * The share of one core used by each sink is computed between two refreshes.
+ */
+class MetricsDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit MetricsDialog(QWidget* parent = 0);
+    ~MetricsDialog();
+
+private:
+    Ui::MetricsDialog* ui;
+    QTimer m_refreshTimer;
+    QElapsedTimer m_elapsedTimer;
+    QHash<int, quint64> m_lastFeedTimeNs; //!< sink feed time at the last refresh by sink id
+
+private slots:
+    void refresh();
+};
+
+#endif /* SDRBASE_GUI_METRICSDIALOG_H_ */
@@ -36,6 +36,7 @@
 #include "gui/presetitem.h"
 #include "gui/addpresetdialog.h"
 #include "gui/pluginsdialog.h"
+#include "gui/metricsdialog.h"
 #include "gui/aboutdialog.h"
 #include "gui/rollupwidget.h"
 #include "gui/channelwindow.h"
@@ -43,6 +44,7 @@
 #include "gui/samplingdevicecontrol.h"
 #include "gui/mypositiondialog.h"
 #include "dsp/dspengine.h"
+#include "dsp/fftengine.h"
 #include "dsp/spectrumvis.h"
 #include "dsp/dspcommands.h"
 #include "plugin/pluginapi.h"
@@ -160,6 +162,9 @@ MainWindow::MainWindow(QWidget* parent) :
 
 	connect(ui->tabInputsView, SIGNAL(currentChanged(int)), this, SLOT(tabInputViewIndexChanged()));
 
+	qDebug("MainWindow::MainWindow: FFT planning took %lld ms for %d plans",
+	        FFTEngine::getPlanningTimeMs(), FFTEngine::getPlansCount());
+
     qDebug() << "MainWindow::MainWindow: end";
 }
 
@@ -736,6 +741,12 @@ void MainWindow::on_action_Loaded_Plugins_triggered()
     pluginsDialog.exec();
 }
 
+void MainWindow::on_action_DSP_Metrics_triggered()
+{
+    MetricsDialog metricsDialog(this);
+    metricsDialog.exec();
+}
+
 void MainWindow::on_action_Audio_triggered()
 {
 	AudioDialog audioDialog(&m_audioDeviceInfo, this);
@@ -23,6 +23,7 @@
 #include <QList>
 
 #include "settings/mainsettings.h"
+#include "dsp/fftwisdom.h"
 #include "util/messagequeue.h"
 #include "util/export.h"
 
@@ -104,6 +105,7 @@ private:
 	AudioDeviceInfo m_audioDeviceInfo;
 	MessageQueue m_inputMessageQueue;
 	MainSettings m_settings;
+	FFTWisdom m_fftWisdom;
 	std::vector<DeviceUISet*> m_deviceUIs;
 	QList<DeviceWidgetTabData> m_deviceWidgetTabs;
 	int m_masterTabIndex;
@@ -158,6 +160,7 @@ private slots:
 	void on_sampleSink_confirmClicked(bool checked);
     void on_channel_addClicked(bool checked);
 	void on_action_Loaded_Plugins_triggered();
+	void on_action_DSP_Metrics_triggered();
 	void on_action_About_triggered();
 	void on_action_addSourceDevice_triggered();
 	void on_action_addSinkDevice_triggered();
@@ -18,7 +18,10 @@ class PluginAPI;
 class DeviceSourceAPI;
 class DeviceSinkAPI;
 class PluginInstanceUI;
+class DeviceSampleSource;
+class ChannelSinkAPI;
 class QWidget;
+class QTimer;
 
 class PluginInterface {
 public:
@@ -51,6 +54,7 @@ public:
 
 	// channel Rx plugins
 	virtual PluginInstanceUI* createRxChannel(const QString& channelName __attribute__((unused)), DeviceSourceAPI *deviceAPI __attribute__((unused)) ) { return 0; }
+	virtual ChannelSinkAPI* createRxChannelCore(const QString& channelName __attribute__((unused)), DeviceSourceAPI *deviceAPI __attribute__((unused)) ) { return 0; } //!< without GUI (headless server)
 
 	// channel Tx plugins
 	virtual PluginInstanceUI* createTxChannel(const QString& channelName __attribute__((unused)), DeviceSinkAPI *deviceAPI __attribute__((unused)) ) { return 0; }
@@ -58,6 +62,7 @@ public:
 	// device source plugins only
 	virtual SamplingDevices enumSampleSources() { return SamplingDevices(); }
 	virtual PluginInstanceUI* createSampleSourcePluginInstanceUI(const QString& sourceId __attribute__((unused)), QWidget **widget __attribute__((unused)), DeviceSourceAPI *deviceAPI __attribute__((unused))) { return 0; }
+	virtual DeviceSampleSource* createSampleSourcePluginInstanceInput(const QString& sourceId __attribute__((unused)), DeviceSourceAPI *deviceAPI __attribute__((unused)), const QTimer& masterTimer __attribute__((unused))) { return 0; } //!< without GUI (headless server)
 
 	// device sink plugins only
 	virtual SamplingDevices enumSampleSinks() { return SamplingDevices(); }
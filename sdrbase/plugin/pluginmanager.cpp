@@ -17,7 +17,7 @@
 #include <plugin/plugininstanceui.h>
 #include "device/devicesourceapi.h"
 #include "device/devicesinkapi.h"
-#include <QApplication>
+#include <QCoreApplication>
 #include <QPluginLoader>
 #include <QComboBox>
 #include <cstdio>
@@ -31,6 +31,7 @@
 #include <QDebug>
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/devicesamplesource.h"
 
 const QString PluginManager::m_sdrDaemonHardwareID = "SDRdaemon";
 const QString PluginManager::m_sdrDaemonDeviceTypeID = "sdrangel.samplesource.sdrdaemon";
@@ -53,7 +54,7 @@ PluginManager::~PluginManager()
 
 void PluginManager::loadPlugins()
 {
-	QString applicationDirPath = QApplication::instance()->applicationDirPath();
+	QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
 	QString applicationLibPath = applicationDirPath + "/../lib";
 	qDebug() << "PluginManager::loadPlugins: " << qPrintable(applicationDirPath) << ", " << qPrintable(applicationLibPath);
 
@@ -551,6 +552,37 @@ int PluginManager::selectSampleSourceBySerialOrSequence(const QString& sourceId,
 {
 	qDebug("PluginManager::selectSampleSourceBySequence by sequence: id: %s ser: %s seq: %d", qPrintable(sourceId), qPrintable(sourceSerial), sourceSequence);
 
+	int index = getSampleSourceIndexBySerialOrSequence(sourceId, sourceSerial, sourceSequence);
+
+	if (index < 0) {
+		return -1; // return if no device attached
+	}
+
+    qDebug() << "PluginManager::selectSampleSourceBySequence: m_sampleSource at index " << index
+            << " hid: " << m_sampleSourceDevices[index].m_hadrwareId.toStdString().c_str()
+            << " id: " << m_sampleSourceDevices[index].m_deviceId.toStdString().c_str()
+            << " ser: " << m_sampleSourceDevices[index].m_deviceSerial.toStdString().c_str()
+            << " seq: " << m_sampleSourceDevices[index].m_deviceSequence;
+
+    deviceAPI->stopAcquisition();
+    deviceAPI->setSampleSourcePluginInstanceUI(0); // this effectively destroys the previous GUI if it exists
+
+    QWidget *gui;
+	PluginInstanceUI *pluginGUI = m_sampleSourceDevices[index].m_plugin->createSampleSourcePluginInstanceUI(m_sampleSourceDevices[index].m_deviceId, &gui, deviceAPI);
+
+	//	m_sampleSourcePluginGUI = pluginGUI;
+    deviceAPI->setSampleSourceSequence(m_sampleSourceDevices[index].m_deviceSequence);
+    deviceAPI->setHardwareId(m_sampleSourceDevices[index].m_hadrwareId);
+    deviceAPI->setSampleSourceId(m_sampleSourceDevices[index].m_deviceId);
+    deviceAPI->setSampleSourceSerial(m_sampleSourceDevices[index].m_deviceSerial);
+    deviceAPI->setSampleSourcePluginInstanceUI(pluginGUI);
+    deviceAPI->setInputGUI(gui, m_sampleSourceDevices[index].m_displayName);
+
+	return index;
+}
+
+int PluginManager::getSampleSourceIndexBySerialOrSequence(const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence) const
+{
 	int index = -1;
 	int index_matchingSequence = -1;
 	int index_firstOfKind = -1;
@@ -586,7 +618,7 @@ int PluginManager::selectSampleSourceBySerialOrSequence(const QString& sourceId,
 				}
 				else
 				{
-					return -1; // return if no device attached
+					return -1; // no device attached
 				}
 			}
 			else
@@ -600,29 +632,84 @@ int PluginManager::selectSampleSourceBySerialOrSequence(const QString& sourceId,
 		}
 	}
 
-    qDebug() << "PluginManager::selectSampleSourceBySequence: m_sampleSource at index " << index
-            << " hid: " << m_sampleSourceDevices[index].m_hadrwareId.toStdString().c_str()
-            << " id: " << m_sampleSourceDevices[index].m_deviceId.toStdString().c_str()
-            << " ser: " << m_sampleSourceDevices[index].m_deviceSerial.toStdString().c_str()
-            << " seq: " << m_sampleSourceDevices[index].m_deviceSequence;
+	return index;
+}
 
-    deviceAPI->stopAcquisition();
-    deviceAPI->setSampleSourcePluginInstanceUI(0); // this effectively destroys the previous GUI if it exists
+int PluginManager::selectSampleSourceCoreBySerialOrSequence(const QString& sourceId,
+		const QString& sourceSerial,
+		uint32_t sourceSequence,
+		DeviceSourceAPI *deviceAPI,
+		const QTimer& masterTimer)
+{
+	int index = getSampleSourceIndexBySerialOrSequence(sourceId, sourceSerial, sourceSequence);
 
-    QWidget *gui;
-	PluginInstanceUI *pluginGUI = m_sampleSourceDevices[index].m_plugin->createSampleSourcePluginInstanceUI(m_sampleSourceDevices[index].m_deviceId, &gui, deviceAPI);
+	if (index < 0) {
+		return -1;
+	}
 
-	//	m_sampleSourcePluginGUI = pluginGUI;
-    deviceAPI->setSampleSourceSequence(m_sampleSourceDevices[index].m_deviceSequence);
-    deviceAPI->setHardwareId(m_sampleSourceDevices[index].m_hadrwareId);
-    deviceAPI->setSampleSourceId(m_sampleSourceDevices[index].m_deviceId);
-    deviceAPI->setSampleSourceSerial(m_sampleSourceDevices[index].m_deviceSerial);
-    deviceAPI->setSampleSourcePluginInstanceUI(pluginGUI);
-    deviceAPI->setInputGUI(gui, m_sampleSourceDevices[index].m_displayName);
+	return selectSampleSourceCoreByIndex(index, deviceAPI, masterTimer);
+}
+
+int PluginManager::selectSampleSourceCoreByIndex(int index, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer)
+{
+	if ((index < 0) || (index >= m_sampleSourceDevices.count())) {
+		return -1;
+	}
+
+	qDebug() << "PluginManager::selectSampleSourceCoreByIndex: m_sampleSource at index " << index
+			<< " hid: " << m_sampleSourceDevices[index].m_hadrwareId.toStdString().c_str()
+			<< " id: " << m_sampleSourceDevices[index].m_deviceId.toStdString().c_str()
+			<< " ser: " << m_sampleSourceDevices[index].m_deviceSerial.toStdString().c_str()
+			<< " seq: " << m_sampleSourceDevices[index].m_deviceSequence;
+
+	// there is no GUI owning the source: the previous one is deleted here once the engine has let it go.
+	// It goes first since a hardware source opens its device when it is created and it may be the same one.
+	deviceAPI->stopAcquisition();
+	DeviceSampleSource *oldSource = deviceAPI->getSource();
+	QByteArray oldSettings;
+	int oldIndex = -1;
+
+	if (oldSource)
+	{
+		oldSettings = oldSource->serialize();
+		oldIndex = getSampleSourceIndexBySerialOrSequence(deviceAPI->getSampleSourceId(), deviceAPI->getSampleSourceSerial(), deviceAPI->getSampleSourceSequence());
+		deviceAPI->setSource(0);
+		delete oldSource;
+	}
+
+	DeviceSampleSource *source = createSampleSourceCore(index, deviceAPI, masterTimer);
+
+	if (source == 0)
+	{
+		qWarning("PluginManager::selectSampleSourceCoreByIndex: %s cannot run without GUI", qPrintable(m_sampleSourceDevices[index].m_deviceId));
+
+		// put the previous source back as it was
+		if ((oldIndex >= 0) && ((oldSource = createSampleSourceCore(oldIndex, deviceAPI, masterTimer)) != 0))
+		{
+			deviceAPI->setSource(oldSource);
+			oldSource->deserialize(oldSettings);
+		}
+
+		return -1;
+	}
+
+	deviceAPI->setSource(source);
 
 	return index;
 }
 
+DeviceSampleSource *PluginManager::createSampleSourceCore(int index, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer)
+{
+	// set before the creation as with the GUI: hardware sources open their device from these
+	deviceAPI->setSampleSourceSequence(m_sampleSourceDevices[index].m_deviceSequence);
+	deviceAPI->setHardwareId(m_sampleSourceDevices[index].m_hadrwareId);
+	deviceAPI->setSampleSourceId(m_sampleSourceDevices[index].m_deviceId);
+	deviceAPI->setSampleSourceSerial(m_sampleSourceDevices[index].m_deviceSerial);
+
+	return m_sampleSourceDevices[index].m_plugin->createSampleSourcePluginInstanceInput(
+			m_sampleSourceDevices[index].m_deviceId, deviceAPI, masterTimer);
+}
+
 int PluginManager::selectSampleSinkBySerialOrSequence(const QString& sinkId, const QString& sinkSerial, uint32_t sinkSequence, DeviceSinkAPI *deviceAPI)
 {
 	qDebug("PluginManager::selectSampleSinkBySerialOrSequence by sequence: id: %s ser: %s seq: %d", qPrintable(sinkId), qPrintable(sinkSerial), sinkSequence);
@@ -803,6 +890,18 @@ void PluginManager::createRxChannelInstance(int channelPluginIndex, DeviceSource
     }
 }
 
+ChannelSinkAPI *PluginManager::createRxChannelCoreInstance(const QString& channelName, DeviceSourceAPI *deviceAPI)
+{
+    for (PluginAPI::ChannelRegistrations::iterator it = m_rxChannelRegistrations.begin(); it != m_rxChannelRegistrations.end(); ++it)
+    {
+        if (it->m_channelName == channelName) {
+            return it->m_plugin->createRxChannelCore(channelName, deviceAPI);
+        }
+    }
+
+    return 0;
+}
+
 void PluginManager::createTxChannelInstance(int channelPluginIndex, DeviceSinkAPI *deviceAPI)
 {
     if (channelPluginIndex < m_txChannelRegistrations.size())
@@ -16,6 +16,8 @@ class Message;
 class MessageQueue;
 class DeviceSourceAPI;
 class DeviceSinkAPI;
+class ChannelSinkAPI;
+class QTimer;
 
 class SDRANGEL_API PluginManager : public QObject {
 	Q_OBJECT
@@ -36,6 +38,31 @@ public:
 
 	typedef QList<Plugin> Plugins;
 
+	struct SamplingDevice {
+		PluginInterface* m_plugin;
+		QString m_displayName;
+		QString m_hadrwareId;
+		QString m_deviceId;
+		QString m_deviceSerial;
+		uint32_t m_deviceSequence;
+
+		SamplingDevice(PluginInterface* plugin,
+				const QString& displayName,
+				const QString& hadrwareId,
+				const QString& deviceId,
+				const QString& deviceSerial,
+				int deviceSequence) :
+			m_plugin(plugin),
+			m_displayName(displayName),
+			m_hadrwareId(hadrwareId),
+			m_deviceId(deviceId),
+			m_deviceSerial(deviceSerial),
+			m_deviceSequence(deviceSequence)
+		{ }
+	};
+
+	typedef QList<SamplingDevice> SamplingDevices;
+
 	explicit PluginManager(MainWindow* mainWindow, QObject* parent = NULL);
 	~PluginManager();
 
@@ -52,6 +79,7 @@ public:
 	PluginAPI::ChannelRegistrations *getTxChannelRegistrations() { return &m_txChannelRegistrations; }
 
 	void updateSampleSourceDevices();
+	const SamplingDevices& getSampleSourceDevices() const { return m_sampleSourceDevices; }
 	void duplicateLocalSampleSourceDevices(uint deviceUID);
 	void fillSampleSourceSelector(QComboBox* comboBox, uint deviceUID);
 	int getSampleSourceSelectorIndex(QComboBox* comboBox, DeviceSourceAPI *deviceSourceAPI);
@@ -66,6 +94,11 @@ public:
 	int selectSampleSourceBySerialOrSequence(const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence, DeviceSourceAPI *deviceAPI);
 	void selectSampleSourceByDevice(void *devicePtr, DeviceSourceAPI *deviceAPI);
 
+	// sources and Rx channels without their GUI (headless server)
+	int selectSampleSourceCoreByIndex(int index, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer);
+	int selectSampleSourceCoreBySerialOrSequence(const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer);
+	ChannelSinkAPI *createRxChannelCoreInstance(const QString& channelName, DeviceSourceAPI *deviceAPI);
+
 	int selectSampleSinkByIndex(int index, DeviceSinkAPI *deviceAPI);
 	int selectFirstSampleSink(const QString& sourceId, DeviceSinkAPI *deviceAPI);
 	int selectSampleSinkBySerialOrSequence(const QString& sinkId, const QString& sinkSerial, uint32_t sinkSequence, DeviceSinkAPI *deviceAPI);
@@ -89,31 +122,6 @@ private:
 
 	typedef QList<SamplingDeviceRegistration> SamplingDeviceRegistrations;
 
-	struct SamplingDevice {
-		PluginInterface* m_plugin;
-		QString m_displayName;
-		QString m_hadrwareId;
-		QString m_deviceId;
-		QString m_deviceSerial;
-		uint32_t m_deviceSequence;
-
-		SamplingDevice(PluginInterface* plugin,
-				const QString& displayName,
-				const QString& hadrwareId,
-				const QString& deviceId,
-				const QString& deviceSerial,
-				int deviceSequence) :
-			m_plugin(plugin),
-			m_displayName(displayName),
-			m_hadrwareId(hadrwareId),
-			m_deviceId(deviceId),
-			m_deviceSerial(deviceSerial),
-			m_deviceSequence(deviceSequence)
-		{ }
-	};
-
-	typedef QList<SamplingDevice> SamplingDevices;
-
 	PluginAPI m_pluginAPI;
 	Plugins m_plugins;
 
@@ -137,6 +145,8 @@ private:
     static const QString m_fileSinkDeviceTypeID;      //!< FileSink sink plugin ID
 
 	void loadPlugins(const QDir& dir);
+	int getSampleSourceIndexBySerialOrSequence(const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence) const;
+	DeviceSampleSource *createSampleSourceCore(int index, DeviceSourceAPI *deviceAPI, const QTimer& masterTimer);
 
 	friend class MainWindow;
 };
@@ -43,9 +43,39 @@ win32 {
         dsp/dvserialworker.cpp
 }
 
+# The AVX2 and NEON kernels need their instruction set flag on that file only like the COMPILE_FLAGS
+# source property of the CMake build. On other architectures they only provide the null kernel getters.
+SIMD_AVX2_SOURCES = dsp/decimatorssimd_avx2.cpp dsp/interpolator_avx2.cpp
+SIMD_NEON_SOURCES = dsp/decimatorssimd_neon.cpp dsp/interpolator_neon.cpp
+
+contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386) {
+    simd_avx2.name = AVX2 ${QMAKE_FILE_IN}
+    simd_avx2.input = SIMD_AVX2_SOURCES
+    simd_avx2.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_BASE}$${first(QMAKE_EXT_OBJ)}
+    simd_avx2.commands = $$QMAKE_CXX -c $(CXXFLAGS) -mavx2 $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+    simd_avx2.dependency_type = TYPE_C
+    simd_avx2.variable_out = OBJECTS
+    QMAKE_EXTRA_COMPILERS += simd_avx2
+} else {
+    SOURCES += $$SIMD_AVX2_SOURCES
+}
+
+contains(QT_ARCH, arm) {
+    simd_neon.name = NEON ${QMAKE_FILE_IN}
+    simd_neon.input = SIMD_NEON_SOURCES
+    simd_neon.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_BASE}$${first(QMAKE_EXT_OBJ)}
+    simd_neon.commands = $$QMAKE_CXX -c $(CXXFLAGS) -mfpu=neon $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+    simd_neon.dependency_type = TYPE_C
+    simd_neon.variable_out = OBJECTS
+    QMAKE_EXTRA_COMPILERS += simd_neon
+} else {
+    SOURCES += $$SIMD_NEON_SOURCES # arm64 has NEON without flag
+}
+
 SOURCES += mainwindow.cpp\
         audio/audiodeviceinfo.cpp\
         audio/audiofifo.cpp\
+        audio/audiomixer.cpp\
         audio/audiooutput.cpp\
         audio/audioinput.cpp\
         device/devicesourceapi.cpp\
@@ -57,26 +87,39 @@ SOURCES += mainwindow.cpp\
         dsp/channelmarker.cpp\
         dsp/ctcssdetector.cpp\
         dsp/cwkeyer.cpp\
+        dsp/decimatorssimd.cpp\
+        dsp/decimatorssimd_sse41.cpp\
         dsp/dspcommands.cpp\
         dsp/dspengine.cpp\
+        dsp/dspmetrics.cpp\
         dsp/dspdevicesourceengine.cpp\
         dsp/dspdevicesinkengine.cpp\
         dsp/fftengine.cpp\
+        dsp/fftwisdom.cpp\
         dsp/kissengine.cpp\
         dsp/fftfilt.cxx\
         dsp/fftwindow.cpp\
         dsp/filterrc.cpp\
         dsp/filtermbe.cpp\
         dsp/filerecord.cpp\
+        dsp/filerecordwriter.cpp\
+        dsp/samplecodec.cpp\
+        dsp/samplepacker.cpp\
+        dsp/sigmfmeta.cpp\
         dsp/interpolator.cpp\
         dsp/hbfiltertraits.cpp\
         dsp/lowpass.cpp\
         dsp/nco.cpp\
         dsp/ncof.cpp\
+        dsp/ncomixer.cpp\
+        dsp/overlapsavefilter.cpp\
         dsp/pidcontroller.cpp\
         dsp/phaselock.cpp\
+        dsp/polyphasefilterbank.cpp\
         dsp/recursivefilters.cpp\
+        dsp/samplemixer.cpp\
         dsp/samplesinkfifo.cpp\
+        dsp/samplesinkbroadcastfifo.cpp\
         dsp/samplesourcefifo.cpp\
         dsp/samplesinkfifodoublebuffered.cpp\
         dsp/basebandsamplesink.cpp\
@@ -110,6 +153,7 @@ SOURCES += mainwindow.cpp\
         gui/indicator.cpp\
         gui/levelmeter.cpp\
         gui/pluginsdialog.cpp\
+        gui/metricsdialog.cpp\
         gui/audiodialog.cpp\
         gui/presetitem.cpp\
         gui/rollupwidget.cpp\
@@ -129,7 +173,9 @@ SOURCES += mainwindow.cpp\
         settings/mainsettings.cpp\
         util/CRC64.cpp\
         util/db.cpp\
+        util/jobpool.cpp\
         util/message.cpp\
+        util/messagepool.cpp\
         util/messagequeue.cpp\
         util/prettyprint.cpp\
         util/syncmessenger.cpp\
@@ -139,8 +185,10 @@ SOURCES += mainwindow.cpp\
 HEADERS  += mainwindow.h\
         audio/audiodeviceinfo.h\
         audio/audiofifo.h\
+        audio/audiomixer.h\
         audio/audiooutput.h\
         audio/audioinput.h\
+        channel/channelsinkapi.h\
         device/devicesourceapi.h\
         device/devicesinkapi.h\
         dsp/afsquelch.h\
@@ -150,19 +198,26 @@ HEADERS  += mainwindow.h\
         dsp/cwkeyer.h\
         dsp/complex.h\
         dsp/decimators.h\
+        dsp/decimatorssimd.h\
         dsp/interpolators.h\
         dsp/dspcommands.h\
         dsp/dspengine.h\
+        dsp/dspmetrics.h\
         dsp/dspdevicesourceengine.h\
         dsp/dspdevicesinkengine.h\
         dsp/dsptypes.h\
         dsp/fftengine.h\
+        dsp/fftwisdom.h\
         dsp/fftfilt.h\
         dsp/fftwengine.h\
         dsp/fftwindow.h\
         dsp/filterrc.h\
         dsp/filtermbe.h\
         dsp/filerecord.h\
+        dsp/filerecordwriter.h\
+        dsp/samplecodec.h\
+        dsp/samplepacker.h\
+        dsp/sigmfmeta.h\
         dsp/gfft.h\
         dsp/hbfiltertraits.h\
         dsp/interpolator.h\
@@ -179,11 +234,16 @@ HEADERS  += mainwindow.h\
         dsp/movingaverage.h\
         dsp/nco.h\
         dsp/ncof.h\
+        dsp/ncomixer.h\
+        dsp/overlapsavefilter.h\
         dsp/phasediscri.h\
         dsp/phaselock.h\
         dsp/pidcontroller.h\
+        dsp/polyphasefilterbank.h\
         dsp/recursivefilters.h\
+        dsp/samplemixer.h\
         dsp/samplesinkfifo.h\
+        dsp/samplesinkbroadcastfifo.h\
         dsp/samplesourcefifo.h\
         dsp/samplesinkfifodoublebuffered.h\
         dsp/samplesinkfifodecimator.h\
@@ -195,6 +255,7 @@ HEADERS  += mainwindow.h\
         dsp/scopevis.h\
         dsp/scopevisng.h\
         dsp/spectrumvis.h\
+        dsp/glspectruminterface.h\
         dsp/threadedbasebandsamplesink.h\
         dsp/threadedbasebandsamplesource.h\
         dsp/wfir.h\
@@ -220,6 +281,7 @@ HEADERS  += mainwindow.h\
         gui/levelmeter.h\
         gui/physicalunit.h\
         gui/pluginsdialog.h\
+        gui/metricsdialog.h\
         gui/presetitem.h\
         gui/rollupwidget.h\
         gui/samplingdevicecontrol.h\
@@ -239,8 +301,10 @@ HEADERS  += mainwindow.h\
         settings/mainsettings.h\
         util/CRC64.h\
         util/db.h\
+        util/jobpool.h\
         util/export.h\
         util/message.h\
+        util/messagepool.h\
         util/messagequeue.h\
         util/prettyprint.h\
         util/syncmessenger.h\
@@ -258,6 +322,7 @@ FORMS    += mainwindow.ui\
         gui/glscopenggui.ui\
         gui/aboutdialog.ui\
         gui/pluginsdialog.ui\
+        gui/metricsdialog.ui\
         gui/samplingdevicecontrol.ui\
         gui/myposdialog.ui\
         gui/glspectrumgui.ui\
@@ -1,5 +1,6 @@
 #include <QSettings>
 #include <QStringList>
+#include <QFileInfo>
 
 #include "settings/mainsettings.h"
 
@@ -82,6 +83,12 @@ void MainSettings::save() const
 	}
 }
 
+QString MainSettings::getFFTWisdomFileName()
+{
+	QSettings s;
+	return QFileInfo(s.fileName()).absolutePath() + "/fftw-wisdom";
+}
+
 void MainSettings::resetToDefaults()
 {
 	m_preferences.resetToDefaults();
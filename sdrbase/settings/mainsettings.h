@@ -16,6 +16,8 @@ public:
 
 	void resetToDefaults();
 
+	static QString getFFTWisdomFileName(); //!< FFT engine wisdom stored next to the settings file
+
 	Preset* newPreset(const QString& group, const QString& description);
 	void deletePreset(const Preset* preset);
 	int getPresetCount() const { return m_presets.count(); }
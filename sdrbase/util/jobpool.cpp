@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include "util/jobpool.h"
+
+JobPool::JobPool(int nbWorkers) :
+	m_stop(false)
+{
+	if (nbWorkers <= 0)
+	{
+		nbWorkers = QThread::idealThreadCount() - 1;
+		nbWorkers = nbWorkers < 1 ? 1 : nbWorkers;
+	}
+
+	for (int i = 0; i < nbWorkers; i++)
+	{
+		m_workers.push_back(new Worker(this, i));
+		m_workers.back()->start();
+	}
+}
+
+JobPool::~JobPool()
+{
+	m_mutex.lock();
+	m_stop = true;
+	m_jobAvailable.wakeAll();
+	m_mutex.unlock();
+
+	for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+	{
+		(*it)->wait();
+		delete *it;
+	}
+}
+
+void JobPool::push(Job* job)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_jobs.push_back(job);
+	m_jobAvailable.wakeOne();
+}
+
+JobPool::Job* JobPool::waitJob()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	while (m_jobs.empty() && !m_stop) {
+		m_jobAvailable.wait(&m_mutex);
+	}
+
+	if (m_stop) {
+		return 0;
+	}
+
+	Job* job = m_jobs.front();
+	m_jobs.pop_front();
+	return job;
+}
+
+void JobPool::Worker::run()
+{
+	Job* job;
+
+	while ((job = m_pool->waitJob()) != 0) {
+		job->run(m_index);
+	}
+}
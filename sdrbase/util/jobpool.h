@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_JOBPOOL_H
+#define INCLUDE_JOBPOOL_H
+
+#include <deque>
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "util/export.h"
+
+/**
+ * Fixed set of worker threads running jobs from a common FIFO. Jobs are owned by the caller and
+ * are usually allocated once per buffer slot so that nothing is allocated while streaming. The
+ * worker index is given to the job so that it can use per worker resources (e.g. a codec
+ * instance) without locking. Completion and ordering of the results are left to the caller.
+ * Jobs still queued when the pool is destroyed are not run.
+ */
+class SDRANGEL_API JobPool {
+public:
+	class Job {
+	public:
+		virtual ~Job() {}
+		virtual void run(int workerIndex) = 0;
+	};
+
+	/** nbWorkers <= 0 uses one worker per core minus one for the caller thread and at least one */
+	JobPool(int nbWorkers = 0);
+	~JobPool();
+
+	void push(Job* job); //!< Run job on the next available worker
+	int getNbWorkers() const { return m_workers.size(); }
+
+private:
+	class Worker : public QThread {
+	public:
+		Worker(JobPool* pool, int index) : m_pool(pool), m_index(index) {}
+
+	private:
+		JobPool* m_pool;
+		int m_index;
+
+		void run();
+	};
+
+	QMutex m_mutex;
+	QWaitCondition m_jobAvailable;
+	std::deque<Job*> m_jobs;
+	bool m_stop;
+	std::vector<Worker*> m_workers;
+
+	Job* waitJob(); //!< Next job or 0 when the pool is stopped
+};
+
+#endif // INCLUDE_JOBPOOL_H
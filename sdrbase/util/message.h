@@ -19,8 +19,12 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <QAtomicPointer>
+#include "util/messagepool.h"
 #include "util/export.h"
 
+class MessageQueue;
+
 class SDRANGEL_API Message {
 public:
 	Message();
@@ -37,6 +41,10 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	friend class MessageQueue;
+	QAtomicPointer<Message> m_queueNext; //!< link to the next message while in a MessageQueue
 };
 
 #define MESSAGE_CLASS_DECLARATION \
@@ -56,4 +64,23 @@ protected:
 	} \
 	bool Name::match(const Message& message) { return message.matchIdentifier(m_identifier); }
 
+/**
+ * Same as MESSAGE_CLASS_DECLARATION for messages sent at a high rate (e.g. periodic reports to the GUI).
+ * Instances are allocated from a per class MessagePool so they are still created with new and deleted
+ * with delete by the receiver.
+ */
+#define MESSAGE_CLASS_POOLED_DECLARATION \
+	MESSAGE_CLASS_DECLARATION \
+	public: \
+		static void* operator new(std::size_t size); \
+		static void operator delete(void* block, std::size_t size); \
+	private: \
+		static MessagePool& getPool();
+
+#define MESSAGE_CLASS_POOLED_DEFINITION(Name, BaseClass) \
+	MESSAGE_CLASS_DEFINITION(Name, BaseClass) \
+	MessagePool& Name::getPool() { static MessagePool *pool = new MessagePool(sizeof(Name)); return *pool; } \
+	void* Name::operator new(std::size_t size) { return getPool().allocate(size); } \
+	void Name::operator delete(void* block, std::size_t size) { getPool().release(block, size); }
+
 #endif // INCLUDE_MESSAGE_H
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include "util/messagepool.h"
+
+MessagePool::MessagePool(std::size_t blockSize, int capacity) :
+	m_free(0),
+	m_nbFree(0),
+	m_blockSize(blockSize < sizeof(Block) ? sizeof(Block) : blockSize),
+	m_capacity(capacity)
+{
+}
+
+void* MessagePool::allocate(std::size_t size)
+{
+	if (size <= m_blockSize)
+	{
+		Block* block;
+
+		m_lock.lock();
+		block = m_free;
+
+		if (block)
+		{
+			m_free = block->m_next;
+			m_nbFree--;
+		}
+
+		m_lock.unlock();
+
+		if (block) {
+			return block;
+		}
+
+		return ::operator new(m_blockSize);
+	}
+	else
+	{
+		return ::operator new(size);
+	}
+}
+
+void MessagePool::release(void* block, std::size_t size)
+{
+	if (block == 0) {
+		return;
+	}
+
+	if (size <= m_blockSize)
+	{
+		bool kept = false;
+
+		m_lock.lock();
+
+		if (m_nbFree < m_capacity)
+		{
+			Block* b = static_cast<Block*>(block);
+			b->m_next = m_free;
+			m_free = b;
+			m_nbFree++;
+			kept = true;
+		}
+
+		m_lock.unlock();
+
+		if (kept) {
+			return;
+		}
+	}
+
+	::operator delete(block);
+}
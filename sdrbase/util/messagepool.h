@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_MESSAGEPOOL_H
+#define INCLUDE_MESSAGEPOOL_H
+
+#include <cstddef>
+#include "util/spinlock.h"
+#include "util/export.h"
+
+#define MESSAGEPOOL_CAPACITY 64 //!< maximum number of free blocks kept by a pool
+
+/**
+ * Free list of memory blocks of one message class. It backs the class operator new and delete
+ * declared with MESSAGE_CLASS_POOLED_DECLARATION so that messages sent at a high rate are
+ * recycled instead of going through the heap allocator each time. Messages are usually created
+ * in one thread and deleted in another so the list is protected by a spinlock that is only held
+ * to link or unlink one block.
+ */
+class SDRANGEL_API MessagePool {
+public:
+	MessagePool(std::size_t blockSize, int capacity = MESSAGEPOOL_CAPACITY);
+
+	void* allocate(std::size_t size); //!< Block from the free list or from the heap if empty or size does not match
+	void release(void* block, std::size_t size); //!< Back to the free list or to the heap if full or size does not match
+
+	int getNbFree() const { return m_nbFree; }
+
+private:
+	struct Block {
+		Block* m_next;
+	};
+
+	Spinlock m_lock;
+	Block* m_free;
+	int m_nbFree;
+	std::size_t m_blockSize; //!< size of the pooled class. Derived classes have other sizes and use the heap.
+	int m_capacity;
+};
+
+#endif // INCLUDE_MESSAGEPOOL_H
@@ -16,14 +16,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDebug>
-#include <QMutexLocker>
 #include "util/messagequeue.h"
 #include "util/message.h"
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -42,9 +42,8 @@ void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddOrdered(1); // counted first so that the consumer never sees a negative size
+		link(message);
 	}
 
 	if (emitSignal)
@@ -55,27 +54,68 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	m_consumerLock.lock();
+	Message* message = unlink();
+	m_consumerLock.unlock();
 
-	if (m_queue.isEmpty())
-	{
-		return 0;
-	}
-	else
-	{
-		return m_queue.takeFirst();
+	if (message) {
+		m_size.fetchAndAddOrdered(-1);
 	}
+
+	return message;
 }
 
-int MessageQueue::size()
+void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
 
-	return m_queue.size();
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
 
-void MessageQueue::clear()
+void MessageQueue::link(Message* message)
+{
+	message->m_queueNext.store(0);
+	Message* prev = m_head.fetchAndStoreOrdered(message);
+	prev->m_queueNext.storeRelease(message); // between the exchange and here the list is cut after prev
+}
+
+Message* MessageQueue::unlink()
 {
-	QMutexLocker locker(&m_lock);
-	m_queue.clear();
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
+
+	if (tail == &m_stub) // skip the stub
+	{
+		if (next == 0) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
+	}
+
+	if (next)
+	{
+		m_tail = next;
+		return tail;
+	}
+
+	if (tail != m_head.loadAcquire()) {
+		return 0; // a producer has not linked its message yet. It will signal when done.
+	}
+
+	// tail is the last message: put the stub back behind it so that it can be unlinked
+	link(&m_stub);
+	next = tail->m_queueNext.loadAcquire();
+
+	if (next)
+	{
+		m_tail = next;
+		return tail;
+	}
+
+	return 0;
 }
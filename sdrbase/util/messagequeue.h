@@ -19,12 +19,18 @@
 #define INCLUDE_MESSAGEQUEUE_H
 
 #include <QObject>
-#include <QQueue>
-#include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include "util/message.h"
+#include "util/spinlock.h"
 #include "util/export.h"
 
-class Message;
-
+/**
+ * Multiple producers single consumer queue of messages. Messages are linked through the intrusive
+ * Message::m_queueNext pointer so push is lock free and does not allocate. Consumers (pop and clear)
+ * are serialized by a spinlock that is never contended when the queue is consumed by a single thread
+ * as intended. isEmpty and size only read an atomic counter and can be polled in the sample loops.
+ */
 class SDRANGEL_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -35,15 +41,22 @@ public:
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
 	Message* pop(); //!< Pop message from queue
 
-	int size(); //!< Returns queue size
-	void clear(); //!< Empty queue
+	int size() const { return m_size.loadAcquire(); } //!< Returns queue size
+	bool isEmpty() const { return m_size.loadAcquire() == 0; } //!< Lock free check for the sample processing loops
+	void clear(); //!< Empty queue and delete the messages
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< last pushed message. Producers swap it.
+	Message* m_tail;                //!< next message to pop. Only used by the consumer.
+	Message m_stub;                 //!< placeholder that keeps the list non empty
+	QAtomicInt m_size;
+	Spinlock m_consumerLock;
+
+	void link(Message* message);
+	Message* unlink();
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
@@ -0,0 +1,767 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdlib.h>
+#include <cstring>
+
+#include <QDateTime>
+#include <QStringList>
+#include <QDebug>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/dspcommands.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/filerecord.h"
+#include "dsp/nco.h"
+#include "audio/audiofifo.h"
+#include "dsp/dspengine.h"
+#include "nfmdemod.h"
+#include "nfmdemodsettings.h"
+#include "amdemod.h"
+#include "amdemodsettings.h"
+#include "ssbdemod.h"
+#include "ssbdemodsettings.h"
+#include "wfmdemod.h"
+#include "wfmdemodsettings.h"
+#include "bfmdemod.h"
+#include "bfmdemodsettings.h"
+#include "rdsparser.h"
+#include "lorademod.h"
+#include "lorademodsettings.h"
+
+#include "batchchannel.h"
+
+namespace {
+
+int nearestIndex(int value, const int *table, int nbEntries)
+{
+    int best = 0;
+
+    for (int i = 1; i < nbEntries; i++)
+    {
+        if (abs(table[i] - value) < abs(table[best] - value)) {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+/** Channel rate of the wide FM GUIs */
+int requiredBW(int rfBW)
+{
+    if (rfBW <= 48000) {
+        return 48000;
+    } else {
+        return (3*rfBW)/2;
+    }
+}
+
+/**
+ * Writes the channel I/Q to a .sdriq file. The channelizer output is still offset by the part of the
+ * channel frequency its half band stages cannot take so the remaining shift is done here like the
+ * demodulators do.
+ */
+class BatchIQSink : public BasebandSampleSink
+{
+public:
+    BatchIQSink(QFile& file, quint64 centerFrequency, std::time_t startTimeStamp) :
+        m_file(file),
+        m_sampleRate(0),
+        m_headerWritten(false)
+    {
+        m_header.sampleRate = 0;
+        m_header.centerFrequency = centerFrequency;
+        m_header.startTimeStamp = startTimeStamp;
+    }
+
+    virtual void start() {}
+    virtual void stop() {}
+
+    virtual bool handleMessage(const Message& cmd)
+    {
+        if (DownChannelizer::MsgChannelizerNotification::match(cmd))
+        {
+            DownChannelizer::MsgChannelizerNotification& notif = (DownChannelizer::MsgChannelizerNotification&) cmd;
+            m_sampleRate = notif.getSampleRate();
+            m_nco.setFreq(-notif.getFrequencyOffset(), m_sampleRate);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+    {
+        (void) positiveOnly;
+
+        if (!m_headerWritten)
+        {
+            m_header.sampleRate = m_sampleRate;
+            FileRecord::writeHeader(m_file, m_header);
+            m_headerWritten = true;
+        }
+
+        m_nco.mixIQ(begin, end, m_mixed);
+        std::size_t nbSamples = end - begin;
+        m_samples.resize(nbSamples);
+
+        for (std::size_t i = 0; i < nbSamples; i++) {
+            m_samples[i] = Sample(m_mixed[i].real(), m_mixed[i].imag());
+        }
+
+        m_file.write((const char *) &m_samples[0], nbSamples * sizeof(Sample));
+    }
+
+private:
+    QFile& m_file;
+    FileRecord::Header m_header;
+    int m_sampleRate;
+    bool m_headerWritten;
+    NCO m_nco;
+    std::vector<Complex> m_mixed;
+    SampleVector m_samples;
+};
+
+} // namespace
+
+BatchChannel::Settings::Settings()
+{
+    resetToDefaults(ModeNFM);
+}
+
+void BatchChannel::Settings::resetToDefaults(Mode mode)
+{
+    m_mode = mode;
+    m_frequencyOffset = 0;
+    m_rfBandwidth = 12500;
+    m_afBandwidth = 3000;
+    m_fmDeviation = 2000;
+    m_volume = 2.0;
+    m_squelch = -40.0;
+    m_squelchGate = 5;
+    m_deltaSquelch = false;
+    m_spanLog2 = 3;
+    m_audioBinaural = false;
+    m_audioFlipChannels = false;
+    m_dsb = false;
+    m_agc = false;
+    m_agcClamping = false;
+    m_agcTimeLog2 = 7;
+    m_agcPowerThreshold = -40;
+    m_agcThresholdGate = 4;
+    m_bandpassEnable = false;
+    m_audioStereo = false;
+    m_lsbStereo = false;
+
+    switch (mode)
+    {
+    case ModeAM:
+        m_rfBandwidth = 5000;
+        break;
+    case ModeSSB:
+        m_rfBandwidth = 3000;
+        m_afBandwidth = 300;
+        m_volume = 3.0;
+        break;
+    case ModeWFM:
+        m_rfBandwidth = WFMDemodSettings::m_rfBW[WFMDemodSettings().m_rfBandwidthIndex];
+        break;
+    case ModeBFM:
+        m_rfBandwidth = BFMDemodSettings::m_rfBW[BFMDemodSettings().m_rfBandwidthIndex];
+        break;
+    case ModeLoRa:
+        m_rfBandwidth = LoRaDemodSettings::m_bandwidths[LoRaDemodSettings().m_bandwidthIndex];
+        break;
+    case ModeIQ:
+        m_rfBandwidth = 48000;
+        break;
+    default:
+        break;
+    }
+}
+
+bool BatchChannel::Settings::fromString(const QString& channel)
+{
+    QStringList fields = channel.split(':');
+    bool ok = true;
+
+    if ((fields.size() < 2) || (fields.size() > 3)) {
+        return false;
+    }
+
+    QString modeName = fields[0].toLower();
+    bool lsb = false;
+
+    if (modeName == "nfm") {
+        resetToDefaults(ModeNFM);
+    } else if (modeName == "am") {
+        resetToDefaults(ModeAM);
+    } else if (modeName == "usb") {
+        resetToDefaults(ModeSSB);
+    } else if (modeName == "lsb") {
+        resetToDefaults(ModeSSB);
+        lsb = true;
+    } else if (modeName == "wfm") {
+        resetToDefaults(ModeWFM);
+    } else if (modeName == "bfm") {
+        resetToDefaults(ModeBFM);
+    } else if (modeName == "lora") {
+        resetToDefaults(ModeLoRa);
+    } else if (modeName == "iq") {
+        resetToDefaults(ModeIQ);
+    } else {
+        return false;
+    }
+
+    m_frequencyOffset = fields[1].toLongLong(&ok);
+
+    if (ok && (fields.size() == 3))
+    {
+        int bandwidth = fields[2].toInt(&ok);
+
+        if (!ok || (bandwidth <= 0)) {
+            return false;
+        }
+
+        if (m_mode == ModeNFM)
+        {
+            int index = nearestIndex(bandwidth, NFMDemodSettings::m_rfBW, NFMDemodSettings::m_nbRfBW);
+            m_rfBandwidth = NFMDemodSettings::m_rfBW[index];
+            m_fmDeviation = NFMDemodSettings::m_fmDev[index];
+        }
+        else if (m_mode == ModeLoRa)
+        {
+            m_rfBandwidth = LoRaDemodSettings::m_bandwidths[nearestIndex(bandwidth, LoRaDemodSettings::m_bandwidths, LoRaDemodSettings::m_nbBandwidths)];
+        }
+        else
+        {
+            m_rfBandwidth = bandwidth;
+        }
+    }
+
+    if (lsb) {
+        m_rfBandwidth = -m_rfBandwidth;
+    }
+
+    return ok;
+}
+
+bool BatchChannel::Settings::fromPreset(const QString& channelId, const QByteArray& data)
+{
+    // the conversions are the ones of the applySettings method of each GUI
+    if (channelId == "de.maintech.sdrangelove.channel.nfm")
+    {
+        NFMDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeNFM);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = NFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex];
+        m_fmDeviation = NFMDemodSettings::m_fmDev[settings.m_rfBandwidthIndex];
+        m_afBandwidth = settings.m_afBandwidth * 1000;
+        m_volume = settings.m_volume / 10.0;
+        m_squelch = settings.m_squelch;
+        m_squelchGate = settings.m_squelchGate;
+        m_deltaSquelch = settings.m_deltaSquelch;
+    }
+    else if (channelId == "de.maintech.sdrangelove.channel.am")
+    {
+        AMDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeAM);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = settings.m_rfBandwidth * 100;
+        m_volume = settings.m_volume / 10.0;
+        m_squelch = settings.m_squelch;
+        m_bandpassEnable = settings.m_bandpassEnable;
+    }
+    else if (channelId == "de.maintech.sdrangelove.channel.ssb")
+    {
+        SSBDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeSSB);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = settings.m_rfBandwidth * 100;
+        m_volume = settings.m_volume / 10.0;
+        m_afBandwidth = settings.m_lowCutoff * 100;
+        m_spanLog2 = settings.m_spanLog2 < 1 ? 1 : settings.m_spanLog2 > 5 ? 5 : settings.m_spanLog2;
+        m_audioBinaural = settings.m_audioBinaural;
+        m_audioFlipChannels = settings.m_audioFlipChannels;
+        m_dsb = settings.m_dsb;
+        m_agc = settings.m_agc;
+        m_agcTimeLog2 = settings.m_agcTimeLog2;
+        m_agcPowerThreshold = settings.m_agcPowerThreshold;
+        m_agcThresholdGate = settings.m_agcThresholdGate;
+        m_agcClamping = settings.m_agcClamping;
+    }
+    else if (channelId == "de.maintech.sdrangelove.channel.wfm")
+    {
+        WFMDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeWFM);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = WFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex];
+        m_afBandwidth = settings.m_afBandwidth * 1000;
+        m_volume = settings.m_volume / 10.0;
+        m_squelch = settings.m_squelch;
+    }
+    else if (channelId == "sdrangel.channel.bfm")
+    {
+        BFMDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeBFM);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = BFMDemodSettings::m_rfBW[settings.m_rfBandwidthIndex];
+        m_afBandwidth = settings.m_afBandwidth * 1000;
+        m_volume = settings.m_volume / 10.0;
+        m_squelch = settings.m_squelch;
+        m_audioStereo = settings.m_audioStereo;
+        m_lsbStereo = settings.m_lsbStereo;
+    }
+    else if (channelId == "de.maintech.sdrangelove.channel.lora")
+    {
+        LoRaDemodSettings settings;
+
+        if (!settings.deserialize(data)) {
+            return false;
+        }
+
+        resetToDefaults(ModeLoRa);
+        m_frequencyOffset = settings.m_inputFrequencyOffset;
+        m_rfBandwidth = LoRaDemodSettings::m_bandwidths[settings.m_bandwidthIndex];
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+int BatchChannel::Settings::getChannelSampleRate() const
+{
+    switch (m_mode)
+    {
+    case ModeWFM:
+    case ModeBFM:
+        return requiredBW(m_rfBandwidth);
+    case ModeLoRa:
+    case ModeIQ:
+        return m_rfBandwidth;
+    default:
+        return 48000;
+    }
+}
+
+const char *BatchChannel::Settings::getModeName() const
+{
+    switch (m_mode)
+    {
+    case ModeNFM:
+        return "nfm";
+    case ModeAM:
+        return "am";
+    case ModeSSB:
+        return m_dsb ? "dsb" : m_rfBandwidth < 0 ? "lsb" : "usb";
+    case ModeWFM:
+        return "wfm";
+    case ModeBFM:
+        return "bfm";
+    case ModeLoRa:
+        return "lora";
+    default:
+        return "iq";
+    }
+}
+
+BatchChannel::BatchChannel(const Settings& settings, int inputSampleRate, quint64 centerFrequency, std::time_t startTimeStamp, const QString& outputBaseName) :
+    m_settings(settings),
+    m_inputSampleRate(inputSampleRate),
+    m_startTimeStamp(startTimeStamp),
+    m_sampleCount(0),
+    m_channelFrequency(centerFrequency + settings.m_frequencyOffset),
+    m_timeReferenceMs(startTimeStamp * 1000LL),
+    m_timeReferenceSample(0),
+    m_open(false),
+    m_channelizer(0),
+    m_sink(0),
+    m_audioFifo(0),
+    m_rdsParser(0),
+    m_audioBytes(0),
+    m_textFile(0),
+    m_rdsProgramIdentification(0)
+{
+    createSink(outputBaseName, centerFrequency + m_settings.m_frequencyOffset);
+
+    if (!m_open) {
+        return;
+    }
+
+    m_channelizer = new DownChannelizer(m_sink);
+    DSPSignalNotification notif(m_inputSampleRate, 0);
+    m_channelizer->handleMessage(notif);
+    DSPConfigureChannelizer conf(m_settings.getChannelSampleRate(), m_settings.m_frequencyOffset);
+    m_channelizer->handleMessage(conf);
+    dispatchMessages();
+    m_channelizer->start();
+
+    if (m_audioFifo)
+    {
+        m_audioBuffer.resize(m_audioFifo->size());
+        m_audioFifo->resetCounters();
+        writeWavHeader(); // placeholder completed by finish()
+    }
+}
+
+BatchChannel::~BatchChannel()
+{
+    finish();
+
+    if (m_channelizer)
+    {
+        m_channelizer->stop();
+        delete m_channelizer;
+    }
+
+    delete m_sink;
+    delete m_rdsParser;
+}
+
+void BatchChannel::createSink(const QString& outputBaseName, quint64 centerFrequency)
+{
+    bool textOutput = (m_settings.m_mode == ModeBFM) || (m_settings.m_mode == ModeLoRa);
+    m_outputFileName = outputBaseName + (m_settings.m_mode == ModeLoRa ? ".txt" : m_settings.m_mode == ModeIQ ? ".sdriq" : ".wav");
+
+    if (m_settings.m_mode != ModeLoRa)
+    {
+        m_outputFile.setFileName(m_outputFileName);
+
+        if (!m_outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCritical("BatchChannel::createSink: cannot open %s: %s", qPrintable(m_outputFileName), qPrintable(m_outputFile.errorString()));
+            return;
+        }
+    }
+
+    if (textOutput)
+    {
+        QString textFileName = m_settings.m_mode == ModeLoRa ? m_outputFileName : outputBaseName + "_rds.txt";
+        m_textFile = fopen(qPrintable(textFileName), "w");
+
+        if (m_textFile == 0)
+        {
+            qCritical("BatchChannel::createSink: cannot open %s", qPrintable(textFileName));
+            return;
+        }
+    }
+
+    // channels never mute or copy to UDP in batch. CTCSS tones are not reported.
+    switch (m_settings.m_mode)
+    {
+    case ModeNFM:
+    {
+        NFMDemod *nfmDemod = new NFMDemod();
+        nfmDemod->configure(&m_messageQueue,
+                m_settings.m_rfBandwidth,
+                m_settings.m_afBandwidth,
+                m_settings.m_fmDeviation,
+                m_settings.m_volume,
+                m_settings.m_squelchGate,
+                m_settings.m_deltaSquelch,
+                m_settings.m_squelch,
+                false,
+                false,
+                false,
+                "127.0.0.1",
+                9999,
+                true);
+        m_audioFifo = nfmDemod->getAudioFifo();
+        m_sink = nfmDemod;
+        break;
+    }
+    case ModeAM:
+    {
+        AMDemod *amDemod = new AMDemod();
+        amDemod->configure(&m_messageQueue,
+                m_settings.m_rfBandwidth,
+                m_settings.m_volume,
+                m_settings.m_squelch,
+                false,
+                m_settings.m_bandpassEnable,
+                false,
+                "127.0.0.1",
+                9999,
+                true);
+        m_audioFifo = amDemod->getAudioFifo();
+        m_sink = amDemod;
+        break;
+    }
+    case ModeSSB:
+    {
+        SSBDemod *ssbDemod = new SSBDemod(0);
+        ssbDemod->configure(&m_messageQueue,
+                m_settings.m_rfBandwidth,
+                m_settings.m_afBandwidth,
+                m_settings.m_volume,
+                m_settings.m_spanLog2,
+                m_settings.m_audioBinaural,
+                m_settings.m_audioFlipChannels,
+                m_settings.m_dsb,
+                false,
+                m_settings.m_agc,
+                m_settings.m_agcClamping,
+                m_settings.m_agcTimeLog2,
+                m_settings.m_agcPowerThreshold,
+                m_settings.m_agcThresholdGate);
+        m_audioFifo = ssbDemod->getAudioFifo();
+        m_sink = ssbDemod;
+        break;
+    }
+    case ModeWFM:
+    {
+        WFMDemod *wfmDemod = new WFMDemod(0);
+        wfmDemod->configure(&m_messageQueue,
+                m_settings.m_rfBandwidth,
+                m_settings.m_afBandwidth,
+                m_settings.m_volume,
+                m_settings.m_squelch,
+                false);
+        m_audioFifo = wfmDemod->getAudioFifo();
+        m_sink = wfmDemod;
+        break;
+    }
+    case ModeBFM:
+    {
+        m_rdsParser = new RDSParser();
+        BFMDemod *bfmDemod = new BFMDemod(0, m_rdsParser);
+        bfmDemod->configure(&m_messageQueue,
+                m_settings.m_rfBandwidth,
+                m_settings.m_afBandwidth,
+                m_settings.m_volume,
+                m_settings.m_squelch,
+                m_settings.m_audioStereo,
+                m_settings.m_lsbStereo,
+                false,
+                true,
+                false,
+                "127.0.0.1",
+                9999,
+                true);
+        m_audioFifo = bfmDemod->getAudioFifo();
+        m_sink = bfmDemod;
+        break;
+    }
+    case ModeLoRa:
+    {
+        LoRaDemod *loraDemod = new LoRaDemod(0);
+        loraDemod->configure(&m_messageQueue, m_settings.m_rfBandwidth);
+        loraDemod->setDecodeOutput(m_textFile);
+        m_sink = loraDemod;
+        break;
+    }
+    default:
+        m_sink = new BatchIQSink(m_outputFile, centerFrequency, m_startTimeStamp);
+        break;
+    }
+
+    if (m_audioFifo) {
+        DSPEngine::instance()->removeAudioSink(m_audioFifo); // read here instead of by the audio output
+    }
+
+    m_open = true;
+}
+
+void BatchChannel::dispatchMessages()
+{
+    Message *message;
+
+    // the channelizer passes on the messages it does not handle
+    while ((message = m_messageQueue.pop()) != 0)
+    {
+        m_channelizer->handleMessage(*message);
+        delete message;
+    }
+}
+
+quint32 BatchChannel::getAudioOverrunCount() const
+{
+    return m_audioFifo ? m_audioFifo->getOverrunCount() : 0;
+}
+
+void BatchChannel::process(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (!m_open) {
+        return;
+    }
+
+    m_channelizer->feed(begin, end, false);
+    m_sampleCount += end - begin;
+
+    if (m_audioFifo) {
+        writeAudio();
+    }
+
+    if (m_rdsParser) {
+        writeRDS();
+    }
+}
+
+void BatchChannel::applyCapture(quint64 centerFrequency, qint64 timestampMs)
+{
+    m_timeReferenceMs = timestampMs;
+    m_timeReferenceSample = m_sampleCount;
+    qint64 frequencyOffset = (qint64) m_channelFrequency - (qint64) centerFrequency;
+
+    if (!m_open || (frequencyOffset == m_settings.m_frequencyOffset)) {
+        return;
+    }
+
+    qWarning("BatchChannel::applyCapture: %s: recording moved to %llu Hz: channel offset %lld Hz%s",
+            qPrintable(m_outputFileName),
+            centerFrequency,
+            frequencyOffset,
+            m_settings.m_mode == ModeIQ ? " (the I/Q file header keeps the first frequency)" : "");
+
+    if ((frequencyOffset < -m_inputSampleRate / 2) || (frequencyOffset > m_inputSampleRate / 2)) {
+        qWarning("BatchChannel::applyCapture: %s: channel out of the recording band", qPrintable(m_outputFileName));
+    }
+
+    m_settings.m_frequencyOffset = frequencyOffset;
+    DSPConfigureChannelizer conf(m_settings.getChannelSampleRate(), m_settings.m_frequencyOffset);
+    m_channelizer->handleMessage(conf);
+    dispatchMessages();
+}
+
+void BatchChannel::writeAudio()
+{
+    uint32_t nbSamples = m_audioFifo->fill();
+
+    if (nbSamples > 0)
+    {
+        nbSamples = m_audioFifo->read((quint8 *) &m_audioBuffer[0], nbSamples, 0);
+        m_outputFile.write((const char *) &m_audioBuffer[0], nbSamples * sizeof(AudioSample));
+        m_audioBytes += nbSamples * sizeof(AudioSample);
+    }
+}
+
+void BatchChannel::writeRDS()
+{
+    qint64 timeMs = m_timeReferenceMs + (qint64) (((m_sampleCount - m_timeReferenceSample) * 1000) / m_inputSampleRate);
+    QString timeStr = QDateTime::fromMSecsSinceEpoch(timeMs).toUTC().toString(Qt::ISODate);
+
+    if (m_rdsParser->m_pi_updated && (m_rdsParser->m_pi_program_identification != m_rdsProgramIdentification))
+    {
+        m_rdsProgramIdentification = m_rdsParser->m_pi_program_identification;
+        fprintf(m_textFile, "%s PI %04X\n", qPrintable(timeStr), m_rdsProgramIdentification);
+    }
+
+    if (m_rdsParser->m_g0_updated)
+    {
+        QString programServiceName(m_rdsParser->m_g0_program_service_name);
+
+        if (programServiceName != m_rdsProgramServiceName)
+        {
+            m_rdsProgramServiceName = programServiceName;
+            fprintf(m_textFile, "%s PS \"%s\"\n", qPrintable(timeStr), qPrintable(programServiceName));
+        }
+    }
+
+    if (m_rdsParser->m_g2_updated)
+    {
+        QString radioText = QString(m_rdsParser->m_g2_radiotext).trimmed();
+
+        if (radioText != m_rdsRadioText)
+        {
+            m_rdsRadioText = radioText;
+            fprintf(m_textFile, "%s RT \"%s\"\n", qPrintable(timeStr), qPrintable(radioText));
+        }
+    }
+
+    m_rdsParser->clearUpdateFlags();
+}
+
+void BatchChannel::writeWavHeader()
+{
+    // 16 bit stereo PCM. The sizes are those of the audio written so far.
+    quint32 sampleRate = DSPEngine::instance()->getAudioSampleRate();
+    quint32 byteRate = sampleRate * sizeof(AudioSample);
+    quint32 dataSize = m_audioBytes;
+    quint32 riffSize = dataSize + 36;
+    quint32 fmtSize = 16;
+    quint16 format = 1;
+    quint16 nbChannels = 2;
+    quint16 blockAlign = sizeof(AudioSample);
+    quint16 bitsPerSample = 16;
+    char header[44];
+
+    std::memcpy(&header[0], "RIFF", 4);
+    std::memcpy(&header[4], &riffSize, 4);
+    std::memcpy(&header[8], "WAVEfmt ", 8);
+    std::memcpy(&header[16], &fmtSize, 4);
+    std::memcpy(&header[20], &format, 2);
+    std::memcpy(&header[22], &nbChannels, 2);
+    std::memcpy(&header[24], &sampleRate, 4);
+    std::memcpy(&header[28], &byteRate, 4);
+    std::memcpy(&header[32], &blockAlign, 2);
+    std::memcpy(&header[34], &bitsPerSample, 2);
+    std::memcpy(&header[36], "data", 4);
+    std::memcpy(&header[40], &dataSize, 4);
+
+    m_outputFile.seek(0);
+    m_outputFile.write(header, sizeof(header));
+}
+
+void BatchChannel::finish()
+{
+    if (m_audioFifo && m_outputFile.isOpen())
+    {
+        writeAudio();
+        writeWavHeader();
+    }
+
+    if (m_outputFile.isOpen()) {
+        m_outputFile.close();
+    }
+
+    if (m_textFile)
+    {
+        fclose(m_textFile);
+        m_textFile = 0;
+    }
+}
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBATCH_BATCHCHANNEL_H_
+#define SDRBATCH_BATCHCHANNEL_H_
+
+#include <stdio.h>
+#include <ctime>
+#include <vector>
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+
+#include "dsp/dsptypes.h"
+#include "util/messagequeue.h"
+
+class BasebandSampleSink;
+class DownChannelizer;
+class AudioFifo;
+class RDSParser;
+
+/**
+ * One channel of the batch processor: a channelizer followed by the DSP part of a channel plugin and
+ * the files its output is written to. It is run by a single worker at a time so it needs no locking.
+ * - demodulators: audio as 16 bit stereo .wav at the audio sample rate
+ * - BFM: audio and the RDS programme information changes in a text file
+ * - LoRa: decoded frames in a text file
+ * - IQ: channel I/Q as .sdriq at the channelizer output rate
+ */
+class BatchChannel
+{
+public:
+    typedef enum
+    {
+        ModeNFM,
+        ModeAM,
+        ModeSSB,
+        ModeWFM,
+        ModeBFM,
+        ModeLoRa,
+        ModeIQ
+    } Mode;
+
+    struct Settings
+    {
+        Mode m_mode;
+        qint64 m_frequencyOffset;  //!< Hz from the recording center frequency
+        int m_rfBandwidth;         //!< Hz. SSB: negative for LSB. IQ: requested output sample rate
+        int m_afBandwidth;         //!< Hz. SSB: low cutoff
+        int m_fmDeviation;         //!< Hz (NFM)
+        Real m_volume;
+        Real m_squelch;            //!< in the units of the channel GUI
+        int m_squelchGate;         //!< 10s of ms (NFM)
+        bool m_deltaSquelch;       //!< NFM
+        int m_spanLog2;            //!< SSB
+        bool m_audioBinaural;      //!< SSB
+        bool m_audioFlipChannels;  //!< SSB
+        bool m_dsb;                //!< SSB
+        bool m_agc;                //!< SSB
+        bool m_agcClamping;        //!< SSB
+        int m_agcTimeLog2;         //!< SSB
+        int m_agcPowerThreshold;   //!< SSB
+        int m_agcThresholdGate;    //!< SSB
+        bool m_bandpassEnable;     //!< AM
+        bool m_audioStereo;        //!< BFM
+        bool m_lsbStereo;          //!< BFM
+
+        Settings();
+        void resetToDefaults(Mode mode); //!< same defaults as the channel GUI
+        bool fromString(const QString& channel); //!< mode:offset[:bandwidth] as given on the command line
+        bool fromPreset(const QString& channelId, const QByteArray& data); //!< channel settings saved in a preset by the GUI
+        int getChannelSampleRate() const;   //!< rate requested from the channelizer
+        const char *getModeName() const;
+    };
+
+    BatchChannel(const Settings& settings, int inputSampleRate, quint64 centerFrequency, std::time_t startTimeStamp, const QString& outputBaseName);
+    ~BatchChannel();
+
+    bool isOpen() const { return m_open; } //!< false if an output file could not be created
+    const Settings& getSettings() const { return m_settings; }
+    const QString& getOutputFileName() const { return m_outputFileName; }
+    quint32 getAudioOverrunCount() const; //!< audio samples lost because a block produced more than the FIFO holds
+
+    void process(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void applyCapture(quint64 centerFrequency, qint64 timestampMs); //!< SigMF capture starting with the next samples: the channel keeps its frequency and times follow the capture
+    void finish(); //!< completes and closes the output files
+
+private:
+    Settings m_settings;
+    int m_inputSampleRate;
+    std::time_t m_startTimeStamp;
+    quint64 m_sampleCount;         //!< input samples processed
+    quint64 m_channelFrequency;    //!< absolute frequency of the channel
+    qint64 m_timeReferenceMs;      //!< time of the input sample m_timeReferenceSample
+    quint64 m_timeReferenceSample;
+    bool m_open;
+    MessageQueue m_messageQueue;   //!< configuration messages posted by the channel
+    DownChannelizer *m_channelizer;
+    BasebandSampleSink *m_sink;
+    AudioFifo *m_audioFifo;
+    RDSParser *m_rdsParser;
+    QString m_outputFileName;
+    QFile m_outputFile;            //!< audio or I/Q
+    quint64 m_audioBytes;
+    std::vector<AudioSample> m_audioBuffer;
+    FILE *m_textFile;              //!< RDS or LoRa
+    QString m_rdsProgramServiceName;
+    QString m_rdsRadioText;
+    unsigned int m_rdsProgramIdentification;
+
+    void createSink(const QString& outputBaseName, quint64 centerFrequency);
+    void dispatchMessages();
+    void writeAudio();
+    void writeRDS();
+    void writeWavHeader();
+};
+
+#endif /* SDRBATCH_BATCHCHANNEL_H_ */
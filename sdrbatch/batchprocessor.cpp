@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDebug>
+
+#include "dsp/filerecord.h"
+#include "dsp/samplepacker.h"
+#include "settings/mainsettings.h"
+#include "settings/preset.h"
+
+#include "parserbatch.h"
+#include "batchprocessor.h"
+
+void BatchProcessor::ChannelJob::run(int workerIndex)
+{
+    (void) workerIndex;
+    m_channel->process(m_block->begin(), m_block->end());
+    m_processor->jobDone();
+}
+
+BatchProcessor::BatchProcessor(const ParserBatch& parser) :
+    m_parser(parser),
+    m_sigMF(false),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_startTimeStamp(0),
+    m_recordSamples(0),
+    m_bytesPerSample(sizeof(Sample)),
+    m_blockSize(0),
+    m_readSamples(0),
+    m_nextCapture(0),
+    m_pendingJobs(0)
+{
+}
+
+BatchProcessor::~BatchProcessor()
+{
+    qDeleteAll(m_jobs);
+    qDeleteAll(m_channels);
+}
+
+bool BatchProcessor::openInput()
+{
+    QString fileName = m_parser.getInputFileName();
+    m_sigMF = SigMFMeta::isSigMF(fileName);
+
+    if (m_sigMF)
+    {
+        if (!m_meta.read(SigMFMeta::getMetaFileName(fileName)) || (m_meta.m_captures.size() == 0))
+        {
+            qCritical("BatchProcessor::openInput: %s: no valid SigMF metadata", qPrintable(fileName));
+            return false;
+        }
+
+        m_bytesPerSample = SamplePacker::getBytesPerSample(m_meta.m_sampleBits);
+
+        if (m_bytesPerSample == 0)
+        {
+            qCritical("BatchProcessor::openInput: %s: %d bits samples not supported", qPrintable(fileName), m_meta.m_sampleBits);
+            return false;
+        }
+
+        m_file.setFileName(SigMFMeta::getDataFileName(fileName));
+
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            qCritical("BatchProcessor::openInput: cannot open %s: %s", qPrintable(m_file.fileName()), qPrintable(m_file.errorString()));
+            return false;
+        }
+
+        // later capture segments are applied by the block starting with them
+        m_sampleRate = m_meta.m_sampleRate;
+        m_centerFrequency = m_meta.m_captures.front().m_frequency;
+        m_startTimeStamp = m_meta.m_captures.front().m_timestampMs / 1000;
+        m_recordSamples = m_file.size() / m_bytesPerSample;
+    }
+    else
+    {
+        m_file.setFileName(fileName);
+        FileRecord::Header header;
+
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            qCritical("BatchProcessor::openInput: cannot open %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+            return false;
+        }
+
+        if (!FileRecord::readHeader(m_file, header))
+        {
+            qCritical("BatchProcessor::openInput: %s: no header", qPrintable(fileName));
+            return false;
+        }
+
+        m_sampleRate = header.sampleRate;
+        m_centerFrequency = header.centerFrequency;
+        m_startTimeStamp = header.startTimeStamp;
+        m_recordSamples = (m_file.size() - FileRecord::getHeaderSize()) / m_bytesPerSample;
+    }
+
+    if (m_sampleRate <= 0)
+    {
+        qCritical("BatchProcessor::openInput: %s: invalid sample rate %d", qPrintable(fileName), m_sampleRate);
+        return false;
+    }
+
+    // about 100 ms per block. The largest audio output per block must fit in the channel audio FIFOs.
+    m_blockSize = m_sampleRate / 10 < 16384 ? 16384 : m_sampleRate / 10;
+
+    if (m_sigMF) {
+        m_readBuffer.resize(m_blockSize * m_bytesPerSample);
+    }
+
+    qWarning("BatchProcessor::openInput: %s: %d S/s at %llu Hz %llu samples (%.1f s)",
+            qPrintable(fileName),
+            m_sampleRate,
+            m_centerFrequency,
+            m_recordSamples,
+            (double) m_recordSamples / m_sampleRate);
+
+    return true;
+}
+
+bool BatchProcessor::addPresetChannels(QList<BatchChannel::Settings>& channelsSettings)
+{
+    MainSettings settings;
+    settings.load();
+    const Preset *preset = 0;
+
+    for (int i = 0; i < settings.getPresetCount(); i++)
+    {
+        const Preset *candidate = settings.getPreset(i);
+
+        if (candidate->isSourcePreset()
+            && (candidate->getDescription() == m_parser.getPresetDescription())
+            && (m_parser.getPresetGroup().isEmpty() || (candidate->getGroup() == m_parser.getPresetGroup())))
+        {
+            preset = candidate;
+            break;
+        }
+    }
+
+    if (preset == 0)
+    {
+        qCritical("BatchProcessor::addPresetChannels: preset [%s | %s] not found",
+                qPrintable(m_parser.getPresetGroup()), qPrintable(m_parser.getPresetDescription()));
+        return false;
+    }
+
+    // channel offsets are relative to the preset center frequency
+    qint64 frequencyShift = (qint64) preset->getCenterFrequency() - (qint64) m_centerFrequency;
+
+    for (int i = 0; i < preset->getChannelCount(); i++)
+    {
+        const Preset::ChannelConfig& channelConfig = preset->getChannelConfig(i);
+        BatchChannel::Settings channelSettings;
+
+        if (channelSettings.fromPreset(channelConfig.m_channel, channelConfig.m_config))
+        {
+            channelSettings.m_frequencyOffset += frequencyShift;
+            channelsSettings.append(channelSettings);
+        }
+        else
+        {
+            qWarning("BatchProcessor::addPresetChannels: channel %s cannot be run in batch", qPrintable(channelConfig.m_channel));
+        }
+    }
+
+    return true;
+}
+
+bool BatchProcessor::createChannels()
+{
+    QList<BatchChannel::Settings> channelsSettings;
+
+    if (!m_parser.getPresetDescription().isEmpty() && !addPresetChannels(channelsSettings)) {
+        return false;
+    }
+
+    for (int i = 0; i < m_parser.getChannels().size(); i++)
+    {
+        BatchChannel::Settings channelSettings;
+
+        if (channelSettings.fromString(m_parser.getChannels().at(i)))
+        {
+            channelsSettings.append(channelSettings);
+        }
+        else
+        {
+            qCritical("BatchProcessor::createChannels: invalid channel %s", qPrintable(m_parser.getChannels().at(i)));
+            return false;
+        }
+    }
+
+    QDir outputDirectory(m_parser.getOutputDirectory());
+    QString baseName = QFileInfo(m_parser.getInputFileName()).completeBaseName();
+
+    if (!outputDirectory.exists() && !outputDirectory.mkpath("."))
+    {
+        qCritical("BatchProcessor::createChannels: cannot create %s", qPrintable(outputDirectory.path()));
+        return false;
+    }
+
+    for (int i = 0; i < channelsSettings.size(); i++)
+    {
+        const BatchChannel::Settings& channelSettings = channelsSettings.at(i);
+
+        if ((channelSettings.m_frequencyOffset < -m_sampleRate / 2) || (channelSettings.m_frequencyOffset > m_sampleRate / 2))
+        {
+            qWarning("BatchProcessor::createChannels: %s channel at %lld Hz is out of the recording band. Skipped.",
+                    channelSettings.getModeName(), channelSettings.m_frequencyOffset);
+            continue;
+        }
+
+        QString outputBaseName = outputDirectory.filePath(QString("%1_%2_%3_%4")
+                .arg(baseName)
+                .arg(i)
+                .arg(channelSettings.getModeName())
+                .arg(channelSettings.m_frequencyOffset));
+        BatchChannel *channel = new BatchChannel(channelSettings, m_sampleRate, m_centerFrequency, m_startTimeStamp, outputBaseName);
+
+        if (!channel->isOpen())
+        {
+            delete channel;
+            return false;
+        }
+
+        m_channels.append(channel);
+        m_jobs.append(new ChannelJob(this, channel));
+        qWarning("BatchProcessor::createChannels: %s channel at %lld Hz to %s",
+                channelSettings.getModeName(), channelSettings.m_frequencyOffset, qPrintable(channel->getOutputFileName()));
+    }
+
+    if (m_channels.size() == 0)
+    {
+        qCritical("BatchProcessor::createChannels: no channel to run");
+        return false;
+    }
+
+    return true;
+}
+
+void BatchProcessor::readBlock(SampleVector& block, int& capture)
+{
+    block.resize(m_blockSize);
+    qint64 nbBytes;
+    capture = -1;
+
+    if (m_sigMF)
+    {
+        const QList<SigMFMeta::Capture>& captures = m_meta.m_captures;
+        quint64 blockSize = m_blockSize;
+
+        // the last of the captures starting here if any
+        while ((m_nextCapture < captures.size()) && (captures[m_nextCapture].m_sampleStart <= m_readSamples)) {
+            capture = m_nextCapture++;
+        }
+
+        // the block ends where the next capture starts
+        if ((m_nextCapture < captures.size()) && (captures[m_nextCapture].m_sampleStart - m_readSamples < blockSize)) {
+            blockSize = captures[m_nextCapture].m_sampleStart - m_readSamples;
+        }
+
+        nbBytes = m_file.read((char *) &m_readBuffer[0], blockSize * m_bytesPerSample);
+        nbBytes = nbBytes < 0 ? 0 : nbBytes;
+        SamplePacker::unpack(&m_readBuffer[0], nbBytes / m_bytesPerSample, &block[0], m_meta.m_sampleBits, m_meta.m_sampleShift);
+    }
+    else // 16 bit samples are read straight into the block
+    {
+        nbBytes = m_file.read((char *) &block[0], m_blockSize * m_bytesPerSample);
+        nbBytes = nbBytes < 0 ? 0 : nbBytes;
+    }
+
+    block.resize(nbBytes / m_bytesPerSample);
+    m_readSamples += block.size();
+}
+
+void BatchProcessor::applyCapture(int capture)
+{
+    const SigMFMeta::Capture& segment = m_meta.m_captures.at(capture);
+
+    for (int i = 0; i < m_channels.size(); i++) {
+        m_channels[i]->applyCapture(segment.m_frequency, segment.m_timestampMs);
+    }
+}
+
+double BatchProcessor::getRealTimeFactor(quint64 nbSamples, qint64 elapsedMs) const
+{
+    return elapsedMs > 0 ? (nbSamples * 1000.0) / ((double) elapsedMs * m_sampleRate) : 0.0;
+}
+
+void BatchProcessor::jobDone()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (--m_pendingJobs == 0) {
+        m_jobsDone.wakeAll();
+    }
+}
+
+bool BatchProcessor::run()
+{
+    if (!openInput() || !createChannels()) {
+        return false;
+    }
+
+    int nbWorkers = m_parser.getNbWorkers();
+
+    if (nbWorkers == 0) {
+        nbWorkers = m_channels.size() < QThread::idealThreadCount() ? m_channels.size() : QThread::idealThreadCount();
+    }
+
+    JobPool jobPool(nbWorkers);
+    SampleVector blocks[2];
+    int captures[2];
+    int current = 0;
+    quint64 nbSamples = 0;
+    quint64 progressStep = (quint64) m_sampleRate * 600; // report every 10 minutes of recording
+    QElapsedTimer timer;
+
+    qWarning("BatchProcessor::run: %d channels on %d workers", m_channels.size(), jobPool.getNbWorkers());
+    timer.start();
+    readBlock(blocks[current], captures[current]);
+
+    while (blocks[current].size() > 0)
+    {
+        // no job is running: the channels can be retuned
+        if (captures[current] >= 0) {
+            applyCapture(captures[current]);
+        }
+
+        m_mutex.lock();
+        m_pendingJobs = m_jobs.size();
+        m_mutex.unlock();
+
+        for (int i = 0; i < m_jobs.size(); i++)
+        {
+            m_jobs[i]->setBlock(&blocks[current]);
+            jobPool.push(m_jobs[i]);
+        }
+
+        // the next block is read while the channels process this one
+        readBlock(blocks[1 - current], captures[1 - current]);
+
+        m_mutex.lock();
+
+        while (m_pendingJobs > 0) {
+            m_jobsDone.wait(&m_mutex);
+        }
+
+        m_mutex.unlock();
+
+        nbSamples += blocks[current].size();
+        current = 1 - current;
+
+        if ((nbSamples % progressStep) < blocks[1 - current].size())
+        {
+            qWarning("BatchProcessor::run: %.0f%% %.1f x real time",
+                    (100.0 * nbSamples) / m_recordSamples,
+                    getRealTimeFactor(nbSamples, timer.elapsed()));
+        }
+    }
+
+    qint64 elapsedMs = timer.elapsed();
+
+    for (int i = 0; i < m_channels.size(); i++)
+    {
+        m_channels[i]->finish();
+
+        if (m_channels[i]->getAudioOverrunCount() > 0)
+        {
+            qWarning("BatchProcessor::run: %s: %u audio samples lost",
+                    qPrintable(m_channels[i]->getOutputFileName()), m_channels[i]->getAudioOverrunCount());
+        }
+    }
+
+    qWarning("BatchProcessor::run: %llu samples (%.1f s) processed in %.1f s: %.1f x real time",
+            nbSamples,
+            (double) nbSamples / m_sampleRate,
+            elapsedMs / 1000.0,
+            getRealTimeFactor(nbSamples, elapsedMs));
+
+    return true;
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBATCH_BATCHPROCESSOR_H_
+#define SDRBATCH_BATCHPROCESSOR_H_
+
+#include <ctime>
+#include <vector>
+
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "dsp/dsptypes.h"
+#include "dsp/sigmfmeta.h"
+#include "dsp/fftwisdom.h"
+#include "util/jobpool.h"
+
+#include "batchchannel.h"
+
+class ParserBatch;
+
+/**
+ * Runs the channels of a preset and/or of the command line on a recording as fast as the CPU allows.
+ * The recording is read by blocks. Each block is given to all channels at once as one job per channel
+ * on a worker pool while the next block is read. A channel only gets its next block when all channels
+ * are done with the current one so each channel is run by one worker at a time.
+ * SigMF blocks are cut at the start of each capture segment whose frequency and time are applied to
+ * the channels before they get its first block.
+ */
+class BatchProcessor
+{
+public:
+    BatchProcessor(const ParserBatch& parser);
+    ~BatchProcessor();
+
+    bool run(); //!< false if nothing could be processed
+
+private:
+    class ChannelJob : public JobPool::Job
+    {
+    public:
+        ChannelJob(BatchProcessor *processor, BatchChannel *channel) :
+            m_processor(processor),
+            m_channel(channel),
+            m_block(0)
+        { }
+
+        void setBlock(const SampleVector *block) { m_block = block; }
+        virtual void run(int workerIndex);
+
+    private:
+        BatchProcessor *m_processor;
+        BatchChannel *m_channel;
+        const SampleVector *m_block;
+    };
+
+    const ParserBatch& m_parser;
+    FFTWisdom m_fftWisdom;
+    QFile m_file;
+    bool m_sigMF;
+    SigMFMeta m_meta;
+    int m_sampleRate;
+    quint64 m_centerFrequency;
+    std::time_t m_startTimeStamp;
+    quint64 m_recordSamples;
+    uint m_bytesPerSample;
+    uint m_blockSize;              //!< samples
+    quint64 m_readSamples;         //!< samples read from the file
+    int m_nextCapture;             //!< index of the next SigMF capture segment to apply
+    std::vector<quint8> m_readBuffer; //!< packed SigMF samples
+    QList<BatchChannel*> m_channels;
+    QList<ChannelJob*> m_jobs;
+    QMutex m_mutex;
+    QWaitCondition m_jobsDone;
+    int m_pendingJobs;
+
+    bool openInput();
+    bool createChannels();
+    bool addPresetChannels(QList<BatchChannel::Settings>& channelsSettings);
+    void readBlock(SampleVector& block, int& capture); //!< block is resized to the samples read. Empty at the end of the file. capture is the SigMF capture starting with the block or -1.
+    void applyCapture(int capture);
+    double getRealTimeFactor(quint64 nbSamples, qint64 elapsedMs) const;
+    void jobDone();
+};
+
+#endif /* SDRBATCH_BATCHPROCESSOR_H_ */
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QCoreApplication>
+
+#include "parserbatch.h"
+#include "batchprocessor.h"
+
+static int runQtApplication(int argc, char* argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    // same names as the GUI so that its presets are found
+    QCoreApplication::setOrganizationName("f4exb");
+    QCoreApplication::setApplicationName("SDRangel");
+    QCoreApplication::setApplicationVersion("3.7.0");
+
+    ParserBatch parser;
+
+    if (!parser.parse(a)) {
+        return 1;
+    }
+
+    BatchProcessor processor(parser);
+
+    return processor.run() ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    return runQtApplication(argc, argv);
+}
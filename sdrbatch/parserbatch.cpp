@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QCommandLineOption>
+#include <QDebug>
+
+#include "parserbatch.h"
+
+ParserBatch::ParserBatch() :
+    m_outputDirectoryOption(QStringList() << "o" << "output",
+        "Directory where the channel outputs are written.",
+        "directory",
+        "."),
+    m_presetGroupOption(QStringList() << "g" << "group",
+        "Group of the preset.",
+        "group"),
+    m_presetDescriptionOption(QStringList() << "p" << "preset",
+        "Preset (description) whose channels are run. Presets are the ones saved by the GUI.",
+        "preset"),
+    m_channelOption(QStringList() << "c" << "channel",
+        "Channel given as mode:offset[:bandwidth]. Offset in Hz from the recording center frequency. Modes: nfm, am, usb, lsb, wfm, bfm, lora, iq. Can be repeated.",
+        "channel"),
+    m_nbWorkersOption(QStringList() << "j" << "jobs",
+        "Number of worker threads. Default is one per channel within the number of cores.",
+        "jobs",
+        "0")
+{
+    m_outputDirectory = ".";
+    m_nbWorkers = 0;
+
+    m_parser.setApplicationDescription("Runs SDRangel channels on a recording as fast as possible");
+    m_parser.addHelpOption();
+    m_parser.addVersionOption();
+
+    m_parser.addOption(m_outputDirectoryOption);
+    m_parser.addOption(m_presetGroupOption);
+    m_parser.addOption(m_presetDescriptionOption);
+    m_parser.addOption(m_channelOption);
+    m_parser.addOption(m_nbWorkersOption);
+    m_parser.addPositionalArgument("file", "Recording (.sdriq or SigMF)");
+}
+
+ParserBatch::~ParserBatch()
+{ }
+
+bool ParserBatch::parse(const QCoreApplication& app)
+{
+    m_parser.process(app);
+
+    bool ok;
+
+    // input file
+
+    QStringList positionalArguments = m_parser.positionalArguments();
+
+    if (positionalArguments.size() != 1)
+    {
+        qCritical("ParserBatch::parse: one recording file must be given");
+        return false;
+    }
+
+    m_inputFileName = positionalArguments.at(0);
+
+    // output directory
+
+    m_outputDirectory = m_parser.value(m_outputDirectoryOption);
+
+    // channels
+
+    m_presetGroup = m_parser.value(m_presetGroupOption);
+    m_presetDescription = m_parser.value(m_presetDescriptionOption);
+    m_channels = m_parser.values(m_channelOption);
+
+    // workers
+
+    int nbWorkers = m_parser.value(m_nbWorkersOption).toInt(&ok);
+
+    if (ok && (nbWorkers >= 0)) {
+        m_nbWorkers = nbWorkers;
+    } else {
+        qWarning() << "ParserBatch::parse: number of workers invalid. Using default: " << m_nbWorkers;
+    }
+
+    return true;
+}
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBATCH_PARSERBATCH_H_
+#define SDRBATCH_PARSERBATCH_H_
+
+#include <QCommandLineParser>
+#include <QString>
+#include <QStringList>
+
+class ParserBatch
+{
+public:
+    ParserBatch();
+    ~ParserBatch();
+
+    bool parse(const QCoreApplication& app); //!< false if the input file is missing
+
+    const QString& getInputFileName() const { return m_inputFileName; }
+    const QString& getOutputDirectory() const { return m_outputDirectory; }
+    const QString& getPresetGroup() const { return m_presetGroup; }
+    const QString& getPresetDescription() const { return m_presetDescription; }
+    const QStringList& getChannels() const { return m_channels; }
+    int getNbWorkers() const { return m_nbWorkers; }
+
+private:
+    QString m_inputFileName;
+    QString m_outputDirectory;
+    QString m_presetGroup;
+    QString m_presetDescription;
+    QStringList m_channels;
+    int m_nbWorkers;
+
+    QCommandLineParser m_parser;
+    QCommandLineOption m_outputDirectoryOption;
+    QCommandLineOption m_presetGroupOption;
+    QCommandLineOption m_presetDescriptionOption;
+    QCommandLineOption m_channelOption;
+    QCommandLineOption m_nbWorkersOption;
+};
+
+#endif /* SDRBATCH_PARSERBATCH_H_ */
@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <QCoreApplication>
+#include <QTimer>
+
+#include "parserbench.h"
+#include "mainbench.h"
+
+static int runQtApplication(int argc, char* argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setOrganizationName("f4exb");
+    QCoreApplication::setApplicationName("SDRangelBench");
+    QCoreApplication::setApplicationVersion("3.7.0");
+
+    ParserBench parser;
+    parser.parse(a);
+
+    MainBench m(parser);
+    QObject::connect(&m, SIGNAL(finished()), &a, SLOT(quit()));
+    QTimer::singleShot(0, &m, SLOT(run()));
+
+    int res = a.exec();
+    return res != 0 ? res : m.getExitCode();
+}
+
+int main(int argc, char* argv[])
+{
+    int res = runQtApplication(argc, argv);
+    qWarning("SDRangel benchmark quit.");
+    return res;
+}
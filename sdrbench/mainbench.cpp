@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <QDebug>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSysInfo>
+
+#include "mainbench.h"
+
+MainBench::MainBench(const ParserBench& parser, QObject *parent) :
+    QObject(parent),
+    m_parser(parser),
+    m_exitCode(0)
+{
+}
+
+MainBench::~MainBench()
+{
+}
+
+void MainBench::run()
+{
+    qDebug() << "MainBench::run: parameters:"
+        << " test: " << m_parser.getTestType()
+        << " nsamples: " << m_parser.getNbSamples()
+        << " blockSize: " << m_parser.getBlockSize()
+        << " repeat: " << m_parser.getRepetition();
+
+    ParserBench::TestType testType = m_parser.getTestType();
+    bool all = testType == ParserBench::TestAll;
+
+    if (testType == ParserBench::TestUnknown)
+    {
+        qWarning() << "MainBench::run: unknown test type: " << m_parser.getTestStr();
+        m_exitCode = 1;
+        emit finished();
+        return;
+    }
+
+    if (all || (testType == ParserBench::TestSampleSinkFifo)) {
+        testSampleSinkFifo();
+    }
+    if (all || (testType == ParserBench::TestDecimators)) {
+        testDecimators();
+    }
+    if (all || (testType == ParserBench::TestFFTFilt)) {
+        testFFTFilt();
+    }
+    if (all || (testType == ParserBench::TestHalfband)) {
+        testHalfband();
+    }
+    if (all || (testType == ParserBench::TestChannelizers)) {
+        testChannelizers();
+    }
+    if (all || (testType == ParserBench::TestInterpolator)) {
+        testInterpolator();
+    }
+    if (all || (testType == ParserBench::TestNCO)) {
+        testNCO();
+    }
+    if (all || (testType == ParserBench::TestSpectrumVis)) {
+        testSpectrumVis();
+    }
+    if (all || (testType == ParserBench::TestDemods)) {
+        testDemods();
+    }
+    if (all || (testType == ParserBench::TestSamplePacker)) {
+        testSamplePacker();
+    }
+    if (all || (testType == ParserBench::TestSampleCodec)) {
+        testSampleCodec();
+    }
+
+    if (!m_parser.getJsonFileName().isEmpty()) {
+        writeJson();
+    }
+
+    emit finished();
+}
+
+void MainBench::addResult(const QString& test, const QString& name, quint64 nbSamples, qint64 nsecs, const QJsonObject& details)
+{
+    QJsonObject result(details);
+    result.insert("test", test);
+    result.insert("name", name);
+    result.insert("samples", (double) nbSamples);
+    result.insert("nsecs", (double) nsecs);
+    result.insert("samplesPerSecond", nsecs == 0 ? 0.0 : (nbSamples * 1.0e9) / nsecs);
+    m_results.append(result);
+}
+
+/**
+ * One document per run with enough context (version, build, CPU) to compare the results of
+ * different releases or machines. Results are in the order they were measured.
+ */
+void MainBench::writeJson()
+{
+    QJsonObject system;
+    system.insert("product", QSysInfo::prettyProductName());
+    system.insert("kernel", QSysInfo::kernelType() + " " + QSysInfo::kernelVersion());
+    system.insert("cpuArchitecture", QSysInfo::currentCpuArchitecture());
+    system.insert("buildAbi", QSysInfo::buildAbi());
+    system.insert("qtVersion", QString(qVersion()));
+
+    QJsonObject parameters;
+    parameters.insert("test", m_parser.getTestStr());
+    parameters.insert("nbSamples", (double) m_parser.getNbSamples());
+    parameters.insert("blockSize", (int) m_parser.getBlockSize());
+    parameters.insert("repeat", (int) m_parser.getRepetition());
+
+    QJsonObject root;
+    root.insert("application", QCoreApplication::applicationName());
+    root.insert("version", QCoreApplication::applicationVersion());
+    root.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert("system", system);
+    root.insert("parameters", parameters);
+    root.insert("results", m_results);
+
+    QFile file(m_parser.getJsonFileName());
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "MainBench::writeJson: cannot open " << m_parser.getJsonFileName() << ": " << file.errorString();
+        return;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    file.close();
+    qDebug() << "MainBench::writeJson: " << m_results.size() << " results written to " << m_parser.getJsonFileName();
+}
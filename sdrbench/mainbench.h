@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#ifndef SDRBENCH_MAINBENCH_H_
+#define SDRBENCH_MAINBENCH_H_
+
+#include <QObject>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "dsp/fftwisdom.h"
+#include "parserbench.h"
+
+class MainBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    MainBench(const ParserBench& parser, QObject *parent = 0);
+    ~MainBench();
+
+    /** Records one measurement for the JSON output. Details are merged into the result object */
+    void addResult(const QString& test, const QString& name, quint64 nbSamples, qint64 nsecs,
+            const QJsonObject& details = QJsonObject());
+    int getExitCode() const { return m_exitCode; } //!< non zero if the run was aborted
+
+public slots:
+    void run();
+
+signals:
+    void finished();
+
+private:
+    const ParserBench& m_parser;
+    FFTWisdom m_fftWisdom; //!< the FFTs are measured with the plans of the other programs
+    QJsonArray m_results;
+    int m_exitCode;
+
+    void testSampleSinkFifo();
+    void testSampleSinkFifo(bool lockFree);
+    void testDecimators();
+    void testFFTFilt();
+    void testHalfband();
+    void testChannelizers();
+    void testInterpolator();
+    void testNCO();
+    void testSpectrumVis();
+    void testDemods();
+    void testSamplePacker();
+    void testSampleCodec();
+    void writeJson();
+};
+
+#endif /* SDRBENCH_MAINBENCH_H_ */
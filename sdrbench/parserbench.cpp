@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCommandLineOption>
+#include <QDebug>
+
+#include "parserbench.h"
+
+ParserBench::ParserBench() :
+    m_testOption(QStringList() << "t" << "test",
+        "Test type: fifo, decimators, fftfilt, halfband, channelizers, interpolator, nco, spectrum, demods, packer, codec, all",
+        "test",
+        "fifo"),
+    m_nbSamplesOption(QStringList() << "n" << "nb-samples",
+        "Number of samples to process per run.",
+        "samples",
+        "100000000"),
+    m_blockSizeOption(QStringList() << "b" << "block-size",
+        "Size of the sample blocks as delivered by the device.",
+        "size",
+        "16384"),
+    m_repetitionOption(QStringList() << "r" << "repeat",
+        "Number of runs of each test.",
+        "repetition",
+        "1"),
+    m_jsonOption(QStringList() << "j" << "json",
+        "Write the results to this JSON file in addition to the console.",
+        "file",
+        "")
+{
+    m_testStr = "fifo";
+    m_testType = TestSampleSinkFifo;
+    m_nbSamples = 100000000;
+    m_blockSize = 16384;
+    m_repetition = 1;
+
+    m_parser.setApplicationDescription("Software Defined Radio DSP core benchmarks");
+    m_parser.addHelpOption();
+    m_parser.addVersionOption();
+
+    m_parser.addOption(m_testOption);
+    m_parser.addOption(m_nbSamplesOption);
+    m_parser.addOption(m_blockSizeOption);
+    m_parser.addOption(m_repetitionOption);
+    m_parser.addOption(m_jsonOption);
+}
+
+ParserBench::~ParserBench()
+{ }
+
+void ParserBench::parse(const QCoreApplication& app)
+{
+    m_parser.process(app);
+
+    bool ok;
+
+    // test switch
+
+    m_testStr = m_parser.value(m_testOption);
+
+    if (m_testStr == "fifo") {
+        m_testType = TestSampleSinkFifo;
+    } else if (m_testStr == "decimators") {
+        m_testType = TestDecimators;
+    } else if (m_testStr == "fftfilt") {
+        m_testType = TestFFTFilt;
+    } else if (m_testStr == "halfband") {
+        m_testType = TestHalfband;
+    } else if (m_testStr == "channelizers") {
+        m_testType = TestChannelizers;
+    } else if (m_testStr == "interpolator") {
+        m_testType = TestInterpolator;
+    } else if (m_testStr == "nco") {
+        m_testType = TestNCO;
+    } else if (m_testStr == "spectrum") {
+        m_testType = TestSpectrumVis;
+    } else if (m_testStr == "demods") {
+        m_testType = TestDemods;
+    } else if (m_testStr == "packer") {
+        m_testType = TestSamplePacker;
+    } else if (m_testStr == "codec") {
+        m_testType = TestSampleCodec;
+    } else if (m_testStr == "all") {
+        m_testType = TestAll;
+    } else {
+        qWarning() << "ParserBench::parse: unknown test " << m_testStr;
+        m_testType = TestUnknown;
+    }
+
+    // number of samples
+
+    quint64 nbSamples = m_parser.value(m_nbSamplesOption).toULongLong(&ok);
+
+    if (ok && (nbSamples > 0)) {
+        m_nbSamples = nbSamples;
+    } else {
+        qWarning() << "ParserBench::parse: number of samples invalid. Using default: " << m_nbSamples;
+    }
+
+    // block size
+
+    uint blockSize = m_parser.value(m_blockSizeOption).toUInt(&ok);
+
+    if (ok && (blockSize > 0)) {
+        m_blockSize = blockSize;
+    } else {
+        qWarning() << "ParserBench::parse: block size invalid. Using default: " << m_blockSize;
+    }
+
+    // repetition
+
+    uint repetition = m_parser.value(m_repetitionOption).toUInt(&ok);
+
+    if (ok && (repetition > 0)) {
+        m_repetition = repetition;
+    } else {
+        qWarning() << "ParserBench::parse: repetition invalid. Using default: " << m_repetition;
+    }
+
+    // JSON output file
+
+    m_jsonFileName = m_parser.value(m_jsonOption);
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBENCH_PARSERBENCH_H_
+#define SDRBENCH_PARSERBENCH_H_
+
+#include <QCommandLineParser>
+#include <QString>
+
+class ParserBench
+{
+public:
+    typedef enum
+    {
+        TestSampleSinkFifo,
+        TestDecimators,
+        TestFFTFilt,
+        TestHalfband,
+        TestChannelizers,
+        TestInterpolator,
+        TestNCO,
+        TestSpectrumVis,
+        TestDemods,
+        TestSamplePacker,
+        TestSampleCodec,
+        TestAll,
+        TestUnknown
+    } TestType;
+
+    ParserBench();
+    ~ParserBench();
+
+    void parse(const QCoreApplication& app);
+
+    TestType getTestType() const { return m_testType; }
+    quint64 getNbSamples() const { return m_nbSamples; }
+    uint getBlockSize() const { return m_blockSize; }
+    uint getRepetition() const { return m_repetition; }
+    const QString& getTestStr() const { return m_testStr; }
+    const QString& getJsonFileName() const { return m_jsonFileName; }
+
+private:
+    QString  m_testStr;
+    TestType m_testType;
+    quint64  m_nbSamples;
+    uint     m_blockSize;
+    uint     m_repetition;
+    QString  m_jsonFileName;
+
+    QCommandLineParser m_parser;
+    QCommandLineOption m_testOption;
+    QCommandLineOption m_nbSamplesOption;
+    QCommandLineOption m_blockSizeOption;
+    QCommandLineOption m_repetitionOption;
+    QCommandLineOption m_jsonOption;
+};
+
+#endif /* SDRBENCH_PARSERBENCH_H_ */
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/upchannelizer.h"
+#include "dsp/dspcommands.h"
+#include "mainbench.h"
+
+namespace {
+
+const int channelizersBasebandRate = 3072000; //!< large power of two multiple of the usual channel rates
+
+/** Channel sink that only counts what the channelizer delivers */
+class ChannelizerBenchSink : public BasebandSampleSink
+{
+public:
+    ChannelizerBenchSink() : m_count(0) {}
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual bool handleMessage(const Message& cmd) { (void) cmd; return true; }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+    {
+        (void) positiveOnly;
+        m_count += end - begin;
+    }
+
+    quint64 getCount() const { return m_count; }
+
+private:
+    quint64 m_count;
+};
+
+/** Channel source producing a complex tone from a table so that it costs next to nothing */
+class ChannelizerBenchSource : public BasebandSampleSource
+{
+public:
+    ChannelizerBenchSource() :
+        m_tone(64),
+        m_index(0),
+        m_count(0)
+    {
+        for (std::size_t i = 0; i < m_tone.size(); i++)
+        {
+            double phase = (2.0 * M_PI * i) / m_tone.size();
+            m_tone[i] = Sample(8192 * cos(phase), 8192 * sin(phase));
+        }
+    }
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual bool handleMessage(const Message& cmd) { (void) cmd; return true; }
+
+    virtual void pull(Sample& sample)
+    {
+        sample = m_tone[m_index];
+        m_index = (m_index + 1) % m_tone.size();
+        m_count++;
+    }
+
+    quint64 getCount() const { return m_count; }
+
+private:
+    SampleVector m_tone;
+    std::size_t m_index;
+    quint64 m_count;
+};
+
+/**
+ * Channel at the center of the baseband or a quarter of the baseband rate above it. The latter
+ * makes the first stage take the upper half.
+ */
+void testDownChannelizer(MainBench& bench, int decimation, int offset, const SampleVector& block, std::size_t nbBlocks)
+{
+    ChannelizerBenchSink sink;
+    DownChannelizer channelizer(&sink);
+    DSPSignalNotification notif(channelizersBasebandRate, 0);
+    channelizer.handleMessage(notif);
+    DSPConfigureChannelizer conf(channelizersBasebandRate / decimation, offset);
+    channelizer.handleMessage(conf);
+
+    quint64 nbSamples = (quint64) nbBlocks * block.size();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        channelizer.feed(block.begin(), block.end(), false);
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    printf("DownChannelizer decim %2d offset %8d: %llu samples: %8.2f MS/s %llu output samples\n",
+        decimation,
+        offset,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs,
+        (unsigned long long) sink.getCount());
+
+    QJsonObject details;
+    details.insert("direction", QString("down"));
+    details.insert("decimation", decimation);
+    details.insert("offset", offset);
+    details.insert("outputSamples", (double) sink.getCount());
+    bench.addResult("channelizers", QString("down decim %1 offset %2").arg(decimation).arg(offset), nbSamples, nsecs, details);
+}
+
+/** Same as above in the transmit direction. Counts are in baseband (output) samples */
+void testUpChannelizer(MainBench& bench, int interpolation, int offset, SampleVector& block, std::size_t nbBlocks)
+{
+    ChannelizerBenchSource source;
+    UpChannelizer channelizer(&source);
+    DSPSignalNotification notif(channelizersBasebandRate, 0);
+    channelizer.handleMessage(notif);
+    DSPConfigureChannelizer conf(channelizersBasebandRate / interpolation, offset);
+    channelizer.handleMessage(conf);
+
+    quint64 nbSamples = (quint64) nbBlocks * block.size();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        channelizer.pull(block.begin(), block.size());
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    printf("UpChannelizer   inter %2d offset %8d: %llu samples: %8.2f MS/s %llu input samples\n",
+        interpolation,
+        offset,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs,
+        (unsigned long long) source.getCount());
+
+    QJsonObject details;
+    details.insert("direction", QString("up"));
+    details.insert("interpolation", interpolation);
+    details.insert("offset", offset);
+    details.insert("inputSamples", (double) source.getCount());
+    bench.addResult("channelizers", QString("up inter %1 offset %2").arg(interpolation).arg(offset), nbSamples, nsecs, details);
+}
+
+} // namespace
+
+void MainBench::testChannelizers()
+{
+    uint blockSize = m_parser.getBlockSize();
+    std::size_t nbBlocks = (m_parser.getNbSamples() + blockSize - 1) / blockSize;
+    SampleVector block(blockSize);
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Sample((rand() % 16384) - 8192, (rand() % 16384) - 8192);
+    }
+
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (int factor = 2; factor <= 64; factor *= 2)
+        {
+            testDownChannelizer(*this, factor, 0, block, nbBlocks);
+            testDownChannelizer(*this, factor, channelizersBasebandRate / 4, block, nbBlocks);
+        }
+
+        for (int factor = 2; factor <= 64; factor *= 2)
+        {
+            testUpChannelizer(*this, factor, 0, block, nbBlocks);
+            testUpChannelizer(*this, factor, channelizersBasebandRate / 4, block, nbBlocks);
+        }
+    }
+}
@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/decimators.h"
+#include "legacydecimators.h"
+#include "mainbench.h"
+
+namespace {
+
+/**
+ * Runs the center decimations with the former template and with each available kernel set on the
+ * same pseudo random input. Every kernel set must give the same samples as the former template and
+ * as the scalar kernels.
+ */
+template<typename T, uint InputBits>
+void testDecimatorsType(MainBench& bench, const char *typeName, quint64 nbSamplesMax, uint blockSize)
+{
+    typedef void (Decimators<T, SDR_SAMP_SZ, InputBits>::*DecimateFunction)(SampleVector::iterator*, const T*, qint32);
+    const DecimateFunction functions[6] = {
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate2_cen,
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate4_cen,
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate8_cen,
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate16_cen,
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate32_cen,
+        &Decimators<T, SDR_SAMP_SZ, InputBits>::decimate64_cen
+    };
+    typedef void (LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::*LegacyDecimateFunction)(SampleVector::iterator*, const T*, qint32);
+    const LegacyDecimateFunction legacyFunctions[6] = {
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate2_cen,
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate4_cen,
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate8_cen,
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate16_cen,
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate32_cen,
+        &LegacyDecimators<T, SDR_SAMP_SZ, InputBits>::decimate64_cen
+    };
+    const DecimatorsSIMD::Arch archs[4] = {
+        DecimatorsSIMD::ArchScalar,
+        DecimatorsSIMD::ArchSSE4_1,
+        DecimatorsSIMD::ArchAVX2,
+        DecimatorsSIMD::ArchNEON
+    };
+
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    std::vector<T> buf(2*blockSize);
+    SampleVector legacy(nbSamples);
+    SampleVector reference(nbSamples);
+    SampleVector output(nbSamples);
+    int amplitude = 1 << (InputBits - 1);
+
+    srand(1);
+
+    for (uint i = 0; i < 2*blockSize; i++) {
+        buf[i] = (T) ((rand() % (2*amplitude)) - (((T) -1) < 0 ? amplitude : 0));
+    }
+
+    for (int log2Decim = 1; log2Decim <= 6; log2Decim++)
+    {
+        LegacyDecimators<T, SDR_SAMP_SZ, InputBits> *legacyDecimators = new LegacyDecimators<T, SDR_SAMP_SZ, InputBits>();
+        SampleVector::iterator legacyIt = legacy.begin();
+        QElapsedTimer legacyTimer;
+        legacyTimer.start();
+
+        for (std::size_t i = 0; i < nbBlocks; i++) {
+            (legacyDecimators->*legacyFunctions[log2Decim - 1])(&legacyIt, &buf[0], 2*blockSize);
+        }
+
+        qint64 legacyNsecs = legacyTimer.nsecsElapsed();
+        int nbLegacyOut = legacyIt - legacy.begin();
+        delete legacyDecimators;
+
+        printf("Decimators %-4s decim %2d %-7s: %llu samples: %8.2f MS/s\n",
+            typeName,
+            1 << log2Decim,
+            "legacy",
+            (unsigned long long) nbSamples,
+            (nbSamples * 1000.0) / legacyNsecs);
+
+        QJsonObject legacyDetails;
+        legacyDetails.insert("type", typeName);
+        legacyDetails.insert("decimation", 1 << log2Decim);
+        legacyDetails.insert("position", QString("cen"));
+        legacyDetails.insert("kernels", QString("legacy"));
+        bench.addResult("decimators", QString("%1 decim %2 cen legacy").arg(typeName).arg(1 << log2Decim),
+            nbSamples, legacyNsecs, legacyDetails);
+
+        for (int a = 0; a < 4; a++)
+        {
+            const DecimatorsSIMDKernels *kernels = DecimatorsSIMD::getKernels(archs[a]);
+
+            if (kernels == 0) {
+                continue;
+            }
+
+            Decimators<T, SDR_SAMP_SZ, InputBits> *decimators = new Decimators<T, SDR_SAMP_SZ, InputBits>();
+            SampleVector& result = (a == 0) ? reference : output;
+            SampleVector::iterator it = result.begin();
+            QElapsedTimer timer;
+
+            decimators->setKernels(kernels);
+            timer.start();
+
+            for (std::size_t i = 0; i < nbBlocks; i++) {
+                (decimators->*functions[log2Decim - 1])(&it, &buf[0], 2*blockSize);
+            }
+
+            qint64 nsecs = timer.nsecsElapsed();
+            int nbOut = it - result.begin();
+            int mismatches = 0;
+            int legacyMismatches = nbOut == nbLegacyOut ? 0 : nbOut > nbLegacyOut ? nbOut - nbLegacyOut : nbLegacyOut - nbOut;
+
+            for (int i = 0; (a != 0) && (i < nbOut); i++)
+            {
+                if ((result[i].real() != reference[i].real()) || (result[i].imag() != reference[i].imag())) {
+                    mismatches++;
+                }
+            }
+
+            for (int i = 0; (i < nbOut) && (i < nbLegacyOut); i++)
+            {
+                if ((result[i].real() != legacy[i].real()) || (result[i].imag() != legacy[i].imag())) {
+                    legacyMismatches++;
+                }
+            }
+
+            printf("Decimators %-4s decim %2d %-7s: %llu samples: %8.2f MS/s %d mismatches %d legacy mismatches\n",
+                typeName,
+                1 << log2Decim,
+                kernels->m_name,
+                (unsigned long long) nbSamples,
+                (nbSamples * 1000.0) / nsecs,
+                mismatches,
+                legacyMismatches);
+
+            QJsonObject details;
+            details.insert("type", typeName);
+            details.insert("decimation", 1 << log2Decim);
+            details.insert("position", QString("cen"));
+            details.insert("kernels", kernels->m_name);
+            details.insert("mismatches", mismatches);
+            details.insert("legacyMismatches", legacyMismatches);
+            bench.addResult("decimators", QString("%1 decim %2 cen %3").arg(typeName).arg(1 << log2Decim).arg(kernels->m_name),
+                nbSamples, nsecs, details);
+
+            delete decimators;
+        }
+    }
+}
+
+/**
+ * Runs every decimation the device plugins can select, that is all the ratios with the
+ * infradyne, supradyne and centered positions, with the default kernels of the CPU.
+ * The unsigned by 2 decimation is only meaningful for unsigned input.
+ */
+template<typename T, uint InputBits>
+void testDecimatorsPositions(MainBench& bench, const char *typeName, quint64 nbSamplesMax, uint blockSize)
+{
+    typedef Decimators<T, SDR_SAMP_SZ, InputBits> DecimatorsType;
+    typedef void (DecimatorsType::*DecimateFunction)(SampleVector::iterator*, const T*, qint32);
+    struct Decimation {
+        int decimation;
+        const char *position;
+        DecimateFunction function;
+    };
+    const Decimation decimations[] = {
+        { 1, "none", &DecimatorsType::decimate1 },
+        { 2, "u", &DecimatorsType::decimate2_u },
+        { 2, "inf", &DecimatorsType::decimate2_inf },
+        { 2, "sup", &DecimatorsType::decimate2_sup },
+        { 2, "cen", &DecimatorsType::decimate2_cen },
+        { 4, "inf", &DecimatorsType::decimate4_inf },
+        { 4, "sup", &DecimatorsType::decimate4_sup },
+        { 4, "cen", &DecimatorsType::decimate4_cen },
+        { 8, "inf", &DecimatorsType::decimate8_inf },
+        { 8, "sup", &DecimatorsType::decimate8_sup },
+        { 8, "cen", &DecimatorsType::decimate8_cen },
+        { 16, "inf", &DecimatorsType::decimate16_inf },
+        { 16, "sup", &DecimatorsType::decimate16_sup },
+        { 16, "cen", &DecimatorsType::decimate16_cen },
+        { 32, "inf", &DecimatorsType::decimate32_inf },
+        { 32, "sup", &DecimatorsType::decimate32_sup },
+        { 32, "cen", &DecimatorsType::decimate32_cen },
+        { 64, "inf", &DecimatorsType::decimate64_inf },
+        { 64, "sup", &DecimatorsType::decimate64_sup },
+        { 64, "cen", &DecimatorsType::decimate64_cen }
+    };
+    const bool unsignedInput = ((T) -1) > 0;
+
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    std::vector<T> buf(2*blockSize);
+    SampleVector output(blockSize); // decimation by 1 writes one sample per input sample
+    int amplitude = 1 << (InputBits - 1);
+
+    srand(1);
+
+    for (uint i = 0; i < 2*blockSize; i++) {
+        buf[i] = (T) ((rand() % (2*amplitude)) - (unsignedInput ? 0 : amplitude));
+    }
+
+    for (std::size_t d = 0; d < sizeof(decimations)/sizeof(decimations[0]); d++)
+    {
+        if ((decimations[d].position[0] == 'u') && !unsignedInput) {
+            continue;
+        }
+
+        DecimatorsType decimators;
+        QElapsedTimer timer;
+        timer.start();
+
+        for (std::size_t i = 0; i < nbBlocks; i++)
+        {
+            SampleVector::iterator it = output.begin();
+            (decimators.*decimations[d].function)(&it, &buf[0], 2*blockSize);
+        }
+
+        qint64 nsecs = timer.nsecsElapsed();
+
+        printf("Decimators %-4s decim %2d %-4s: %llu samples: %8.2f MS/s\n",
+            typeName,
+            decimations[d].decimation,
+            decimations[d].position,
+            (unsigned long long) nbSamples,
+            (nbSamples * 1000.0) / nsecs);
+
+        QJsonObject details;
+        details.insert("type", typeName);
+        details.insert("decimation", decimations[d].decimation);
+        details.insert("position", decimations[d].position);
+        details.insert("kernels", decimators.getKernels()->m_name);
+        bench.addResult("decimators", QString("%1 decim %2 %3").arg(typeName).arg(decimations[d].decimation).arg(decimations[d].position),
+            nbSamples, nsecs, details);
+    }
+}
+
+} // namespace
+
+void MainBench::testDecimators()
+{
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        testDecimatorsType<quint8, 8>(*this, "u8", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testDecimatorsType<qint8, 8>(*this, "s8", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testDecimatorsType<qint16, 12>(*this, "s16", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testDecimatorsPositions<quint8, 8>(*this, "u8", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testDecimatorsPositions<qint8, 8>(*this, "s8", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testDecimatorsPositions<qint16, 12>(*this, "s16", m_parser.getNbSamples(), m_parser.getBlockSize());
+    }
+}
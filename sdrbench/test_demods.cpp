@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/dspcommands.h"
+#include "util/messagequeue.h"
+#include "nfmdemod.h"
+#include "ssbdemod.h"
+#include "bfmdemod.h"
+#include "rdsparser.h"
+#include "mainbench.h"
+
+namespace {
+
+const int demodsBasebandRate = 2400000; //!< typical RTL-SDR rate that is not a power of two multiple of the channel rates
+const int demodsChannelOffset = 100000;
+
+QtMessageHandler demodsPreviousMessageHandler = 0;
+
+/**
+ * Nothing plays the audio FIFOs so they overflow after a few hundred milliseconds and the demodulators
+ * log every short write. These debug messages are dropped while the demodulators run.
+ */
+void demodsMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    if ((type != QtDebugMsg) && demodsPreviousMessageHandler) {
+        demodsPreviousMessageHandler(type, context, msg);
+    }
+}
+
+/** Frequency modulated tone or plain carrier when deviation is zero at the given offset of the baseband */
+void makeDemodsBlock(SampleVector& block, int offset, int deviation, int toneFrequency)
+{
+    double phase = 0.0;
+
+    srand(1);
+
+    for (std::size_t i = 0; i < block.size(); i++)
+    {
+        double t = (double) i / demodsBasebandRate;
+        double frequency = offset + deviation * sin(2.0 * M_PI * toneFrequency * t);
+        phase += (2.0 * M_PI * frequency) / demodsBasebandRate;
+        block[i] = Sample(8192 * cos(phase) + (rand() % 256) - 128, 8192 * sin(phase) + (rand() % 256) - 128);
+    }
+}
+
+/**
+ * Runs the demodulator behind a channelizer the way the device engine does. The configuration messages
+ * posted by the demodulator configure method are applied through the channelizer that passes them on.
+ */
+void testDemod(MainBench& bench, const char *demodName, BasebandSampleSink& demod, MessageQueue& messageQueue,
+        int channelRate, const SampleVector& block, std::size_t nbBlocks)
+{
+    DownChannelizer channelizer(&demod);
+    DSPSignalNotification notif(demodsBasebandRate, 0);
+    channelizer.handleMessage(notif);
+    DSPConfigureChannelizer conf(channelRate, demodsChannelOffset);
+    channelizer.handleMessage(conf);
+
+    Message *message;
+
+    while ((message = messageQueue.pop()) != 0)
+    {
+        channelizer.handleMessage(*message);
+        delete message;
+    }
+
+    channelizer.start();
+
+    quint64 nbSamples = (quint64) nbBlocks * block.size();
+    demodsPreviousMessageHandler = qInstallMessageHandler(demodsMessageHandler);
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        channelizer.feed(block.begin(), block.end(), false);
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    qInstallMessageHandler(demodsPreviousMessageHandler);
+    channelizer.stop();
+
+    printf("%-3s demod channel rate %6d: %llu samples: %8.2f MS/s %6.1f x real time\n",
+        demodName,
+        channelRate,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs,
+        (nbSamples * 1e9) / ((double) nsecs * demodsBasebandRate));
+
+    QJsonObject details;
+    details.insert("basebandRate", demodsBasebandRate);
+    details.insert("channelRate", channelRate);
+    details.insert("realTimeFactor", (nbSamples * 1e9) / ((double) nsecs * demodsBasebandRate));
+    bench.addResult("demods", demodName, nbSamples, nsecs, details);
+}
+
+} // namespace
+
+void MainBench::testDemods()
+{
+    uint blockSize = m_parser.getBlockSize();
+    std::size_t nbBlocks = (m_parser.getNbSamples() + blockSize - 1) / blockSize;
+    SampleVector block(blockSize);
+    MessageQueue messageQueue; // stands for the demodulator input queue normally served by the device engine
+
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        makeDemodsBlock(block, demodsChannelOffset, 2500, 1000);
+        NFMDemod nfmDemod;
+        nfmDemod.configure(&messageQueue, 12500, 3000, 2000, 2.0, 5, false, -40.0, false, false, false, "127.0.0.1", 9999, true);
+        testDemod(*this, "NFM", nfmDemod, messageQueue, 48000, block, nbBlocks);
+
+        makeDemodsBlock(block, demodsChannelOffset + 1000, 0, 0);
+        SSBDemod ssbDemod(0);
+        ssbDemod.configure(&messageQueue, 3000, 300, 2.0, 3, false, false, false, false, true, false, 7, -40, 4);
+        testDemod(*this, "SSB", ssbDemod, messageQueue, 48000, block, nbBlocks);
+
+        makeDemodsBlock(block, demodsChannelOffset, 75000, 1000);
+        RDSParser rdsParser;
+        BFMDemod bfmDemod(0, &rdsParser);
+        bfmDemod.configure(&messageQueue, 250000, 15000, 2.0, -60.0, true, false, false, true, false, "127.0.0.1", 9999, true);
+        testDemod(*this, "BFM", bfmDemod, messageQueue, (3 * 250000) / 2, block, nbBlocks);
+    }
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/fftfilt.h"
+#include "dsp/overlapsavefilter.h"
+#include "mainbench.h"
+
+namespace {
+
+/**
+ * Low pass filters the same pseudo random input with fftfilt fed one sample at a time and with
+ * OverlapSaveFilter fed by device sized blocks in place. The overlap-save output is delayed by one
+ * hop with respect to fftfilt, which is accounted for when the outputs are compared.
+ */
+void testFFTFiltSize(MainBench& bench, int fftSize, quint64 nbSamplesMax, uint blockSize)
+{
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    std::size_t nbSamples = nbBlocks * blockSize;
+    std::vector<Complex> input(nbSamples);
+    std::vector<Complex> reference;
+    std::vector<Complex> output(nbSamples);
+    const float cutoff = 0.1f;
+
+    srand(1);
+
+    for (std::size_t i = 0; i < nbSamples; i++) {
+        input[i] = Complex((rand() % 65536) - 32768, (rand() % 65536) - 32768);
+    }
+
+    reference.reserve(nbSamples);
+    fftfilt filter(cutoff, fftSize);
+    fftfilt::cmplx *filtered;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbSamples; i++)
+    {
+        int nbOut = filter.runFilt(input[i], &filtered);
+        reference.insert(reference.end(), filtered, filtered + nbOut);
+    }
+
+    qint64 nsecsPerSample = timer.nsecsElapsed();
+
+    OverlapSaveFilter::Response response(fftSize);
+    response.createFilter(0, cutoff);
+    OverlapSaveFilter blockFilter(&response);
+    std::copy(input.begin(), input.end(), output.begin());
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        blockFilter.process(&output[i * blockSize], &output[i * blockSize], blockSize); // in place
+    }
+
+    qint64 nsecsBlock = timer.nsecsElapsed();
+    int latency = blockFilter.getLatency();
+    float maxDiff = 0, maxRef = 0;
+
+    for (std::size_t i = 0; (i < reference.size()) && (i + latency < nbSamples); i++)
+    {
+        maxDiff = std::max(maxDiff, std::abs(reference[i] - output[i + latency]));
+        maxRef = std::max(maxRef, std::abs(reference[i]));
+    }
+
+    printf("FFT filter size %5d: %llu samples: fftfilt %8.2f MS/s overlap-save %8.2f MS/s max relative difference %.2e\n",
+        fftSize,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecsPerSample,
+        (nbSamples * 1000.0) / nsecsBlock,
+        maxRef == 0 ? 0.0 : maxDiff / maxRef);
+
+    QJsonObject details;
+    details.insert("fftSize", fftSize);
+    bench.addResult("fftfilt", QString("fftfilt size %1").arg(fftSize), nbSamples, nsecsPerSample, details);
+    details.insert("maxRelativeDifference", maxRef == 0 ? 0.0 : maxDiff / maxRef);
+    bench.addResult("fftfilt", QString("overlap-save size %1").arg(fftSize), nbSamples, nsecsBlock, details);
+}
+
+} // namespace
+
+void MainBench::testFFTFilt()
+{
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (int fftSize = 256; fftSize <= 4096; fftSize *= 2) {
+            testFFTFiltSize(*this, fftSize, m_parser.getNbSamples(), m_parser.getBlockSize());
+        }
+    }
+}
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/inthalfbandfilter.h"
+#include "dsp/inthalfbandfiltereo1.h"
+#include "dsp/inthalfbandfilterdb.h"
+#include "dsp/inthalfbandfilterst.h"
+#include "mainbench.h"
+
+namespace {
+
+const char *halfbandModeNames[3] = {"center", "lower", "upper"};
+
+/**
+ * Decimates by 2 the same block nbBlocks times. The implementations do not all keep the same
+ * input sample parity so their outputs are not compared, only the output sample count is checked.
+ */
+template<class HBFilter>
+qint64 decimateBlocks(int mode, const SampleVector& block, std::size_t nbBlocks, SampleVector& output, std::size_t& nbOut)
+{
+    bool (HBFilter::*work)(Sample*);
+
+    if (mode == 0) {
+        work = &HBFilter::workDecimateCenter;
+    } else if (mode == 1) {
+        work = &HBFilter::workDecimateLowerHalf;
+    } else {
+        work = &HBFilter::workDecimateUpperHalf;
+    }
+
+    HBFilter *filter = new HBFilter();
+    QElapsedTimer timer;
+    timer.start();
+
+    nbOut = 0;
+
+    for (std::size_t i = 0; i < nbBlocks; i++)
+    {
+        SampleVector::iterator out = output.begin();
+
+        for (SampleVector::const_iterator it = block.begin(); it != block.end(); ++it)
+        {
+            Sample s = *it;
+
+            if ((filter->*work)(&s)) {
+                *out++ = s;
+            }
+        }
+
+        nbOut += out - output.begin();
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    delete filter;
+    return nsecs;
+}
+
+/**
+ * Interpolates by 2 the first half of the block nbBlocks times so that as many samples
+ * are produced as with the decimation.
+ */
+template<class HBFilter>
+qint64 interpolateBlocks(int mode, const SampleVector& block, std::size_t nbBlocks, SampleVector& output, std::size_t& nbOut)
+{
+    bool (HBFilter::*work)(Sample*, Sample*);
+
+    if (mode == 0) {
+        work = &HBFilter::workInterpolateCenter;
+    } else if (mode == 1) {
+        work = &HBFilter::workInterpolateLowerHalf;
+    } else {
+        work = &HBFilter::workInterpolateUpperHalf;
+    }
+
+    HBFilter *filter = new HBFilter();
+    std::size_t nbIn = block.size() / 2;
+    QElapsedTimer timer;
+    timer.start();
+    nbOut = 0;
+
+    for (std::size_t i = 0; i < nbBlocks; i++)
+    {
+        SampleVector::iterator out = output.begin();
+
+        for (std::size_t j = 0; j < nbIn; ++out)
+        {
+            Sample s = block[j];
+
+            if ((filter->*work)(&s, &(*out))) {
+                j++;
+            }
+        }
+
+        nbOut += out - output.begin();
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    delete filter;
+    return nsecs;
+}
+
+void reportHalfband(MainBench& bench, const char *filterName, int order, const char *operation, int mode,
+        quint64 nbSamples, qint64 nsecs, std::size_t nbOut)
+{
+    printf("Halfband %-20s order %3d %-11s %-6s: %llu samples: %8.2f MS/s %llu output samples\n",
+        filterName,
+        order,
+        operation,
+        halfbandModeNames[mode],
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs,
+        (unsigned long long) nbOut);
+
+    QJsonObject details;
+    details.insert("filter", filterName);
+    details.insert("order", order);
+    details.insert("operation", operation);
+    details.insert("mode", halfbandModeNames[mode]);
+    details.insert("outputSamples", (double) nbOut);
+    bench.addResult("halfband", QString("%1 %2 %3 %4").arg(filterName).arg(order).arg(operation).arg(halfbandModeNames[mode]),
+        nbSamples, nsecs, details);
+}
+
+/**
+ * Runs the plain, EO1, DB and ST variants on the same input. Counts are in high rate samples:
+ * input when decimating, output when interpolating.
+ */
+template<class HBFilter>
+void testHalfbandFilter(MainBench& bench, const char *filterName, int order, const SampleVector& block, std::size_t nbBlocks)
+{
+    quint64 nbSamples = (quint64) nbBlocks * block.size();
+    SampleVector output(block.size());
+    std::size_t nbOut;
+
+    for (int mode = 0; mode < 3; mode++)
+    {
+        qint64 nsecs = decimateBlocks<HBFilter>(mode, block, nbBlocks, output, nbOut);
+        reportHalfband(bench, filterName, order, "decimate", mode, nbSamples, nsecs, nbOut);
+    }
+
+    for (int mode = 0; mode < 3; mode++)
+    {
+        qint64 nsecs = interpolateBlocks<HBFilter>(mode, block, nbBlocks, output, nbOut);
+        reportHalfband(bench, filterName, order, "interpolate", mode, nbSamples, nsecs, nbOut);
+    }
+}
+
+template<uint32_t HBFilterOrder>
+void testHalfbandOrder(MainBench& bench, quint64 nbSamplesMax, uint blockSize)
+{
+    blockSize = (blockSize / 2) * 2;
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    SampleVector block(blockSize);
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Sample((rand() % 16384) - 8192, (rand() % 16384) - 8192);
+    }
+
+    testHalfbandFilter<IntHalfbandFilter<HBFilterOrder> >(bench, "IntHalfbandFilter", HBFilterOrder, block, nbBlocks);
+    testHalfbandFilter<IntHalfbandFilterEO1<HBFilterOrder> >(bench, "IntHalfbandFilterEO1", HBFilterOrder, block, nbBlocks);
+    testHalfbandFilter<IntHalfbandFilterDB<HBFilterOrder> >(bench, "IntHalfbandFilterDB", HBFilterOrder, block, nbBlocks);
+    testHalfbandFilter<IntHalfbandFilterST<HBFilterOrder> >(bench, "IntHalfbandFilterST", HBFilterOrder, block, nbBlocks);
+}
+
+} // namespace
+
+void MainBench::testHalfband()
+{
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        testHalfbandOrder<48>(*this, m_parser.getNbSamples(), m_parser.getBlockSize()); // down channelizer
+        testHalfbandOrder<96>(*this, m_parser.getNbSamples(), m_parser.getBlockSize()); // up channelizer
+    }
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/interpolator.h"
+#include "mainbench.h"
+
+namespace {
+
+/**
+ * Decimates the same pseudo random input from inputRate to the 48 kS/s audio rate the way the
+ * demodulators do, once one sample at a time and once by blocks. Both forms give the same outputs.
+ */
+void testInterpolatorDecimate(MainBench& bench, int inputRate, Real cutoff, quint64 nbSamplesMax, uint blockSize)
+{
+    const int outputRate = 48000;
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    std::vector<Complex> block(blockSize);
+    std::vector<Complex> reference(blockSize);
+    std::vector<Complex> output(blockSize);
+    Real distance = (Real) inputRate / (Real) outputRate;
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Complex((rand() % 65536) / 32768.0f - 1.0f, (rand() % 65536) / 32768.0f - 1.0f);
+    }
+
+    Interpolator interpolator;
+    interpolator.create(16, inputRate, cutoff);
+    Real distanceRemain = 0;
+    int nbOutRef = 0;
+    Complex ci;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++)
+    {
+        nbOutRef = 0;
+
+        for (uint j = 0; j < blockSize; j++)
+        {
+            if (interpolator.decimate(&distanceRemain, block[j], &ci))
+            {
+                reference[nbOutRef++] = ci;
+                distanceRemain += distance;
+            }
+        }
+    }
+
+    qint64 nsecsPerSample = timer.nsecsElapsed();
+
+    Interpolator blockInterpolator;
+    blockInterpolator.create(16, inputRate, cutoff);
+    distanceRemain = 0;
+    int nbOut = 0;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        nbOut = blockInterpolator.decimate(&distanceRemain, distance, &block[0], blockSize, output);
+    }
+
+    qint64 nsecsBlock = timer.nsecsElapsed();
+    float maxDiff = 0, maxRef = 0;
+
+    for (int i = 0; (i < nbOut) && (i < nbOutRef); i++)
+    {
+        maxDiff = std::max(maxDiff, std::abs(reference[i] - output[i]));
+        maxRef = std::max(maxRef, std::abs(reference[i]));
+    }
+
+    printf("Interpolator decimate %7d -> %d: %llu samples: per sample %8.2f MS/s block %8.2f MS/s max relative difference %.2e\n",
+        inputRate,
+        outputRate,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecsPerSample,
+        (nbSamples * 1000.0) / nsecsBlock,
+        maxRef == 0 ? 0.0 : maxDiff / maxRef);
+
+    QJsonObject details;
+    details.insert("operation", QString("decimate"));
+    details.insert("inputRate", inputRate);
+    details.insert("outputRate", outputRate);
+    bench.addResult("interpolator", QString("decimate %1 per sample").arg(inputRate), nbSamples, nsecsPerSample, details);
+    details.insert("maxRelativeDifference", maxRef == 0 ? 0.0 : maxDiff / maxRef);
+    bench.addResult("interpolator", QString("decimate %1 block").arg(inputRate), nbSamples, nsecsBlock, details);
+}
+
+/**
+ * Upsamples from the 48 kS/s audio rate to outputRate the way the modulators do.
+ * Counts are in output samples.
+ */
+void testInterpolatorInterpolate(MainBench& bench, int outputRate, Real cutoff, quint64 nbSamplesMax, uint blockSize)
+{
+    const int inputRate = 48000;
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    std::vector<Complex> block(blockSize);
+    std::vector<Complex> output(blockSize);
+    Real distance = (Real) inputRate / (Real) outputRate;
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Complex((rand() % 65536) / 32768.0f - 1.0f, 0.0f);
+    }
+
+    Interpolator interpolator;
+    interpolator.create(48, inputRate, cutoff, 3.0);
+    Real distanceRemain = 0;
+    uint inIndex = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++)
+    {
+        for (uint j = 0; j < blockSize; j++)
+        {
+            if (interpolator.interpolate(&distanceRemain, block[inIndex], &output[j])) {
+                inIndex = (inIndex + 1) % blockSize;
+            }
+
+            distanceRemain += distance;
+        }
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    printf("Interpolator interpolate %d -> %7d: %llu samples: %8.2f MS/s\n",
+        inputRate,
+        outputRate,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs);
+
+    QJsonObject details;
+    details.insert("operation", QString("interpolate"));
+    details.insert("inputRate", inputRate);
+    details.insert("outputRate", outputRate);
+    bench.addResult("interpolator", QString("interpolate %1").arg(outputRate), nbSamples, nsecs, details);
+}
+
+} // namespace
+
+void MainBench::testInterpolator()
+{
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        testInterpolatorDecimate(*this, 96000, 12500 / 2.2, m_parser.getNbSamples(), m_parser.getBlockSize());   // NFM
+        testInterpolatorDecimate(*this, 375000, 15000, m_parser.getNbSamples(), m_parser.getBlockSize());        // BFM
+        testInterpolatorDecimate(*this, 1536000, 100000, m_parser.getNbSamples(), m_parser.getBlockSize());      // wide channels
+        testInterpolatorInterpolate(*this, 96000, 12500 / 2.2, m_parser.getNbSamples(), m_parser.getBlockSize()); // NFM modulator
+        testInterpolatorInterpolate(*this, 384000, 12500 / 2.2, m_parser.getNbSamples(), m_parser.getBlockSize());
+    }
+}
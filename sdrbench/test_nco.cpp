@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/nco.h"
+#include "dsp/ncof.h"
+#include "mainbench.h"
+
+namespace {
+
+/**
+ * Shifts the same pseudo random input the way the channels do: with the per sample nextIQ() product
+ * then with the block mixIQ(). The table lookup and the phasor recursion of the block form differ
+ * by a small amount that is reported relative to the input amplitude.
+ */
+template<class Oscillator>
+void testNCOType(MainBench& bench, const char *ncoName, quint64 nbSamplesMax, uint blockSize)
+{
+    const Real frequency = 12345.0f;
+    const Real sampleRate = 48000.0f;
+    std::size_t nbBlocks = (nbSamplesMax + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    SampleVector block(blockSize);
+    std::vector<Complex> reference(blockSize);
+    std::vector<Complex> output(blockSize);
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Sample((rand() % 65536) - 32768, (rand() % 65536) - 32768);
+    }
+
+    Oscillator nco;
+    nco.setFreq(frequency, sampleRate);
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++)
+    {
+        for (uint j = 0; j < blockSize; j++) {
+            reference[j] = Complex(block[j].real(), block[j].imag()) * nco.nextIQ();
+        }
+    }
+
+    qint64 nsecsPerSample = timer.nsecsElapsed();
+
+    Oscillator blockNco;
+    blockNco.setFreq(frequency, sampleRate);
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        blockNco.mixIQ(block.begin(), block.end(), output);
+    }
+
+    qint64 nsecsBlock = timer.nsecsElapsed();
+    float maxDiff = 0;
+
+    for (uint i = 0; i < blockSize; i++) {
+        maxDiff = std::max(maxDiff, std::abs(reference[i] - output[i]));
+    }
+
+    printf("%-4s: %llu samples: nextIQ %8.2f MS/s mixIQ %8.2f MS/s max relative difference %.2e\n",
+        ncoName,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecsPerSample,
+        (nbSamples * 1000.0) / nsecsBlock,
+        maxDiff / 32768.0);
+
+    QJsonObject details;
+    details.insert("oscillator", ncoName);
+    bench.addResult("nco", QString("%1 nextIQ").arg(ncoName), nbSamples, nsecsPerSample, details);
+    details.insert("maxRelativeDifference", maxDiff / 32768.0);
+    bench.addResult("nco", QString("%1 mixIQ").arg(ncoName), nbSamples, nsecsBlock, details);
+}
+
+} // namespace
+
+void MainBench::testNCO()
+{
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        testNCOType<NCO>(*this, "NCO", m_parser.getNbSamples(), m_parser.getBlockSize());
+        testNCOType<NCOF>(*this, "NCOF", m_parser.getNbSamples(), m_parser.getBlockSize());
+    }
+}
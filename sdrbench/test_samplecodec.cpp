@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/samplecodec.h"
+#include "dsp/samplepacker.h"
+#include "mainbench.h"
+
+namespace {
+
+enum Signal
+{
+    SignalZero,      //!< Rice parameter 0
+    SignalMax,       //!< positive full scale: first difference of the first group is the largest positive one
+    SignalMin,       //!< negative full scale
+    SignalAlternate, //!< full scale square wave at Nyquist: largest differences on every value
+    SignalSteps,     //!< full scale steps at group boundaries: the difference with the previous group matters
+    SignalLSB,       //!< +/-1 LSB noise: smallest non zero Rice parameter
+    SignalTone,      //!< full scale slow tone: differences coded
+    SignalNoise,     //!< full scale random noise: groups stored packed
+    SignalOverload,  //!< 16 bit full scale that saturates when reduced
+    SignalCount
+};
+
+const char *signalNames[SignalCount] = { "zero", "max", "min", "alternate", "steps", "lsb", "tone", "noise", "overload" };
+
+void generate(SampleVector& samples, Signal signal, int sampleBits, int sampleShift)
+{
+    qint32 max = ((1 << (sampleBits - 1)) - 1) << sampleShift;
+    qint32 min = -(1 << (sampleBits - 1 + sampleShift));
+
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        qint32 re, im;
+
+        switch (signal)
+        {
+        case SignalMax:
+            re = max;
+            im = max;
+            break;
+        case SignalMin:
+            re = min;
+            im = min;
+            break;
+        case SignalAlternate:
+            re = (i & 1) ? min : max;
+            im = (i & 1) ? max : min;
+            break;
+        case SignalSteps:
+            re = ((i / 32) & 1) ? min : max;
+            im = ((i / 32) & 1) ? max : min;
+            break;
+        case SignalLSB:
+            re = ((rand() % 3) - 1) * (1 << sampleShift);
+            im = ((rand() % 3) - 1) * (1 << sampleShift);
+            break;
+        case SignalTone:
+            re = (qint32) lrint(max * cos(2.0 * M_PI * i / 1000.0));
+            im = (qint32) lrint(max * sin(2.0 * M_PI * i / 1000.0));
+            break;
+        case SignalNoise:
+            re = ((rand() % (1 << sampleBits)) - (1 << (sampleBits - 1))) * (1 << sampleShift);
+            im = ((rand() % (1 << sampleBits)) - (1 << (sampleBits - 1))) * (1 << sampleShift);
+            break;
+        case SignalOverload:
+            re = (i & 1) ? -32768 : 32767;
+            im = (i & 2) ? -32768 : 32767;
+            break;
+        default:
+            re = 0;
+            im = 0;
+            break;
+        }
+
+        samples[i] = Sample(re, im);
+    }
+}
+
+/**
+ * Encodes then decodes a signal. The decoded samples must be the same as after packing and
+ * unpacking, that is the codec must add no loss to the bit depth reduction. The encoder must refuse
+ * an output buffer one byte too short and the decoder must refuse the input truncated by one byte.
+ */
+bool testSampleCodecSignal(MainBench& bench, Signal signal, int sampleBits, uint nbSamples, uint repetition)
+{
+    int sampleShift = 16 - sampleBits;
+    SampleVector input(nbSamples);
+    SampleVector reference(nbSamples);
+    SampleVector output(nbSamples);
+    std::vector<quint8> packed(nbSamples * SamplePacker::getBytesPerSample(sampleBits));
+    std::vector<quint8> encoded(nbSamples * 8 + 16); // worst case is the packed size plus the group headers
+
+    srand(1);
+    generate(input, signal, sampleBits, sampleShift);
+    SamplePacker::pack(&input[0], nbSamples, &packed[0], sampleBits, sampleShift);
+    SamplePacker::unpack(&packed[0], nbSamples, &reference[0], sampleBits, sampleShift);
+
+    uint encodedSize = 0;
+    uint decodedSize = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (uint i = 0; i < repetition; i++)
+    {
+        encodedSize = SampleCodec::encode(&input[0], nbSamples, &encoded[0], encoded.size(), sampleBits, sampleShift);
+        decodedSize = SampleCodec::decode(&encoded[0], encodedSize, &output[0], nbSamples, sampleBits, sampleShift);
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    int mismatches = 0;
+
+    for (uint i = 0; i < nbSamples; i++)
+    {
+        if ((output[i].real() != reference[i].real()) || (output[i].imag() != reference[i].imag())) {
+            mismatches++;
+        }
+    }
+
+    bool overflowRefused = (encodedSize > 0) && (SampleCodec::encode(&input[0], nbSamples, &encoded[0], encodedSize - 1, sampleBits, sampleShift) == 0);
+    SampleVector truncatedOutput(nbSamples);
+    bool truncationRefused = (encodedSize > 0) && (SampleCodec::decode(&encoded[0], encodedSize - 1, &truncatedOutput[0], nbSamples, sampleBits, sampleShift) == 0);
+    bool passed = (encodedSize > 0) && (decodedSize == encodedSize) && (mismatches == 0) && overflowRefused && truncationRefused;
+
+    printf("SampleCodec %2d bits %-9s %5u samples: %6u bytes (%5.1f%% of packed) %d mismatches%s%s: %s\n",
+        sampleBits,
+        signalNames[signal],
+        nbSamples,
+        encodedSize,
+        (encodedSize * 100.0) / packed.size(),
+        mismatches,
+        overflowRefused ? "" : " overflow accepted",
+        truncationRefused ? "" : " truncation accepted",
+        passed ? "OK" : "FAILED");
+
+    QJsonObject details;
+    details.insert("sampleBits", sampleBits);
+    details.insert("signal", signalNames[signal]);
+    details.insert("bytes", (int) encodedSize);
+    details.insert("packedBytes", (int) packed.size());
+    details.insert("mismatches", mismatches);
+    details.insert("passed", passed);
+    bench.addResult("codec", QString("%1 bits %2 %3").arg(sampleBits).arg(signalNames[signal]).arg(nbSamples),
+        (quint64) nbSamples * repetition, nsecs, details);
+
+    return passed;
+}
+
+} // namespace
+
+void MainBench::testSampleCodec()
+{
+    const int sampleBits[3] = { 8, 12, 16 };
+    const uint lengths[4] = { 1, 31, 33, 127*127 }; // partial groups and an SDRdaemon frame
+    bool ok = true;
+
+    for (int b = 0; b < 3; b++)
+    {
+        for (int s = 0; s < SignalCount; s++)
+        {
+            for (int l = 0; l < 4; l++) {
+                ok = testSampleCodecSignal(*this, (Signal) s, sampleBits[b], lengths[l], m_parser.getRepetition()) && ok;
+            }
+        }
+    }
+
+    if (!ok) {
+        m_exitCode = 1;
+    }
+}
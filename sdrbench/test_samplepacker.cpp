@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/decimators.h"
+#include "dsp/samplepacker.h"
+#include "mainbench.h"
+
+namespace {
+
+/**
+ * Native recording round trip: a tone at 90% of the full scale of a device with InputBits bits goes
+ * through each center decimation, then is packed back to InputBits bits with the native shift and
+ * unpacked. The packed values must not saturate and must still span most of the range, and the
+ * unpacked samples must be within half a packing step of the decimator output.
+ */
+template<typename T, uint InputBits>
+bool testSamplePackerType(MainBench& bench, const char *typeName, uint repetition)
+{
+    typedef Decimators<T, SDR_SAMP_SZ, InputBits> DecimatorsType;
+    typedef void (DecimatorsType::*DecimateFunction)(SampleVector::iterator*, const T*, qint32);
+    const DecimateFunction functions[7] = {
+        &DecimatorsType::decimate1,
+        &DecimatorsType::decimate2_cen,
+        &DecimatorsType::decimate4_cen,
+        &DecimatorsType::decimate8_cen,
+        &DecimatorsType::decimate16_cen,
+        &DecimatorsType::decimate32_cen,
+        &DecimatorsType::decimate64_cen
+    };
+    const uint blockSize = 16384;      // multiple of the tone periods so that blocks join without a phase jump
+    const uint nbBlocks = 8 * repetition;
+    const int sampleShift = SamplePacker::getNativeShift(InputBits);
+    const qint32 maxValue = (1 << (InputBits - 1)) - 1;
+    std::vector<T> buf(2*blockSize);
+    SampleVector decimated(blockSize);
+    SampleVector unpacked(blockSize);
+    std::vector<quint8> packed(blockSize * SamplePacker::getBytesPerSample(InputBits));
+    bool ok = true;
+
+    for (int log2Decim = 0; log2Decim <= 6; log2Decim++)
+    {
+        double frequency = 1.0 / (16 << log2Decim); // cycles per input sample: in the pass band at every ratio
+
+        for (uint i = 0; i < blockSize; i++)
+        {
+            buf[2*i]   = (T) lrint(0.9 * maxValue * cos(2.0 * M_PI * frequency * i));
+            buf[2*i+1] = (T) lrint(0.9 * maxValue * sin(2.0 * M_PI * frequency * i));
+        }
+
+        DecimatorsType decimators;
+        quint64 nbSamples = 0;
+        qint64 nsecs = 0;
+        int saturated = 0;
+        qint32 peak = 0;
+        qint32 maxError = 0;
+
+        for (uint b = 0; b < nbBlocks; b++)
+        {
+            SampleVector::iterator it = decimated.begin();
+            (decimators.*functions[log2Decim])(&it, &buf[0], 2*blockSize);
+            uint nbOut = it - decimated.begin();
+
+            if (b == 0) { // filters settling
+                continue;
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            SamplePacker::pack(&decimated[0], nbOut, &packed[0], InputBits, sampleShift);
+            SamplePacker::unpack(&packed[0], nbOut, &unpacked[0], InputBits, sampleShift);
+            nsecs += timer.nsecsElapsed();
+            nbSamples += nbOut;
+
+            for (uint i = 0; i < nbOut; i++)
+            {
+                qint32 values[2] = { unpacked[i].real(), unpacked[i].imag() };
+                qint32 errors[2] = { unpacked[i].real() - decimated[i].real(), unpacked[i].imag() - decimated[i].imag() };
+
+                for (int k = 0; k < 2; k++)
+                {
+                    qint32 value = values[k] / (1 << sampleShift);
+
+                    if ((value >= maxValue) || (value <= -maxValue - 1)) {
+                        saturated++;
+                    }
+
+                    peak = abs(value) > peak ? abs(value) : peak;
+                    maxError = abs(errors[k]) > maxError ? abs(errors[k]) : maxError;
+                }
+            }
+        }
+
+        bool passed = (saturated == 0)
+            && (peak >= (8 * maxValue) / 10)
+            && (maxError <= (sampleShift > 0 ? 1 << (sampleShift - 1) : 0));
+        ok = ok && passed;
+
+        printf("SamplePacker %-4s decim %2d: shift %d peak %5d/%d saturated %d max error %d: %s\n",
+            typeName,
+            1 << log2Decim,
+            sampleShift,
+            peak,
+            maxValue,
+            saturated,
+            maxError,
+            passed ? "OK" : "FAILED");
+
+        QJsonObject details;
+        details.insert("type", typeName);
+        details.insert("decimation", 1 << log2Decim);
+        details.insert("sampleShift", sampleShift);
+        details.insert("peak", peak);
+        details.insert("saturated", saturated);
+        details.insert("maxError", maxError);
+        details.insert("passed", passed);
+        bench.addResult("packer", QString("%1 decim %2").arg(typeName).arg(1 << log2Decim), nbSamples, nsecs, details);
+    }
+
+    return ok;
+}
+
+} // namespace
+
+void MainBench::testSamplePacker()
+{
+    bool ok = testSamplePackerType<qint8, 8>(*this, "s8", m_parser.getRepetition());
+    ok = testSamplePackerType<qint16, 12>(*this, "s16", m_parser.getRepetition()) && ok;
+
+    if (!ok) {
+        m_exitCode = 1;
+    }
+}
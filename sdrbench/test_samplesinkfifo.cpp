@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <vector>
+
+#include <QThread>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QDebug>
+
+#include "dsp/samplesinkfifo.h"
+#include "mainbench.h"
+
+namespace {
+
+const uint fifoSize = 1<<19; // same as Airspy and HackRF device FIFOs
+
+/**
+ * Plays the device thread: pushes device sized blocks into the FIFO waiting for room
+ * so that no sample is dropped and time stamps each block just before it is written.
+ */
+class FifoBenchProducer : public QThread
+{
+public:
+    FifoBenchProducer(SampleSinkFifo& fifo, const SampleVector& block, const QElapsedTimer& timer, std::vector<qint64>& stamps) :
+        m_fifo(fifo),
+        m_block(block),
+        m_timer(timer),
+        m_stamps(stamps)
+    {}
+
+private:
+    SampleSinkFifo& m_fifo;
+    const SampleVector& m_block;
+    const QElapsedTimer& m_timer;
+    std::vector<qint64>& m_stamps;
+
+    void run()
+    {
+        uint blockSize = m_block.size();
+
+        for (std::size_t i = 0; i < m_stamps.size(); i++)
+        {
+            while (m_fifo.size() - m_fifo.fill() < blockSize) {
+                QThread::yieldCurrentThread();
+            }
+
+            m_stamps[i] = m_timer.nsecsElapsed();
+            m_fifo.write(m_block.begin(), m_block.end());
+        }
+    }
+};
+
+} // namespace
+
+void MainBench::testSampleSinkFifo()
+{
+    if (m_parser.getBlockSize() > fifoSize) // the producer would wait forever for room
+    {
+        qWarning() << "MainBench::testSampleSinkFifo: block size " << m_parser.getBlockSize()
+            << " larger than the FIFO size " << fifoSize;
+        m_exitCode = 1;
+        return;
+    }
+
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        testSampleSinkFifo(false);
+        testSampleSinkFifo(true);
+    }
+}
+
+void MainBench::testSampleSinkFifo(bool lockFree)
+{
+    uint blockSize = m_parser.getBlockSize();
+    std::size_t nbBlocks = (m_parser.getNbSamples() + blockSize - 1) / blockSize;
+    quint64 nbSamples = (quint64) nbBlocks * blockSize;
+    SampleVector block(blockSize);
+    std::vector<qint64> stamps(nbBlocks);
+    SampleSinkFifo fifo;
+    QElapsedTimer timer;
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Sample(i & 0x7FFF, (blockSize - i) & 0x7FFF);
+    }
+
+    fifo.setLockFree(lockFree);
+    fifo.setSize(fifoSize);
+
+    FifoBenchProducer producer(fifo, block, timer, stamps);
+    quint64 samplesRead = 0;
+    std::size_t blockIndex = 0;
+    qint64 latencySum = 0;
+    qint64 latencyMax = 0;
+    quint32 checksum = 0; // wraps around on long runs
+
+    timer.start();
+    producer.start();
+
+    while (samplesRead < nbSamples)
+    {
+        uint fill = fifo.fill();
+
+        if (fill == 0)
+        {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        SampleVector::iterator part1begin;
+        SampleVector::iterator part1end;
+        SampleVector::iterator part2begin;
+        SampleVector::iterator part2end;
+
+        uint count = fifo.readBegin(fill, &part1begin, &part1end, &part2begin, &part2end);
+
+        // touch the data as a sink would do
+        for (SampleVector::iterator it = part1begin; it != part1end; ++it) {
+            checksum += it->real();
+        }
+        for (SampleVector::iterator it = part2begin; it != part2end; ++it) {
+            checksum += it->real();
+        }
+
+        fifo.readCommit(count);
+        samplesRead += count;
+
+        qint64 now = timer.nsecsElapsed();
+
+        while ((blockIndex < nbBlocks) && ((quint64) (blockIndex + 1) * blockSize <= samplesRead))
+        {
+            qint64 latency = now - stamps[blockIndex];
+            latencySum += latency;
+            latencyMax = latency > latencyMax ? latency : latencyMax;
+            blockIndex++;
+        }
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+    producer.wait();
+
+    printf("SampleSinkFifo %-9s: %llu samples in blocks of %u: %8.2f MS/s latency avg: %8.1f us max: %8.1f us (checksum %08x)\n",
+        lockFree ? "lock free" : "mutex",
+        (unsigned long long) nbSamples,
+        blockSize,
+        (nbSamples * 1000.0) / nsecs,
+        latencySum / (nbBlocks * 1000.0),
+        latencyMax / 1000.0,
+        checksum);
+
+    QJsonObject details;
+    details.insert("blockSize", (int) blockSize);
+    details.insert("latencyAvgUs", latencySum / (nbBlocks * 1000.0));
+    details.insert("latencyMaxUs", latencyMax / 1000.0);
+    addResult("fifo", lockFree ? "lock free" : "mutex", nbSamples, nsecs, details);
+}
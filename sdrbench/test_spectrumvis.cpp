@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "dsp/spectrumvis.h"
+#include "dsp/glspectruminterface.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Stands for the display: only counts the spectrums it is sent */
+class SpectrumBenchDisplay : public GLSpectrumInterface
+{
+public:
+    SpectrumBenchDisplay() : m_count(0) {}
+
+    virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize, int lineSamples)
+    {
+        (void) spectrum;
+        (void) fftSize;
+        (void) lineSamples;
+        m_count++;
+    }
+
+    int getCount() const { return m_count; }
+
+private:
+    int m_count;
+};
+
+/**
+ * Feeds device sized blocks to the spectrum. Only the FFTs due for display are computed, that is one
+ * or the averaged ones per spectrum, so the rate mostly depends on the display period.
+ * Returns the number of spectrums sent to the display.
+ */
+int testSpectrumVisConfig(MainBench& bench, int fftSize, int overlapPercent, SpectrumVis::AvgMode avgMode, int avgNb,
+        const SampleVector& block, std::size_t nbBlocks)
+{
+    const char *avgModeNames[4] = {"none", "mean", "peak", "min"};
+    SpectrumBenchDisplay display;
+    SpectrumVis spectrumVis(&display);
+    SpectrumVis::MsgConfigureSpectrumVis conf(fftSize, overlapPercent, FFTWindow::BlackmanHarris, avgMode, avgNb);
+    spectrumVis.handleMessage(conf);
+
+    quint64 nbSamples = (quint64) nbBlocks * block.size();
+    QElapsedTimer timer;
+    timer.start();
+
+    for (std::size_t i = 0; i < nbBlocks; i++) {
+        spectrumVis.feed(block.begin(), block.end(), false);
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    printf("SpectrumVis FFT %5d overlap %2d%% average %-4s x%-3d: %llu samples: %8.2f MS/s %d spectrums\n",
+        fftSize,
+        overlapPercent,
+        avgModeNames[avgMode],
+        avgNb,
+        (unsigned long long) nbSamples,
+        (nbSamples * 1000.0) / nsecs,
+        display.getCount());
+
+    QJsonObject details;
+    details.insert("fftSize", fftSize);
+    details.insert("overlapPercent", overlapPercent);
+    details.insert("avgMode", avgModeNames[avgMode]);
+    details.insert("avgNb", avgNb);
+    details.insert("spectrums", display.getCount());
+    bench.addResult("spectrum", QString("fft %1 overlap %2 avg %3 x%4").arg(fftSize).arg(overlapPercent).arg(avgModeNames[avgMode]).arg(avgNb),
+        nbSamples, nsecs, details);
+
+    return display.getCount();
+}
+
+} // namespace
+
+void MainBench::testSpectrumVis()
+{
+    uint blockSize = m_parser.getBlockSize();
+    std::size_t nbBlocks = (m_parser.getNbSamples() + blockSize - 1) / blockSize;
+    SampleVector block(blockSize);
+
+    srand(1);
+
+    for (uint i = 0; i < blockSize; i++) {
+        block[i] = Sample((rand() % 65536) - 32768, (rand() % 65536) - 32768);
+    }
+
+    for (uint i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (int fftSize = 1024; fftSize <= 16384; fftSize *= 4)
+        {
+            testSpectrumVisConfig(*this, fftSize, 0, SpectrumVis::AvgModeNone, 1, block, nbBlocks);
+            testSpectrumVisConfig(*this, fftSize, 50, SpectrumVis::AvgModeNone, 1, block, nbBlocks);
+            testSpectrumVisConfig(*this, fftSize, 0, SpectrumVis::AvgModeMean, 10, block, nbBlocks);
+            testSpectrumVisConfig(*this, fftSize, 50, SpectrumVis::AvgModePeak, 10, block, nbBlocks);
+
+            // the number of averages is ignored without averaging: the display must not freeze
+            if (testSpectrumVisConfig(*this, fftSize, 0, SpectrumVis::AvgModeNone, 10, block, nbBlocks) == 0)
+            {
+                printf("SpectrumVis FFT %5d average none x10: no spectrum sent: FAILED\n", fftSize);
+                m_exitCode = 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QSettings>
+
+#include "httplistener.h"
+
+#include "parsersrv.h"
+#include "maincore.h"
+#include "webapiadapter.h"
+#include "webapirequesthandler.h"
+
+static int runQtApplication(int argc, char* argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setOrganizationName("f4exb");
+    QCoreApplication::setApplicationName("SDRangelSrv");
+    QCoreApplication::setApplicationVersion("3.7.0");
+
+    ParserSrv parser;
+    parser.parse(a);
+
+    MainCore m;
+    WebAPIAdapter adapter(m);
+    WebAPIRequestHandler *requestHandler = new WebAPIRequestHandler(&adapter);
+
+    // listener settings are kept apart from the main settings shared with the GUI
+    QSettings *listenerSettings = new QSettings(QSettings::IniFormat, QSettings::UserScope, "f4exb", "sdrangelsrv", &a);
+    listenerSettings->beginGroup("listener");
+    listenerSettings->setValue("host", parser.getServerAddress());
+    listenerSettings->setValue("port", parser.getServerPort());
+
+    stefanfrings::HttpListener *listener = new stefanfrings::HttpListener(listenerSettings, requestHandler);
+    int res = 1;
+
+    if (listener->isListening())
+    {
+        qWarning("SDRangel server listening on %s:%d", qPrintable(parser.getServerAddress()), parser.getServerPort());
+        res = a.exec();
+    }
+    else
+    {
+        qCritical("SDRangel server cannot listen on %s:%d", qPrintable(parser.getServerAddress()), parser.getServerPort());
+    }
+
+    // the listener must go before the request handler, the adapter and the core
+    listener->close();
+    delete listener;
+    delete requestHandler;
+
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    int res = runQtApplication(argc, argv);
+    qWarning("SDRangel server quit.");
+    return res;
+}
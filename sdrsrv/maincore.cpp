@@ -0,0 +1,333 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/dspengine.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/devicesamplesource.h"
+#include "device/devicesourceapi.h"
+#include "channel/channelsinkapi.h"
+#include "plugin/pluginmanager.h"
+#include "settings/preset.h"
+
+#include "maincore.h"
+
+MainCore::MainCore(QObject *parent) :
+    QObject(parent),
+    m_dspEngine(DSPEngine::instance()),
+    m_pluginManager(0)
+{
+    qDebug() << "MainCore::MainCore: start";
+
+    m_settings.setAudioDeviceInfo(&m_audioDeviceInfo);
+
+    m_pluginManager = new PluginManager(0, this);
+    m_pluginManager->loadPlugins();
+
+    connect(&m_purgeTimer, SIGNAL(timeout()), this, SLOT(purgeMessages()));
+    m_purgeTimer.start(1000);
+
+    m_masterTimer.start(50);
+
+    qDebug() << "MainCore::MainCore: load settings...";
+
+    m_settings.load();
+    m_settings.sortPresets();
+
+    qDebug() << "MainCore::MainCore: add the first device...";
+
+    addSourceDevice();
+
+    qDebug() << "MainCore::MainCore: select SampleSource from settings...";
+
+    if (m_pluginManager->selectSampleSourceCoreByIndex(m_settings.getSourceIndex(), m_deviceSets.back()->m_deviceSourceAPI, m_masterTimer) < 0)
+    {
+        qCritical("MainCore::MainCore: sample source from settings cannot be used without GUI. Working preset not loaded.");
+    }
+    else
+    {
+        qDebug() << "MainCore::MainCore: load current preset settings...";
+        QString errorMessage;
+
+        if (!loadPresetSettings(m_settings.getWorkingPreset(), 0, errorMessage)) {
+            qCritical("MainCore::MainCore: working preset not loaded: %s", qPrintable(errorMessage));
+        }
+    }
+
+    qDebug() << "MainCore::MainCore: end";
+}
+
+MainCore::~MainCore()
+{
+    m_dspEngine->stopAudioOutput();
+
+    while (m_deviceSets.size() > 0) {
+        deleteLastDeviceSet();
+    }
+
+    delete m_pluginManager;
+
+    qDebug() << "MainCore::~MainCore: end";
+}
+
+const MainCore::DeviceSet *MainCore::getDeviceSet(int deviceSetIndex) const
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return 0;
+    } else {
+        return m_deviceSets[deviceSetIndex];
+    }
+}
+
+int MainCore::addSourceDevice()
+{
+    DSPDeviceSourceEngine *dspDeviceSourceEngine = m_dspEngine->addDeviceSourceEngine();
+    dspDeviceSourceEngine->start();
+
+    DeviceSet *deviceSet = new DeviceSet();
+    deviceSet->m_deviceSourceEngine = dspDeviceSourceEngine;
+
+    int deviceSetIndex = m_deviceSets.size();
+    deviceSet->m_deviceSourceAPI = new DeviceSourceAPI(0, deviceSetIndex, dspDeviceSourceEngine, 0, 0);
+    m_deviceSets.push_back(deviceSet);
+
+    m_pluginManager->duplicateLocalSampleSourceDevices(dspDeviceSourceEngine->getUID());
+    m_pluginManager->selectSampleSourceCoreBySerialOrSequence("sdrangel.samplesource.filesource", "0", 0, deviceSet->m_deviceSourceAPI, m_masterTimer);
+
+    qDebug("MainCore::addSourceDevice: device set %d added", deviceSetIndex);
+
+    return deviceSetIndex;
+}
+
+bool MainCore::removeLastDevice()
+{
+    if (m_deviceSets.size() < 2) {
+        return false;
+    }
+
+    deleteLastDeviceSet();
+
+    qDebug("MainCore::removeLastDevice: %d device sets left", (int) m_deviceSets.size());
+
+    return true;
+}
+
+void MainCore::deleteLastDeviceSet()
+{
+    DeviceSet *deviceSet = m_deviceSets.back();
+    DeviceSourceAPI *deviceAPI = deviceSet->m_deviceSourceAPI;
+
+    deviceAPI->stopAcquisition();
+    removeChannels(deviceSet);
+
+    DeviceSampleSource *source = deviceAPI->getSource();
+    deviceAPI->setSource(0);
+    delete source;
+    deviceAPI->clearBuddiesLists();
+    delete deviceAPI;
+
+    deviceSet->m_deviceSourceEngine->stop();
+    m_dspEngine->removeLastDeviceSourceEngine();
+
+    delete deviceSet;
+    m_deviceSets.pop_back();
+}
+
+bool MainCore::selectSampleSource(int deviceSetIndex, const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return false;
+    }
+
+    DeviceSourceAPI *deviceAPI = m_deviceSets[deviceSetIndex]->m_deviceSourceAPI;
+
+    return m_pluginManager->selectSampleSourceCoreBySerialOrSequence(sourceId, sourceSerial, sourceSequence, deviceAPI, m_masterTimer) >= 0;
+}
+
+bool MainCore::loadPresetSettings(const Preset *preset, int deviceSetIndex, QString& errorMessage)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size()))
+    {
+        errorMessage = QString("Device set %1 not found").arg(deviceSetIndex);
+        return false;
+    }
+
+    if (!preset->isSourcePreset())
+    {
+        qDebug("MainCore::loadPresetSettings: preset [%s | %s] is not a source preset", qPrintable(preset->getGroup()), qPrintable(preset->getDescription()));
+        errorMessage = "Preset is not a source preset";
+        return false;
+    }
+
+    qDebug("MainCore::loadPresetSettings: preset [%s | %s]", qPrintable(preset->getGroup()), qPrintable(preset->getDescription()));
+
+    DeviceSet *deviceSet = m_deviceSets[deviceSetIndex];
+    DeviceSourceAPI *deviceAPI = deviceSet->m_deviceSourceAPI;
+    DeviceSampleSource *source = deviceAPI->getSource();
+
+    // create all channels first so that a preset the server cannot run leaves the device set untouched
+
+    QList<ChannelSinkAPI*> channels;
+    QStringList channelIds;
+
+    for (int i = 0; i < preset->getChannelCount(); i++)
+    {
+        const Preset::ChannelConfig& channelConfig = preset->getChannelConfig(i);
+        ChannelSinkAPI *channel = m_pluginManager->createRxChannelCoreInstance(channelConfig.m_channel, deviceAPI);
+
+        if (channel == 0)
+        {
+            qWarning("MainCore::loadPresetSettings: channel %s cannot be used without GUI", qPrintable(channelConfig.m_channel));
+            errorMessage = QString("Channel %1 cannot be used without GUI").arg(channelConfig.m_channel);
+
+            while (!channels.isEmpty()) {
+                channels.takeLast()->destroy();
+            }
+
+            return false;
+        }
+
+        channel->deserialize(channelConfig.m_config);
+        channels.append(channel);
+        channelIds.append(channelConfig.m_channel);
+    }
+
+    // source settings
+
+    const QByteArray* sourceConfig = preset->findBestDeviceConfig(deviceAPI->getSampleSourceId(), deviceAPI->getSampleSourceSerial(), deviceAPI->getSampleSourceSequence());
+
+    if (sourceConfig != 0) {
+        source->deserialize(*sourceConfig);
+    } else {
+        qDebug("MainCore::loadPresetSettings: source %s not found in preset", qPrintable(deviceAPI->getSampleSourceId()));
+    }
+
+    source->setCenterFrequency(preset->getCenterFrequency());
+
+    // channels settings
+
+    removeChannels(deviceSet);
+    deviceSet->m_channels = channels;
+    deviceSet->m_channelIds = channelIds;
+    renameChannels(deviceSet);
+
+    return true;
+}
+
+bool MainCore::startAcquisition(int deviceSetIndex)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return false;
+    }
+
+    DeviceSourceAPI *deviceAPI = m_deviceSets[deviceSetIndex]->m_deviceSourceAPI;
+
+    if (deviceAPI->initAcquisition() && deviceAPI->startAcquisition())
+    {
+        m_dspEngine->startAudioOutput();
+        return true;
+    }
+    else
+    {
+        qWarning("MainCore::startAcquisition: device set %d: %s", deviceSetIndex, qPrintable(deviceAPI->errorMessage()));
+        return false;
+    }
+}
+
+bool MainCore::stopAcquisition(int deviceSetIndex)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return false;
+    }
+
+    m_deviceSets[deviceSetIndex]->m_deviceSourceAPI->stopAcquisition();
+    m_dspEngine->stopAudioOutput();
+
+    return true;
+}
+
+ChannelSinkAPI *MainCore::addChannel(int deviceSetIndex, const QString& channelId)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return 0;
+    }
+
+    DeviceSet *deviceSet = m_deviceSets[deviceSetIndex];
+    ChannelSinkAPI *channel = m_pluginManager->createRxChannelCoreInstance(channelId, deviceSet->m_deviceSourceAPI);
+
+    if (channel)
+    {
+        deviceSet->m_channels.append(channel);
+        deviceSet->m_channelIds.append(channelId);
+        renameChannels(deviceSet);
+    }
+
+    return channel;
+}
+
+bool MainCore::removeChannel(int deviceSetIndex, int channelIndex)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceSets.size())) {
+        return false;
+    }
+
+    DeviceSet *deviceSet = m_deviceSets[deviceSetIndex];
+
+    if ((channelIndex < 0) || (channelIndex >= deviceSet->m_channels.size())) {
+        return false;
+    }
+
+    deviceSet->m_channels.takeAt(channelIndex)->destroy();
+    deviceSet->m_channelIds.removeAt(channelIndex);
+    renameChannels(deviceSet);
+
+    return true;
+}
+
+void MainCore::removeChannels(DeviceSet *deviceSet)
+{
+    while (!deviceSet->m_channels.isEmpty()) {
+        deviceSet->m_channels.takeLast()->destroy();
+    }
+
+    deviceSet->m_channelIds.clear();
+}
+
+void MainCore::renameChannels(DeviceSet *deviceSet)
+{
+    for (int i = 0; i < deviceSet->m_channels.size(); i++) {
+        deviceSet->m_channels[i]->setName(QString("%1:%2").arg(deviceSet->m_channelIds[i]).arg(i));
+    }
+}
+
+void MainCore::purgeMessages()
+{
+    // reports are normally consumed by the GUIs. Without them they are just dropped.
+    for (std::vector<DeviceSet*>::iterator it = m_deviceSets.begin(); it != m_deviceSets.end(); ++it)
+    {
+        DeviceSourceAPI *deviceAPI = (*it)->m_deviceSourceAPI;
+        deviceAPI->getDeviceOutputMessageQueue()->clear();
+
+        if (deviceAPI->getSource()) {
+            deviceAPI->getSource()->getOutputMessageQueueToGUI()->clear();
+        }
+
+        for (int i = 0; i < (*it)->m_channels.size(); i++) {
+            (*it)->m_channels[i]->purgeReports();
+        }
+    }
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_MAINCORE_H_
+#define SDRSRV_MAINCORE_H_
+
+#include <QObject>
+#include <QTimer>
+#include <QList>
+#include <QStringList>
+#include <vector>
+
+#include "settings/mainsettings.h"
+#include "dsp/fftwisdom.h"
+#include "audio/audiodeviceinfo.h"
+
+class DSPEngine;
+class DSPDeviceSourceEngine;
+class DeviceSourceAPI;
+class ChannelSinkAPI;
+class PluginManager;
+class Preset;
+
+/**
+ * Counterpart of the MainWindow without any GUI. It holds the device sets made of a source device engine,
+ * its device API and the channels created on it. The devices and channels are created through the GUI-free
+ * factories of the plugins so only the plugins implementing them can be used.
+ */
+class MainCore : public QObject {
+    Q_OBJECT
+
+public:
+    struct DeviceSet
+    {
+        DSPDeviceSourceEngine *m_deviceSourceEngine;
+        DeviceSourceAPI *m_deviceSourceAPI;
+        QList<ChannelSinkAPI*> m_channels;
+        QStringList m_channelIds;
+
+        DeviceSet() :
+            m_deviceSourceEngine(0),
+            m_deviceSourceAPI(0)
+        { }
+    };
+
+    explicit MainCore(QObject *parent = 0);
+    ~MainCore();
+
+    MainSettings& getSettings() { return m_settings; }
+    PluginManager *getPluginManager() { return m_pluginManager; }
+    int getDeviceSetCount() const { return m_deviceSets.size(); }
+    const DeviceSet *getDeviceSet(int deviceSetIndex) const;
+
+    int addSourceDevice();        //!< Add a device set with the file source and return its index
+    bool removeLastDevice();      //!< Remove the last device set. The first one cannot be removed.
+    bool selectSampleSource(int deviceSetIndex, const QString& sourceId, const QString& sourceSerial, uint32_t sourceSequence);
+    bool loadPresetSettings(const Preset *preset, int deviceSetIndex, QString& errorMessage); //!< Fails without changes if a channel has no GUI-free implementation
+    bool startAcquisition(int deviceSetIndex);
+    bool stopAcquisition(int deviceSetIndex);
+    ChannelSinkAPI *addChannel(int deviceSetIndex, const QString& channelId);
+    bool removeChannel(int deviceSetIndex, int channelIndex);
+
+private:
+    MainSettings m_settings;
+    FFTWisdom m_fftWisdom;
+    AudioDeviceInfo m_audioDeviceInfo;
+    DSPEngine *m_dspEngine;
+    PluginManager *m_pluginManager;
+    QTimer m_masterTimer;
+    QTimer m_purgeTimer;
+    std::vector<DeviceSet*> m_deviceSets;
+
+    void deleteLastDeviceSet();
+    void removeChannels(DeviceSet *deviceSet);
+    void renameChannels(DeviceSet *deviceSet);
+
+private slots:
+    void purgeMessages();
+};
+
+#endif /* SDRSRV_MAINCORE_H_ */
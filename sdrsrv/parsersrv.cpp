@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCommandLineOption>
+#include <QHostAddress>
+#include <QDebug>
+
+#include "parsersrv.h"
+
+ParserSrv::ParserSrv() :
+    m_serverAddressOption(QStringList() << "a" << "address",
+        "Web API server address.",
+        "address",
+        "127.0.0.1"),
+    m_serverPortOption(QStringList() << "p" << "port",
+        "Web API server port.",
+        "port",
+        "8091")
+{
+    m_serverAddress = "127.0.0.1";
+    m_serverPort = 8091;
+
+    m_parser.setApplicationDescription("Software Defined Radio server controlled by a REST API");
+    m_parser.addHelpOption();
+    m_parser.addVersionOption();
+
+    m_parser.addOption(m_serverAddressOption);
+    m_parser.addOption(m_serverPortOption);
+}
+
+ParserSrv::~ParserSrv()
+{ }
+
+void ParserSrv::parse(const QCoreApplication& app)
+{
+    m_parser.process(app);
+
+    bool ok;
+
+    // server address
+
+    QString serverAddress = m_parser.value(m_serverAddressOption);
+
+    if (!QHostAddress(serverAddress).isNull()) {
+        m_serverAddress = serverAddress;
+    } else {
+        qWarning() << "ParserSrv::parse: server address invalid. Using default: " << m_serverAddress;
+    }
+
+    // server port
+
+    int serverPort = m_parser.value(m_serverPortOption).toInt(&ok);
+
+    if (ok && (serverPort > 1023) && (serverPort < 65536)) {
+        m_serverPort = serverPort;
+    } else {
+        qWarning() << "ParserSrv::parse: server port invalid. Using default: " << m_serverPort;
+    }
+}
@@ -0,0 +1,474 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/devicesamplesource.h"
+#include "device/devicesourceapi.h"
+#include "channel/channelsinkapi.h"
+#include "plugin/pluginmanager.h"
+#include "settings/preset.h"
+
+#include "maincore.h"
+#include "webapiadapter.h"
+
+static QString engineStateString(DSPDeviceSourceEngine::State state)
+{
+    switch (state)
+    {
+    case DSPDeviceSourceEngine::StIdle:
+        return "idle";
+    case DSPDeviceSourceEngine::StReady:
+        return "ready";
+    case DSPDeviceSourceEngine::StRunning:
+        return "running";
+    case DSPDeviceSourceEngine::StError:
+        return "error";
+    default:
+        return "notStarted";
+    }
+}
+
+WebAPIAdapter::WebAPIAdapter(MainCore& mainCore, QObject *parent) :
+    QObject(parent),
+    m_mainCore(mainCore)
+{
+    qRegisterMetaType<WebAPIReply>();
+}
+
+WebAPIAdapter::~WebAPIAdapter()
+{ }
+
+WebAPIReply WebAPIAdapter::serve(const QByteArray& method, const QByteArray& path, const QByteArray& body)
+{
+    qDebug("WebAPIAdapter::serve: %s %s", method.constData(), path.constData());
+
+    QJsonObject request;
+
+    if (!body.trimmed().isEmpty())
+    {
+        QJsonParseError parseError;
+        QJsonDocument document = QJsonDocument::fromJson(body, &parseError);
+
+        if (parseError.error != QJsonParseError::NoError) {
+            return error(400, QString("Invalid JSON: %1").arg(parseError.errorString()));
+        } else if (!document.isObject()) {
+            return error(400, "JSON object expected");
+        }
+
+        request = document.object();
+    }
+
+    QStringList parts = QString(path).split('/', QString::SkipEmptyParts);
+
+    if ((parts.size() == 0) || (parts[0] != "sdrangel")) {
+        return error(404, "Not found");
+    }
+
+    if (parts.size() == 1)
+    {
+        return method == "GET" ? instanceGet() : error(405, "Method not allowed");
+    }
+    else if ((parts.size() == 2) && (parts[1] == "devices"))
+    {
+        return method == "GET" ? devicesGet() : error(405, "Method not allowed");
+    }
+    else if ((parts.size() == 2) && (parts[1] == "channels"))
+    {
+        return method == "GET" ? channelsGet() : error(405, "Method not allowed");
+    }
+    else if ((parts.size() == 2) && (parts[1] == "presets"))
+    {
+        return method == "GET" ? presetsGet() : error(405, "Method not allowed");
+    }
+    else if ((parts.size() == 2) && (parts[1] == "devicesets"))
+    {
+        return deviceSetsService(method);
+    }
+    else if ((parts.size() > 2) && (parts[1] == "deviceset"))
+    {
+        bool ok;
+        int deviceSetIndex = parts[2].toInt(&ok);
+
+        if (!ok || (m_mainCore.getDeviceSet(deviceSetIndex) == 0)) {
+            return error(404, QString("Device set %1 not found").arg(parts[2]));
+        }
+
+        return deviceSetService(deviceSetIndex, parts.mid(3), method, request);
+    }
+
+    return error(404, "Not found");
+}
+
+WebAPIReply WebAPIAdapter::instanceGet()
+{
+    QJsonObject object;
+    object["appName"] = QCoreApplication::applicationName();
+    object["version"] = QCoreApplication::applicationVersion();
+    object["deviceSetCount"] = m_mainCore.getDeviceSetCount();
+    return reply(object);
+}
+
+WebAPIReply WebAPIAdapter::devicesGet()
+{
+    const PluginManager::SamplingDevices& devices = m_mainCore.getPluginManager()->getSampleSourceDevices();
+    QJsonArray array;
+
+    for (int i = 0; i < devices.count(); i++)
+    {
+        QJsonObject device;
+        device["index"] = i;
+        device["displayName"] = devices[i].m_displayName;
+        device["hwType"] = devices[i].m_hadrwareId;
+        device["id"] = devices[i].m_deviceId;
+        device["serial"] = devices[i].m_deviceSerial;
+        device["sequence"] = (int) devices[i].m_deviceSequence;
+        array.append(device);
+    }
+
+    QJsonObject object;
+    object["devices"] = array;
+    return reply(object);
+}
+
+WebAPIReply WebAPIAdapter::channelsGet()
+{
+    const PluginAPI::ChannelRegistrations *channels = m_mainCore.getPluginManager()->getRxChannelRegistrations();
+    QJsonArray array;
+
+    for (int i = 0; i < channels->count(); i++)
+    {
+        QJsonObject channel;
+        channel["index"] = i;
+        channel["id"] = channels->at(i).m_channelName;
+        array.append(channel);
+    }
+
+    QJsonObject object;
+    object["channels"] = array;
+    return reply(object);
+}
+
+WebAPIReply WebAPIAdapter::presetsGet()
+{
+    const MainSettings& settings = m_mainCore.getSettings();
+    QJsonArray array;
+
+    for (int i = 0; i < settings.getPresetCount(); i++)
+    {
+        const Preset *preset = settings.getPreset(i);
+        QJsonObject object;
+        object["index"] = i;
+        object["group"] = preset->getGroup();
+        object["description"] = preset->getDescription();
+        object["centerFrequency"] = (double) preset->getCenterFrequency();
+        object["source"] = preset->isSourcePreset();
+        array.append(object);
+    }
+
+    QJsonObject object;
+    object["presets"] = array;
+    return reply(object);
+}
+
+WebAPIReply WebAPIAdapter::deviceSetsService(const QByteArray& method)
+{
+    if (method == "GET")
+    {
+        QJsonArray array;
+
+        for (int i = 0; i < m_mainCore.getDeviceSetCount(); i++) {
+            array.append(deviceSetReport(i));
+        }
+
+        QJsonObject object;
+        object["deviceSets"] = array;
+        return reply(object);
+    }
+    else if (method == "POST")
+    {
+        int deviceSetIndex = m_mainCore.addSourceDevice();
+        return reply(deviceSetReport(deviceSetIndex), 201);
+    }
+    else if (method == "DELETE")
+    {
+        if (!m_mainCore.removeLastDevice()) {
+            return error(400, "The first device set cannot be removed");
+        }
+
+        QJsonObject object;
+        object["deviceSetCount"] = m_mainCore.getDeviceSetCount();
+        return reply(object);
+    }
+
+    return error(405, "Method not allowed");
+}
+
+WebAPIReply WebAPIAdapter::deviceSetService(int deviceSetIndex, const QStringList& path, const QByteArray& method, const QJsonObject& request)
+{
+    if (path.size() == 0)
+    {
+        return method == "GET" ? reply(deviceSetReport(deviceSetIndex)) : error(405, "Method not allowed");
+    }
+    else if ((path.size() == 1) && (path[0] == "device"))
+    {
+        return deviceService(deviceSetIndex, method, request);
+    }
+    else if ((path.size() == 2) && (path[0] == "device") && (path[1] == "run"))
+    {
+        return deviceRunService(deviceSetIndex, method);
+    }
+    else if ((path.size() == 1) && (path[0] == "preset"))
+    {
+        return presetService(deviceSetIndex, method, request);
+    }
+    else if ((path.size() == 1) && (path[0] == "channel"))
+    {
+        return channelsService(deviceSetIndex, method, request);
+    }
+    else if ((path.size() == 2) && (path[0] == "channel"))
+    {
+        bool ok;
+        int channelIndex = path[1].toInt(&ok);
+
+        if (!ok || (channelIndex < 0) || (channelIndex >= m_mainCore.getDeviceSet(deviceSetIndex)->m_channels.size())) {
+            return error(404, QString("Channel %1 not found").arg(path[1]));
+        }
+
+        return channelService(deviceSetIndex, channelIndex, method, request);
+    }
+
+    return error(404, "Not found");
+}
+
+WebAPIReply WebAPIAdapter::deviceService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request)
+{
+    if (method == "PUT") // select another device
+    {
+        if (!request.contains("id")) {
+            return error(400, "Device id expected");
+        }
+
+        if (!m_mainCore.selectSampleSource(deviceSetIndex,
+                request["id"].toString(),
+                request["serial"].toString(),
+                request["sequence"].toInt(0)))
+        {
+            return error(400, QString("Device %1 not found or not usable without GUI").arg(request["id"].toString()));
+        }
+
+        return reply(deviceSetReport(deviceSetIndex));
+    }
+    else if (method == "PATCH") // change settings of the current device
+    {
+        DeviceSampleSource *source = m_mainCore.getDeviceSet(deviceSetIndex)->m_deviceSourceAPI->getSource();
+
+        if (request.contains("settings"))
+        {
+            QByteArray settings = QByteArray::fromBase64(request["settings"].toString().toLatin1());
+
+            if (!source->deserialize(settings)) {
+                return error(400, "Device settings could not be applied");
+            }
+        }
+
+        if (request.contains("centerFrequency")) {
+            source->setCenterFrequency((qint64) request["centerFrequency"].toDouble());
+        }
+
+        return reply(deviceSetReport(deviceSetIndex));
+    }
+
+    return error(405, "Method not allowed");
+}
+
+WebAPIReply WebAPIAdapter::deviceRunService(int deviceSetIndex, const QByteArray& method)
+{
+    if (method == "POST")
+    {
+        if (!m_mainCore.startAcquisition(deviceSetIndex)) {
+            return error(500, m_mainCore.getDeviceSet(deviceSetIndex)->m_deviceSourceAPI->errorMessage());
+        }
+    }
+    else if (method == "DELETE")
+    {
+        m_mainCore.stopAcquisition(deviceSetIndex);
+    }
+    else if (method != "GET")
+    {
+        return error(405, "Method not allowed");
+    }
+
+    QJsonObject object;
+    object["state"] = engineStateString(m_mainCore.getDeviceSet(deviceSetIndex)->m_deviceSourceAPI->state());
+    return reply(object);
+}
+
+WebAPIReply WebAPIAdapter::presetService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request)
+{
+    if (method != "PATCH") {
+        return error(405, "Method not allowed");
+    }
+
+    const MainSettings& settings = m_mainCore.getSettings();
+    const Preset *preset = 0;
+
+    if (request.contains("index"))
+    {
+        int presetIndex = request["index"].toInt(-1);
+
+        if ((presetIndex >= 0) && (presetIndex < settings.getPresetCount())) {
+            preset = settings.getPreset(presetIndex);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < settings.getPresetCount(); i++)
+        {
+            if ((settings.getPreset(i)->getGroup() == request["group"].toString())
+             && (settings.getPreset(i)->getDescription() == request["description"].toString()))
+            {
+                preset = settings.getPreset(i);
+                break;
+            }
+        }
+    }
+
+    if (preset == 0) {
+        return error(404, "Preset not found");
+    }
+
+    QString errorMessage;
+
+    if (!m_mainCore.loadPresetSettings(preset, deviceSetIndex, errorMessage)) {
+        return error(400, errorMessage);
+    }
+
+    return reply(deviceSetReport(deviceSetIndex));
+}
+
+WebAPIReply WebAPIAdapter::channelsService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request)
+{
+    if (method != "POST") {
+        return error(405, "Method not allowed");
+    }
+
+    ChannelSinkAPI *channel = m_mainCore.addChannel(deviceSetIndex, request["id"].toString());
+
+    if (channel == 0) {
+        return error(400, QString("Channel %1 not found or not usable without GUI").arg(request["id"].toString()));
+    }
+
+    return channelService(deviceSetIndex, m_mainCore.getDeviceSet(deviceSetIndex)->m_channels.size() - 1, "GET", QJsonObject());
+}
+
+WebAPIReply WebAPIAdapter::channelService(int deviceSetIndex, int channelIndex, const QByteArray& method, const QJsonObject& request)
+{
+    const MainCore::DeviceSet *deviceSet = m_mainCore.getDeviceSet(deviceSetIndex);
+    ChannelSinkAPI *channel = deviceSet->m_channels[channelIndex];
+
+    if (method == "DELETE")
+    {
+        m_mainCore.removeChannel(deviceSetIndex, channelIndex);
+        return reply(deviceSetReport(deviceSetIndex));
+    }
+    else if (method == "PATCH")
+    {
+        if (request.contains("settings"))
+        {
+            QByteArray settings = QByteArray::fromBase64(request["settings"].toString().toLatin1());
+
+            if (!channel->deserialize(settings)) {
+                return error(400, "Channel settings could not be applied");
+            }
+        }
+
+        if (request.contains("deltaFrequency")) {
+            channel->setCenterFrequency((qint64) request["deltaFrequency"].toDouble());
+        }
+    }
+    else if (method != "GET")
+    {
+        return error(405, "Method not allowed");
+    }
+
+    QJsonObject object;
+    object["index"] = channelIndex;
+    object["id"] = deviceSet->m_channelIds[channelIndex];
+    object["name"] = channel->getName();
+    object["deltaFrequency"] = (double) channel->getCenterFrequency();
+    object["settings"] = QString(channel->serialize().toBase64());
+    return reply(object);
+}
+
+QJsonObject WebAPIAdapter::deviceSetReport(int deviceSetIndex)
+{
+    const MainCore::DeviceSet *deviceSet = m_mainCore.getDeviceSet(deviceSetIndex);
+    DeviceSourceAPI *deviceAPI = deviceSet->m_deviceSourceAPI;
+    DeviceSampleSource *source = deviceAPI->getSource();
+
+    QJsonObject device;
+    device["hwType"] = deviceAPI->getHardwareId();
+    device["id"] = deviceAPI->getSampleSourceId();
+    device["serial"] = deviceAPI->getSampleSourceSerial();
+    device["sequence"] = (int) deviceAPI->getSampleSourceSequence();
+    device["state"] = engineStateString(deviceAPI->state());
+
+    if (source)
+    {
+        device["description"] = source->getDeviceDescription();
+        device["centerFrequency"] = (double) source->getCenterFrequency();
+        device["sampleRate"] = source->getSampleRate();
+        device["settings"] = QString(source->serialize().toBase64());
+    }
+
+    QJsonArray channels;
+
+    for (int i = 0; i < deviceSet->m_channels.size(); i++)
+    {
+        QJsonObject channel;
+        channel["index"] = i;
+        channel["id"] = deviceSet->m_channelIds[i];
+        channel["name"] = deviceSet->m_channels[i]->getName();
+        channel["deltaFrequency"] = (double) deviceSet->m_channels[i]->getCenterFrequency();
+        channels.append(channel);
+    }
+
+    QJsonObject object;
+    object["index"] = deviceSetIndex;
+    object["device"] = device;
+    object["channels"] = channels;
+    return object;
+}
+
+WebAPIReply WebAPIAdapter::reply(const QJsonObject& object, int status)
+{
+    WebAPIReply webAPIReply;
+    webAPIReply.m_status = status;
+    webAPIReply.m_body = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    return webAPIReply;
+}
+
+WebAPIReply WebAPIAdapter::error(int status, const QString& message)
+{
+    QJsonObject object;
+    object["message"] = message;
+    return reply(object, status);
+}
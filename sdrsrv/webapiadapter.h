@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_WEBAPIADAPTER_H_
+#define SDRSRV_WEBAPIADAPTER_H_
+
+#include <QObject>
+#include <QByteArray>
+#include <QStringList>
+#include <QJsonObject>
+#include <QMetaType>
+
+class MainCore;
+
+struct WebAPIReply
+{
+    int m_status;        //!< HTTP status code
+    QByteArray m_body;   //!< JSON body
+
+    WebAPIReply() :
+        m_status(200)
+    { }
+};
+
+Q_DECLARE_METATYPE(WebAPIReply)
+
+/**
+ * Translates the REST requests into MainCore calls. It lives in the main thread together with MainCore
+ * and the DSP objects so the HTTP worker threads reach it only through a blocking queued invocation of serve().
+ */
+class WebAPIAdapter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WebAPIAdapter(MainCore& mainCore, QObject *parent = 0);
+    ~WebAPIAdapter();
+
+    Q_INVOKABLE WebAPIReply serve(const QByteArray& method, const QByteArray& path, const QByteArray& body);
+
+private:
+    MainCore& m_mainCore;
+
+    WebAPIReply instanceGet();
+    WebAPIReply devicesGet();
+    WebAPIReply channelsGet();
+    WebAPIReply presetsGet();
+    WebAPIReply deviceSetsService(const QByteArray& method);
+    WebAPIReply deviceSetService(int deviceSetIndex, const QStringList& path, const QByteArray& method, const QJsonObject& request);
+    WebAPIReply deviceService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request);
+    WebAPIReply deviceRunService(int deviceSetIndex, const QByteArray& method);
+    WebAPIReply presetService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request);
+    WebAPIReply channelsService(int deviceSetIndex, const QByteArray& method, const QJsonObject& request);
+    WebAPIReply channelService(int deviceSetIndex, int channelIndex, const QByteArray& method, const QJsonObject& request);
+
+    QJsonObject deviceSetReport(int deviceSetIndex);
+    static WebAPIReply reply(const QJsonObject& object, int status = 200);
+    static WebAPIReply error(int status, const QString& message);
+};
+
+#endif /* SDRSRV_WEBAPIADAPTER_H_ */
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QMetaObject>
+
+#include "dsp/dspmetrics.h"
+
+#include "webapiadapter.h"
+#include "webapirequesthandler.h"
+
+static QByteArray statusDescription(int status)
+{
+    switch (status)
+    {
+    case 200:
+        return "OK";
+    case 201:
+        return "Created";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    default:
+        return "Internal Server Error";
+    }
+}
+
+WebAPIRequestHandler::WebAPIRequestHandler(WebAPIAdapter *adapter, QObject *parent) :
+    HttpRequestHandler(parent),
+    m_adapter(adapter)
+{ }
+
+WebAPIRequestHandler::~WebAPIRequestHandler()
+{ }
+
+void WebAPIRequestHandler::service(stefanfrings::HttpRequest& request, stefanfrings::HttpResponse& response)
+{
+    // the metrics registry can be read from any thread so this one does not wait for the main thread
+    if ((request.getPath() == "/metrics") && (request.getMethod() == "GET"))
+    {
+        response.setHeader("Content-Type", "text/plain; version=0.0.4");
+        response.write(DSPMetrics::instance()->serializePrometheus(), true);
+        return;
+    }
+
+    WebAPIReply reply;
+
+    QMetaObject::invokeMethod(m_adapter, "serve", Qt::BlockingQueuedConnection,
+            Q_RETURN_ARG(WebAPIReply, reply),
+            Q_ARG(QByteArray, request.getMethod()),
+            Q_ARG(QByteArray, request.getPath()),
+            Q_ARG(QByteArray, request.getBody()));
+
+    response.setHeader("Content-Type", "application/json; charset=utf-8");
+    response.setStatus(reply.m_status, statusDescription(reply.m_status));
+    response.write(reply.m_body, true);
+}
@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_WEBAPIREQUESTHANDLER_H_
+#define SDRSRV_WEBAPIREQUESTHANDLER_H_
+
+#include "httprequesthandler.h"
+
+class WebAPIAdapter;
+
+/**
+ * Called on the HTTP server threads. The request is handed over to the adapter in the main thread
+ * and the thread waits for its reply.
+ */
+class WebAPIRequestHandler : public stefanfrings::HttpRequestHandler {
+    Q_OBJECT
+
+public:
+    explicit WebAPIRequestHandler(WebAPIAdapter *adapter, QObject *parent = 0);
+    virtual ~WebAPIRequestHandler();
+
+    virtual void service(stefanfrings::HttpRequest& request, stefanfrings::HttpResponse& response);
+
+private:
+    WebAPIAdapter *m_adapter;
+};
+
+#endif /* SDRSRV_WEBAPIREQUESTHANDLER_H_ */